@@ -0,0 +1,44 @@
+# Compiles the CppAD models of a problem ahead of time into a static library.
+#
+#   ocs2_add_cppad_bundle(<target> GENERATOR <executable> [ARGS <arg>...] [DEPENDS <file>...])
+#
+# The generator is an executable that creates the models inside an ocs2::CppAdModelExporter, see CppAdModelExporter in
+# ocs2_core/automatic_differentiation/CppAdModelBundle.h. It is called at build time as
+#   <executable> <output folder> <target> <arg>...
+# and has to write the bundle named <target> to the output folder. The bundle is regenerated when the generator or one of the DEPENDS
+# files, for example the task file, changes.
+#
+# Targets that link <target> compile its registration source, such that ocs2::CppAdInterface binds to the bundled models at runtime
+# instead of compiling and loading a shared library. Models that do not match the bundle fall back to the libraries on disk.
+include(CMakeParseArguments)
+
+function(ocs2_add_cppad_bundle TARGET)
+  cmake_parse_arguments(BUNDLE "" "GENERATOR" "ARGS;DEPENDS" ${ARGN})
+  if(NOT BUNDLE_GENERATOR)
+    message(FATAL_ERROR "ocs2_add_cppad_bundle: GENERATOR is required")
+  endif()
+
+  set(BUNDLE_FOLDER ${CMAKE_CURRENT_BINARY_DIR}/${TARGET})
+  set(BUNDLE_MODELS ${BUNDLE_FOLDER}/${TARGET}_models.c)
+  set(BUNDLE_REGISTRATION ${BUNDLE_FOLDER}/${TARGET}_registration.cpp)
+  set(BUNDLE_STAMP ${BUNDLE_FOLDER}/${TARGET}.stamp)
+
+  # The generator only rewrites sources that change, the stamp tracks when it ran.
+  add_custom_command(
+    OUTPUT ${BUNDLE_STAMP}
+    BYPRODUCTS ${BUNDLE_MODELS} ${BUNDLE_REGISTRATION}
+    COMMAND ${BUNDLE_GENERATOR} ${BUNDLE_FOLDER} ${TARGET} ${BUNDLE_ARGS}
+    COMMAND ${CMAKE_COMMAND} -E touch ${BUNDLE_STAMP}
+    DEPENDS ${BUNDLE_GENERATOR} ${BUNDLE_DEPENDS}
+    COMMENT "Generating CppAD models of ${TARGET}"
+    VERBATIM
+  )
+  add_custom_target(${TARGET}_generate DEPENDS ${BUNDLE_STAMP})
+
+  # The registration is compiled into the targets that link the bundle, the linker would drop it from the static library otherwise.
+  add_library(${TARGET} STATIC ${BUNDLE_MODELS})
+  add_dependencies(${TARGET} ${TARGET}_generate)
+  set_target_properties(${TARGET} PROPERTIES POSITION_INDEPENDENT_CODE ON)
+  target_sources(${TARGET} INTERFACE ${BUNDLE_REGISTRATION})
+  target_link_libraries(${TARGET} m)
+endfunction()
@@ -70,6 +70,9 @@ class StateAugmentedLagrangian final : public StateAugmentedLagrangianInterface
 
   Multiplier initializeLagrangian(scalar_t time) const override;
 
+  /** The penalty depends on the same variables as the constraint */
+  const ApproximationSparsity& getSparsity() const override { return constraintPtr_->getSparsity(); }
+
   /** Gets the wrapped constraint. */
   template <typename Derived = StateConstraint>
   Derived& get() {
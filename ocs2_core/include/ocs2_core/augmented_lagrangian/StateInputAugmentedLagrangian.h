@@ -72,6 +72,9 @@ class StateInputAugmentedLagrangian final : public StateInputAugmentedLagrangian
 
   Multiplier initializeLagrangian(scalar_t time) const override;
 
+  /** The penalty depends on the same variables as the constraint */
+  const ApproximationSparsity& getSparsity() const override { return constraintPtr_->getSparsity(); }
+
   /** Gets the wrapped constraint. */
   template <typename Derived = StateInputConstraint>
   Derived& get() {
@@ -66,6 +66,9 @@ class StateInputAugmentedLagrangianInterface {
   /** Initialize Lagrange/penalty multipliers. */
   virtual Multiplier initializeLagrangian(scalar_t time) const = 0;
 
+  /** Get the variables that the penalty depends on. The collection only adds the nonzero blocks of sparse terms. The default is dense. */
+  virtual const ApproximationSparsity& getSparsity() const { return ApproximationSparsity::dense(); }
+
  protected:
   StateInputAugmentedLagrangianInterface(const StateInputAugmentedLagrangianInterface& rhs) = default;
 };
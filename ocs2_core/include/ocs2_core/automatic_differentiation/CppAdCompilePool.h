@@ -0,0 +1,112 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+class CppAdInterface;
+
+/**
+ * Background pool for compiling the code-generated CppAD libraries in parallel.
+ *
+ * While a pool is alive, the CppAdInterface objects that are created on the same thread do not compile their library in place. The
+ * source code is still generated in the calling thread, but the compilation is handed to the pool and the library is loaded once
+ * wait() is called. This allows to start the compilation of all the models of a problem and to wait on all of them at once:
+ *
+ *   CppAdCompilePool compilePool;
+ *   ... create the CppAD based dynamics, costs and constraints ...
+ *   compilePool.wait();
+ *
+ * @note The models can neither be evaluated nor moved to another thread before wait() has returned. Copies that are made before are
+ * loaded together with the original.
+ */
+class CppAdCompilePool {
+ public:
+  /**
+   * Constructor. Makes this pool the active pool of the calling thread.
+   *
+   * @param [in] nThreads: Number of compilations running in parallel.
+   */
+  explicit CppAdCompilePool(size_t nThreads = defaultNumThreads());
+
+  /** Destructor. Waits for the remaining compilations and restores the previously active pool. */
+  ~CppAdCompilePool();
+
+  CppAdCompilePool(const CppAdCompilePool&) = delete;
+  CppAdCompilePool& operator=(const CppAdCompilePool&) = delete;
+
+  /**
+   * Blocks until all the libraries handed to the pool are compiled and loads them into their CppAdInterface objects.
+   * If a compilation fails, the first error is rethrown after all the others are finished.
+   */
+  void wait();
+
+  /** Returns the pool that is active on the calling thread, nullptr if there is none. */
+  static CppAdCompilePool* getActivePool();
+
+  /** Number of hardware threads, at least one. */
+  static size_t defaultNumThreads();
+
+ private:
+  friend class CppAdInterface;
+
+  /**
+   * Runs the compilation job in the background.
+   *
+   * @param [in] job: The compilation.
+   * @param [in] resources: Objects used by the job. They are kept alive until wait() and released in the thread calling wait().
+   * @return future of the compilation
+   */
+  std::shared_future<void> compile(std::function<void()> job, std::shared_ptr<void> resources);
+
+  /** Registers an interface whose library is loaded in wait(). */
+  void registerInterface(CppAdInterface* adInterface);
+
+  /** Removes an interface that is destroyed before wait(). */
+  void unregisterInterface(CppAdInterface* adInterface);
+
+  CppAdCompilePool* previousActivePool_;
+  ThreadPool threadPool_;
+
+  std::mutex mutex_;
+  std::vector<std::shared_future<void>> compilations_;
+  std::vector<std::shared_ptr<void>> resources_;
+  std::vector<CppAdInterface*> pendingInterfaces_;
+};
+
+}  // namespace ocs2
@@ -33,7 +33,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Eigen/Core>
 
 // STL
+#include <future>
+#include <memory>
 #include <string>
+#include <vector>
 
 // CppAD
 #include <cppad/cg.hpp>
@@ -45,6 +48,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+class CppAdCompilePool;
+
+/**
+ * Interface to the code generation of CppAD models.
+ *
+ * The generated libraries are cached on disk. The file name of a library contains a hash of the recorded tape, the dimensions, the
+ * approximation order and the compile flags, such that a library is only reused if it still matches the model. Libraries are compiled
+ * to a temporary file and renamed when complete, which makes the cache safe to share between concurrent processes.
+ *
+ * If a CppAdCompilePool is active on the calling thread, the compilation runs in the background. See CppAdCompilePool.
+ *
+ * Models that are compiled ahead of time into a bundle that is linked into the executable are used instead of the libraries on disk,
+ * see CppAdModelBundle.h. The bundled model has to match the model in the same way as a library on disk.
+ */
 class CppAdInterface {
  public:
   enum class ApproximationOrder { Zero, First, Second };
@@ -82,10 +99,11 @@ class CppAdInterface {
   CppAdInterface(ad_function_t adFunction, size_t variableDim, std::string modelName, std::string folderName = "/tmp/ocs2",
                  std::vector<std::string> compileFlags = {"-O3", "-g", "-march=native", "-mtune=native", "-ffast-math"});
 
-  ~CppAdInterface() = default;
+  ~CppAdInterface();
 
   /**
-   * Copy constructor. Models are reloaded if available.
+   * Copy constructor. Models are reloaded if available. If the library of rhs is still compiled in a CppAdCompilePool, the copy is
+   * loaded together with rhs.
    */
   CppAdInterface(const CppAdInterface& rhs);
 
@@ -95,12 +113,13 @@ class CppAdInterface {
   CppAdInterface& operator=(CppAdInterface&& rhs) = delete;
 
   /**
-   * Loads earlier created model from disk
+   * Loads the model created earlier by this object, or the object it was copied from, from disk.
    */
   void loadModels(bool verbose = true);
 
   /**
-   * Creates models, compiles them, and saves them to disk
+   * Creates models, compiles them, and saves them to disk. A bundled model that matches the model is used without compilation, it
+   * cannot be outdated.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -108,7 +127,7 @@ class CppAdInterface {
   void createModels(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
   /**
-   * Load models if they are available on disk. Creates a new library otherwise.
+   * Load models if a bundled model or a library on disk that matches the model is available. Creates a new library otherwise.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -122,6 +141,15 @@ class CppAdInterface {
    */
   vector_t getFunctionValue(const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Evaluates the function into a caller-provided vector. Does not allocate if functionValue already has the size of the range.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] functionValue : y = f(x,p)
+   */
+  void getFunctionValue(const vector_t& x, const vector_t& p, vector_t& functionValue) const;
+
   /**
    * Jacobian with gradient of each output w.r.t the variables x in the rows.
    *
@@ -131,6 +159,15 @@ class CppAdInterface {
    */
   matrix_t getJacobian(const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Jacobian written into a caller-provided matrix. Does not allocate if jacobian already has the size (rangeDim x variableDim).
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] jacobian : d/dx( f(x,p) )
+   */
+  void getJacobian(const vector_t& x, const vector_t& p, matrix_t& jacobian) const;
+
   /**
    * Returns the full Gauss-Newton approximation of the function.
    * With auto differentiated function y = f(x,p), the following approximation is made:
@@ -145,6 +182,16 @@ class CppAdInterface {
    */
   ScalarFunctionQuadraticApproximation getGaussNewtonApproximation(const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Gauss-Newton approximation written into a caller-provided approximation. Only f, dfdx and dfdxx are written, the other fields
+   * are left untouched. Does not allocate if dfdx and dfdxx already have the right size.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] gnApprox : Quadratic approximation with the values stored in f, dfdx, dfdxx.
+   */
+  void getGaussNewtonApproximation(const vector_t& x, const vector_t& p, ScalarFunctionQuadraticApproximation& gnApprox) const;
+
   /**
    * Hessian, available per output.
    *
@@ -155,6 +202,17 @@ class CppAdInterface {
    */
   matrix_t getHessian(size_t outputIndex, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Hessian of one output written into a caller-provided matrix. Does not allocate if hessian already has the size
+   * (variableDim x variableDim).
+   *
+   * @param outputIndex : Output to get the hessian for.
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] hessian : dd/dxdx( f_i(x,p) )
+   */
+  void getHessian(size_t outputIndex, const vector_t& x, const vector_t& p, matrix_t& hessian) const;
+
   /**
    * Weighted hessian
    *
@@ -165,7 +223,93 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Weighted hessian written into a caller-provided matrix. Does not allocate if hessian already has the size
+   * (variableDim x variableDim).
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] hessian : dd/dxdx(sum_i  w_i*f_i(x,p) )
+   */
+  void getHessian(const vector_t& w, const vector_t& x, const vector_t& p, matrix_t& hessian) const;
+
+  /**
+   * Indices of the variables x that the function depends on, in increasing order. The derivatives w.r.t. all the other variables are
+   * zero. Detected while taping in createModels() and loadModelsIfAvailable(), before that all variables are returned.
+   */
+  const std::vector<size_t>& getVariableSparsity() const { return variableSparsity_; }
+
  private:
+  friend class CppAdCompilePool;
+
+  /**
+   * Records the tape of the function and stores the range dimension.
+   * @return optimized tape
+   */
+  std::unique_ptr<ad_fun_t> createTape();
+
+  /**
+   * Computes the key of the library in the cache, a hash of the operation graph of the tape, the dimensions, the approximation order
+   * and the compile flags.
+   *
+   * @param fun : taped ad function
+   * @param approximationOrder : Order of derivatives to generate
+   * @return hexadecimal representation of the hash
+   */
+  std::string computeLibraryKey(ad_fun_t& fun, ApproximationOrder approximationOrder) const;
+
+  /**
+   * Generates the sources and compiles the library. If a CppAdCompilePool is active, the compilation is handed to the pool and the
+   * library is loaded in CppAdCompilePool::wait(). Otherwise the library is loaded right away.
+   *
+   * @param fun : taped ad function
+   * @param approximationOrder : Order of derivatives to generate
+   * @param verbose : Print out extra information
+   */
+  void compileLibrary(std::unique_ptr<ad_fun_t> fun, ApproximationOrder approximationOrder, bool verbose);
+
+  /**
+   * Waits for the compilation in the CppAdCompilePool and loads the library. Called by the pool.
+   */
+  void finishPendingCompilation();
+
+  /**
+   * Name of the model in a bundle, the model name followed by the library key. Used as prefix of the generated C functions.
+   */
+  std::string getBundleModelName() const;
+
+  /**
+   * Binds the model of a registered bundle.
+   *
+   * @param verbose : Print out extra information
+   */
+  void loadBundleModel(bool verbose);
+
+  /**
+   * Generates the sources and adds them to the active CppAdModelExporter instead of compiling them.
+   *
+   * @param fun : taped ad function
+   * @param approximationOrder : Order of derivatives to generate
+   * @param verbose : Print out extra information
+   */
+  void exportModel(std::unique_ptr<ad_fun_t> fun, ApproximationOrder approximationOrder, bool verbose);
+
+  /**
+   * Weighted hessian with the weights given as an array.
+   */
+  void getHessian(CppAD::cg::ArrayView<const scalar_t> w, const vector_t& x, const vector_t& p, matrix_t& hessian) const;
+
+  /**
+   * Concatenates the variables and the parameters.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [in, out] buffer : Storage for the concatenation. Only used if there are parameters.
+   * @return view on [x; p]
+   */
+  CppAD::cg::ArrayView<const scalar_t> concatenateInput(const vector_t& x, const vector_t& p, std::vector<scalar_t>& buffer) const;
+
   /**
    * Defines library folder names
    */
@@ -207,6 +351,12 @@ class CppAdInterface {
    */
   void setSparsityNonzeros();
 
+  /**
+   * Stores the variables that the taped function depends on
+   * @param fun : taped ad function
+   */
+  void setVariableSparsity(ad_fun_t& fun);
+
   /**
    * Creates sparsity pattern for the Jacobian that will be generated
    * @param fun : taped ad function
@@ -232,6 +382,7 @@ class CppAdInterface {
   size_t rangeDim_ = 0;
   size_t nnzJacobian_ = 0;
   size_t nnzHessian_ = 0;
+  std::vector<size_t> variableSparsity_;
 
   // Names
   std::string modelName_;
@@ -239,7 +390,12 @@ class CppAdInterface {
   std::string libraryFolder_;
   std::string tmpName_;
   std::string tmpFolder_;
+  std::string libraryKey_;
   std::string libraryName_;
+
+  // Compilation in a CppAdCompilePool
+  CppAdCompilePool* compilePool_ = nullptr;
+  std::shared_future<void> pendingCompilation_;
 };
 
 }  // namespace ocs2
@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace CppAD {
+namespace cg {
+template <class Base>
+class GenericModel;
+}  // namespace cg
+}  // namespace CppAD
+
+namespace ocs2 {
+
+class CppAdInterface;
+
+/**
+ * Entry of the function table of a model bundle. The layout matches the table that is written by CppAdModelExporter into the C sources
+ * of the bundle. The table is terminated by an entry with a null name.
+ */
+struct CppAdBundleFunction {
+  const char* name;
+  void* function;
+};
+
+/**
+ * Registers the functions of a model bundle. Called by the registration source of the bundle at static initialization.
+ *
+ * @param [in] functions: Null terminated function table of the bundle.
+ * @return true
+ */
+bool registerCppAdBundle(const CppAdBundleFunction* functions);
+
+/**
+ * Checks whether a model is available in one of the registered bundles.
+ *
+ * @param [in] bundleModelName: Name of the model in the bundle, see CppAdInterface.
+ */
+bool isCppAdBundleModelAvailable(const std::string& bundleModelName);
+
+/**
+ * Binds a model of a registered bundle. Throws if the model is not available.
+ *
+ * @param [in] bundleModelName: Name of the model in the bundle, see CppAdInterface.
+ * @return model evaluating the functions that are linked into the executable
+ */
+std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> loadCppAdBundleModel(const std::string& bundleModelName);
+
+/**
+ * Exports the code-generated CppAD models into a bundle that is compiled ahead of time.
+ *
+ * While an exporter is alive, the CppAdInterface objects that are created on the same thread neither compile nor load their models.
+ * They add the generated sources to the exporter instead, and write() stores all of them into two files:
+ *
+ *   <bundleName>_models.c: The sources of all the models and a function table.
+ *   <bundleName>_registration.cpp: Registers the function table at static initialization.
+ *
+ * Linking both into an executable makes CppAdInterface bind to the models without a compiler or dynamic loading at runtime. The CMake
+ * helper ocs2_add_cppad_bundle() runs a generator executable at build time and creates the library of the bundle.
+ *
+ * The models are identified by the same key as the libraries on disk, a bundled model is therefore only used if it matches the model
+ * that is created at runtime. Other models fall back to the libraries on disk.
+ */
+class CppAdModelExporter {
+ public:
+  /**
+   * Constructor. Makes this exporter the active exporter of the calling thread.
+   *
+   * @param [in] bundleName: Name of the bundle, has to be a valid C identifier.
+   */
+  explicit CppAdModelExporter(std::string bundleName);
+
+  /** Destructor. Restores the previously active exporter. */
+  ~CppAdModelExporter();
+
+  CppAdModelExporter(const CppAdModelExporter&) = delete;
+  CppAdModelExporter& operator=(const CppAdModelExporter&) = delete;
+
+  /**
+   * Writes the sources of the bundle. The files are only touched if their content changes, which avoids rebuilding the bundle.
+   *
+   * @param [in] outputFolder: Folder to write the files to, created if needed.
+   */
+  void write(const std::string& outputFolder) const;
+
+  /** Number of exported models. */
+  size_t getNumModels() const { return modelNames_.size(); }
+
+  /** Returns the exporter that is active on the calling thread, nullptr if there is none. */
+  static CppAdModelExporter* getActiveExporter();
+
+ private:
+  friend class CppAdInterface;
+
+  /**
+   * Adds the sources of a model. Models that are already part of the bundle are skipped.
+   *
+   * @param [in] bundleModelName: Name of the model in the bundle.
+   * @param [in] sources: Model sources generated by CppADCodeGen, by file name.
+   */
+  void addModel(const std::string& bundleModelName, const std::map<std::string, std::string>& sources);
+
+  CppAdModelExporter* previousActiveExporter_;
+  std::string bundleName_;
+  std::set<std::string> modelNames_;
+  std::vector<std::pair<std::string, std::string>> sources_;  // function name and source
+};
+
+}  // namespace ocs2
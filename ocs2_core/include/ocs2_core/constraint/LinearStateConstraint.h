@@ -57,6 +57,9 @@ class LinearStateConstraint : public StateConstraint {
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t t, const vector_t& x,
                                                            const PreComputation& /* preComputation */) const final;
 
+  void getLinearApproximation(scalar_t t, const vector_t& x, const PreComputation& /* preComputation */,
+                              VectorFunctionLinearApproximation& g) const final;
+
  public:
   vector_t h_; /**< State only constraint */
   matrix_t F_; /**< State only constraint derivative wrt. state */
@@ -58,6 +58,9 @@ class LinearStateInputConstraint : public StateInputConstraint {
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
                                                            const PreComputation& /* preComputation */) const final;
 
+  void getLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& /* preComputation */,
+                              VectorFunctionLinearApproximation& g) const final;
+
  public:
   vector_t e_; /**< State input constraint */
   matrix_t C_; /**< State input constraint derivative wrt. state */
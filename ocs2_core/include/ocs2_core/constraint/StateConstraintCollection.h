@@ -55,6 +55,9 @@ class StateConstraintCollection : public Collection<StateConstraint> {
   /** Returns the number of active constraints at a given time for each term. If a term is inactive, its size is zero. */
   size_array_t getTermsSize(scalar_t time) const;
 
+  /** Same as above, but writes into a caller-provided output to reuse its memory. */
+  void getTermsSize(scalar_t time, size_array_t& termsSize) const;
+
   /** Get an array of all constraints. If a term is inactive, the corresponding element is a vector of size zero. */
   virtual vector_array_t getValue(scalar_t time, const vector_t& state, const PreComputation& preComp) const;
 
@@ -62,6 +65,13 @@ class StateConstraintCollection : public Collection<StateConstraint> {
   virtual VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
                                                                    const PreComputation& preComp) const;
 
+  /**
+   * Get the constraint linear approximation into a caller-provided output. The memory of the output is reused.
+   * @note A derived class that overrides the method above should override this one as well.
+   */
+  virtual void getLinearApproximation(scalar_t time, const vector_t& state, const PreComputation& preComp,
+                                      VectorFunctionLinearApproximation& linearApproximation) const;
+
   /** Get the constraint quadratic approximation */
   virtual VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                          const PreComputation& preComp) const;
@@ -62,9 +62,14 @@ class StateConstraintCppAd : public StateConstraint {
   vector_t getValue(scalar_t time, const vector_t& state, const PreComputation& preComputation) const override;
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
                                                            const PreComputation& preComputation) const override;
+  void getLinearApproximation(scalar_t time, const vector_t& state, const PreComputation& preComputation,
+                              VectorFunctionLinearApproximation& constraint) const override;
   VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                  const PreComputation& preComputation) const override;
 
+  /** Sparsity detected while taping the constraint */
+  const ApproximationSparsity& getSparsity() const override { return sparsity_; }
+
  protected:
   StateConstraintCppAd(const StateConstraintCppAd& rhs);
 
@@ -73,6 +78,7 @@ class StateConstraintCppAd : public StateConstraint {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  ApproximationSparsity sparsity_;
 };
 
 }  // namespace ocs2
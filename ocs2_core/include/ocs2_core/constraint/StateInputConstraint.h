@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/Types.h>
 #include <ocs2_core/constraint/ConstraintOrder.h>
+#include <ocs2_core/misc/ApproximationSparsity.h>
 
 namespace ocs2 {
 
@@ -66,6 +67,12 @@ class StateInputConstraint {
     }
   }
 
+  /** Get the constraint linear approximation into a caller-provided output. Override this method to reuse the memory of the output. */
+  virtual void getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+                                      VectorFunctionLinearApproximation& linearApproximation) const {
+    linearApproximation = getLinearApproximation(time, state, input, preComp);
+  }
+
   /** Get the constraint quadratic approximation */
   virtual VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                          const PreComputation& preComp) const {
@@ -76,6 +83,12 @@ class StateInputConstraint {
     }
   }
 
+  /**
+   * Get the variables that the constraint depends on. The penalties of the soft constraints and the augmented Lagrangian terms inherit
+   * it, and the collections only add the nonzero blocks of their approximations. The default is dense.
+   */
+  virtual const ApproximationSparsity& getSparsity() const { return ApproximationSparsity::dense(); }
+
  protected:
   StateInputConstraint(const StateInputConstraint& rhs) = default;
 
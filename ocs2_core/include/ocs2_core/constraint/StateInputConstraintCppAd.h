@@ -63,9 +63,14 @@ class StateInputConstraintCppAd : public StateInputConstraint {
   vector_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& /* preComputation */) const override;
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                            const PreComputation& /* preComputation */) const override;
+  void getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& /* preComputation */,
+                              VectorFunctionLinearApproximation& constraint) const override;
   VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                  const PreComputation& /* preComputation */) const override;
 
+  /** Sparsity detected while taping the constraint */
+  const ApproximationSparsity& getSparsity() const override { return sparsity_; }
+
  protected:
   StateInputConstraintCppAd(const StateInputConstraintCppAd& rhs);
 
@@ -75,6 +80,7 @@ class StateInputConstraintCppAd : public StateInputConstraint {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  ApproximationSparsity sparsity_;
 };
 
 }  // namespace ocs2
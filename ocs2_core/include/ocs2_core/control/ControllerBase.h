@@ -54,6 +54,18 @@ class ControllerBase {
    */
   virtual vector_t computeInput(scalar_t t, const vector_t& x) = 0;
 
+  /**
+   * @brief Computes the control command at a given time and state, starting the time lookup from the interval of the previous query.
+   * Controllers overriding this method do not allocate memory when the output already has the right size.
+   * The default implementation calls computeInput().
+   *
+   * @param [in] t: Current time.
+   * @param [in] x: Current state.
+   * @param [out] u: Current input. Its memory is reused.
+   * @param [in, out] cursor: The time interval of the previous query, which is updated. Initialize it with 0 for a new controller.
+   */
+  virtual void computeInputWithCursor(scalar_t t, const vector_t& x, vector_t& u, int& cursor) { u = computeInput(t, x); }
+
   /**
    * @brief Merges this controller with another controller that comes active later in time
    * This method is typically used to merge controllers from multiple time partitions.
@@ -79,6 +79,8 @@ class LinearController final : public ControllerBase {
 
   vector_t computeInput(scalar_t t, const vector_t& x) override;
 
+  void computeInputWithCursor(scalar_t t, const vector_t& x, vector_t& u, int& cursor) override;
+
   void concatenate(const ControllerBase* nextController, int index, int length) override;
 
   int size() const override;
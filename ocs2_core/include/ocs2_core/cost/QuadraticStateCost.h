@@ -53,15 +53,24 @@ class QuadraticStateCost : public StateCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Get cost term quadratic approximation into a caller-provided output */
+  void getQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                 ScalarFunctionQuadraticApproximation& Phi) const final;
+
+  /** Sparsity of the weight matrix */
+  const ApproximationSparsity& getSparsity() const override { return sparsity_; }
+
  protected:
   QuadraticStateCost(const QuadraticStateCost& rhs) = default;
 
-  /** Computes the state deviation for the nominal state.
+  /** Computes the state deviation for the nominal state into the caller-provided vector, whose memory is reused.
    * This method can be overwritten if desiredTrajectory has a different dimensions. */
-  virtual vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const;
+  virtual void getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                 vector_t& stateDeviation) const;
 
  private:
   matrix_t Q_;
+  ApproximationSparsity sparsity_;
 };
 
 }  // namespace ocs2
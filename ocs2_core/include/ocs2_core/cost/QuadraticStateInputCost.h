@@ -29,8 +29,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
-#include <utility>
-
 #include <ocs2_core/cost/StateInputCost.h>
 
 namespace ocs2 {
@@ -58,18 +56,27 @@ class QuadraticStateInputCost : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation&) const final;
 
+  /** Get cost term quadratic approximation into a caller-provided output */
+  void getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation&, ScalarFunctionQuadraticApproximation& L) const final;
+
+  /** Sparsity of the weight matrices */
+  const ApproximationSparsity& getSparsity() const override { return sparsity_; }
+
  protected:
   QuadraticStateInputCost(const QuadraticStateInputCost& rhs) = default;
 
-  /** Computes the state-input deviation pair around the nominal state and input.
+  /** Computes the state-input deviation around the nominal state and input into the caller-provided vectors, whose memory is reused.
    * This method can be overwritten if desiredTrajectory has a different dimensions. */
-  virtual std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                               const TargetTrajectories& targetTrajectories) const;
+  virtual void getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
+                                      const TargetTrajectories& targetTrajectories, vector_t& stateDeviation,
+                                      vector_t& inputDeviation) const;
 
  private:
   matrix_t Q_;
   matrix_t R_;
   matrix_t P_;
+  ApproximationSparsity sparsity_;
 };
 
 }  // namespace ocs2
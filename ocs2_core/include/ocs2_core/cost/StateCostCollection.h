@@ -59,6 +59,13 @@ class StateCostCollection : public Collection<StateCost> {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const;
 
+  /**
+   * Get state cost quadratic approximation into a caller-provided output. The memory of the output is reused.
+   * @note A derived class that overrides the method above should override this one as well.
+   */
+  virtual void getQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                         const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const;
+
  protected:
   /** Copy constructor */
   StateCostCollection(const StateCostCollection& other);
@@ -68,6 +68,13 @@ class StateCostCppAd : public StateCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComp) const override;
 
+  /** Get cost term quadratic approximation into a caller-provided output */
+  void getQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const override;
+
+  /** Sparsity detected while taping the cost term */
+  const ApproximationSparsity& getSparsity() const override { return sparsity_; }
+
  protected:
   StateCostCppAd(const StateCostCppAd& rhs);
 
@@ -76,6 +83,7 @@ class StateCostCppAd : public StateCost {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  ApproximationSparsity sparsity_;
 };
 
 }  // namespace ocs2
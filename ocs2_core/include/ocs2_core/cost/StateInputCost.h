@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/ApproximationSparsity.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
 
 namespace ocs2 {
@@ -56,6 +57,19 @@ class StateInputCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /** Get cost term quadratic approximation into a caller-provided output. Override this method to reuse the memory of the output. */
+  virtual void getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                         const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                         ScalarFunctionQuadraticApproximation& approximation) const {
+    approximation = getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+
+  /**
+   * Get the variables that the cost term depends on. The collection only adds the nonzero blocks of the quadratic approximation of a
+   * sparse term. The default is dense.
+   */
+  virtual const ApproximationSparsity& getSparsity() const { return ApproximationSparsity::dense(); }
+
  protected:
   StateInputCost(const StateInputCost& rhs) = default;
 };
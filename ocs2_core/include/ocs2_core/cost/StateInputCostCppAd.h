@@ -69,6 +69,13 @@ class StateInputCostCppAd : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComputation) const override;
 
+  /** Get cost term quadratic approximation into a caller-provided output */
+  void getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                                 const PreComputation& preComputation, ScalarFunctionQuadraticApproximation& cost) const override;
+
+  /** Sparsity detected while taping the cost term */
+  const ApproximationSparsity& getSparsity() const override { return sparsity_; }
+
  protected:
   StateInputCostCppAd(const StateInputCostCppAd& rhs);
 
@@ -78,6 +85,7 @@ class StateInputCostCppAd : public StateInputCost {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  ApproximationSparsity sparsity_;
 };
 
 }  // namespace ocs2
@@ -77,6 +77,9 @@ class StateInputCostGaussNewtonAd : public StateInputCost {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComputation) const override;
 
+  /** Sparsity detected while taping the cost term */
+  const ApproximationSparsity& getSparsity() const override { return sparsity_; }
+
  protected:
   StateInputCostGaussNewtonAd(const StateInputCostGaussNewtonAd& rhs);
 
@@ -94,6 +97,7 @@ class StateInputCostGaussNewtonAd : public StateInputCost {
 
  private:
   std::unique_ptr<CppAdInterface> adInterfacePtr_;
+  ApproximationSparsity sparsity_;
 };
 
 }  // namespace ocs2
@@ -76,11 +76,12 @@ DynamicsDiscretizer selectDynamicsDiscretization(SensitivityIntegratorType integ
  * @param x : starting state x_{k}
  * @param u : input u_{k}, assumed constant over the entire interval
  * @param dt : interval duration
- * Returns an approximation of the form:
+ * @param [out] approximation : an approximation of the form:
  *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ *      The memory of the output is reused if it has the right size.
  */
-using DynamicsSensitivityDiscretizer =
-    std::function<VectorFunctionLinearApproximation(SystemDynamicsBase&, scalar_t, const vector_t&, const vector_t&, scalar_t)>;
+using DynamicsSensitivityDiscretizer = std::function<void(SystemDynamicsBase&, scalar_t, const vector_t&, const vector_t&, scalar_t,
+                                                          VectorFunctionLinearApproximation&)>;
 
 /**
  * Select available integrator based on enum
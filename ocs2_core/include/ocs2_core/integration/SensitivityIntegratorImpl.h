@@ -48,6 +48,12 @@ vector_t eulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vecto
 VectorFunctionLinearApproximation eulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
                                                                  const vector_t& u, scalar_t dt);
 
+/**
+ * Same as above, but writes the linear approximation into a caller-provided output to reuse its memory.
+ */
+void eulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                    VectorFunctionLinearApproximation& approximation);
+
 /**
  * Computes the discretized dynamics. Uses an Runge-Kutta 2nd order discretization.
  * Returns x_{k+1}
@@ -62,6 +68,12 @@ vector_t rk2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Same as above, but writes the linear approximation into a caller-provided output to reuse its memory.
+ */
+void rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                  VectorFunctionLinearApproximation& approximation);
+
 /**
  * Computes the discretized dynamics. Uses an Runge-Kutta 4th order discretization.
  * Returns x_{k+1}
@@ -76,4 +88,10 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Same as above, but writes the linear approximation into a caller-provided output to reuse its memory.
+ */
+void rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                  VectorFunctionLinearApproximation& approximation);
+
 }  // namespace ocs2
\ No newline at end of file
@@ -50,6 +50,10 @@ class LoopshapingStateConstraint final : public StateConstraintCollection {
   vector_array_t getValue(scalar_t time, const vector_t& state, const PreComputation& preComp) const override;
   VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state,
                                                            const PreComputation& preComp) const override;
+  void getLinearApproximation(scalar_t time, const vector_t& state, const PreComputation& preComp,
+                              VectorFunctionLinearApproximation& linearApproximation) const override {
+    linearApproximation = getLinearApproximation(time, state, preComp);
+  }
 
   VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                  const PreComputation& preComp) const override;
@@ -43,6 +43,14 @@ class LoopshapingStateInputConstraint : public StateInputConstraintCollection {
 
   vector_array_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) const override;
 
+  using StateInputConstraintCollection::getLinearApproximation;
+
+  /** Delegates to the loopshaping linear approximation of the derived class. */
+  void getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp,
+                              VectorFunctionLinearApproximation& linearApproximation) const final {
+    linearApproximation = getLinearApproximation(time, state, input, preComp);
+  }
+
  protected:
   LoopshapingStateInputConstraint(const StateInputConstraintCollection& systemConstraint,
                                   std::shared_ptr<LoopshapingDefinition> loopshapingDefinition)
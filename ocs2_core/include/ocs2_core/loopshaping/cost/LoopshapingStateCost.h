@@ -56,6 +56,11 @@ class LoopshapingStateCost final : public StateCostCollection {
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComp) const override;
 
+  void getQuadraticApproximation(scalar_t t, const vector_t& x, const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                 ScalarFunctionQuadraticApproximation& cost) const override {
+    cost = getQuadraticApproximation(t, x, targetTrajectories, preComp);
+  }
+
  private:
   LoopshapingStateCost(const LoopshapingStateCost& other) = default;
 
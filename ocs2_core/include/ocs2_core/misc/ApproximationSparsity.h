@@ -0,0 +1,129 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * The variables that a function of the state and the input depends on. The derivatives with respect to all the other variables are
+ * zero. The collections use it to add only the nonzero blocks of the approximation of a term to the sum of all the terms.
+ *
+ * The indices are stored as ranges of contiguous indices. A default constructed sparsity is dense, i.e. the function depends on all
+ * the variables.
+ */
+class ApproximationSparsity {
+ public:
+  /** Range of contiguous indices [start, start + size). */
+  struct IndexRange {
+    size_t start;
+    size_t size;
+  };
+
+  /** Dense sparsity */
+  ApproximationSparsity() = default;
+
+  /**
+   * Constructor for a sparse function.
+   *
+   * @param [in] stateIndices : Indices of the states that the function depends on, in any order.
+   * @param [in] inputIndices : Indices of the inputs that the function depends on, in any order.
+   */
+  ApproximationSparsity(std::vector<size_t> stateIndices, std::vector<size_t> inputIndices);
+
+  /** Returns a shared instance of the dense sparsity. */
+  static const ApproximationSparsity& dense();
+
+  /** Whether the function can depend on all the variables. */
+  bool isDense() const { return isDense_; }
+
+  /** Ranges of the states that the function depends on. Only defined if the sparsity is not dense. */
+  const std::vector<IndexRange>& getStateRanges() const { return stateRanges_; }
+
+  /** Ranges of the inputs that the function depends on. Only defined if the sparsity is not dense. */
+  const std::vector<IndexRange>& getInputRanges() const { return inputRanges_; }
+
+ private:
+  bool isDense_ = true;
+  std::vector<IndexRange> stateRanges_;
+  std::vector<IndexRange> inputRanges_;
+};
+
+/** Indices of the rows of a matrix with at least one nonzero entry, in increasing order. */
+std::vector<size_t> getNonzeroRows(const matrix_t& m);
+
+/**
+ * Sparsity of a function of the state and the input.
+ *
+ * @param [in] stateIndices : Indices of the states that the function depends on, in any order.
+ * @param [in] inputIndices : Indices of the inputs that the function depends on, in any order.
+ * @param [in] stateDim : State dimension.
+ * @param [in] inputDim : Input dimension.
+ * @return The sparsity, dense if the function depends on all the states and inputs.
+ */
+ApproximationSparsity getStateInputSparsity(std::vector<size_t> stateIndices, std::vector<size_t> inputIndices, size_t stateDim,
+                                            size_t inputDim);
+
+/**
+ * Sparsity of a function of the variables [time; state; input], the layout of the variables of the CppAD based terms.
+ *
+ * @param [in] variableIndices : Indices of the variables that the function depends on, see CppAdInterface::getVariableSparsity().
+ * @param [in] stateDim : State dimension.
+ * @param [in] inputDim : Input dimension.
+ * @return The sparsity, dense if the function depends on all the states and inputs.
+ */
+ApproximationSparsity getTimeStateInputSparsity(const std::vector<size_t>& variableIndices, size_t stateDim, size_t inputDim);
+
+/**
+ * Adds the nonzero blocks of the approximation of a term to the sum: sum += term. Entries of the term outside its sparsity are
+ * ignored. The sum must already have the full size.
+ *
+ * @param [in] term : The approximation of the term.
+ * @param [in] sparsity : The sparsity of the term.
+ * @param [in, out] sum : The sum to add to.
+ */
+void addSparse(const ScalarFunctionQuadraticApproximation& term, const ApproximationSparsity& sparsity,
+               ScalarFunctionQuadraticApproximation& sum);
+
+/**
+ * Adds the nonzero state blocks of the approximation of a state-only term to the sum: sum.f += term.f, sum.dfdx += term.dfdx, and
+ * sum.dfdxx += term.dfdxx. The input derivatives of both the term and the sum are not accessed.
+ *
+ * @param [in] term : The approximation of the term.
+ * @param [in] sparsity : The sparsity of the term.
+ * @param [in, out] sum : The sum to add to.
+ */
+void addSparseStateOnly(const ScalarFunctionQuadraticApproximation& term, const ApproximationSparsity& sparsity,
+                        ScalarFunctionQuadraticApproximation& sum);
+
+}  // namespace ocs2
@@ -68,11 +68,18 @@ class RepeatedTimer {
    */
   void endTimer() {
     auto endTime = std::chrono::steady_clock::now();
-    lastIntervalTime_ = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime_);
+    addInterval(endTime - startTime_);
+  };
+
+  /**
+   * Adds an interval that was measured externally, e.g. between time points taken in different threads.
+   */
+  void addInterval(std::chrono::steady_clock::duration interval) {
+    lastIntervalTime_ = std::chrono::duration_cast<std::chrono::nanoseconds>(interval);
     maxIntervalTime_ = std::max(maxIntervalTime_, lastIntervalTime_);
     totalTime_ += lastIntervalTime_;
     numTimedIntervals_++;
-  };
+  }
 
   /**
    * @return Number of intervals that were timed
@@ -124,6 +124,17 @@ void computeConstraintProjection(const matrix_t& Dm, const matrix_t& RmInvUmUmT,
  */
 std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(const VectorFunctionLinearApproximation& constraint);
 
+/**
+ * Same as above, but writes into caller-provided outputs whose memory is reused. The decomposition is kept in thread-local storage,
+ * such that repeated calls with the same sizes do not allocate.
+ *
+ * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+ * @param [out] projection : Projection terms Px = dfdx, Pu = dfdu, Pe = f.
+ * @param [out] pseudoInverse : Left pseudo-inverse of D^T.
+ */
+void qrConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection,
+                            matrix_t& pseudoInverse);
+
 /**
  * Returns the linear projection
  *  u = Pu * \tilde{u} + Px * x + Pe
@@ -139,6 +150,17 @@ std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(co
 std::pair<VectorFunctionLinearApproximation, matrix_t> luConstraintProjection(const VectorFunctionLinearApproximation& constraint,
                                                                               bool extractPseudoInverse = false);
 
+/**
+ * Same as above, but writes into caller-provided outputs whose memory is reused. The decomposition is kept in thread-local storage,
+ * but the kernel and the solves of Eigen's FullPivLU still create temporaries.
+ *
+ * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+ * @param [out] projection : Projection terms Px = dfdx, Pu = dfdu, Pe = f.
+ * @param [out] pseudoInversePtr : If not null, the left pseudo-inverse of D^T is written to it.
+ */
+void luConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection,
+                            matrix_t* pseudoInversePtr = nullptr);
+
 /** Computes the rank of a matrix */
 template <typename Derived>
 int rank(const Derived& A) {
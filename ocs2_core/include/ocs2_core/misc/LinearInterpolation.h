@@ -53,6 +53,18 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Same as timeSegment, but the search starts from the interval of the previous query. For monotonic enquiry times, as in a control
+ * loop or in the backward sweep of the Riccati equations, the cost of a query is amortized O(1). If the enquiry time jumps backward
+ * by more than a few intervals, a binary search is used.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @param [in, out] cursor: The interval of the previous query, which is updated to the interval of this query. Initialize it with 0.
+ * @return {index, alpha}
+ */
+index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& cursor);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -139,6 +151,17 @@ template <typename Data, class Alloc, class AccessFun>
 auto interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray,
                  AccessFun accessFun) -> remove_cvref_t<typename std::result_of<AccessFun(const std::vector<Data, Alloc>&, size_t)>::type>;
 
+/**
+ * Directly uses the index and interpolation coefficient provided by the user. The result is written into the provided output, so no
+ * memory is allocated when it already has the right size.
+ * @note If sizes in data array are not equal, the interpolation will snap to the data point closest to the query time
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] dataArray: array of vectors. It should not be empty.
+ * @param [out] result: The interpolation result. Its memory is reused.
+ */
+void interpolate(index_alpha_t indexAlpha, const vector_array_t& dataArray, vector_t& result);
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
 
@@ -66,13 +66,10 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+/**
+ * Computes the interpolation coefficient for the interval returned by lookup::findIntervalInTimeArray.
+ */
+inline index_alpha_t timeSegmentFromInterval(int index, scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -104,6 +101,51 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  return timeSegmentFromInterval(index, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& cursor) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    cursor = 0;
+    return {0, scalar_t(1.0)};
+  }
+
+  // the interval is the last index with timeArray[index] < enquiryTime, or -1 if there is none.
+  const auto numTimes = static_cast<int>(timeArray.size());
+  int index = std::min(std::max(cursor, -1), numTimes - 1);
+  if (index >= 0 && !(timeArray[index] < enquiryTime)) {
+    // the enquiry time moved backward: walk back a few intervals before falling back to a binary search
+    constexpr int maxBackwardSteps = 4;
+    for (int i = 0; i < maxBackwardSteps && index >= 0 && !(timeArray[index] < enquiryTime); ++i) {
+      --index;
+    }
+    if (index >= 0 && !(timeArray[index] < enquiryTime)) {
+      index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+    }
+  } else {
+    while (index + 1 < numTimes && timeArray[index + 1] < enquiryTime) {
+      ++index;
+    }
+  }
+
+  cursor = index;
+  return timeSegmentFromInterval(index, enquiryTime, timeArray);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -153,5 +195,27 @@ auto interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, c
   return interpolate(timeSegment(enquiryTime, timeArray), dataArray, accessFun);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline void interpolate(index_alpha_t indexAlpha, const vector_array_t& dataArray, vector_t& result) {
+  assert(dataArray.size() > 0);
+  if (dataArray.size() > 1) {
+    // Normal interpolation case
+    const int index = indexAlpha.first;
+    const scalar_t alpha = indexAlpha.second;
+    const auto& lhs = dataArray[index];
+    const auto& rhs = dataArray[index + 1];
+    if (lhs.size() == rhs.size()) {
+      result = alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+    } else {
+      result = (alpha > 0.5) ? lhs : rhs;
+    }
+  } else {  // dataArray.size() == 1
+    // Time vector has only 1 element -> Constant function
+    result = dataArray[0];
+  }
+}
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
@@ -185,6 +185,16 @@ size_array_t getSizes(const std::vector<LagrangianMetrics>& termsLagrangianMetri
  */
 vector_array_t toConstraintArray(const size_array_t& termsSize, const vector_t& vec);
 
+/**
+ * Same as above, but writes into a caller-provided array. The memory of its elements is reused when their sizes do not change.
+ *
+ * @param [in] termsSize : An array of constraint terms size. It as the same size as the output array.
+ * @param [in] vec : Serialized array of constraint terms of the format :
+ *                   (..., constraintArray[i], ...)
+ * @param [out] constraintArray : An array of constraint terms.
+ */
+void toConstraintArray(const size_array_t& termsSize, const vector_t& vec, vector_array_t& constraintArray);
+
 /**
  * Deserializes the vector to an array of LagrangianMetrics structures based on size of constraint terms.
  *
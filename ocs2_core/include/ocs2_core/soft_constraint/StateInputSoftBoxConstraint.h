@@ -93,6 +93,9 @@ class StateInputSoftBoxConstraint final : public StateInputCost {
                                                                  const TargetTrajectories& /* targetTrajectories */,
                                                                  const PreComputation& preComp) const override;
 
+  /** The penalty only depends on the bounded states and inputs */
+  const ApproximationSparsity& getSparsity() const override { return sparsity_; }
+
  private:
   StateInputSoftBoxConstraint(const StateInputSoftBoxConstraint& other) = default;
 
@@ -106,6 +109,7 @@ class StateInputSoftBoxConstraint final : public StateInputCost {
   std::vector<BoxConstraint> stateBoxConstraints_;
   std::vector<BoxConstraint> inputBoxConstraints_;
   scalar_t offset_;
+  ApproximationSparsity sparsity_;
 };
 
 }  // namespace ocs2
@@ -89,6 +89,9 @@ class StateSoftConstraint final : public StateCost {
                                                                  const TargetTrajectories& /* targetTrajectories */,
                                                                  const PreComputation& preComp) const override;
 
+  /** The penalty depends on the same variables as the constraint */
+  const ApproximationSparsity& getSparsity() const override { return constraintPtr_->getSparsity(); }
+
  private:
   StateSoftConstraint(const StateSoftConstraint& other);
 
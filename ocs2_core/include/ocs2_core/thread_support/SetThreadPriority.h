@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <pthread.h>
+#include <sched.h>
 #include <iostream>
 #include <thread>
 
@@ -73,4 +74,53 @@ inline void setThisThreadPriority(int priority) {
   setThreadPriority(priority, pthread_self());
 }
 
+/**
+ * Pins the input thread to a CPU core.
+ *
+ * @param cpu: The non-negative index into the CPU cores available to the calling thread (as given by sched_getaffinity), taken modulo
+ *             their number. E.g., with the cores {2, 3, 6} available, the indices 0, 1, 2, 3 pin the thread to the cores 2, 3, 6, 2.
+ * @param thread: A reference to the thread.
+ */
+inline void setThreadAffinity(int cpu, pthread_t thread) {
+  cpu_set_t availableCpus;
+  CPU_ZERO(&availableCpus);
+  if (cpu < 0 || sched_getaffinity(0, sizeof(cpu_set_t), &availableCpus) != 0 || CPU_COUNT(&availableCpus) == 0) {
+    std::cerr << "WARNING: Failed to set threads affinity to CPU index " << cpu << "." << std::endl;
+    return;
+  }
+
+  // find the (cpu % numAvailableCpus)-th available core
+  int remaining = cpu % CPU_COUNT(&availableCpus);
+  int core = 0;
+  while (!CPU_ISSET(core, &availableCpus) || remaining-- > 0) {
+    ++core;
+  }
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(core, &cpuSet);
+  if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+    std::cerr << "WARNING: Failed to set threads affinity to CPU " << core << "." << std::endl;
+  }
+}
+
+/**
+ * Pins the input thread to a CPU core.
+ *
+ * @param cpu: The index of the CPU core, see setThreadAffinity(int, pthread_t).
+ * @param thread: A reference to the thread.
+ */
+inline void setThreadAffinity(int cpu, std::thread& thread) {
+  setThreadAffinity(cpu, thread.native_handle());
+}
+
+/**
+ * Pins the thread this function is called from to a CPU core.
+ *
+ * @param cpu: The index of the CPU core, see setThreadAffinity(int, pthread_t).
+ */
+inline void setThisThreadAffinity(int cpu) {
+  setThreadAffinity(cpu, pthread_self());
+}
+
 }  // namespace ocs2
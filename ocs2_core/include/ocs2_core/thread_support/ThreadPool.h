@@ -29,17 +29,28 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <exception>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace ocs2 {
 
 /**
  * Thread pool class to execute tasks on multiple threads.
+ *
+ * The pool serves two kinds of work:
+ * - Asynchronous tasks submitted through run(), which are queued and return a future.
+ * - Fork-join jobs submitted through runParallel(). These do not go through the task queue. The job is published to the persistent
+ *   workers through a lock-free handoff, and the task instances are distributed over per-worker ranges from which idle participants
+ *   steal. A runParallel() call does not allocate on the heap. Workers spin for a short while before parking, so back-to-back
+ *   fork-join calls (e.g. several per solver iteration) do not pay for a kernel wake-up.
  */
 class ThreadPool {
  public:
@@ -48,8 +59,10 @@ class ThreadPool {
    *
    * @param [in] nThreads: Number of threads to launch in the pool
    * @param [in] priority: The worker thread priority
+   * @param [in] firstCpu: If non-negative, worker i is pinned to the available CPU core with index (firstCpu + i), see
+   *                       setThreadAffinity(). The calling thread is not pinned.
    */
-  explicit ThreadPool(size_t nThreads = 1, int priority = 0);
+  explicit ThreadPool(size_t nThreads = 1, int priority = 0, int firstCpu = -1);
 
   /**
    * Destructor
@@ -69,16 +82,25 @@ class ThreadPool {
 
   /**
    * Helper function to run a task N times parallel with the help of the pool.
-   * - 1 task will run in the calling thread with ID = nThreads.
-   * - N-1 tasks will run on the threadpool with ID in [0, nThreads-1].
+   * - The calling thread participates with ID = nThreads.
+   * - The threadpool workers participate with ID in [0, nThreads-1].
+   *
+   * The task function is invoked by reference, it is neither copied nor stored. Hence the same object is concurrently called from
+   * all participating threads.
    *
-   * @note This is a blocking operation, returns when all tasks are completed.
+   * @note This is a blocking operation, returns when all tasks are completed. If a task throws, the first exception is rethrown
+   * in the calling thread after all tasks are finished.
+   * @note Calls from different threads are serialized. A call from within a task of this pool runs all N instances in the
+   * calling worker thread.
    * @warning Calling runParallel(task, nThreads) does not guarantee that each task will be executed with a different workerIndex.
+   * However, all tasks that run concurrently have different workerIndex.
    *
+   * @tparam Functor: Type of callable task object with signature void(int).
    * @param [in] taskFunction: task function to run in the pool.
-   * @param [in] N: number of times to run taskFunction in parallel.
+   * @param [in] N: number of times to run taskFunction in parallel. The task runs at least once, also for N < 1.
    */
-  void runParallel(std::function<void(int)> taskFunction, int N);
+  template <typename Functor>
+  void runParallel(Functor&& taskFunction, int N);
 
   /** Get the number of threads. */
   size_t numThreads() const { return workerThreads_.size(); }
@@ -103,11 +125,67 @@ class ThreadPool {
    */
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
-  bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
+  /**
+   * Type-erased implementation of runParallel.
+   *
+   * @param [in] invoke: Function that calls the task object with the given worker index.
+   * @param [in] taskObject: Pointer to the task object.
+   * @param [in] N: number of times to run the task.
+   */
+  void runParallelImpl(void (*invoke)(void*, int), void* taskObject, int N);
+
+  /**
+   * Executes the task instances of the current fork-join job. Starts with the range owned by workerIndex and then steals from the
+   * ranges of the other participants.
+   *
+   * @param [in] workerIndex: worker thread index, nThreads for the calling thread.
+   */
+  void executeParallelJob(int workerIndex);
+
+  /** Wakes up the parked workers if there are any. */
+  void notifyParkedWorkers();
+
+  static constexpr size_t kCacheLineSize = 64;
+
+  /**
+   * Contiguous range of task instances owned by one participant. Padded to a full cache line and allocated with cache-line alignment
+   * to avoid false sharing between the participants (alignas is not honored by array new before C++17).
+   */
+  struct TaskRange {
+    std::atomic_int next{0};
+    int end{0};
+    char padding[kCacheLineSize - sizeof(std::atomic_int) - sizeof(int)];
+  };
+  static_assert(sizeof(TaskRange) == kCacheLineSize, "TaskRange must fill exactly one cache line.");
+
+  /** Releases the memory of the cache-line aligned task ranges. */
+  struct TaskRangesDeleter {
+    void operator()(TaskRange* ranges) const;
+  };
+
+  /** Description of the current fork-join job, written by the calling thread before the job is opened. */
+  struct ParallelJob {
+    void (*invoke)(void*, int) = nullptr;
+    void* taskObject = nullptr;
+  };
+
+  std::atomic_bool stop_{false};  //!< flag telling all threads to stop
 
   std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
+  std::atomic_size_t numQueuedTasks_{0};             //!< size of taskQueue_, readable without the lock
   std::condition_variable taskQueueCondition_;
   std::mutex taskQueueLock_;
+  std::atomic_int numParkedWorkers_{0};
+
+  std::mutex parallelJobLock_;  //!< serializes runParallel calls from different threads
+  ParallelJob parallelJob_;
+  std::unique_ptr<TaskRange[], TaskRangesDeleter> taskRanges_;  //!< one range per worker plus one for the calling thread
+  std::atomic_uint64_t parallelJobEpoch_{0};  //!< incremented for every published job
+  std::atomic_bool parallelJobOpen_{false};   //!< true while workers are allowed to join the current job
+  std::atomic_int numActiveParticipants_{0};  //!< number of workers that are inspecting or executing the current job
+  std::atomic_int numCompletedTasks_{0};
+  std::mutex parallelExceptionLock_;
+  std::exception_ptr parallelExceptionPtr_;  // protected by parallelExceptionLock_
 
   std::vector<std::thread> workerThreads_;
 };
@@ -154,4 +232,14 @@ std::future<typename std::result_of<Functor(int)>::type> ThreadPool::run(Functor
   return future;
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void ThreadPool::runParallel(Functor&& taskFunction, int N) {
+  using FunctorType = typename std::remove_reference<Functor>::type;
+  auto invoke = [](void* taskObject, int workerIndex) { (*static_cast<FunctorType*>(taskObject))(workerIndex); };
+  runParallelImpl(invoke, const_cast<void*>(static_cast<const void*>(std::addressof(taskFunction))), N);
+}
+
 }  // namespace ocs2
@@ -90,10 +90,7 @@ ScalarFunctionQuadraticApproximation StateAugmentedLagrangianCollection::getQuad
   // accumulate terms
   for (size_t i = firstActiveInd + 1; i < terms_.size(); i++) {
     if (terms_[i]->isActive(time)) {
-      const auto termPenalty = terms_[i]->getQuadraticApproximation(time, state, termsMultiplier[i], preComp);
-      penalty.f += termPenalty.f;
-      penalty.dfdx += termPenalty.dfdx;
-      penalty.dfdxx += termPenalty.dfdxx;
+      addSparseStateOnly(terms_[i]->getQuadraticApproximation(time, state, termsMultiplier[i], preComp), terms_[i]->getSparsity(), penalty);
     }
   }
 
@@ -92,7 +92,7 @@ ScalarFunctionQuadraticApproximation StateInputAugmentedLagrangianCollection::ge
   // accumulate terms
   for (size_t i = firstActiveInd + 1; i < terms_.size(); i++) {
     if (terms_[i]->isActive(time)) {
-      penalty += terms_[i]->getQuadraticApproximation(time, state, input, termsMultiplier[i], preComp);
+      addSparse(terms_[i]->getQuadraticApproximation(time, state, input, termsMultiplier[i], preComp), terms_[i]->getSparsity(), penalty);
     }
   }
 
@@ -0,0 +1,142 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/automatic_differentiation/CppAdCompilePool.h>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+
+namespace ocs2 {
+
+namespace {
+thread_local CppAdCompilePool* activePool = nullptr;
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdCompilePool::CppAdCompilePool(size_t nThreads) : previousActivePool_(activePool), threadPool_(std::max<size_t>(nThreads, 1)) {
+  activePool = this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdCompilePool::~CppAdCompilePool() {
+  try {
+    wait();
+  } catch (const std::exception& e) {
+    std::cerr << "[CppAdCompilePool] " << e.what() << std::endl;
+  }
+  activePool = previousActivePool_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdCompilePool::wait() {
+  std::vector<std::shared_future<void>> compilations;
+  std::vector<std::shared_ptr<void>> resources;
+  std::vector<CppAdInterface*> pendingInterfaces;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    compilations.swap(compilations_);
+    resources.swap(resources_);
+    pendingInterfaces.swap(pendingInterfaces_);
+  }
+
+  // Wait for all the compilations, also the ones of already destroyed interfaces
+  for (const auto& compilation : compilations) {
+    compilation.wait();
+  }
+  resources.clear();
+
+  // Load the libraries, the errors of the compilations are rethrown here
+  std::exception_ptr firstError;
+  for (auto* adInterface : pendingInterfaces) {
+    try {
+      adInterface->finishPendingCompilation();
+    } catch (...) {
+      if (!firstError) {
+        firstError = std::current_exception();
+      }
+    }
+  }
+
+  if (firstError) {
+    std::rethrow_exception(firstError);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdCompilePool* CppAdCompilePool::getActivePool() {
+  return activePool;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t CppAdCompilePool::defaultNumThreads() {
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::shared_future<void> CppAdCompilePool::compile(std::function<void()> job, std::shared_ptr<void> resources) {
+  auto compilation = threadPool_.run([job](int) { job(); }).share();
+  std::lock_guard<std::mutex> lock(mutex_);
+  compilations_.push_back(compilation);
+  resources_.push_back(std::move(resources));
+  return compilation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdCompilePool::registerInterface(CppAdInterface* adInterface) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pendingInterfaces_.push_back(adInterface);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdCompilePool::unregisterInterface(CppAdInterface* adInterface) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pendingInterfaces_.erase(std::remove(pendingInterfaces_.begin(), pendingInterfaces_.end(), adInterface), pendingInterfaces_.end());
+}
+
+}  // namespace ocs2
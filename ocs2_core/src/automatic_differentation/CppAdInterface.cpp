@@ -29,10 +29,166 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <cctype>
+#include <iomanip>
+#include <iterator>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/automatic_differentiation/CppAdCompilePool.h>
+#include <ocs2_core/automatic_differentiation/CppAdModelBundle.h>
+
 namespace ocs2 {
 
+namespace {
+
+/**
+ * Scratch memory for the model evaluations. The buffers are shared by all models evaluated on the same thread. They grow to the largest
+ * model and are reused afterwards, such that the evaluations do not allocate in steady state.
+ */
+struct CppAdScratch {
+  std::vector<scalar_t> xp;
+  std::vector<scalar_t> value;
+  std::vector<scalar_t> weights;
+  std::vector<scalar_t> sparseValues;
+};
+
+CppAdScratch& getThreadLocalScratch() {
+  thread_local CppAdScratch scratch;
+  return scratch;
+}
+
+/** 64 bit FNV-1a hash. Unlike std::hash, the result is specified and therefore the same in every process and build. */
+class Fnv1aHash {
+ public:
+  void add(const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash_ = (hash_ ^ bytes[i]) * 1099511628211ULL;
+    }
+  }
+
+  template <typename T>
+  void add(const T& value) {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic types are hashed by value.");
+    add(&value, sizeof(T));
+  }
+
+  void add(const std::string& value) {
+    add(value.size());
+    add(value.data(), value.size());
+  }
+
+  std::string toHex() const {
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash_;
+    return stream.str();
+  }
+
+ private:
+  uint64_t hash_ = 14695981039346656037ULL;
+};
+
+/**
+ * Hashes the operation graph that results from evaluating the tape with code generation variables. The nodes are visited in a
+ * depth first post order from the dependent variables, such that equal tapes give equal hashes independent of the memory layout.
+ */
+void hashOperationGraph(const CppAD::vector<ad_base_t>& independents, const CppAD::vector<ad_base_t>& dependents, Fnv1aHash& hash) {
+  using node_t = CppAD::cg::OperationNode<scalar_t>;
+
+  std::unordered_map<const node_t*, size_t> independentIndices;
+  for (size_t i = 0; i < independents.size(); i++) {
+    independentIndices.emplace(independents[i].getOperationNode(), i);
+  }
+
+  std::unordered_map<const node_t*, size_t> nodeIds;
+  std::vector<std::pair<const node_t*, size_t>> stack;  // node and index of the next argument to visit
+  auto hashNode = [&](const node_t* node) {
+    hash.add(static_cast<int>(node->getOperationType()));
+    const auto independentIndex = independentIndices.find(node);
+    if (independentIndex != independentIndices.end()) {
+      hash.add(independentIndex->second);
+    }
+    hash.add(node->getInfo().size());
+    for (const auto info : node->getInfo()) {
+      hash.add(info);
+    }
+    hash.add(node->getArguments().size());
+    for (const auto& argument : node->getArguments()) {
+      if (argument.getOperation() != nullptr) {
+        hash.add(nodeIds.at(argument.getOperation()));
+      } else {
+        hash.add(*argument.getParameter());
+      }
+    }
+  };
+
+  for (size_t i = 0; i < dependents.size(); i++) {
+    const auto& dependent = dependents[i];
+    if (dependent.isParameter()) {
+      hash.add(dependent.getValue());
+      continue;
+    }
+
+    stack.emplace_back(dependent.getOperationNode(), 0);
+    while (!stack.empty()) {
+      const node_t* node = stack.back().first;
+      const auto& arguments = node->getArguments();
+      if (nodeIds.count(node) > 0) {
+        stack.pop_back();
+      } else if (stack.back().second < arguments.size()) {
+        const node_t* argumentNode = arguments[stack.back().second++].getOperation();
+        if (argumentNode != nullptr && nodeIds.count(argumentNode) == 0) {
+          stack.emplace_back(argumentNode, 0);
+        }
+      } else {
+        hashNode(node);
+        nodeIds.emplace(node, nodeIds.size());
+        stack.pop_back();
+      }
+    }
+    hash.add(nodeIds.at(dependent.getOperationNode()));
+  }
+}
+
+/** Library processor that allows to generate the sources ahead of the compilation. */
+class LibraryProcessor : public CppAD::cg::DynamicModelLibraryProcessor<scalar_t> {
+ public:
+  using CppAD::cg::DynamicModelLibraryProcessor<scalar_t>::DynamicModelLibraryProcessor;
+
+  /** Generates and caches the sources, createDynamicLibrary() then only compiles them. */
+  void generateSources(CppAD::cg::ModelCSourceGen<scalar_t>& model) {
+    this->getSources(model);
+    this->getLibrarySources();
+  }
+
+  /** Generates the sources of the model only, without the sources that define the library. */
+  const std::map<std::string, std::string>& generateModelSources(CppAD::cg::ModelCSourceGen<scalar_t>& model) {
+    return this->getSources(model);
+  }
+};
+
+/** Objects of the code generation that have to stay alive until the library is compiled. */
+struct LibraryBuild {
+  LibraryBuild(std::unique_ptr<CppAdInterface::ad_fun_t> funPtr, const std::string& modelName, const std::string& libraryName)
+      : fun(std::move(funPtr)),
+        sourceGen(*fun, modelName),
+        libraryCSourceGen(sourceGen),
+        libraryProcessor(libraryCSourceGen, libraryName) {}
+
+  std::unique_ptr<CppAdInterface::ad_fun_t> fun;
+  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen;
+  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen;
+  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+  LibraryProcessor libraryProcessor;
+};
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -43,7 +199,9 @@ CppAdInterface::CppAdInterface(ad_parameterized_function_t adFunction, size_t va
       parameterDim_(parameterDim),
       modelName_(std::move(modelName)),
       folderName_(std::move(folderName)),
-      compileFlags_(std::move(compileFlags)) {
+      compileFlags_(std::move(compileFlags)),
+      variableSparsity_(variableDim) {
+  std::iota(variableSparsity_.begin(), variableSparsity_.end(), 0);
   setFolderNames();
 }
 
@@ -60,7 +218,19 @@ CppAdInterface::CppAdInterface(ad_function_t adFunction, size_t variableDim, std
 /******************************************************************************************************/
 CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
     : CppAdInterface(rhs.adFunction_, rhs.variableDim_, rhs.parameterDim_, rhs.modelName_, rhs.folderName_, rhs.compileFlags_) {
-  if (isLibraryAvailable()) {
+  libraryKey_ = rhs.libraryKey_;
+  setFolderNames();
+  rangeDim_ = rhs.rangeDim_;
+  variableSparsity_ = rhs.variableSparsity_;
+
+  if (rhs.model_ != nullptr && rhs.dynamicLib_ == nullptr) {
+    // rhs is bound to a bundled model
+    loadBundleModel(false);
+  } else if (rhs.compilePool_ != nullptr) {
+    pendingCompilation_ = rhs.pendingCompilation_;
+    compilePool_ = rhs.compilePool_;
+    compilePool_->registerInterface(this);
+  } else if (isLibraryAvailable()) {
     loadModels(false);
   }
 }
@@ -68,55 +238,28 @@ CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
-  createFolderStructure();
-
-  // set and declare independent variables and start tape recording
-  ad_vector_t xp(variableDim_ + parameterDim_);
-  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
-  CppAD::Independent(xp);
-
-  // Split in variables and parameters
-  ad_vector_t x = xp.segment(0, variableDim_);
-  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
-  // dependent variable vector
-  ad_vector_t y;
-  // the model equation
-  adFunction_(x, p, y);
-  rangeDim_ = y.rows();
-  // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
-  // Optimize the operation sequence
-  fun.optimize();
-
-  // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
-
-  // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
-  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
-  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
-  setCompilerOptions(gccCompiler);
-
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Compiling Shared Library: "
-              << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+CppAdInterface::~CppAdInterface() {
+  if (compilePool_ != nullptr) {
+    compilePool_->unregisterInterface(this);
   }
+}
 
-  // Compile and store the library
-  dynamicLib_ = libraryProcessor.createDynamicLibrary(gccCompiler);
-  model_ = dynamicLib_->model(modelName_);
-
-  setSparsityNonzeros();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
+  auto fun = createTape();
+  setVariableSparsity(*fun);
+  libraryKey_ = computeLibraryKey(*fun, approximationOrder);
+  setFolderNames();
 
-  // Rename generated library after loading
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Renaming " << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << " to "
-              << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
+  if (CppAdModelExporter::getActiveExporter() != nullptr) {
+    exportModel(std::move(fun), approximationOrder, verbose);
+  } else if (isCppAdBundleModelAvailable(getBundleModelName())) {
+    loadBundleModel(verbose);
+  } else {
+    compileLibrary(std::move(fun), approximationOrder, verbose);
   }
-  boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
-                            libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
 }
 
 /******************************************************************************************************/
@@ -138,38 +281,111 @@ void CppAdInterface::loadModels(bool verbose) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
-  if (isLibraryAvailable()) {
+  auto fun = createTape();
+  setVariableSparsity(*fun);
+  libraryKey_ = computeLibraryKey(*fun, approximationOrder);
+  setFolderNames();
+
+  if (CppAdModelExporter::getActiveExporter() != nullptr) {
+    exportModel(std::move(fun), approximationOrder, verbose);
+  } else if (isCppAdBundleModelAvailable(getBundleModelName())) {
+    loadBundleModel(verbose);
+  } else if (isLibraryAvailable()) {
     loadModels(verbose);
   } else {
-    createModels(approximationOrder, verbose);
+    compileLibrary(std::move(fun), approximationOrder, verbose);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::finishPendingCompilation() {
+  compilePool_ = nullptr;
+  auto pendingCompilation = std::move(pendingCompilation_);
+  pendingCompilation.get();  // rethrows the error of the compilation
+  loadModels(false);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::getBundleModelName() const {
+  // The model name becomes part of C identifiers
+  std::string bundleModelName = modelName_;
+  for (auto& c : bundleModelName) {
+    if (!std::isalnum(static_cast<unsigned char>(c))) {
+      c = '_';
+    }
+  }
+  return bundleModelName + "_" + libraryKey_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadBundleModel(bool verbose) {
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Binding bundled model: " << getBundleModelName() << std::endl;
+  }
+  model_ = loadCppAdBundleModel(getBundleModelName());
+  dynamicLib_.reset();
+  rangeDim_ = model_->Range();
+
+  setSparsityNonzeros();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::exportModel(std::unique_ptr<ad_fun_t> fun, ApproximationOrder approximationOrder, bool verbose) {
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Exporting model: " << getBundleModelName() << std::endl;
   }
+  LibraryBuild build(std::move(fun), getBundleModelName(), libraryName_);
+  setApproximationOrder(approximationOrder, build.sourceGen, *build.fun);
+  CppAdModelExporter::getActiveExporter()->addModel(getBundleModelName(), build.libraryProcessor.generateModelSources(build.sourceGen));
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
+  vector_t functionValue;
+  getFunctionValue(x, p, functionValue);
+  return functionValue;
+}
 
-  vector_t functionValue(model_->Range());
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p, vector_t& functionValue) const {
+  auto& scratch = getThreadLocalScratch();
+  const auto xpArrayView = concatenateInput(x, p, scratch.xp);
 
-  model_->ForwardZero(xp, functionValue);
+  functionValue.resize(rangeDim_);
+  model_->ForwardZero(xpArrayView, CppAD::cg::ArrayView<scalar_t>(functionValue.data(), functionValue.size()));
   assert(functionValue.allFinite());
-  return functionValue;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
+  matrix_t jacobian;
+  getJacobian(x, p, jacobian);
+  return jacobian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobian(const vector_t& x, const vector_t& p, matrix_t& jacobian) const {
+  auto& scratch = getThreadLocalScratch();
+  const auto xpArrayView = concatenateInput(x, p, scratch.xp);
 
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
+  scratch.sparseValues.resize(nnzJacobian_);
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(scratch.sparseValues.data(), nnzJacobian_);
   size_t const* rows;
   size_t const* cols;
   // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
@@ -177,37 +393,44 @@ matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const
 
   // Write sparse elements into Eigen type. Only jacobian w.r.t. variables was requested, so cols should not contain elements corresponding
   // to parameters.
-  matrix_t jacobian = matrix_t::Zero(model_->Range(), variableDim_);
+  jacobian.setZero(rangeDim_, variableDim_);
   for (size_t i = 0; i < nnzJacobian_; i++) {
-    jacobian(rows[i], cols[i]) = sparseJacobian[i];
+    jacobian(rows[i], cols[i]) = sparseJacobianArrayView[i];
   }
 
   assert(jacobian.allFinite());
-  return jacobian;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
-
   ScalarFunctionQuadraticApproximation gnApprox;
+  getGaussNewtonApproximation(x, p, gnApprox);
+  return gnApprox;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p,
+                                                 ScalarFunctionQuadraticApproximation& gnApprox) const {
+  auto& scratch = getThreadLocalScratch();
+  const auto xpArrayView = concatenateInput(x, p, scratch.xp);
 
   // Zero order
-  vector_t valueVector(model_->Range());
-  model_->ForwardZero(xp, valueVector);
+  scratch.value.resize(rangeDim_);
+  CppAD::cg::ArrayView<scalar_t> valueArrayView(scratch.value.data(), rangeDim_);
+  model_->ForwardZero(xpArrayView, valueArrayView);
+  const Eigen::Map<const vector_t> valueVector(scratch.value.data(), rangeDim_);
   gnApprox.f = 0.5 * valueVector.squaredNorm();
 
   // Jacobian
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
+  scratch.sparseValues.resize(nnzJacobian_);
+  CppAD::cg::ArrayView<scalar_t> sparseJacobian(scratch.sparseValues.data(), nnzJacobian_);
   size_t const* rows;
   size_t const* cols;
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  model_->SparseJacobian(xpArrayView, sparseJacobian, &rows, &cols);
 
   // Sparse evaluation of J' * f
   gnApprox.dfdx.setZero(variableDim_);
@@ -229,60 +452,196 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
     // Diagonal element always exists:
     gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
     // Process off-diagonals
-    size_t j = i + 1;
-    while (rows[j] == row_i) {
+    for (size_t j = i + 1; j < nnzJacobian_ && rows[j] == row_i; ++j) {
       const size_t col_j = cols[j];
       gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
       gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
-      ++j;
     }
   }
 
   assert(gnApprox.dfdx.allFinite());
   assert(gnApprox.dfdxx.allFinite());
-  return gnApprox;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p) const {
-  vector_t w = vector_t::Zero(rangeDim_);
-  w[outputIndex] = 1.0;
+  matrix_t hessian;
+  getHessian(outputIndex, x, p, hessian);
+  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p, matrix_t& hessian) const {
+  auto& scratch = getThreadLocalScratch();
+  scratch.weights.assign(rangeDim_, 0.0);
+  scratch.weights[outputIndex] = 1.0;
 
-  return getHessian(w, x, p);
+  getHessian(CppAD::cg::ArrayView<const scalar_t>(scratch.weights.data(), rangeDim_), x, p, hessian);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
+  matrix_t hessian;
+  getHessian(w, x, p, hessian);
+  return hessian;
+}
 
-  std::vector<scalar_t> sparseHessian(nnzHessian_);
-  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessian);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p, matrix_t& hessian) const {
+  getHessian(CppAD::cg::ArrayView<const scalar_t>(w.data(), w.size()), x, p, hessian);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getHessian(CppAD::cg::ArrayView<const scalar_t> w, const vector_t& x, const vector_t& p, matrix_t& hessian) const {
+  auto& scratch = getThreadLocalScratch();
+  const auto xpArrayView = concatenateInput(x, p, scratch.xp);
+
+  scratch.sparseValues.resize(nnzHessian_);
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(scratch.sparseValues.data(), nnzHessian_);
   size_t const* rows;
   size_t const* cols;
 
-  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
-
   // Call this particular SparseHessian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+  model_->SparseHessian(xpArrayView, w, sparseHessianArrayView, &rows, &cols);
 
   // Fills upper triangular sparsity of hessian w.r.t variables.
-  matrix_t hessian = matrix_t::Zero(variableDim_, variableDim_);
+  hessian.setZero(variableDim_, variableDim_);
   for (size_t i = 0; i < nnzHessian_; i++) {
-    hessian(rows[i], cols[i]) = sparseHessian[i];
+    hessian(rows[i], cols[i]) = sparseHessianArrayView[i];
   }
 
   // Copy upper triangular to lower triangular part
   hessian.template triangularView<Eigen::StrictlyLower>() = hessian.template triangularView<Eigen::StrictlyUpper>().transpose();
 
   assert(hessian.allFinite());
-  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<CppAdInterface::ad_fun_t> CppAdInterface::createTape() {
+  // set and declare independent variables and start tape recording
+  ad_vector_t xp(variableDim_ + parameterDim_);
+  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
+  CppAD::Independent(xp);
+
+  // Split in variables and parameters
+  ad_vector_t x = xp.segment(0, variableDim_);
+  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
+  // dependent variable vector
+  ad_vector_t y;
+  // the model equation
+  adFunction_(x, p, y);
+  rangeDim_ = y.rows();
+  // create f: xp -> y and stop tape recording
+  std::unique_ptr<ad_fun_t> fun(new ad_fun_t(xp, y));
+  // Optimize the operation sequence
+  fun->optimize();
+  return fun;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::computeLibraryKey(ad_fun_t& fun, ApproximationOrder approximationOrder) const {
+  Fnv1aHash hash;
+  hash.add(std::string(CPPAD_PACKAGE_STRING));
+  hash.add(modelName_);
+  hash.add(variableDim_);
+  hash.add(parameterDim_);
+  hash.add(rangeDim_);
+  hash.add(static_cast<int>(approximationOrder));
+  hash.add(compileFlags_.size());
+  for (const auto& flag : compileFlags_) {
+    hash.add(flag);
+  }
+
+  // Evaluate the tape with code generation variables to obtain its operation graph
+  CppAD::cg::CodeHandler<scalar_t> codeHandler;
+  CppAD::vector<ad_base_t> xp(variableDim_ + parameterDim_);
+  codeHandler.makeVariables(xp);
+  const CppAD::vector<ad_base_t> y = fun.Forward(0, xp);
+  hashOperationGraph(xp, y, hash);
+
+  return hash.toHex();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compileLibrary(std::unique_ptr<ad_fun_t> fun, ApproximationOrder approximationOrder, bool verbose) {
+  createFolderStructure();
+
+  // generates source code, compile to temporary shared library file to avoid interference between processes
+  const std::string extension = CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+  const std::string tmpLibraryName = libraryName_ + tmpName_;
+  auto build = std::make_shared<LibraryBuild>(std::move(fun), modelName_, tmpLibraryName);
+  setApproximationOrder(approximationOrder, build->sourceGen, *build->fun);
+  setCompilerOptions(build->gccCompiler);
+
+  // The sources are generated in the calling thread, CppAD does not support taping in parallel without further setup.
+  build->libraryProcessor.generateSources(build->sourceGen);
+
+  // The compilation only captures a raw pointer to the build. The CppAD objects in it are destroyed by the owner of the build in the
+  // calling thread, as CppAD's memory pool is not thread safe without further setup.
+  auto compile = [buildPtr = build.get(), tmpLibraryName, extension, libraryName = libraryName_, tmpFolder = tmpFolder_, verbose]() {
+    if (verbose) {
+      std::cerr << "[CppAdInterface] Compiling Shared Library: " << tmpLibraryName + extension << std::endl;
+    }
+    buildPtr->libraryProcessor.createDynamicLibrary(buildPtr->gccCompiler, false);
+
+    // Rename the library when complete, such that other processes never load a partially written library
+    if (verbose) {
+      std::cerr << "[CppAdInterface] Renaming " << tmpLibraryName + extension << " to " << libraryName + extension << std::endl;
+    }
+    boost::filesystem::rename(tmpLibraryName + extension, libraryName + extension);
+
+    // Keep the sources next to the library, unless they are already there from another process
+    boost::system::error_code errorCode;
+    boost::filesystem::rename(tmpFolder, libraryName + "_sources", errorCode);
+    if (errorCode) {
+      boost::filesystem::remove_all(tmpFolder, errorCode);
+    }
+  };
+
+  auto* compilePool = CppAdCompilePool::getActivePool();
+  if (compilePool != nullptr) {
+    pendingCompilation_ = compilePool->compile(std::move(compile), std::move(build));
+    if (compilePool_ == nullptr) {
+      compilePool_ = compilePool;
+      compilePool_->registerInterface(this);
+    }
+  } else {
+    compile();
+    loadModels(false);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAD::cg::ArrayView<const scalar_t> CppAdInterface::concatenateInput(const vector_t& x, const vector_t& p,
+                                                                      std::vector<scalar_t>& buffer) const {
+  assert(static_cast<size_t>(x.size()) == variableDim_);
+  assert(static_cast<size_t>(p.size()) == parameterDim_);
+  if (parameterDim_ == 0) {
+    return CppAD::cg::ArrayView<const scalar_t>(x.data(), x.size());
+  }
+
+  buffer.resize(variableDim_ + parameterDim_);
+  std::copy(x.data(), x.data() + variableDim_, buffer.begin());
+  std::copy(p.data(), p.data() + parameterDim_, buffer.begin() + variableDim_);
+  return CppAD::cg::ArrayView<const scalar_t>(buffer.data(), buffer.size());
 }
 
 /******************************************************************************************************/
@@ -297,6 +656,9 @@ void CppAdInterface::setFolderNames() {
   tmpName_ = getUniqueTemporaryName();
   tmpFolder_ = libraryFolder_ + "/" + tmpName_;
   libraryName_ = libraryFolder_ + "/" + modelName_ + "_lib";
+  if (!libraryKey_.empty()) {
+    libraryName_ += "_" + libraryKey_;
+  }
 }
 
 /******************************************************************************************************/
@@ -337,8 +699,8 @@ void CppAdInterface::setCompilerOptions(CppAD::cg::GccCompiler<scalar_t>& compil
 
   compiler.setTemporaryFolder(tmpFolder_);
 
-  // Save sources
-  compiler.setSourcesFolder(libraryFolder_);
+  // Save sources, in the temporary folder such that concurrent compilations of the same model do not overwrite each others sources
+  compiler.setSourcesFolder(tmpFolder_);
   compiler.setSaveToDiskFirst(true);
 }
 
@@ -375,6 +737,18 @@ void CppAdInterface::setSparsityNonzeros() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setVariableSparsity(ad_fun_t& fun) {
+  // Union of the nonzero columns of all outputs, restricted to the variables
+  std::set<size_t> variables;
+  for (const auto& row : cppad_sparsity::getJacobianSparsityPattern(fun)) {
+    std::copy_if(row.begin(), row.end(), std::inserter(variables, variables.end()), [&](size_t j) { return j < variableDim_; });
+  }
+  variableSparsity_.assign(variables.begin(), variables.end());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
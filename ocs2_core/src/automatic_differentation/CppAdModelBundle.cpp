@@ -0,0 +1,206 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/automatic_differentiation/CppAdModelBundle.h>
+
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <boost/filesystem.hpp>
+
+#include <cppad/cg.hpp>
+
+namespace ocs2 {
+
+namespace {
+
+thread_local CppAdModelExporter* activeExporter = nullptr;
+
+/** Functions of all the registered bundles by name. Constructed on first use, the bundles register during static initialization. */
+struct BundleRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string, void*> functions;
+};
+
+BundleRegistry& getBundleRegistry() {
+  static BundleRegistry registry;
+  return registry;
+}
+
+void* findBundleFunction(const std::string& functionName) {
+  auto& registry = getBundleRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const auto it = registry.functions.find(functionName);
+  return (it != registry.functions.end()) ? it->second : nullptr;
+}
+
+/** Model that binds the functions of a registered bundle, the counterpart of CppAD::cg::LinuxDynamicLibModel. */
+class BundleModel : public CppAD::cg::FunctorGenericModel<scalar_t> {
+ public:
+  explicit BundleModel(const std::string& bundleModelName) : CppAD::cg::FunctorGenericModel<scalar_t>(bundleModelName) { this->init(); }
+
+ protected:
+  void* loadFunction(const std::string& functionName, bool required) override {
+    void* function = findBundleFunction(functionName);
+    if (function == nullptr && required) {
+      throw std::runtime_error("[CppAdModelBundle] Function " + functionName + " is not part of a registered bundle.");
+    }
+    return function;
+  }
+};
+
+/** Writes the file, unless it already has the given content. */
+void writeIfChanged(const std::string& fileName, const std::string& content) {
+  {
+    std::ifstream existingFile(fileName);
+    if (existingFile.good()) {
+      std::stringstream existingContent;
+      existingContent << existingFile.rdbuf();
+      if (existingContent.str() == content) {
+        return;
+      }
+    }
+  }
+
+  std::ofstream file(fileName);
+  file << content;
+  if (!file.good()) {
+    throw std::runtime_error("[CppAdModelExporter] Could not write " + fileName);
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool registerCppAdBundle(const CppAdBundleFunction* functions) {
+  auto& registry = getBundleRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (; functions->name != nullptr; ++functions) {
+    registry.functions.emplace(functions->name, functions->function);
+  }
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isCppAdBundleModelAvailable(const std::string& bundleModelName) {
+  return findBundleFunction(bundleModelName + "_" + CppAD::cg::ModelCSourceGen<scalar_t>::FUNCTION_INFO) != nullptr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> loadCppAdBundleModel(const std::string& bundleModelName) {
+  return std::unique_ptr<CppAD::cg::GenericModel<scalar_t>>(new BundleModel(bundleModelName));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelExporter::CppAdModelExporter(std::string bundleName) : previousActiveExporter_(activeExporter), bundleName_(std::move(bundleName)) {
+  activeExporter = this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelExporter::~CppAdModelExporter() {
+  activeExporter = previousActiveExporter_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelExporter* CppAdModelExporter::getActiveExporter() {
+  return activeExporter;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelExporter::addModel(const std::string& bundleModelName, const std::map<std::string, std::string>& sources) {
+  if (!modelNames_.insert(bundleModelName).second) {
+    return;
+  }
+
+  // Every model source defines one function that is named after the file
+  const std::string extension = ".c";
+  for (const auto& source : sources) {
+    const auto& fileName = source.first;
+    if (fileName.size() <= extension.size() || fileName.compare(fileName.size() - extension.size(), extension.size(), extension) != 0) {
+      throw std::runtime_error("[CppAdModelExporter] Unexpected source file " + fileName);
+    }
+    sources_.emplace_back(fileName.substr(0, fileName.size() - extension.size()), source.second);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelExporter::write(const std::string& outputFolder) const {
+  boost::filesystem::create_directories(outputFolder);
+
+  // Every source defines the types Array and LangCAtomicFun. They are renamed per source, such that the sources can be concatenated.
+  std::ostringstream models;
+  models << "/* Generated by CppAdModelExporter, do not edit. */\n\n";
+  models << "#include <math.h>\n#include <stdio.h>\n\n";
+  for (size_t i = 0; i < sources_.size(); i++) {
+    models << "#define Array " << bundleName_ << "_Array" << i << "\n";
+    models << "#define LangCAtomicFun " << bundleName_ << "_LangCAtomicFun" << i << "\n\n";
+    models << sources_[i].second << "\n";
+    models << "#undef Array\n#undef LangCAtomicFun\n\n";
+  }
+
+  // Function table, see CppAdBundleFunction
+  models << "struct " << bundleName_ << "_function {\n  const char* name;\n  void* function;\n};\n\n";
+  models << "const struct " << bundleName_ << "_function " << bundleName_ << "_functions[] = {\n";
+  for (const auto& source : sources_) {
+    models << "    {\"" << source.first << "\", (void*)&" << source.first << "},\n";
+  }
+  models << "    {0, 0}};\n";
+
+  std::ostringstream registration;
+  registration << "// Generated by CppAdModelExporter, do not edit.\n\n";
+  registration << "#include <ocs2_core/automatic_differentiation/CppAdModelBundle.h>\n\n";
+  registration << "extern \"C\" const ocs2::CppAdBundleFunction " << bundleName_ << "_functions[];\n\n";
+  registration << "namespace {\n";
+  registration << "const bool registered = ocs2::registerCppAdBundle(" << bundleName_ << "_functions);\n";
+  registration << "}  // unnamed namespace\n";
+
+  writeIfChanged(outputFolder + "/" + bundleName_ + "_models.c", models.str());
+  writeIfChanged(outputFolder + "/" + bundleName_ + "_registration.cpp", registration.str());
+}
+
+}  // namespace ocs2
@@ -64,12 +64,21 @@ vector_t LinearStateConstraint::getValue(scalar_t t, const vector_t& x, const Pr
 /******************************************************************************************************/
 /******************************************************************************************************/
 VectorFunctionLinearApproximation LinearStateConstraint::getLinearApproximation(scalar_t t, const vector_t& x,
-                                                                                const PreComputation&) const {
+                                                                                const PreComputation& preComp) const {
   VectorFunctionLinearApproximation g;
+  getLinearApproximation(t, x, preComp, g);
+  return g;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearStateConstraint::getLinearApproximation(scalar_t t, const vector_t& x, const PreComputation&,
+                                                   VectorFunctionLinearApproximation& g) const {
   g.f = h_;
   g.f.noalias() += F_ * x;
   g.dfdx = F_;
-  return g;
+  g.dfdu.resize(0, 0);
 }
 
 }  // namespace ocs2
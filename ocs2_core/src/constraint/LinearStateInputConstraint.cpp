@@ -65,14 +65,22 @@ vector_t LinearStateInputConstraint::getValue(scalar_t t, const vector_t& x, con
 /******************************************************************************************************/
 /******************************************************************************************************/
 VectorFunctionLinearApproximation LinearStateInputConstraint::getLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
-                                                                                     const PreComputation&) const {
+                                                                                     const PreComputation& preComp) const {
   VectorFunctionLinearApproximation g;
+  getLinearApproximation(t, x, u, preComp, g);
+  return g;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearStateInputConstraint::getLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&,
+                                                        VectorFunctionLinearApproximation& g) const {
   g.f = e_;
   g.f.noalias() += C_ * x;
   g.f.noalias() += D_ * u;
   g.dfdx = C_;
   g.dfdu = D_;
-  return g;
 }
 
 }  // namespace ocs2
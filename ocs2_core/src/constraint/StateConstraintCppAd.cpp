@@ -56,13 +56,14 @@ void StateConstraintCppAd::initialize(size_t stateDim, size_t parameterDim, cons
   } else {
     adInterfacePtr_->loadModelsIfAvailable(orderCppAd, verbose);
   }
+  sparsity_ = getTimeStateInputSparsity(adInterfacePtr_->getVariableSparsity(), stateDim, 0);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateConstraintCppAd::StateConstraintCppAd(const StateConstraintCppAd& rhs)
-    : StateConstraint(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateConstraint(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)), sparsity_(rhs.sparsity_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -79,17 +80,28 @@ vector_t StateConstraintCppAd::getValue(scalar_t time, const vector_t& state, co
 VectorFunctionLinearApproximation StateConstraintCppAd::getLinearApproximation(scalar_t time, const vector_t& state,
                                                                                const PreComputation& preComputation) const {
   VectorFunctionLinearApproximation constraint;
+  getLinearApproximation(time, state, preComputation, constraint);
+  return constraint;
+}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateConstraintCppAd::getLinearApproximation(scalar_t time, const vector_t& state, const PreComputation& preComputation,
+                                                  VectorFunctionLinearApproximation& constraint) const {
   const size_t stateDim = state.rows();
   const vector_t params = getParameters(time, preComputation);
-  vector_t tapedTimeState(1 + stateDim);
+
+  // reused between calls on the same thread
+  thread_local vector_t tapedTimeState;
+  tapedTimeState.resize(1 + stateDim);
   tapedTimeState << time, state;
+  thread_local matrix_t J;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
+  adInterfacePtr_->getFunctionValue(tapedTimeState, params, constraint.f);
+  adInterfacePtr_->getJacobian(tapedTimeState, params, J);
   constraint.dfdx = J.rightCols(stateDim);
-
-  return constraint;
+  constraint.dfdu.resize(0, 0);
 }
 
 /******************************************************************************************************/
@@ -108,16 +120,18 @@ VectorFunctionQuadraticApproximation StateConstraintCppAd::getQuadraticApproxima
   vector_t tapedTimeState(1 + stateDim);
   tapedTimeState << time, state;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
+  thread_local matrix_t J;  // reused between calls on the same thread
+  adInterfacePtr_->getFunctionValue(tapedTimeState, params, constraint.f);
+  adInterfacePtr_->getJacobian(tapedTimeState, params, J);
   constraint.dfdx = J.rightCols(stateDim);
 
   const size_t numConstraints = constraint.f.rows();
   constraint.dfdxx.resize(numConstraints);
   constraint.dfdux.resize(numConstraints);
   constraint.dfduu.resize(numConstraints);
+  thread_local matrix_t H;
   for (int i = 0; i < numConstraints; i++) {
-    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeState, params);
+    adInterfacePtr_->getHessian(i, tapedTimeState, params, H);
     constraint.dfdxx[i] = H.bottomRightCorner(stateDim, stateDim);
   }
 
@@ -61,13 +61,21 @@ size_t StateInputConstraintCollection::getNumConstraints(scalar_t time) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 size_array_t StateInputConstraintCollection::getTermsSize(scalar_t time) const {
-  size_array_t termsSize(this->terms_.size(), 0);
+  size_array_t termsSize;
+  getTermsSize(time, termsSize);
+  return termsSize;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCollection::getTermsSize(scalar_t time, size_array_t& termsSize) const {
+  termsSize.assign(this->terms_.size(), 0);
   for (size_t i = 0; i < this->terms_.size(); ++i) {
     if (this->terms_[i]->isActive(time)) {
       termsSize[i] = this->terms_[i]->getNumConstraints(time);
     }
   }
-  return termsSize;
 }
 
 /******************************************************************************************************/
@@ -108,6 +116,29 @@ VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearAppro
   return linearApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCollection::getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                            const PreComputation& preComp,
+                                                            VectorFunctionLinearApproximation& linearApproximation) const {
+  linearApproximation.resize(getNumConstraints(time), state.rows(), input.rows());
+
+  // append linearApproximation of each constraintTerm
+  thread_local VectorFunctionLinearApproximation constraintTermApproximation;
+  size_t i = 0;
+  for (const auto& constraintTerm : this->terms_) {
+    if (constraintTerm->isActive(time)) {
+      constraintTerm->getLinearApproximation(time, state, input, preComp, constraintTermApproximation);
+      const size_t nc = constraintTermApproximation.f.rows();
+      linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
+      linearApproximation.dfdx.middleRows(i, nc) = constraintTermApproximation.dfdx;
+      linearApproximation.dfdu.middleRows(i, nc) = constraintTermApproximation.dfdu;
+      i += nc;
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -57,13 +57,14 @@ void StateInputConstraintCppAd::initialize(size_t stateDim, size_t inputDim, siz
   } else {
     adInterfacePtr_->loadModelsIfAvailable(orderCppAd, verbose);
   }
+  sparsity_ = getTimeStateInputSparsity(adInterfacePtr_->getVariableSparsity(), stateDim, inputDim);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputConstraintCppAd::StateInputConstraintCppAd(const StateInputConstraintCppAd& rhs)
-    : StateInputConstraint(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateInputConstraint(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)), sparsity_(rhs.sparsity_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -82,19 +83,30 @@ VectorFunctionLinearApproximation StateInputConstraintCppAd::getLinearApproximat
                                                                                     const vector_t& input,
                                                                                     const PreComputation& preComputation) const {
   VectorFunctionLinearApproximation constraint;
+  getLinearApproximation(time, state, input, preComputation, constraint);
+  return constraint;
+}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCppAd::getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                       const PreComputation& preComputation,
+                                                       VectorFunctionLinearApproximation& constraint) const {
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
   const vector_t params = getParameters(time, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
+
+  // reused between calls on the same thread
+  thread_local vector_t tapedTimeStateInput;
+  tapedTimeStateInput.resize(1 + stateDim + inputDim);
   tapedTimeStateInput << time, state, input;
+  thread_local matrix_t J;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
+  adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params, constraint.f);
+  adInterfacePtr_->getJacobian(tapedTimeStateInput, params, J);
   constraint.dfdx = J.middleCols(1, stateDim);
   constraint.dfdu = J.rightCols(inputDim);
-
-  return constraint;
 }
 
 /******************************************************************************************************/
@@ -115,8 +127,9 @@ VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getQuadraticAppr
   vector_t tapedTimeStateInput(1 + stateDim + inputDim);
   tapedTimeStateInput << time, state, input;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
+  thread_local matrix_t J;  // reused between calls on the same thread
+  adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params, constraint.f);
+  adInterfacePtr_->getJacobian(tapedTimeStateInput, params, J);
   constraint.dfdx = J.middleCols(1, stateDim);
   constraint.dfdu = J.rightCols(inputDim);
 
@@ -124,8 +137,9 @@ VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getQuadraticAppr
   constraint.dfdxx.resize(numConstraints);
   constraint.dfdux.resize(numConstraints);
   constraint.dfduu.resize(numConstraints);
+  thread_local matrix_t H;
   for (int i = 0; i < numConstraints; i++) {
-    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeStateInput, params);
+    adInterfacePtr_->getHessian(i, tapedTimeStateInput, params, H);
     constraint.dfdxx[i] = H.block(1, 1, stateDim, stateDim);
     constraint.dfdux[i] = H.block(1 + stateDim, 1, inputDim, stateDim);
     constraint.dfduu[i] = H.bottomRightCorner(inputDim, inputDim);
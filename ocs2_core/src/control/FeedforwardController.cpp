@@ -90,6 +90,13 @@ vector_t FeedforwardController::computeInput(scalar_t t, const vector_t& x) {
   return LinearInterpolation::interpolate(t, timeStamp_, uffArray_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FeedforwardController::computeInputWithCursor(scalar_t t, const vector_t& x, vector_t& u, int& cursor) {
+  LinearInterpolation::interpolate(LinearInterpolation::timeSegment(t, timeStamp_, cursor), uffArray_, u);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
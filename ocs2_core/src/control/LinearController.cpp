@@ -86,6 +86,31 @@ vector_t LinearController::computeInput(scalar_t t, const vector_t& x) {
   return uff;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::computeInputWithCursor(scalar_t t, const vector_t& x, vector_t& u, int& cursor) {
+  const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_, cursor);
+
+  LinearInterpolation::interpolate(indexAlpha, biasArray_, u);
+
+  // add the interpolated feedback without forming the interpolated gain matrix
+  if (gainArray_.size() > 1) {
+    const int index = indexAlpha.first;
+    const scalar_t alpha = indexAlpha.second;
+    const auto& lhs = gainArray_[index];
+    const auto& rhs = gainArray_[index + 1];
+    if (lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols()) {
+      u.noalias() += alpha * lhs * x;
+      u.noalias() += (scalar_t(1.0) - alpha) * rhs * x;
+    } else {
+      u.noalias() += ((alpha > 0.5) ? lhs : rhs) * x;
+    }
+  } else {
+    u.noalias() += gainArray_.front() * x;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -34,7 +34,10 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-QuadraticStateCost::QuadraticStateCost(matrix_t Q) : Q_(std::move(Q)) {}
+QuadraticStateCost::QuadraticStateCost(matrix_t Q) : Q_(std::move(Q)) {
+  // Q is symmetric, its nonzero rows are the states the cost depends on
+  sparsity_ = getStateInputSparsity(getNonzeroRows(Q_), {}, Q_.rows(), 0);
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -48,7 +51,8 @@ QuadraticStateCost* QuadraticStateCost::clone() const {
 /******************************************************************************************************/
 scalar_t QuadraticStateCost::getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
                                       const PreComputation&) const {
-  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+  vector_t xDeviation;
+  getStateDeviation(time, state, targetTrajectories, xDeviation);
   return 0.5 * xDeviation.dot(Q_ * xDeviation);
 }
 
@@ -57,21 +61,35 @@ scalar_t QuadraticStateCost::getValue(scalar_t time, const vector_t& state, cons
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                    const TargetTrajectories& targetTrajectories,
-                                                                                   const PreComputation&) const {
-  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
-
+                                                                                   const PreComputation& preComp) const {
   ScalarFunctionQuadraticApproximation Phi;
+  getQuadraticApproximation(time, state, targetTrajectories, preComp, Phi);
+  return Phi;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateCost::getQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                   const PreComputation&, ScalarFunctionQuadraticApproximation& Phi) const {
+  thread_local vector_t xDeviation;  // reused between calls on the same thread
+  getStateDeviation(time, state, targetTrajectories, xDeviation);
+
   Phi.dfdxx = Q_;
   Phi.dfdx.noalias() = Q_ * xDeviation;
   Phi.f = 0.5 * xDeviation.dot(Phi.dfdx);
-  return Phi;
+  Phi.dfdu.resize(0);
+  Phi.dfdux.resize(0, 0);
+  Phi.dfduu.resize(0, 0);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-vector_t QuadraticStateCost::getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const {
-  return state - targetTrajectories.getDesiredState(time);
+void QuadraticStateCost::getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                           vector_t& stateDeviation) const {
+  targetTrajectories.getDesiredState(time, stateDeviation);
+  stateDeviation = state - stateDeviation;
 }
 
 }  // namespace ocs2
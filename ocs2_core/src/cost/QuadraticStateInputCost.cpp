@@ -40,6 +40,17 @@ QuadraticStateInputCost::QuadraticStateInputCost(matrix_t Q, matrix_t R, matrix_
     assert(P_.rows() == R_.rows());
     assert(P_.cols() == Q_.rows());
   }
+
+  // Q and R are symmetric, P couples the inputs of its nonzero rows with the states of its nonzero columns
+  auto stateIndices = getNonzeroRows(Q_);
+  auto inputIndices = getNonzeroRows(R_);
+  if (P_.size() > 0) {
+    const auto stateIndicesP = getNonzeroRows(P_.transpose());
+    const auto inputIndicesP = getNonzeroRows(P_);
+    stateIndices.insert(stateIndices.end(), stateIndicesP.begin(), stateIndicesP.end());
+    inputIndices.insert(inputIndices.end(), inputIndicesP.begin(), inputIndicesP.end());
+  }
+  sparsity_ = getStateInputSparsity(std::move(stateIndices), std::move(inputIndices), Q_.rows(), R_.rows());
 }
 
 /******************************************************************************************************/
@@ -55,7 +66,7 @@ QuadraticStateInputCost* QuadraticStateInputCost::clone() const {
 scalar_t QuadraticStateInputCost::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                            const TargetTrajectories& targetTrajectories, const PreComputation&) const {
   vector_t stateDeviation, inputDeviation;
-  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+  getStateInputDeviation(time, state, input, targetTrajectories, stateDeviation, inputDeviation);
 
   if (P_.size() == 0) {
     return 0.5 * stateDeviation.dot(Q_ * stateDeviation) + 0.5 * inputDeviation.dot(R_ * inputDeviation);
@@ -71,39 +82,50 @@ scalar_t QuadraticStateInputCost::getValue(scalar_t time, const vector_t& state,
 ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                         const vector_t& input,
                                                                                         const TargetTrajectories& targetTrajectories,
-                                                                                        const PreComputation&) const {
-  vector_t stateDeviation, inputDeviation;
-  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
-
+                                                                                        const PreComputation& preComp) const {
   ScalarFunctionQuadraticApproximation L;
+  getQuadraticApproximation(time, state, input, targetTrajectories, preComp, L);
+  return L;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void QuadraticStateInputCost::getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                        const TargetTrajectories& targetTrajectories, const PreComputation&,
+                                                        ScalarFunctionQuadraticApproximation& L) const {
+  thread_local vector_t stateDeviation;  // reused between calls on the same thread
+  thread_local vector_t inputDeviation;
+  getStateInputDeviation(time, state, input, targetTrajectories, stateDeviation, inputDeviation);
+
   L.dfdxx = Q_;
   L.dfduu = R_;
   L.dfdx.noalias() = Q_ * stateDeviation;
   L.dfdu.noalias() = R_ * inputDeviation;
-  L.f = 0.5 * stateDeviation.dot(L.dfdx) + 0.5 * inputDeviation.dot(L.dfdu);
 
   if (P_.size() == 0) {
     L.dfdux.setZero(input.size(), state.size());
 
   } else {
-    const vector_t pDeviation = P_ * stateDeviation;
-    L.f += inputDeviation.dot(pDeviation);
-    L.dfdu += pDeviation;
+    L.dfdu.noalias() += P_ * stateDeviation;
     L.dfdx.noalias() += P_.transpose() * inputDeviation;
     L.dfdux = P_;
   }
 
-  return L;
+  // 0.5 * dx' * (Q * dx + P' * du) + 0.5 * du' * (R * du + P * dx) = 0.5 * dx' * Q * dx + 0.5 * du' * R * du + du' * P * dx
+  L.f = 0.5 * stateDeviation.dot(L.dfdx) + 0.5 * inputDeviation.dot(L.dfdu);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::pair<vector_t, vector_t> QuadraticStateInputCost::getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                                              const TargetTrajectories& targetTrajectories) const {
-  const vector_t stateDeviation = state - targetTrajectories.getDesiredState(time);
-  const vector_t inputDeviation = input - targetTrajectories.getDesiredInput(time);
-  return {stateDeviation, inputDeviation};
+void QuadraticStateInputCost::getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                     const TargetTrajectories& targetTrajectories, vector_t& stateDeviation,
+                                                     vector_t& inputDeviation) const {
+  targetTrajectories.getDesiredState(time, stateDeviation);
+  stateDeviation = state - stateDeviation;
+  targetTrajectories.getDesiredInput(time, inputDeviation);
+  inputDeviation = input - inputDeviation;
 }
 
 }  // namespace ocs2
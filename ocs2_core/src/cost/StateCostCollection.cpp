@@ -78,10 +78,7 @@ ScalarFunctionQuadraticApproximation StateCostCollection::getQuadraticApproximat
   auto cost = (*firstActive)->getQuadraticApproximation(time, state, targetTrajectories, preComp);
   std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateCost>& costTerm) {
     if (costTerm->isActive(time)) {
-      const auto costTermApproximation = costTerm->getQuadraticApproximation(time, state, targetTrajectories, preComp);
-      cost.f += costTermApproximation.f;
-      cost.dfdx += costTermApproximation.dfdx;
-      cost.dfdxx += costTermApproximation.dfdxx;
+      addSparseStateOnly(costTerm->getQuadraticApproximation(time, state, targetTrajectories, preComp), costTerm->getSparsity(), cost);
     }
   });
 
@@ -93,4 +90,34 @@ ScalarFunctionQuadraticApproximation StateCostCollection::getQuadraticApproximat
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateCostCollection::getQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                    const PreComputation& preComp, ScalarFunctionQuadraticApproximation& cost) const {
+  const auto firstActive =
+      std::find_if(terms_.begin(), terms_.end(), [time](const std::unique_ptr<StateCost>& costTerm) { return costTerm->isActive(time); });
+
+  // No active terms (or terms is empty).
+  if (firstActive == terms_.end()) {
+    cost.setZero(state.rows());
+    return;
+  }
+
+  // Initialize with first active term, accumulate potentially other active terms.
+  (*firstActive)->getQuadraticApproximation(time, state, targetTrajectories, preComp, cost);
+  thread_local ScalarFunctionQuadraticApproximation costTermApproximation;
+  std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateCost>& costTerm) {
+    if (costTerm->isActive(time)) {
+      costTerm->getQuadraticApproximation(time, state, targetTrajectories, preComp, costTermApproximation);
+      addSparseStateOnly(costTermApproximation, costTerm->getSparsity(), cost);
+    }
+  });
+
+  // Make sure that input derivatives are empty
+  cost.dfdu.resize(0);
+  cost.dfduu.resize(0, 0);
+  cost.dfdux.resize(0, 0);
+}
+
 }  // namespace ocs2
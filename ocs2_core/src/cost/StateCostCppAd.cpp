@@ -50,13 +50,14 @@ void StateCostCppAd::initialize(size_t stateDim, size_t parameterDim, const std:
   } else {
     adInterfacePtr_->loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
   }
+  sparsity_ = getTimeStateInputSparsity(adInterfacePtr_->getVariableSparsity(), stateDim, 0);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateCostCppAd::StateCostCppAd(const StateCostCppAd& rhs)
-    : StateCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)), sparsity_(rhs.sparsity_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -65,7 +66,9 @@ scalar_t StateCostCppAd::getValue(scalar_t time, const vector_t& state, const Ta
                                   const PreComputation& preComputation) const {
   vector_t tapedTimeState(1 + state.rows());
   tapedTimeState << time, state;
-  return adInterfacePtr_->getFunctionValue(tapedTimeState, getParameters(time, targetTrajectories, preComputation))(0);
+  thread_local vector_t value;
+  adInterfacePtr_->getFunctionValue(tapedTimeState, getParameters(time, targetTrajectories, preComputation), value);
+  return value(0);
 }
 
 /******************************************************************************************************/
@@ -75,21 +78,37 @@ ScalarFunctionQuadraticApproximation StateCostCppAd::getQuadraticApproximation(s
                                                                                const TargetTrajectories& targetTrajectories,
                                                                                const PreComputation& preComputation) const {
   ScalarFunctionQuadraticApproximation cost;
+  getQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
+  return cost;
+}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateCostCppAd::getQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                               const PreComputation& preComputation, ScalarFunctionQuadraticApproximation& cost) const {
   const size_t stateDim = state.rows();
   const vector_t params = getParameters(time, targetTrajectories, preComputation);
-  vector_t tapedTimeState(1 + stateDim);
+
+  // Evaluation buffers are reused between calls on the same thread
+  thread_local vector_t tapedTimeState;
+  tapedTimeState.resize(1 + stateDim);
   tapedTimeState << time, state;
+  thread_local vector_t value;
+  thread_local matrix_t J;
+  thread_local matrix_t H;
 
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params)(0);
+  adInterfacePtr_->getFunctionValue(tapedTimeState, params, value);
+  cost.f = value(0);
 
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
+  adInterfacePtr_->getJacobian(tapedTimeState, params, J);
   cost.dfdx = J.rightCols(stateDim).transpose();
 
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeState, params);
+  adInterfacePtr_->getHessian(0, tapedTimeState, params, H);
   cost.dfdxx = H.bottomRightCorner(stateDim, stateDim);
-
-  return cost;
+  cost.dfdu.resize(0);
+  cost.dfdux.resize(0, 0);
+  cost.dfduu.resize(0, 0);
 }
 
 }  // namespace ocs2
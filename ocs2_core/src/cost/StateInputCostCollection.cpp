@@ -79,11 +79,37 @@ ScalarFunctionQuadraticApproximation StateInputCostCollection::getQuadraticAppro
   auto cost = (*firstActive)->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
   std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateInputCost>& costTerm) {
     if (costTerm->isActive(time)) {
-      cost += costTerm->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+      addSparse(costTerm->getQuadraticApproximation(time, state, input, targetTrajectories, preComp), costTerm->getSparsity(), cost);
     }
   });
 
   return cost;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCollection::getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                         const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                         ScalarFunctionQuadraticApproximation& cost) const {
+  const auto firstActive = std::find_if(terms_.begin(), terms_.end(),
+                                        [time](const std::unique_ptr<StateInputCost>& costTerm) { return costTerm->isActive(time); });
+
+  // No active terms (or terms is empty).
+  if (firstActive == terms_.end()) {
+    cost.setZero(state.rows(), input.rows());
+    return;
+  }
+
+  // Initialize with first active term, accumulate potentially other active terms.
+  (*firstActive)->getQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
+  thread_local ScalarFunctionQuadraticApproximation costTermApproximation;
+  std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateInputCost>& costTerm) {
+    if (costTerm->isActive(time)) {
+      costTerm->getQuadraticApproximation(time, state, input, targetTrajectories, preComp, costTermApproximation);
+      addSparse(costTermApproximation, costTerm->getSparsity(), cost);
+    }
+  });
+}
+
 }  // namespace ocs2
@@ -51,13 +51,14 @@ void StateInputCostCppAd::initialize(size_t stateDim, size_t inputDim, size_t pa
   } else {
     adInterfacePtr_->loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
   }
+  sparsity_ = getTimeStateInputSparsity(adInterfacePtr_->getVariableSparsity(), stateDim, inputDim);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputCostCppAd::StateInputCostCppAd(const StateInputCostCppAd& rhs)
-    : StateInputCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateInputCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)), sparsity_(rhs.sparsity_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -66,7 +67,9 @@ scalar_t StateInputCostCppAd::getValue(scalar_t time, const vector_t& state, con
                                        const TargetTrajectories& targetTrajectories, const PreComputation& preComputation) const {
   vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
   tapedTimeStateInput << time, state, input;
-  return adInterfacePtr_->getFunctionValue(tapedTimeStateInput, getParameters(time, targetTrajectories, preComputation))(0);
+  thread_local vector_t value;
+  adInterfacePtr_->getFunctionValue(tapedTimeStateInput, getParameters(time, targetTrajectories, preComputation), value);
+  return value(0);
 }
 
 /******************************************************************************************************/
@@ -77,25 +80,39 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
                                                                                     const TargetTrajectories& targetTrajectories,
                                                                                     const PreComputation& preComputation) const {
   ScalarFunctionQuadraticApproximation cost;
+  getQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
+  return cost;
+}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCppAd::getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                    const TargetTrajectories& targetTrajectories, const PreComputation& preComputation,
+                                                    ScalarFunctionQuadraticApproximation& cost) const {
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
   const vector_t params = getParameters(time, targetTrajectories, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
+
+  // Evaluation buffers are reused between calls on the same thread
+  thread_local vector_t tapedTimeStateInput;
+  tapedTimeStateInput.resize(1 + stateDim + inputDim);
   tapedTimeStateInput << time, state, input;
+  thread_local vector_t value;
+  thread_local matrix_t J;
+  thread_local matrix_t H;
 
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params)(0);
+  adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params, value);
+  cost.f = value(0);
 
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
+  adInterfacePtr_->getJacobian(tapedTimeStateInput, params, J);
   cost.dfdx = J.middleCols(1, stateDim).transpose();
   cost.dfdu = J.rightCols(inputDim).transpose();
 
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeStateInput, params);
+  adInterfacePtr_->getHessian(0, tapedTimeStateInput, params, H);
   cost.dfdxx = H.block(1, 1, stateDim, stateDim);
   cost.dfdux = H.block(1 + stateDim, 1, inputDim, stateDim);
   cost.dfduu = H.bottomRightCorner(inputDim, inputDim);
-
-  return cost;
 }
 
 }  // namespace ocs2
@@ -50,13 +50,14 @@ void StateInputCostGaussNewtonAd::initialize(size_t stateDim, size_t inputDim, s
   } else {
     adInterfacePtr_->loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, verbose);
   }
+  sparsity_ = getTimeStateInputSparsity(adInterfacePtr_->getVariableSparsity(), stateDim, inputDim);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputCostGaussNewtonAd::StateInputCostGaussNewtonAd(const StateInputCostGaussNewtonAd& rhs)
-    : StateInputCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateInputCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)), sparsity_(rhs.sparsity_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -66,7 +67,8 @@ scalar_t StateInputCostGaussNewtonAd::getValue(scalar_t time, const vector_t& st
   vector_t timeStateInput(1 + state.rows() + input.rows());
   timeStateInput << time, state, input;
   const auto parameters = getParameters(time, targetTrajectories, preComputation);
-  const auto costVector = adInterfacePtr_->getFunctionValue(timeStateInput, parameters);
+  thread_local vector_t costVector;
+  adInterfacePtr_->getFunctionValue(timeStateInput, parameters, costVector);
   return 0.5 * costVector.squaredNorm();
 }
 
@@ -82,7 +84,8 @@ ScalarFunctionQuadraticApproximation StateInputCostGaussNewtonAd::getQuadraticAp
   vector_t timeStateInput(1 + stateDim + inputDim);
   timeStateInput << time, state, input;
   const auto parameters = getParameters(time, targetTrajectories, preComputation);
-  const auto gnApproximation = adInterfacePtr_->getGaussNewtonApproximation(timeStateInput, parameters);
+  thread_local ScalarFunctionQuadraticApproximation gnApproximation;
+  adInterfacePtr_->getGaussNewtonApproximation(timeStateInput, parameters, gnApproximation);
 
   ScalarFunctionQuadraticApproximation L;
   L.f = gnApproximation.f;
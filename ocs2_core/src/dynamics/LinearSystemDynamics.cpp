@@ -68,13 +68,21 @@ vector_t LinearSystemDynamics::computeJumpMap(scalar_t t, const vector_t& x, con
 /******************************************************************************************************/
 /******************************************************************************************************/
 VectorFunctionLinearApproximation LinearSystemDynamics::linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
-                                                                            const PreComputation&) {
+                                                                            const PreComputation& preComp) {
   VectorFunctionLinearApproximation approximation;
-  approximation.f = A_ * x;
+  linearApproximation(t, x, u, preComp, approximation);
+  return approximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearSystemDynamics::linearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&,
+                                               VectorFunctionLinearApproximation& approximation) {
+  approximation.f.noalias() = A_ * x;
   approximation.f.noalias() += B_ * u;
   approximation.dfdx = A_;
   approximation.dfdu = B_;
-  return approximation;
 }
 
 /******************************************************************************************************/
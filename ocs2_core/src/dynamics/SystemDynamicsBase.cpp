@@ -50,6 +50,24 @@ VectorFunctionLinearApproximation SystemDynamicsBase::linearApproximation(scalar
   return linearApproximation(t, x, u, *preCompPtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBase::linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                             VectorFunctionLinearApproximation& approximation) {
+  assert(preCompPtr_ != nullptr);
+  preCompPtr_->request(Request::Dynamics + Request::Approximation, t, x, u);
+  linearApproximation(t, x, u, *preCompPtr_, approximation);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBase::linearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp,
+                                             VectorFunctionLinearApproximation& approximation) {
+  approximation = linearApproximation(t, x, u, preComp);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
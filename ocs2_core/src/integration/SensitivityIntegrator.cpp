@@ -55,13 +55,15 @@ DynamicsDiscretizer selectDynamicsDiscretization(SensitivityIntegratorType integ
 /******************************************************************************************************/
 /******************************************************************************************************/
 DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(SensitivityIntegratorType integratorType) {
+  using InPlaceDiscretization = void (*)(SystemDynamicsBase&, scalar_t, const vector_t&, const vector_t&, scalar_t,
+                                         VectorFunctionLinearApproximation&);
   switch (integratorType) {
     case SensitivityIntegratorType::EULER:
-      return eulerSensitivityDiscretization;
+      return static_cast<InPlaceDiscretization>(eulerSensitivityDiscretization);
     case SensitivityIntegratorType::RK2:
-      return rk2SensitivityDiscretization;
+      return static_cast<InPlaceDiscretization>(rk2SensitivityDiscretization);
     case SensitivityIntegratorType::RK4:
-      return rk4SensitivityDiscretization;
+      return static_cast<InPlaceDiscretization>(rk4SensitivityDiscretization);
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
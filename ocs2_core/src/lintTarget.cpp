@@ -3,7 +3,9 @@
 #include <ocs2_core/Types.h>
 
 // Automatic Differentation
+#include <ocs2_core/automatic_differentiation/CppAdCompilePool.h>
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/automatic_differentiation/CppAdModelBundle.h>
 #include <ocs2_core/automatic_differentiation/CppAdSparsity.h>
 #include <ocs2_core/automatic_differentiation/FiniteDifferenceMethods.h>
 
@@ -61,6 +63,7 @@
 #include <ocs2_core/loopshaping/Loopshaping.h>
 
 // Misc
+#include <ocs2_core/misc/ApproximationSparsity.h>
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/misc/CommandLine.h>
 // #include <ocs2_core/misc/LTI_Equations.h>
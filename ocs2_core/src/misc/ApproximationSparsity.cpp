@@ -0,0 +1,168 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/misc/ApproximationSparsity.h>
+
+#include <algorithm>
+
+namespace ocs2 {
+
+namespace {
+
+/** Sorts the indices and merges them into ranges of contiguous indices. */
+std::vector<ApproximationSparsity::IndexRange> toRanges(std::vector<size_t> indices) {
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+  std::vector<ApproximationSparsity::IndexRange> ranges;
+  for (const auto index : indices) {
+    if (!ranges.empty() && ranges.back().start + ranges.back().size == index) {
+      ranges.back().size++;
+    } else {
+      ranges.push_back({index, 1});
+    }
+  }
+  return ranges;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ApproximationSparsity::ApproximationSparsity(std::vector<size_t> stateIndices, std::vector<size_t> inputIndices)
+    : isDense_(false), stateRanges_(toRanges(std::move(stateIndices))), inputRanges_(toRanges(std::move(inputIndices))) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const ApproximationSparsity& ApproximationSparsity::dense() {
+  static const ApproximationSparsity denseSparsity;
+  return denseSparsity;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<size_t> getNonzeroRows(const matrix_t& m) {
+  std::vector<size_t> rows;
+  for (Eigen::Index i = 0; i < m.rows(); i++) {
+    if ((m.row(i).array() != 0.0).any()) {
+      rows.push_back(i);
+    }
+  }
+  return rows;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ApproximationSparsity getStateInputSparsity(std::vector<size_t> stateIndices, std::vector<size_t> inputIndices, size_t stateDim,
+                                            size_t inputDim) {
+  ApproximationSparsity sparsity(std::move(stateIndices), std::move(inputIndices));
+
+  // Adding the blocks one by one does not pay off for dense functions
+  const auto numIndices = [](const std::vector<ApproximationSparsity::IndexRange>& ranges) {
+    size_t n = 0;
+    for (const auto& range : ranges) {
+      n += range.size;
+    }
+    return n;
+  };
+  if (numIndices(sparsity.getStateRanges()) == stateDim && numIndices(sparsity.getInputRanges()) == inputDim) {
+    return ApproximationSparsity::dense();
+  }
+  return sparsity;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ApproximationSparsity getTimeStateInputSparsity(const std::vector<size_t>& variableIndices, size_t stateDim, size_t inputDim) {
+  std::vector<size_t> stateIndices;
+  std::vector<size_t> inputIndices;
+  for (const auto i : variableIndices) {
+    if (i >= 1 && i < 1 + stateDim) {
+      stateIndices.push_back(i - 1);
+    } else if (i >= 1 + stateDim && i < 1 + stateDim + inputDim) {
+      inputIndices.push_back(i - 1 - stateDim);
+    }
+  }
+  return getStateInputSparsity(std::move(stateIndices), std::move(inputIndices), stateDim, inputDim);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addSparse(const ScalarFunctionQuadraticApproximation& term, const ApproximationSparsity& sparsity,
+               ScalarFunctionQuadraticApproximation& sum) {
+  if (sparsity.isDense()) {
+    sum += term;
+    return;
+  }
+
+  sum.f += term.f;
+  for (const auto& i : sparsity.getStateRanges()) {
+    sum.dfdx.segment(i.start, i.size) += term.dfdx.segment(i.start, i.size);
+    for (const auto& j : sparsity.getStateRanges()) {
+      sum.dfdxx.block(i.start, j.start, i.size, j.size) += term.dfdxx.block(i.start, j.start, i.size, j.size);
+    }
+  }
+  for (const auto& i : sparsity.getInputRanges()) {
+    sum.dfdu.segment(i.start, i.size) += term.dfdu.segment(i.start, i.size);
+    for (const auto& j : sparsity.getStateRanges()) {
+      sum.dfdux.block(i.start, j.start, i.size, j.size) += term.dfdux.block(i.start, j.start, i.size, j.size);
+    }
+    for (const auto& j : sparsity.getInputRanges()) {
+      sum.dfduu.block(i.start, j.start, i.size, j.size) += term.dfduu.block(i.start, j.start, i.size, j.size);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addSparseStateOnly(const ScalarFunctionQuadraticApproximation& term, const ApproximationSparsity& sparsity,
+                        ScalarFunctionQuadraticApproximation& sum) {
+  sum.f += term.f;
+  if (sparsity.isDense()) {
+    sum.dfdx += term.dfdx;
+    sum.dfdxx += term.dfdxx;
+    return;
+  }
+
+  for (const auto& i : sparsity.getStateRanges()) {
+    sum.dfdx.segment(i.start, i.size) += term.dfdx.segment(i.start, i.size);
+    for (const auto& j : sparsity.getStateRanges()) {
+      sum.dfdxx.block(i.start, j.start, i.size, j.size) += term.dfdxx.block(i.start, j.start, i.size, j.size);
+    }
+  }
+}
+
+}  // namespace ocs2
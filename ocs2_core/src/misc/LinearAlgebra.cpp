@@ -158,23 +158,32 @@ void computeConstraintProjection(const matrix_t& Dm, const matrix_t& RmInvUmUmT,
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(const VectorFunctionLinearApproximation& constraint) {
+  std::pair<VectorFunctionLinearApproximation, matrix_t> result;
+  qrConstraintProjection(constraint, result.first, result.second);
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void qrConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection,
+                            matrix_t& pseudoInverse) {
   // Constraint Projectors are based on the QR decomposition
   const auto numConstraints = constraint.dfdu.rows();
   const auto numInputs = constraint.dfdu.cols();
-  const Eigen::HouseholderQR<matrix_t> QRof_DT(constraint.dfdu.transpose());
-
-  const matrix_t Q = QRof_DT.householderQ();
-  const auto Q1 = Q.leftCols(numConstraints);
-
-  const auto R = QRof_DT.matrixQR().topRows(numConstraints).triangularView<Eigen::Upper>();
-  const matrix_t pseudoInverse = R.solve(Q1.transpose());  // left pseudo-inverse of D^T
-
-  VectorFunctionLinearApproximation projectionTerms;
-  projectionTerms.dfdu = Q.rightCols(numInputs - numConstraints);
-  projectionTerms.dfdx.noalias() = -pseudoInverse.transpose() * constraint.dfdx;
-  projectionTerms.f.noalias() = -pseudoInverse.transpose() * constraint.f;
-
-  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
+  thread_local Eigen::HouseholderQR<matrix_t> QRof_DT;  // reused between calls on the same thread
+  thread_local matrix_t Q;
+  thread_local vector_t workspace;
+  QRof_DT.compute(constraint.dfdu.transpose());
+  QRof_DT.householderQ().evalTo(Q, workspace);
+
+  // left pseudo-inverse of D^T
+  pseudoInverse = Q.leftCols(numConstraints).transpose();
+  QRof_DT.matrixQR().topRows(numConstraints).triangularView<Eigen::Upper>().solveInPlace(pseudoInverse);
+
+  projection.dfdu = Q.rightCols(numInputs - numConstraints);
+  projection.dfdx.noalias() = -pseudoInverse.transpose() * constraint.dfdx;
+  projection.f.noalias() = -pseudoInverse.transpose() * constraint.f;
 }
 
 /******************************************************************************************************/
@@ -182,20 +191,27 @@ std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(co
 /******************************************************************************************************/
 std::pair<VectorFunctionLinearApproximation, matrix_t> luConstraintProjection(const VectorFunctionLinearApproximation& constraint,
                                                                               bool extractPseudoInverse) {
+  std::pair<VectorFunctionLinearApproximation, matrix_t> result;
+  luConstraintProjection(constraint, result.first, extractPseudoInverse ? &result.second : nullptr);
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void luConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection,
+                            matrix_t* pseudoInversePtr) {
   // Constraint Projectors are based on the LU decomposition
-  const Eigen::FullPivLU<matrix_t> lu(constraint.dfdu);
+  thread_local Eigen::FullPivLU<matrix_t> lu;  // reused between calls on the same thread
+  lu.compute(constraint.dfdu);
 
-  VectorFunctionLinearApproximation projectionTerms;
-  projectionTerms.dfdu = lu.kernel();
-  projectionTerms.dfdx.noalias() = -lu.solve(constraint.dfdx);
-  projectionTerms.f.noalias() = -lu.solve(constraint.f);
+  projection.dfdu = lu.kernel();
+  projection.dfdx.noalias() = -lu.solve(constraint.dfdx);
+  projection.f.noalias() = -lu.solve(constraint.f);
 
-  matrix_t pseudoInverse;
-  if (extractPseudoInverse) {
-    pseudoInverse = lu.solve(matrix_t::Identity(constraint.f.size(), constraint.f.size())).transpose();  // left pseudo-inverse of D^T
+  if (pseudoInversePtr != nullptr) {
+    *pseudoInversePtr = lu.solve(matrix_t::Identity(constraint.f.size(), constraint.f.size())).transpose();  // left pseudo-inverse of D^T
   }
-
-  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
 }
 
 // Explicit instantiations for dynamic sized matrices
@@ -94,6 +94,30 @@ vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::getDesiredState(scalar_t time, vector_t& desiredState) const {
+  if (this->empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
+  } else {
+    LinearInterpolation::interpolate(LinearInterpolation::timeSegment(time, timeTrajectory), stateTrajectory, desiredState);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void TargetTrajectories::getDesiredInput(scalar_t time, vector_t& desiredInput) const {
+  if (this->empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
+  } else if (inputTrajectory.empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories does not have inputTrajectory!");
+  } else {
+    LinearInterpolation::interpolate(LinearInterpolation::timeSegment(time, timeTrajectory), inputTrajectory, desiredInput);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
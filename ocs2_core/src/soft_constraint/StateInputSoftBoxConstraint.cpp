@@ -56,6 +56,16 @@ StateInputSoftBoxConstraint::StateInputSoftBoxConstraint(std::vector<BoxConstrai
     : stateBoxConstraints_(std::move(stateBoxConstraints)), inputBoxConstraints_(std::move(inputBoxConstraints)), offset_(0.0) {
   sortByIndex(stateBoxConstraints_);
   sortByIndex(inputBoxConstraints_);
+
+  const auto getIndices = [](const std::vector<BoxConstraint>& boxConstraints) {
+    std::vector<size_t> indices;
+    indices.reserve(boxConstraints.size());
+    for (const auto& boxConstraint : boxConstraints) {
+      indices.push_back(boxConstraint.index);
+    }
+    return indices;
+  };
+  sparsity_ = ApproximationSparsity(getIndices(stateBoxConstraints_), getIndices(inputBoxConstraints_));
 }
 
 /******************************************************************************************************/
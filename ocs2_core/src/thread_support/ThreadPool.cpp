@@ -27,22 +27,85 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 namespace ocs2 {
 
+namespace {
+
+/** Number of polling iterations before an idle worker parks on the condition variable. */
+constexpr int kWorkerSpinIterations = 4000;
+
+/** Number of polling iterations before the calling thread starts yielding while waiting for the workers. */
+constexpr int kCallerSpinIterations = 2000;
+
+/** Pool and worker index of the current thread, used to detect nested runParallel calls. */
+thread_local const ThreadPool* currentThreadPoolPtr = nullptr;
+thread_local int currentWorkerIndex = 0;
+
+/** Hint to the CPU that we are in a spin-wait loop. */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#else
+  std::this_thread::yield();
+#endif
+}
+
+/** Busy-waits until the predicate is satisfied. Yields the CPU once the wait takes longer than a few microseconds. */
+template <typename Predicate>
+void spinWait(Predicate&& predicate) {
+  for (int i = 0; !predicate(); ++i) {
+    if (i < kCallerSpinIterations) {
+      cpuRelax();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+}  // unnamed namespace
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-ThreadPool::ThreadPool(size_t nThreads, int priority) {
+ThreadPool::ThreadPool(size_t nThreads, int priority, int firstCpu) {
+  void* memory = nullptr;
+  if (posix_memalign(&memory, kCacheLineSize, (nThreads + 1) * sizeof(TaskRange)) != 0) {
+    throw std::bad_alloc();
+  }
+  taskRanges_.reset(static_cast<TaskRange*>(memory));
+  for (size_t r = 0; r < nThreads + 1; r++) {
+    new (&taskRanges_[r]) TaskRange();
+  }
+
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
     workerThreads_.emplace_back(&ThreadPool::worker, this, i);
     setThreadPriority(priority, workerThreads_.back());
+    if (firstCpu >= 0) {
+      setThreadAffinity(firstCpu + static_cast<int>(i), workerThreads_.back());
+    }
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::TaskRangesDeleter::operator()(TaskRange* ranges) const {
+  // TaskRange is trivially destructible
+  std::free(ranges);
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -63,21 +126,54 @@ ThreadPool::~ThreadPool() {
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::worker(int workerIndex) {
+  currentThreadPoolPtr = this;
+  currentWorkerIndex = workerIndex;
+
+  uint64_t lastEpoch = 0;
+  const auto hasWork = [&] { return parallelJobEpoch_.load() != lastEpoch || numQueuedTasks_.load() > 0; };
+
   while (true) {
-    std::unique_ptr<ThreadPool::TaskBase> taskPtr;
-    {
+    // spin for a while before parking
+    bool workAvailable = false;
+    for (int i = 0; i < kWorkerSpinIterations && !stop_.load(std::memory_order_relaxed); ++i) {
+      if (hasWork()) {
+        workAvailable = true;
+        break;
+      }
+      cpuRelax();
+    }
+
+    if (!workAvailable) {
       std::unique_lock<std::mutex> lock(taskQueueLock_);
-      taskQueueCondition_.wait(lock, [this] { return !taskQueue_.empty() || stop_; });
+      ++numParkedWorkers_;
+      taskQueueCondition_.wait(lock, [&] { return stop_.load() || hasWork(); });
+      --numParkedWorkers_;
+    }
 
-      // exit condition
-      if (stop_) {
-        break;
+    // exit condition
+    if (stop_) {
+      break;
+    }
+
+    // join the fork-join job
+    const auto epoch = parallelJobEpoch_.load();
+    if (epoch != lastEpoch) {
+      lastEpoch = epoch;
+      ++numActiveParticipants_;
+      if (parallelJobOpen_.load()) {
+        executeParallelJob(workerIndex);
       }
+      --numActiveParticipants_;
+    }
 
-      // pop the first task
+    // pop the first asynchronous task
+    std::unique_ptr<ThreadPool::TaskBase> taskPtr;
+    if (numQueuedTasks_.load() > 0) {
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
       if (!taskQueue_.empty()) {
         taskPtr = std::move(taskQueue_.front());
         taskQueue_.pop();
+        --numQueuedTasks_;
       }
     }
 
@@ -94,6 +190,7 @@ void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
   {
     std::lock_guard<std::mutex> lock(taskQueueLock_);
     taskQueue_.push(std::move(taskPtr));
+    ++numQueuedTasks_;
   }
   taskQueueCondition_.notify_one();
 }
@@ -101,24 +198,96 @@ void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
-  // Launch tasks in helper threads
-  std::vector<std::future<void>> futures;
-  if (N > 1) {
-    const int numHelpers = N - 1;
-    futures.reserve(numHelpers);
-    for (int i = 0; i < numHelpers; ++i) {
-      futures.emplace_back(run(taskFunction));
+void ThreadPool::notifyParkedWorkers() {
+  if (numParkedWorkers_.load() > 0) {
+    // taking the lock guarantees that a worker is either before its predicate check or waiting on the condition variable
+    { std::lock_guard<std::mutex> lock(taskQueueLock_); }
+    taskQueueCondition_.notify_all();
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::executeParallelJob(int workerIndex) {
+  const int numRanges = static_cast<int>(numThreads()) + 1;
+  for (int r = 0; r < numRanges; ++r) {
+    // own range first, then steal from the others
+    auto& range = taskRanges_[(workerIndex + r) % numRanges];
+    while (range.next.load(std::memory_order_relaxed) < range.end) {
+      if (range.next.fetch_add(1, std::memory_order_relaxed) >= range.end) {
+        break;
+      }
+      try {
+        parallelJob_.invoke(parallelJob_.taskObject, workerIndex);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(parallelExceptionLock_);
+        if (!parallelExceptionPtr_) {
+          parallelExceptionPtr_ = std::current_exception();
+        }
+      }
+      numCompletedTasks_.fetch_add(1, std::memory_order_release);
+    }
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::runParallelImpl(void (*invoke)(void*, int), void* taskObject, int N) {
+  const auto numWorkers = static_cast<int>(numThreads());
+
+  // Without helpers, or when called from within one of our own tasks, all instances run in this thread. As before, at least one
+  // instance is executed.
+  if (numWorkers == 0 || N <= 1 || currentThreadPoolPtr == this) {
+    const int workerId = (currentThreadPoolPtr == this) ? currentWorkerIndex : numWorkers;
+    const int numInstances = std::max(N, 1);
+    for (int i = 0; i < numInstances; ++i) {
+      invoke(taskObject, workerId);
     }
+    return;
   }
 
-  // Execute one instance in this thread.
-  const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
-  taskFunction(workerId);
+  std::lock_guard<std::mutex> jobLock(parallelJobLock_);
+
+  // Describe the job and distribute the instances over the participants. No worker reads these while the job is closed.
+  parallelJob_.invoke = invoke;
+  parallelJob_.taskObject = taskObject;
+  const int numRanges = numWorkers + 1;
+  for (int r = 0; r < numRanges; ++r) {
+    taskRanges_[r].next.store(static_cast<int>(static_cast<int64_t>(N) * r / numRanges), std::memory_order_relaxed);
+    taskRanges_[r].end = static_cast<int>(static_cast<int64_t>(N) * (r + 1) / numRanges);
+  }
+  numCompletedTasks_.store(0, std::memory_order_relaxed);
+
+  // Publish
+  parallelJobOpen_.store(true);
+  ++parallelJobEpoch_;
+  notifyParkedWorkers();
+
+  // Execute in this thread. Threadpool workers use ID 0 -> nThreads - 1.
+  const auto* previousThreadPoolPtr = currentThreadPoolPtr;
+  const auto previousWorkerIndex = currentWorkerIndex;
+  currentThreadPoolPtr = this;
+  currentWorkerIndex = numWorkers;
+  executeParallelJob(numWorkers);
+  currentThreadPoolPtr = previousThreadPoolPtr;
+  currentWorkerIndex = previousWorkerIndex;
 
   // Wait for helpers to finish.
-  for (auto&& fut : futures) {
-    fut.get();
+  spinWait([&] { return numCompletedTasks_.load(std::memory_order_acquire) == N; });
+
+  // Close the job and wait until no worker holds a reference to it anymore.
+  parallelJobOpen_.store(false);
+  spinWait([&] { return numActiveParticipants_.load() == 0; });
+
+  std::exception_ptr exceptionPtr;
+  {
+    std::lock_guard<std::mutex> lock(parallelExceptionLock_);
+    std::swap(exceptionPtr, parallelExceptionPtr_);
+  }
+  if (exceptionPtr) {
+    std::rethrow_exception(exceptionPtr);
   }
 }
 
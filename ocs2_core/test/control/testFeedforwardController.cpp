@@ -22,3 +22,17 @@ TEST(testFeedforwardController, testSerialization) {
     EXPECT_TRUE(controller.uffArray_[k].isApprox(controllerOut.uffArray_[k], 1e-6));
   }
 }
+
+TEST(testFeedforwardController, testCursor) {
+  scalar_array_t time = {0.0, 0.5, 0.5, 1.0};
+  vector_array_t uff = {vector_t::Random(2), vector_t::Random(2), vector_t::Random(2), vector_t::Random(2)};
+  FeedforwardController controller(time, uff);
+
+  int cursor = 0;
+  vector_t input;
+  const vector_t state = vector_t::Random(3);
+  for (const scalar_t t : {-0.1, 0.0, 0.25, 0.5, 0.75, 1.0, 1.5, 0.6, 0.1}) {
+    controller.computeInputWithCursor(t, state, input, cursor);
+    EXPECT_TRUE(input.isApprox(controller.computeInput(t, state))) << "time: " << t;
+  }
+}
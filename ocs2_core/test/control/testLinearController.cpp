@@ -24,3 +24,18 @@ TEST(testLinearController, testSerialization) {
     EXPECT_TRUE(controller.biasArray_[k].isApprox(controllerOut.biasArray_[k], 1e-6));
   }
 }
+
+TEST(testLinearController, testCursor) {
+  scalar_array_t time = {0.0, 0.5, 0.5, 1.0};
+  vector_array_t bias = {vector_t::Random(2), vector_t::Random(2), vector_t::Random(2), vector_t::Random(2)};
+  matrix_array_t gain = {matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3)};
+  LinearController controller(time, bias, gain);
+
+  int cursor = 0;
+  vector_t input;
+  const vector_t state = vector_t::Random(3);
+  for (const scalar_t t : {-0.1, 0.0, 0.25, 0.5, 0.75, 1.0, 1.5, 0.6, 0.1}) {
+    controller.computeInputWithCursor(t, state, input, cursor);
+    EXPECT_TRUE(input.isApprox(controller.computeInput(t, state))) << "time: " << t;
+  }
+}
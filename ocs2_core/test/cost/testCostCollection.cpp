@@ -29,8 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
 #include <ocs2_core/cost/StateCostCollection.h>
 #include <ocs2_core/cost/StateInputCostCollection.h>
+#include <ocs2_core/test/testTools.h>
 
 class SimpleQuadraticCost final : public ocs2::StateInputCost {
  public:
@@ -117,6 +119,35 @@ TEST_F(StateInputCost_TestFixture, getStateInputCostApproximation) {
   EXPECT_TRUE((cost.dfdux.array() == 0.0).all());
 }
 
+TEST_F(StateInputCost_TestFixture, addsSparseTerms) {
+  // Costs on the state 1-2 and input 1, and on the state 3 coupled with the input 0
+  ocs2::matrix_t Q1 = ocs2::matrix_t::Zero(STATE_DIM, STATE_DIM);
+  Q1.block(1, 1, 2, 2) << 2.0, 0.5, 0.5, 3.0;
+  ocs2::matrix_t R1 = ocs2::matrix_t::Zero(INPUT_DIM, INPUT_DIM);
+  R1(1, 1) = 4.0;
+  ocs2::matrix_t Q2 = ocs2::matrix_t::Zero(STATE_DIM, STATE_DIM);
+  Q2(3, 3) = 1.0;
+  ocs2::matrix_t R2 = ocs2::matrix_t::Zero(INPUT_DIM, INPUT_DIM);
+  R2(0, 0) = 1.0;
+  ocs2::matrix_t P2 = ocs2::matrix_t::Zero(INPUT_DIM, STATE_DIM);
+  P2(0, 3) = 0.5;
+
+  targetTrajectories = ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Zero(STATE_DIM)}, {ocs2::vector_t::Zero(INPUT_DIM)});
+  auto sparseCost1 = std::make_unique<ocs2::QuadraticStateInputCost>(Q1, R1);
+  auto sparseCost2 = std::make_unique<ocs2::QuadraticStateInputCost>(Q2, R2, P2);
+  ASSERT_FALSE(sparseCost1->getSparsity().isDense());
+  ASSERT_FALSE(sparseCost2->getSparsity().isDense());
+  expectedCostApproximation += sparseCost1->getQuadraticApproximation(t, x, u, targetTrajectories, {});
+  expectedCostApproximation += sparseCost2->getQuadraticApproximation(t, x, u, targetTrajectories, {});
+  costCollection.add("Sparse quadratic cost", std::move(sparseCost1));
+  costCollection.add("Another sparse quadratic cost", std::move(sparseCost2));
+
+  ocs2::ScalarFunctionQuadraticApproximation cost;
+  costCollection.getQuadraticApproximation(t, x, u, targetTrajectories, {}, cost);
+  EXPECT_TRUE(ocs2::isApprox(cost, expectedCostApproximation));
+  EXPECT_TRUE(ocs2::isApprox(costCollection.getQuadraticApproximation(t, x, u, targetTrajectories, {}), expectedCostApproximation));
+}
+
 TEST_F(StateInputCost_TestFixture, canGetCostFunction) {
   const auto& costFunction = costCollection.get("Simple quadratic cost");
 }
@@ -159,3 +159,51 @@ TEST(TestGNStateInputCostCppAd, getValue) {
   ASSERT_DOUBLE_EQ(approx.dfdux(0, 1), 0.0);
   ASSERT_DOUBLE_EQ(approx.dfduu(0, 0), (t * t + 1.0));
 }
+
+class TestSparseStateInputCost : public ocs2::StateInputCostCppAd {
+ public:
+  TestSparseStateInputCost() { initialize(3, 2, 0, "TestSparseStateInputCost", "/tmp/ocs2", true, false); }
+  ~TestSparseStateInputCost() override = default;
+  TestSparseStateInputCost* clone() const override { return new TestSparseStateInputCost(*this); }
+
+  ocs2::ad_scalar_t costFunction(ocs2::ad_scalar_t time, const ocs2::ad_vector_t& state, const ocs2::ad_vector_t& input,
+                                 const ocs2::ad_vector_t& parameters) const override {
+    return time * state(1) * state(1) + state(1) * input(0);
+  }
+
+ private:
+  TestSparseStateInputCost(const TestSparseStateInputCost& other) = default;
+};
+
+TEST(TestStateInputCostCppAd, detectsSparsity) {
+  TestSparseStateInputCost cost;
+  std::unique_ptr<TestSparseStateInputCost> clonedCost(cost.clone());
+
+  for (const auto* c : {&cost, clonedCost.get()}) {
+    const auto& sparsity = c->getSparsity();
+    ASSERT_FALSE(sparsity.isDense());
+    ASSERT_EQ(sparsity.getStateRanges().size(), 1);
+    EXPECT_EQ(sparsity.getStateRanges()[0].start, 1);
+    EXPECT_EQ(sparsity.getStateRanges()[0].size, 1);
+    ASSERT_EQ(sparsity.getInputRanges().size(), 1);
+    EXPECT_EQ(sparsity.getInputRanges()[0].start, 0);
+    EXPECT_EQ(sparsity.getInputRanges()[0].size, 1);
+  }
+
+  // Adding only the nonzero blocks gives the same result as adding the full approximation
+  const ocs2::TargetTrajectories desiredTrajectory;
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::vector_t x = ocs2::vector_t::Random(3);
+  const ocs2::vector_t u = ocs2::vector_t::Random(2);
+  const auto approx = cost.getQuadraticApproximation(t, x, u, desiredTrajectory, ocs2::PreComputation());
+  auto sparseSum = ocs2::ScalarFunctionQuadraticApproximation::Zero(3, 2);
+  ocs2::addSparse(approx, cost.getSparsity(), sparseSum);
+  auto denseSum = ocs2::ScalarFunctionQuadraticApproximation::Zero(3, 2);
+  denseSum += approx;
+  EXPECT_DOUBLE_EQ(sparseSum.f, denseSum.f);
+  EXPECT_TRUE(sparseSum.dfdx.isApprox(denseSum.dfdx));
+  EXPECT_TRUE(sparseSum.dfdu.isApprox(denseSum.dfdu));
+  EXPECT_TRUE(sparseSum.dfdxx.isApprox(denseSum.dfdxx));
+  EXPECT_TRUE(sparseSum.dfdux.isApprox(denseSum.dfdux));
+  EXPECT_TRUE(sparseSum.dfduu.isApprox(denseSum.dfduu));
+}
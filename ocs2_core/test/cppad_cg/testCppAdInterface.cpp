@@ -2,6 +2,14 @@
 
 #include <gtest/gtest.h>
 
+#include <dlfcn.h>
+#include <cstdlib>
+
+#include <boost/filesystem.hpp>
+
+#include <ocs2_core/automatic_differentiation/CppAdCompilePool.h>
+#include <ocs2_core/automatic_differentiation/CppAdModelBundle.h>
+
 #include "commonFixture.h"
 
 using namespace ocs2;
@@ -60,3 +68,138 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST_F(CppAdInterfaceParameterizedFixture, evaluateIntoOutputs) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelEvaluateIntoOutputs");
+
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  vector_t value;
+  matrix_t jacobian;
+  matrix_t hessian;
+  ocs2::ScalarFunctionQuadraticApproximation gnApproximation;
+
+  // Repeated evaluations into the same outputs
+  for (int i = 0; i < 3; i++) {
+    vector_t x = vector_t::Random(variableDim_);
+    vector_t p = vector_t::Random(parameterDim_);
+
+    adInterface.getFunctionValue(x, p, value);
+    ASSERT_TRUE(value.isApprox(testFun(x, p)));
+    adInterface.getJacobian(x, p, jacobian);
+    ASSERT_TRUE(jacobian.isApprox(testJacobian(x, p)));
+    adInterface.getHessian(0, x, p, hessian);
+    ASSERT_TRUE(hessian.isApprox(testHessian(0, x, p)));
+    adInterface.getHessian(1, x, p, hessian);
+    ASSERT_TRUE(hessian.isApprox(testHessian(1, x, p)));
+
+    adInterface.getGaussNewtonApproximation(x, p, gnApproximation);
+    ASSERT_DOUBLE_EQ(gnApproximation.f, 0.5 * testFun(x, p).squaredNorm());
+    ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
+    ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
+  }
+}
+
+TEST_F(CppAdInterfaceNoParameterFixture, libraryMatchesModel) {
+  // A library of another model with the same name must not be loaded
+  auto scaledFun = [](const ad_vector_t& x, ad_vector_t& y) {
+    funImpl(x, y);
+    y(0) *= 3.0;
+  };
+  ocs2::CppAdInterface scaledInterface(scaledFun, variableDim_, "testModelLibraryMatchesModel");
+  scaledInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, "testModelLibraryMatchesModel");
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+
+  const vector_t x = vector_t::Random(variableDim_);
+  ASSERT_TRUE(scaledInterface.getFunctionValue(x).isApprox(3.0 * testFun(x)));
+  ASSERT_TRUE(adInterface.getFunctionValue(x).isApprox(testFun(x)));
+  ASSERT_TRUE(adInterface.getHessian(0, x).isApprox(testHessian(x)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, compilePool) {
+  const std::vector<std::string> modelNames{"testModelCompilePool0", "testModelCompilePool1", "testModelCompilePool2"};
+
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> adInterfaces;
+  std::unique_ptr<ocs2::CppAdInterface> adInterfaceCopy;
+  {
+    ocs2::CppAdCompilePool compilePool(2);
+    ASSERT_EQ(ocs2::CppAdCompilePool::getActivePool(), &compilePool);
+    for (const auto& modelName : modelNames) {
+      adInterfaces.emplace_back(new ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, modelName));
+      adInterfaces.back()->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+    }
+    // Copy before the library is loaded
+    adInterfaceCopy.reset(new ocs2::CppAdInterface(*adInterfaces.front()));
+    // Destroyed before the library is loaded
+    ocs2::CppAdInterface temporary(funImpl, variableDim_, parameterDim_, "testModelCompilePoolTemporary");
+    temporary.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+
+    compilePool.wait();
+  }
+  ASSERT_EQ(ocs2::CppAdCompilePool::getActivePool(), nullptr);
+  adInterfaces.push_back(std::move(adInterfaceCopy));
+
+  for (const auto& adInterface : adInterfaces) {
+    vector_t x = vector_t::Random(variableDim_);
+    vector_t p = vector_t::Random(parameterDim_);
+    ASSERT_TRUE(adInterface->getFunctionValue(x, p).isApprox(testFun(x, p)));
+    ASSERT_TRUE(adInterface->getJacobian(x, p).isApprox(testJacobian(x, p)));
+    ASSERT_TRUE(adInterface->getHessian(1, x, p).isApprox(testHessian(1, x, p)));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, modelBundle) {
+  const std::string bundleFolder = "/tmp/ocs2/testModelBundle";
+  const std::string libraryFolder = "/tmp/ocs2/testModelBundleLibraries";
+  boost::filesystem::remove_all(bundleFolder);
+  boost::filesystem::remove_all(libraryFolder);
+
+  {
+    ocs2::CppAdModelExporter exporter("testModelBundle");
+    ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelBundle", libraryFolder);
+    adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+    ocs2::CppAdInterface adInterfaceCopy(adInterface);
+    adInterfaceCopy.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+    ASSERT_EQ(exporter.getNumModels(), 1);
+    exporter.write(bundleFolder);
+  }
+  ASSERT_EQ(ocs2::CppAdModelExporter::getActiveExporter(), nullptr);
+
+  // Stands in for linking the bundle into the executable
+  const std::string bundleLibrary = bundleFolder + "/libtestModelBundle.so";
+  const std::string compileCommand = "gcc -shared -fPIC -O1 -o " + bundleLibrary + " " + bundleFolder + "/testModelBundle_models.c";
+  ASSERT_EQ(std::system(compileCommand.c_str()), 0);
+  void* bundleHandle = dlopen(bundleLibrary.c_str(), RTLD_NOW | RTLD_LOCAL);
+  ASSERT_NE(bundleHandle, nullptr);
+  const auto* functions = static_cast<const ocs2::CppAdBundleFunction*>(dlsym(bundleHandle, "testModelBundle_functions"));
+  ASSERT_NE(functions, nullptr);
+  ocs2::registerCppAdBundle(functions);
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelBundle", libraryFolder);
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ocs2::CppAdInterface adInterfaceCopy(adInterface);
+
+  // Nothing is compiled or written to the library folder
+  ASSERT_FALSE(boost::filesystem::exists(libraryFolder));
+
+  for (const auto* bundledInterface : {&adInterface, &adInterfaceCopy}) {
+    vector_t x = vector_t::Random(variableDim_);
+    vector_t p = vector_t::Random(parameterDim_);
+    ASSERT_TRUE(bundledInterface->getFunctionValue(x, p).isApprox(testFun(x, p)));
+    ASSERT_TRUE(bundledInterface->getJacobian(x, p).isApprox(testJacobian(x, p)));
+    ASSERT_TRUE(bundledInterface->getHessian(1, x, p).isApprox(testHessian(1, x, p)));
+  }
+
+  // A different model with the same name is not bound to the bundle
+  auto scaledFun = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    funImpl(x, p, y);
+    y(0) *= 3.0;
+  };
+  ocs2::CppAdInterface scaledInterface(scaledFun, variableDim_, parameterDim_, "testModelBundle", libraryFolder);
+  scaledInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  ASSERT_TRUE(boost::filesystem::exists(libraryFolder));
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(scaledInterface.getFunctionValue(x, p).isApprox(vector_t(testFun(x, p).cwiseProduct(vector_t::LinSpaced(2, 3.0, 1.0)))));
+}
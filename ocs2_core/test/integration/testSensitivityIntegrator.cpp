@@ -81,7 +81,8 @@ TEST(test_sensitivity_integrator, eulerSensitivity) {
 
   const auto eulerForwardDynamics = eulerDiscretization(*system, t, x, u, dt);
   ASSERT_TRUE(eulerForwardDynamics.isApprox(eulerdynamics_check.f));
-  const auto eulerLinearizedDynamics = eulerSensitivityDiscretization(*system, t, x, u, dt);
+  ocs2::VectorFunctionLinearApproximation eulerLinearizedDynamics;
+  eulerSensitivityDiscretization(*system, t, x, u, dt, eulerLinearizedDynamics);
   ASSERT_TRUE(eulerLinearizedDynamics.f.isApprox(eulerdynamics_check.f));
   ASSERT_TRUE(eulerLinearizedDynamics.dfdx.isApprox(eulerdynamics_check.dfdx));
   ASSERT_TRUE(eulerLinearizedDynamics.dfdu.isApprox(eulerdynamics_check.dfdu));
@@ -125,7 +126,8 @@ TEST(test_sensitivity_integrator, rk2Sensitivity) {
 
   const auto rk2ForwardDynamics = rk2Discretization(*system, t, x, u, dt);
   ASSERT_TRUE(rk2ForwardDynamics.isApprox(rk2dynamics_check.f));
-  const auto rk2LinearizedDynamics = rk2SensitivityDiscretization(*system, t, x, u, dt);
+  ocs2::VectorFunctionLinearApproximation rk2LinearizedDynamics;
+  rk2SensitivityDiscretization(*system, t, x, u, dt, rk2LinearizedDynamics);
   ASSERT_TRUE(rk2LinearizedDynamics.f.isApprox(rk2dynamics_check.f));
   ASSERT_TRUE(rk2LinearizedDynamics.dfdx.isApprox(rk2dynamics_check.dfdx));
   ASSERT_TRUE(rk2LinearizedDynamics.dfdu.isApprox(rk2dynamics_check.dfdu));
@@ -178,7 +180,8 @@ TEST(test_sensitivity_integrator, rk4Sensitivity) {
 
   const auto rk4ForwardDynamics = rk4Discretization(*system, t, x, u, dt);
   ASSERT_TRUE(rk4ForwardDynamics.isApprox(rk4dynamics_check.f));
-  const auto rk4LinearizedDynamics = rk4SensitivityDiscretization(*system, t, x, u, dt);
+  ocs2::VectorFunctionLinearApproximation rk4LinearizedDynamics;
+  rk4SensitivityDiscretization(*system, t, x, u, dt, rk4LinearizedDynamics);
   ASSERT_TRUE(rk4LinearizedDynamics.f.isApprox(rk4dynamics_check.f));
   ASSERT_TRUE(rk4LinearizedDynamics.dfdx.isApprox(rk4dynamics_check.dfdx));
   ASSERT_TRUE(rk4LinearizedDynamics.dfdu.isApprox(rk4dynamics_check.dfdu));
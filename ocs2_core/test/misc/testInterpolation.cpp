@@ -132,3 +132,56 @@ TEST(testLinearInterpolation, testDifferentEigenSizes) {
   result = ocs2::LinearInterpolation::interpolate(1.1, times, data);
   EXPECT_TRUE(result.isApprox(data[1]));
 }
+
+TEST(testLinearInterpolation, testCursorTimeSegment) {
+  // time array with an event time and a short interval
+  constexpr auto eps = ocs2::numeric_traits::weakEpsilon<ocs2::scalar_t>();
+  std::vector<double> t = {0.0, 0.1, 0.2, 0.2, 0.3, 0.3 + eps, 0.4, 0.5};
+
+  auto checkSameSegment = [&](double time, int& cursor) {
+    const auto expected = ocs2::LinearInterpolation::timeSegment(time, t);
+    const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(time, t, cursor);
+    EXPECT_EQ(indexAlpha.first, expected.first) << "time: " << time;
+    EXPECT_DOUBLE_EQ(indexAlpha.second, expected.second) << "time: " << time;
+  };
+
+  // forward queries including the knots
+  int cursor = 0;
+  for (double time = -0.1; time < 0.6; time += 0.005) {
+    checkSameSegment(time, cursor);
+  }
+  for (const auto time : t) {
+    checkSameSegment(time, cursor);
+  }
+
+  // backward queries including the knots
+  for (double time = 0.6; time > -0.1; time -= 0.005) {
+    checkSameSegment(time, cursor);
+  }
+  for (auto it = t.rbegin(); it != t.rend(); ++it) {
+    checkSameSegment(*it, cursor);
+  }
+
+  // random queries
+  for (int i = 0; i < 100; i++) {
+    checkSameSegment(0.35 * (Eigen::Vector2d::Random()(0) + 1.0) - 0.05, cursor);
+  }
+
+  // the cursor of a different time array
+  cursor = 1000;
+  checkSameSegment(0.25, cursor);
+  cursor = -1000;
+  checkSameSegment(0.25, cursor);
+}
+
+TEST(testLinearInterpolation, testInPlaceInterpolation) {
+  const std::vector<double> t = {0.0, 1.0, 1.0, 2.0};
+  const ocs2::vector_array_t v = {ocs2::vector_t::Zero(2), ocs2::vector_t::Ones(2), ocs2::vector_t::Ones(3), 2.0 * ocs2::vector_t::Ones(3)};
+
+  ocs2::vector_t result;
+  for (const double time : {-1.0, 0.0, 0.3, 1.0, 1.5, 2.0, 3.0}) {
+    const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(time, t);
+    ocs2::LinearInterpolation::interpolate(indexAlpha, v, result);
+    EXPECT_TRUE(result.isApprox(ocs2::LinearInterpolation::interpolate(indexAlpha, v))) << "time: " << time;
+  }
+}
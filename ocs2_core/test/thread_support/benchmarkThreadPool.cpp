@@ -0,0 +1,85 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+/** Compares the dispatch latency of runParallel against dispatching the same tasks through the task queue. */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+using namespace ocs2;
+
+int main() {
+  constexpr size_t nThreads = 3;
+  constexpr int numSamples = 10000;
+  ThreadPool pool(nThreads);
+  std::atomic_int counter;
+  counter = 0;
+  auto task = [&](int) { counter++; };
+
+  // Dispatch through the task queue with one future per helper, as runParallel did before.
+  auto queuedRunParallel = [&](int N) {
+    std::vector<std::future<void>> futures;
+    futures.reserve(N - 1);
+    for (int i = 0; i < N - 1; ++i) {
+      futures.emplace_back(pool.run(std::function<void(int)>(task)));
+    }
+    task(nThreads);
+    for (auto&& fut : futures) {
+      fut.get();
+    }
+  };
+
+  auto measure = [&](const std::string& name, const std::function<void()>& dispatch) {
+    std::vector<double> latencies;
+    latencies.reserve(numSamples);
+    for (int i = 0; i < numSamples; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      dispatch();
+      const auto end = std::chrono::steady_clock::now();
+      latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    std::cout << "[ThreadPool] " << name << " dispatch latency [us] p50: " << percentile(0.5) << ", p90: " << percentile(0.9)
+              << ", p99: " << percentile(0.99) << ", max: " << latencies.back() << "\n";
+  };
+
+  measure("task queue ", [&] { queuedRunParallel(nThreads + 1); });
+  measure("runParallel", [&] { pool.runParallel(task, nThreads + 1); });
+
+  return counter == 2 * numSamples * (nThreads + 1) ? 0 : 1;
+}
@@ -1,4 +1,13 @@
 #include <gtest/gtest.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 using namespace ocs2;
@@ -85,6 +94,17 @@ TEST(testThreadPool, testRunMultiple) {
   EXPECT_EQ(counter, 42);
 }
 
+TEST(testThreadPool, testRunParallelAtLeastOnce) {
+  // e.g. runParallel(task, pool.numThreads()) with an empty pool
+  ThreadPool pool(0);
+  std::atomic_int counter;
+  counter = 0;
+
+  pool.runParallel([&](int) { counter++; }, 0);
+
+  EXPECT_EQ(counter, 1);
+}
+
 TEST(testThreadPool, testNoThreads) {
   ThreadPool pool(0);
 
@@ -121,3 +141,102 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testRunParallelPropagateException) {
+  ThreadPool pool(2);
+  std::atomic_int counter;
+  counter = 0;
+
+  auto task = [&](int) {
+    if (counter++ == 5) {
+      throw std::runtime_error("exception");
+    }
+  };
+  EXPECT_THROW(pool.runParallel(task, 10), std::runtime_error);
+  EXPECT_EQ(counter, 10);
+
+  // pool is still usable
+  counter = 0;
+  pool.runParallel([&](int) { counter++; }, 10);
+  EXPECT_EQ(counter, 10);
+}
+
+TEST(testThreadPool, testRunParallelWorkerIndex) {
+  constexpr size_t nThreads = 3;
+  ThreadPool pool(nThreads);
+  std::vector<std::atomic_int> busy(nThreads + 1);
+  std::atomic_bool overlap{false};
+
+  for (int iter = 0; iter < 1000; iter++) {
+    pool.runParallel(
+        [&](int workerIndex) {
+          ASSERT_GE(workerIndex, 0);
+          ASSERT_LE(workerIndex, nThreads);
+          if (busy[workerIndex]++ != 0) {
+            overlap = true;
+          }
+          busy[workerIndex]--;
+        },
+        nThreads + 1);
+  }
+
+  EXPECT_FALSE(overlap);
+}
+
+TEST(testThreadPool, testPinnedWorkers) {
+  constexpr size_t nThreads = 3;
+  constexpr int firstCpu = 1;
+
+  // the k-th core available to this thread
+  cpu_set_t availableCpus;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set_t), &availableCpus), 0);
+  std::vector<int> availableCores;
+  for (int core = 0; core < CPU_SETSIZE; core++) {
+    if (CPU_ISSET(core, &availableCpus)) {
+      availableCores.push_back(core);
+    }
+  }
+  ASSERT_FALSE(availableCores.empty());
+
+  ThreadPool pool(nThreads, 0, firstCpu);
+  std::vector<cpu_set_t> workerCpus(nThreads + 1);
+  std::vector<std::atomic_bool> hasRun(nThreads + 1);
+
+  // repeat until every worker participated, the tasks sleep to give all workers the chance to join
+  auto allWorkersHaveRun = [&] {
+    return std::all_of(hasRun.begin(), hasRun.begin() + nThreads, [](const std::atomic_bool& b) { return b.load(); });
+  };
+  for (int iter = 0; iter < 100 && !allWorkersHaveRun(); iter++) {
+    pool.runParallel(
+        [&](int workerIndex) {
+          if (!hasRun[workerIndex]) {
+            ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &workerCpus[workerIndex]), 0);
+            hasRun[workerIndex] = true;
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        },
+        nThreads + 1);
+  }
+
+  for (size_t i = 0; i < nThreads; i++) {
+    ASSERT_TRUE(hasRun[i]) << "worker " << i;
+    const int expectedCore = availableCores[(firstCpu + i) % availableCores.size()];
+    EXPECT_EQ(CPU_COUNT(&workerCpus[i]), 1) << "worker " << i;
+    EXPECT_TRUE(CPU_ISSET(expectedCore, &workerCpus[i])) << "worker " << i;
+  }
+
+  // the calling thread is not pinned
+  if (hasRun[nThreads]) {
+    EXPECT_TRUE(CPU_EQUAL(&workerCpus[nThreads], &availableCpus));
+  }
+}
+
+TEST(testThreadPool, testNestedRunParallel) {
+  ThreadPool pool(2);
+  std::atomic_int counter;
+  counter = 0;
+
+  pool.runParallel([&](int) { pool.runParallel([&](int) { counter++; }, 3); }, 4);
+
+  EXPECT_EQ(counter, 12);
+}
@@ -196,6 +196,20 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   vector_t computeFlowMap(scalar_t z, const vector_t& allSs) override;
 
  private:
+  /**
+   * Interpolates all the fields of the projected model data and the Riccati modification that the flow map uses in a single pass.
+   * The results are written into the preallocated buffers of creCache. The cost terms are written into the time derivatives, since
+   * they are their first terms.
+   *
+   * @param [in] indexAlpha: The index and interpolation coefficient (alpha) pair.
+   * @param [out] creCache: The continuous-time Riccati equation cache date.
+   * @param [out] dSm: The state second derivative of the cost.
+   * @param [out] dSv: The state derivative of the cost.
+   * @param [out] ds: The cost.
+   */
+  void interpolateData(std::pair<int, scalar_t> indexAlpha, ContinuousTimeRiccatiData& creCache, matrix_t& dSm, vector_t& dSv,
+                       scalar_t& ds) const;
+
   /**
    * Computes the Riccati equations for SLQ problem.
    *
@@ -237,6 +251,7 @@ class ContinuousTimeRiccatiEquations final : public OdeBase {
   const std::vector<ModelData>* modelDataEventTimesPtr_ = nullptr;
   const std::vector<riccati_modification::Data>* riccatiModificationPtr_ = nullptr;
   scalar_array_t eventTimes_;
+  int timeSegmentCursor_ = 0;
 
   ContinuousTimeRiccatiData continuousTimeRiccatiData_;
 };
@@ -142,7 +142,7 @@ void ILQR::discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vec
 
   // linearize system dynamics
   modelData.dynamicsBias.setZero(modelData.stateDim);
-  modelData.dynamics = sensitivityDiscretizer_(system, time, state, input, timeStep);
+  sensitivityDiscretizer_(system, time, state, input, timeStep, modelData.dynamics);
   modelData.dynamics.f.setZero(modelData.stateDim);
 
   // quadratic approximation to the cost function
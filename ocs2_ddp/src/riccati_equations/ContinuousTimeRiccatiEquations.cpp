@@ -27,15 +27,42 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  ******************************************************************************/
 
+#include <tuple>
+
 #include <ocs2_core/misc/Lookup.h>
-#include <ocs2_core/model_data/ModelDataLinearInterpolation.h>
 
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
-#include <ocs2_ddp/riccati_equations/RiccatiModificationInterpolation.h>
 #include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
 namespace ocs2 {
 
+namespace {
+
+/** The two data points of a time segment and the interpolation coefficient. A single data point is a constant function. */
+template <typename Data, class Alloc>
+std::tuple<const Data&, const Data&, scalar_t> getSegmentData(LinearInterpolation::index_alpha_t indexAlpha,
+                                                             const std::vector<Data, Alloc>& dataArray) {
+  assert(!dataArray.empty());
+  if (dataArray.size() > 1) {
+    return std::tuple<const Data&, const Data&, scalar_t>(dataArray[indexAlpha.first], dataArray[indexAlpha.first + 1], indexAlpha.second);
+  } else {
+    return std::tuple<const Data&, const Data&, scalar_t>(dataArray[0], dataArray[0], 1.0);
+  }
+}
+
+/** Interpolates between the same field of two consecutive data points into a preallocated result. */
+template <typename Field>
+void interpolateField(scalar_t alpha, const Field& lhs, const Field& rhs, Field& result) {
+  if (lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols()) {
+    result = alpha * lhs + (1.0 - alpha) * rhs;
+  } else {
+    // snap to the closest data point, as LinearInterpolation::interpolate
+    result = (alpha > 0.5) ? lhs : rhs;
+  }
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -127,6 +154,9 @@ void ContinuousTimeRiccatiEquations::setData(const scalar_array_t* timeStampPtr,
   for (const auto& postEventIndex : *eventsPastTheEndIndecesPtr) {
     eventTimes_.push_back((*timeStampPtr)[postEventIndex - 1]);
   }
+
+  // the backward sweep starts at the end of the time stamps
+  timeSegmentCursor_ = static_cast<int>(timeStampPtr->size()) - 1;
 }
 
 /******************************************************************************************************/
@@ -152,7 +182,7 @@ vector_t ContinuousTimeRiccatiEquations::computeJumpMap(scalar_t z, const vector
 vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector_t& allSs) {
   // index
   const scalar_t t = -z;  // denormalized time
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_);
+  const auto indexAlpha = LinearInterpolation::timeSegment(t, *timeStampPtr_, timeSegmentCursor_);
 
   convert2Matrix(allSs, continuousTimeRiccatiData_.Sm_, continuousTimeRiccatiData_.Sv_, continuousTimeRiccatiData_.s_);
   if (isRiskSensitive_) {
@@ -171,37 +201,63 @@ vector_t ContinuousTimeRiccatiEquations::computeFlowMap(scalar_t z, const vector
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t> indexAlpha, const matrix_t& Sm, const vector_t& Sv,
-                                                       const scalar_t& s, ContinuousTimeRiccatiData& creCache, matrix_t& dSm, vector_t& dSv,
-                                                       scalar_t& ds) const {
-  /* note: according to some discussions on stackoverflow, it does not buy
-   * computation time if multiplications with symmetric matrices are executed
-   * using selfadjointView(). Doing the full multiplication seems to be faster
-   * because of vectorization
-   */
-
+void ContinuousTimeRiccatiEquations::interpolateData(std::pair<int, scalar_t> indexAlpha, ContinuousTimeRiccatiData& creCache,
+                                                     matrix_t& dSm, vector_t& dSv, scalar_t& ds) const {
+  const auto modelData = getSegmentData(indexAlpha, *projectedModelDataPtr_);
+  const auto& lhs = std::get<0>(modelData);
+  const auto& rhs = std::get<1>(modelData);
+  scalar_t alpha = std::get<2>(modelData);
   // Hv
-  creCache.projectedHv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsBias);
+  interpolateField(alpha, lhs.dynamicsBias, rhs.dynamicsBias, creCache.projectedHv_);
   // Am
-  creCache.projectedAm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdx);
+  interpolateField(alpha, lhs.dynamics.dfdx, rhs.dynamics.dfdx, creCache.projectedAm_);
   // Bm
-  creCache.projectedBm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamics_dfdu);
+  interpolateField(alpha, lhs.dynamics.dfdu, rhs.dynamics.dfdu, creCache.projectedBm_);
   // q
-  ds = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_f);
+  ds = alpha * lhs.cost.f + (1.0 - alpha) * rhs.cost.f;
   // Qv
-  dSv = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdx);
+  interpolateField(alpha, lhs.cost.dfdx, rhs.cost.dfdx, dSv);
   // Qm
-  dSm = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdxx);
+  interpolateField(alpha, lhs.cost.dfdxx, rhs.cost.dfdxx, dSm);
   // Rv
-  creCache.projectedGv_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdu);
+  interpolateField(alpha, lhs.cost.dfdu, rhs.cost.dfdu, creCache.projectedGv_);
   // Pm
-  creCache.projectedGm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfdux);
+  interpolateField(alpha, lhs.cost.dfdux, rhs.cost.dfdux, creCache.projectedGm_);
+  // Rm
+  if (!reducedFormRiccati_) {
+    interpolateField(alpha, lhs.cost.dfduu, rhs.cost.dfduu, creCache.projectedRm_);
+  }
+  // Sigma
+  if (isRiskSensitive_) {
+    interpolateField(alpha, lhs.dynamicsCovariance, rhs.dynamicsCovariance, creCache.dynamicsCovariance_);
+  }
+
+  const auto modification = getSegmentData(indexAlpha, *riccatiModificationPtr_);
+  const auto& lhsModification = std::get<0>(modification);
+  const auto& rhsModification = std::get<1>(modification);
+  alpha = std::get<2>(modification);
   // delatQm
-  creCache.deltaQm_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaQm);
+  interpolateField(alpha, lhsModification.deltaQm_, rhsModification.deltaQm_, creCache.deltaQm_);
   // delatGm
-  creCache.projectedKm_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGm);
+  interpolateField(alpha, lhsModification.deltaGm_, rhsModification.deltaGm_, creCache.projectedKm_);
   // delatGv
-  creCache.projectedLv_ = LinearInterpolation::interpolate(indexAlpha, *riccatiModificationPtr_, riccati_modification::deltaGv);
+  interpolateField(alpha, lhsModification.deltaGv_, rhsModification.deltaGv_, creCache.projectedLv_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t> indexAlpha, const matrix_t& Sm, const vector_t& Sv,
+                                                       const scalar_t& s, ContinuousTimeRiccatiData& creCache, matrix_t& dSm, vector_t& dSv,
+                                                       scalar_t& ds) const {
+  /* note: according to some discussions on stackoverflow, it does not buy
+   * computation time if multiplications with symmetric matrices are executed
+   * using selfadjointView(). Doing the full multiplication seems to be faster
+   * because of vectorization
+   */
+
+  // Hv, Am, Bm, q, Qv, Qm, Rv, Pm, Rm, deltaQm, deltaGm, and deltaGv
+  interpolateData(indexAlpha, creCache, dSm, dSv, ds);
 
   // projectedGm = projectedPm + projectedBm^T * Sm [COMPLEXITY: nx^2 * np]
   creCache.projectedGm_.noalias() += creCache.projectedBm_.transpose() * Sm;
@@ -219,8 +275,6 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
   creCache.SmTrans_projectedAm_.noalias() = Sm.transpose() * creCache.projectedAm_;
   creCache.projectedKm_T_projectedGm_.noalias() = creCache.projectedKm_.transpose() * creCache.projectedGm_;
   if (!reducedFormRiccati_) {
-    // Rm
-    creCache.projectedRm_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::cost_dfduu);
     // [COMPLEXITY: nx * np^2]
     creCache.projectedRm_projectedKm_.noalias() = creCache.projectedRm_ * creCache.projectedKm_;
     // [COMPLEXITY: np^2]
@@ -297,11 +351,9 @@ void ContinuousTimeRiccatiEquations::computeFlowMapSLQ(std::pair<int, scalar_t>
 void ContinuousTimeRiccatiEquations::computeFlowMapILEG(std::pair<int, scalar_t> indexAlpha, const matrix_t& Sm, const vector_t& Sv,
                                                         const scalar_t& s, ContinuousTimeRiccatiData& creCache, matrix_t& dSm,
                                                         vector_t& dSv, scalar_t& ds) const {
+  // Sigma is interpolated together with the other data
   computeFlowMapSLQ(indexAlpha, Sm, Sv, s, creCache, dSm, dSv, ds);
 
-  // Sigma
-  creCache.dynamicsCovariance_ = LinearInterpolation::interpolate(indexAlpha, *projectedModelDataPtr_, model_data::dynamicsCovariance);
-
   creCache.Sigma_Sv_.noalias() = creCache.dynamicsCovariance_ * Sv;
   creCache.Sigma_Sm_.noalias() = creCache.dynamicsCovariance_ * Sm;
 
@@ -44,8 +44,9 @@ struct Settings {
   scalar_t costTol = 1e-4;   // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
   // Linesearch - step size rules
-  scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
-  scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  scalar_t alpha_decay = 0.5;               // multiply the step size by this factor every time a linesearch step is rejected.
+  scalar_t alpha_min = 1e-4;                // terminate linesearch if the attempted step size is below this threshold
+  size_t linesearchCandidatesPerSweep = 1;  // number of step sizes evaluated speculatively in one parallel sweep, 1 for one at a time
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
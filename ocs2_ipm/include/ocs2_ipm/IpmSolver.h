@@ -136,10 +136,15 @@ class IpmSolver : public SolverBase {
                                             const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
                                             const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                      const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics);
+  /**
+   * Computes only the performance metrics of a batch of candidate trajectories {t, x_c(t), u_c(t), slackStateIneq_c(t),
+   * slackStateInputIneq_c(t)}. The nodes of all candidates are evaluated in a single parallel sweep.
+   */
+  std::vector<PerformanceIndex> computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                                   const std::vector<vector_array_t>& x, const std::vector<vector_array_t>& u,
+                                                   scalar_t barrierParam, const std::vector<vector_array_t>& slackStateIneq,
+                                                   const std::vector<vector_array_t>& slackStateInputIneq,
+                                                   std::vector<std::vector<Metrics>>& metrics);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -230,6 +235,8 @@ class IpmSolver : public SolverBase {
 
   // Benchmarking
   size_t totalNumIterations_{0};
+  size_t numLinesearchSweeps_{0};
+  size_t numLinesearchCandidates_{0};
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
@@ -112,6 +112,8 @@ void IpmSolver::reset() {
   solveQpTimer_.reset();
   linesearchTimer_.reset();
   computeControllerTimer_.reset();
+  numLinesearchSweeps_ = 0;
+  numLinesearchCandidates_ = 0;
 }
 
 std::string IpmSolver::getBenchmarkingInformation() const {
@@ -138,6 +140,9 @@ std::string IpmSolver::getBenchmarkingInformation() const {
                << solveQpTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tLinesearch         :\t" << linesearchTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
+    infoStream << "\t  Sweeps           :\t" << static_cast<scalar_t>(numLinesearchSweeps_) / std::max<size_t>(totalNumIterations_, 1)
+               << " per iteration, " << static_cast<scalar_t>(numLinesearchCandidates_) / std::max<size_t>(numLinesearchSweeps_, 1)
+               << " step sizes per sweep\n";
     infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
   }
@@ -723,57 +728,67 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
   return totalPerformance;
 }
 
-PerformanceIndex IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                               const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+std::vector<PerformanceIndex> IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                                            const std::vector<vector_array_t>& x, const std::vector<vector_array_t>& u,
+                                                            scalar_t barrierParam, const std::vector<vector_array_t>& slackStateIneq,
+                                                            const std::vector<vector_array_t>& slackStateInputIneq,
+                                                            std::vector<std::vector<Metrics>>& metrics) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numCandidates = static_cast<int>(x.size());
+  metrics.resize(numCandidates);
+  for (auto& candidateMetrics : metrics) {
+    candidateMetrics.resize(N + 1);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  // The nodes of all candidates are distributed over the workers: task j evaluates node (j % (N + 1)) of candidate (j / (N + 1))
+  std::vector<std::vector<PerformanceIndex>> performance(numCandidates, std::vector<PerformanceIndex>(settings_.nThreads));
+  std::atomic_int taskIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    int j;
+    while ((j = taskIndex++) < numCandidates * (N + 1)) {
+      const int c = j / (N + 1);
+      const int i = j % (N + 1);
+      if (i == N) {
+        const scalar_t tN = getIntervalStart(time[N]);
+        metrics[c][N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[c][N]);
+        performance[c][workerId] += ipm::toPerformanceIndex(metrics[c][N], barrierParam, slackStateIneq[c][N]);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
+        metrics[c][i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[c][i], x[c][i + 1]);
+        performance[c][workerId] += ipm::toPerformanceIndex(metrics[c][i], barrierParam, slackStateIneq[c][i]);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        const bool enableStateInequalityConstraints = (i > 0);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        metrics[c][i] =
+            multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[c][i], x[c][i + 1], u[c][i]);
         // Disable the state-only inequality constraints at the initial node
         if (i == 0) {
-          metrics[i].stateIneqConstraint.clear();
+          metrics[c][i].stateIneqConstraint.clear();
         }
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
+        performance[c][workerId] +=
+            ipm::toPerformanceIndex(metrics[c][i], dt, barrierParam, slackStateIneq[c][i], slackStateInputIneq[c][i]);
       }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += ipm::toPerformanceIndex(metrics[N], barrierParam, slackStateIneq[N]);
     }
   };
   runParallel(std::move(parallelTask));
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
-
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
+  std::vector<PerformanceIndex> totalPerformance(numCandidates);
+  for (int c = 0; c < numCandidates; c++) {
+    // Account for initial state in performance
+    const vector_t initDynamicsViolation = initState - x[c].front();
+    metrics[c].front().dynamicsViolation += initDynamicsViolation;
+    performance[c].front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+
+    // Sum performance of the threads
+    auto& total = totalPerformance[c];
+    total = std::accumulate(std::next(performance[c].begin()), performance[c].end(), performance[c].front());
+    total.merit = total.cost + total.equalityLagrangian + total.inequalityLagrangian;
+  }
   return totalPerformance;
 }
 
@@ -805,66 +820,98 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
 
+  // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
+  auto isStepTooSmall = [&](scalar_t alpha) { return alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol; };
+
+  const size_t numCandidatesPerSweep = std::max<size_t>(settings_.linesearchCandidatesPerSweep, 1);
   scalar_t alpha = subproblemSolution.maxPrimalStepSize;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  vector_array_t slackStateIneqNew(slackStateIneq.size());
-  vector_array_t slackStateInputIneqNew(slackStateInputIneq.size());
-  std::vector<Metrics> metricsNew(metrics.size());
-  do {
-    // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
-    multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, alpha, slackStateIneqNew);
-    multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, alpha, slackStateInputIneqNew);
+  bool keepSearching = true;
+  std::vector<scalar_t> alphas;
+  std::vector<vector_array_t> xNew;
+  std::vector<vector_array_t> uNew;
+  std::vector<vector_array_t> slackStateIneqNew;
+  std::vector<vector_array_t> slackStateInputIneqNew;
+  std::vector<std::vector<Metrics>> metricsNew;
+  while (keepSearching) {
+    // Speculatively evaluate the next step sizes of the back-tracking sequence in one sweep
+    alphas.assign(1, alpha);
+    while (alphas.size() < numCandidatesPerSweep) {
+      const scalar_t nextAlpha = alphas.back() * settings_.alpha_decay;
+      if (nextAlpha < settings_.alpha_min || isStepTooSmall(nextAlpha)) {
+        break;
+      }
+      alphas.push_back(nextAlpha);
+    }
+
+    // Compute steps
+    xNew.resize(alphas.size(), vector_array_t(x.size()));
+    uNew.resize(alphas.size(), vector_array_t(u.size()));
+    slackStateIneqNew.resize(alphas.size(), vector_array_t(slackStateIneq.size()));
+    slackStateInputIneqNew.resize(alphas.size(), vector_array_t(slackStateInputIneq.size()));
+    for (size_t c = 0; c < alphas.size(); c++) {
+      multiple_shooting::incrementTrajectory(u, du, alphas[c], uNew[c]);
+      multiple_shooting::incrementTrajectory(x, dx, alphas[c], xNew[c]);
+      multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, alphas[c], slackStateIneqNew[c]);
+      multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, alphas[c], slackStateInputIneqNew[c]);
+    }
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew =
+    const auto performanceNew =
         computePerformance(timeDiscretization, initState, xNew, uNew, barrierParam, slackStateIneqNew, slackStateInputIneqNew, metricsNew);
+    ++numLinesearchSweeps_;
+    numLinesearchCandidates_ += alphas.size();
+
+    // Apply the acceptance logic in the order of the back-tracking sequence
+    for (size_t c = 0; c < alphas.size(); c++) {
+      alpha = alphas[c];
+
+      // Step acceptance and record step type
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, performanceNew[c], alpha * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
+        std::cerr << performanceNew[c] << "\n";
+      }
 
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
+      if (stepAccepted) {  // Return if step accepted
+        x = std::move(xNew[c]);
+        u = std::move(uNew[c]);
+        slackStateIneq = std::move(slackStateIneqNew[c]);
+        slackStateInputIneq = std::move(slackStateInputIneqNew[c]);
+        metrics = std::move(metricsNew[c]);
+
+        // Prepare step info
+        ipm::StepInfo stepInfo;
+        stepInfo.primalStepSize = alpha;
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = alpha * deltaXnorm;
+        stepInfo.du_norm = alpha * deltaUnorm;
+        stepInfo.performanceAfterStep = performanceNew[c];
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew[c]);
+        return stepInfo;
+      }
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      slackStateIneq = std::move(slackStateIneqNew);
-      slackStateInputIneq = std::move(slackStateInputIneqNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      ipm::StepInfo stepInfo;
-      stepInfo.primalStepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
+      // Try smaller step
       alpha *= settings_.alpha_decay;
-
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
+      if (isStepTooSmall(alpha)) {
         if (settings_.printLinesearch) {
           std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
                     << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
         }
+        keepSearching = false;
+        break;
+      }
+      if (alpha < settings_.alpha_min) {
+        keepSearching = false;
         break;
       }
     }
-  } while (alpha >= settings_.alpha_min);
+  }
 
   // Alpha_min reached -> Don't take a step
   ipm::StepInfo stepInfo;
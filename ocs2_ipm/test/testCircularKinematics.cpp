@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/constraint/LinearStateConstraint.h>
 #include <ocs2_core/constraint/LinearStateInputConstraint.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/initialization/OperatingPoints.h>
 #include <ocs2_oc/test/circular_kinematics.h>
 
 using namespace ocs2;
@@ -343,4 +344,94 @@ TEST(test_circular_kinematics, solve_projected_EqConstraints_MixedIneqConstraint
   for (const auto e : shiftTime) {
     solver.run(startTime + e, initState, finalTime + e);
   }
-}
\ No newline at end of file
+}
+
+TEST(test_circular_kinematics, solve_speculativeLinesearch) {
+  // optimal control problem
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/ocs2/ipm_test_generated");
+
+  // inequality constraints
+  constexpr size_t numInputIneqConstraint = 4;
+  const vector_t e = (vector_t(numInputIneqConstraint) << 0.5, 0.5, 0.5, 0.5).finished();
+  const matrix_t C = matrix_t::Zero(numInputIneqConstraint, 2);
+  const matrix_t D = (matrix_t(numInputIneqConstraint, 2) << matrix_t::Identity(2, 2), -matrix_t::Identity(2, 2)).finished();
+  problem.inequalityConstraintPtr->add("ubound", std::make_unique<LinearStateInputConstraint>(e, C, D));
+
+  // Solver settings
+  auto settings = []() {
+    ipm::Settings s;
+    s.dt = 0.01;
+    s.ipmIteration = 20;
+    s.useFeedbackPolicy = true;
+    s.printLinesearch = true;
+    s.nThreads = 3;
+    s.initialBarrierParameter = 1.0e-02;
+    s.targetBarrierParameter = 1.0e-04;
+    s.barrierLinearDecreaseFactor = 0.2;
+    s.barrierSuperlinearDecreasePower = 1.5;
+    s.fractionToBoundaryMargin = 0.995;
+    return s;
+  }();
+
+  // Additional problem definitions
+  const scalar_t startTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const vector_t initState = (vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Initial guess far off the circle, such that the linesearch has to back-track
+  const vector_t guessState = (vector_t(2) << -3.0, 4.0).finished();
+  const vector_t guessInput = (vector_t(2) << 0.4, -0.4).finished();
+  OperatingPoints operatingPoints(guessState, guessInput);
+
+  struct Solution {
+    PrimalSolution primalSolution;
+    DualSolution dualSolution;
+    std::vector<PerformanceIndex> iterationsLog;
+  };
+  auto solve = [&](size_t linesearchCandidatesPerSweep) {
+    settings.linesearchCandidatesPerSweep = linesearchCandidatesPerSweep;
+    IpmSolver solver(settings, problem, operatingPoints);
+    solver.run(startTime, initState, finalTime);
+    return Solution{solver.primalSolution(finalTime), *solver.getDualSolution(), solver.getIterationsLog()};
+  };
+
+  // Solve one step size at a time, the bad guess has to lead to at least one rejected step
+  testing::internal::CaptureStderr();
+  const auto sequential = solve(1);
+  const std::string sequentialLinesearchLog = testing::internal::GetCapturedStderr();
+  ASSERT_NE(sequentialLinesearchLog.find("(Rejected)"), std::string::npos);
+
+  auto expectSameMultipliers = [](const std::vector<Multiplier>& expected, const std::vector<Multiplier>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (int i = 0; i < expected.size(); i++) {
+      EXPECT_TRUE(expected[i].lagrangian.isApprox(actual[i].lagrangian));
+    }
+  };
+
+  // The speculative sweeps apply the acceptance logic in the same order, hence accept the same primal and dual steps.
+  for (const size_t linesearchCandidatesPerSweep : {2, 4}) {
+    testing::internal::CaptureStderr();
+    const auto speculative = solve(linesearchCandidatesPerSweep);
+    const std::string speculativeLinesearchLog = testing::internal::GetCapturedStderr();
+    ASSERT_NE(speculativeLinesearchLog.find("(Rejected)"), std::string::npos);
+
+    ASSERT_EQ(sequential.iterationsLog.size(), speculative.iterationsLog.size());
+    for (int i = 0; i < sequential.iterationsLog.size(); i++) {
+      EXPECT_DOUBLE_EQ(sequential.iterationsLog[i].merit, speculative.iterationsLog[i].merit);
+    }
+
+    ASSERT_EQ(sequential.primalSolution.stateTrajectory_.size(), speculative.primalSolution.stateTrajectory_.size());
+    for (int i = 0; i < sequential.primalSolution.stateTrajectory_.size(); i++) {
+      EXPECT_TRUE(sequential.primalSolution.stateTrajectory_[i].isApprox(speculative.primalSolution.stateTrajectory_[i]));
+      EXPECT_TRUE(sequential.primalSolution.inputTrajectory_[i].isApprox(speculative.primalSolution.inputTrajectory_[i]));
+    }
+
+    ASSERT_EQ(sequential.dualSolution.intermediates.size(), speculative.dualSolution.intermediates.size());
+    for (int i = 0; i < sequential.dualSolution.intermediates.size(); i++) {
+      expectSameMultipliers(sequential.dualSolution.intermediates[i].stateIneq, speculative.dualSolution.intermediates[i].stateIneq);
+      expectSameMultipliers(sequential.dualSolution.intermediates[i].stateInputIneq,
+                            speculative.dualSolution.intermediates[i].stateInputIneq);
+    }
+    expectSameMultipliers(sequential.dualSolution.final.stateIneq, speculative.dualSolution.final.stateIneq);
+  }
+}
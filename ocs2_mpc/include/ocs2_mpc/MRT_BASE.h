@@ -31,13 +31,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Eigen/Dense>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <mutex>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
@@ -54,6 +57,10 @@ namespace ocs2 {
 /**
  * This class implements core MRT (Model Reference Tracking) functionality.
  * The responsibility of filling the buffer variables is left to the deriving classes.
+ *
+ * The policy is handed over from the MPC thread to the control thread through a preallocated triple buffer. The MPC thread fills
+ * the free slot in place and publishes it, while the control thread picks up the most recently published slot in updatePolicy()
+ * without locking or allocating memory. Since the slots are reused, the trajectory containers keep their capacity between updates.
  */
 class MRT_BASE {
  public:
@@ -62,7 +69,8 @@ class MRT_BASE {
   virtual ~MRT_BASE() = default;
 
   /**
-   * Resets the class to its instantiated state.
+   * Resets the class to its instantiated state. It can be called from any thread: a policy which has not been picked up yet is
+   * discarded immediately, while the active policy is dropped by the next call to updatePolicy().
    */
   void reset();
 
@@ -125,6 +133,22 @@ class MRT_BASE {
    */
   void evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode);
 
+  /**
+   * @brief Evaluates the controller without locking or allocating memory, for calls from a real-time control loop.
+   *
+   * The time lookups start from the intervals found by the previous call, so that a query with a later time than the previous one
+   * costs amortized O(1). No memory is allocated as long as the outputs are preallocated with the right size. Unlike evaluatePolicy(),
+   * no warning is printed when the query time exceeds the policy horizon. This is supported by LinearController and
+   * FeedforwardController, other controllers fall back to ControllerBase::computeInput().
+   *
+   * @param [in] currentTime: the query time.
+   * @param [in] currentState: the query state.
+   * @param [out] mpcState: the current nominal state of MPC.
+   * @param [out] mpcInput: the optimized control input.
+   * @param [out] mode: the active mode.
+   */
+  void evaluatePolicyRealtime(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode);
+
   /**
    * @brief Rolls out the control policy from the current time and state to get the next state and input using the MPC policy.
    *
@@ -143,10 +167,18 @@ class MRT_BASE {
    * is available on the buffer this method will load it to the in-use policy.
    * This method also calls the modifyActiveSolution() method.
    *
+   * This method is wait-free: it never blocks on the thread which publishes the policies.
+   *
    * @return True if the policy is updated.
    */
   bool updatePolicy();
 
+  /**
+   * Gets the statistics of the time between publishing a policy in the buffer and making it active through updatePolicy().
+   * @warning The timer is updated in updatePolicy(). Read access and calls to updatePolicy() must be synced by the user.
+   */
+  const benchmark::RepeatedTimer& getPolicyLatencyTimer() const { return policyLatencyTimer_; }
+
   /**
    * @brief rolloutSet: Whether or not the internal rollout object has been set
    * @return True if a rollout object is available.
@@ -158,33 +190,71 @@ class MRT_BASE {
    */
   void addMrtObserver(std::shared_ptr<MrtObserver> mrtObserver) { observerPtrArray_.push_back(std::move(mrtObserver)); };
 
-
-  // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
-  std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
-  std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
  protected:
+  /**
+   * Fills the free slot of the policy buffer in place and publishes it. The previous content of the slot is left in the arguments such
+   * that the writer can reuse the allocated memory.
+   *
+   * @param [in] writer: A callable with signature void(CommandData&, PrimalSolution&, PerformanceIndex&). If it throws, nothing is
+   * published.
+   */
+  template <typename Writer>
+  void writeToBuffer(Writer&& writer) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    PolicyBuffer& buffer = policyBuffers_[writeIndex_];
+    writer(buffer.command, buffer.primalSolution, buffer.performanceIndices);
+    publishWriteBuffer();
+  }
+
   void moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
  private:
-  /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** A slot of the policy triple buffer. */
+  struct PolicyBuffer {
+    CommandData command;
+    PrimalSolution primalSolution;
+    PerformanceIndex performanceIndices;
+    std::chrono::steady_clock::time_point publishTime;
+  };
+
+  /** Publishes the slot at writeIndex_ and takes over the previously published slot for the next write. Requires writeMutex_. */
+  void publishWriteBuffer();
+
+  /** Gets the active slot or throws if updatePolicy() has not loaded a policy yet. */
+  const PolicyBuffer& getActiveBuffer(const char* caller) const;
+  PolicyBuffer& getActiveBuffer(const char* caller) {
+    return const_cast<PolicyBuffer&>(static_cast<const MRT_BASE*>(this)->getActiveBuffer(caller));
+  }
+
+  /** Calls modifyActiveSolution on all mrt observers. This function is called in the thread calling updatePolicy() */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
-  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyBufferedSolution on all mrt observers. This function is called in the thread publishing the policy */
   void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer);
 
+  // the slot index is stored in the lower bits of publishedIndex_, the upper bits mark a policy which is not yet active and a reset
+  // which the reader has not seen yet.
+  static constexpr int indexMask_ = 0x3;
+  static constexpr int newPolicyFlag_ = 0x4;
+  static constexpr int resetFlag_ = 0x8;
+
   // flags on state of the class
   std::atomic_bool policyReceivedEver_;
-  bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
+  bool activePolicyAvailable_;  // whether updatePolicy() has loaded a policy into the active slot
+
+  // triple buffer: each slot is owned by either the writer, the reader, or is the latest published one.
+  std::array<PolicyBuffer, 3> policyBuffers_;
+  size_t writeIndex_;                // owned by the thread publishing the policy
+  size_t activeIndex_;               // owned by the thread calling updatePolicy()
+  std::atomic<int> publishedIndex_;  // exchanged between both threads
+  std::mutex writeMutex_;            // serializes the writers and reset()
+
+  // time interval cursors of the active policy used by evaluatePolicyRealtime()
+  int stateCursor_;
+  int controllerCursor_;
 
-  // thread safety
-  mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
-  const size_t mrtTrylockWarningThreshold_ = 5;
-  size_t mrtTrylockWarningCount_;
+  benchmark::RepeatedTimer policyLatencyTimer_;
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
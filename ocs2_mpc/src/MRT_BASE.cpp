@@ -36,59 +36,48 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-MRT_BASE::MRT_BASE() {
-  reset();
-}
+MRT_BASE::MRT_BASE()
+    : policyReceivedEver_(false),
+      activePolicyAvailable_(false),
+      writeIndex_(0),
+      activeIndex_(1),
+      publishedIndex_(2),
+      stateCursor_(0),
+      controllerCursor_(0) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::reset() {
-  std::lock_guard<std::mutex> lock(bufferMutex_);
+  std::lock_guard<std::mutex> lock(writeMutex_);
 
   policyReceivedEver_ = false;
-  newPolicyInBuffer_ = false;
-  mrtTrylockWarningCount_ = 0;
-
-  activeCommandPtr_.reset();
-  bufferCommandPtr_.reset();
-  activePrimalSolutionPtr_.reset();
-  bufferPrimalSolutionPtr_.reset();
-  activePerformanceIndicesPtr_.reset();
-  bufferPerformanceIndicesPtr_.reset();
+
+  // Publish the write slot with the reset flag instead of a new policy. This discards a policy which has not been picked up yet. The
+  // active slot belongs to the reader, which drops its policy in the next updatePolicy().
+  const int published = publishedIndex_.exchange(static_cast<int>(writeIndex_) | resetFlag_, std::memory_order_acq_rel);
+  writeIndex_ = static_cast<size_t>(published & indexMask_);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 const CommandData& MRT_BASE::getCommand() const {
-  if (activeCommandPtr_ != nullptr) {
-    return *activeCommandPtr_;
-  } else {
-    throw std::runtime_error("[MRT_BASE::getCommand] updatePolicy() should be called first!");
-  }
+  return getActiveBuffer("getCommand").command;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PrimalSolution& MRT_BASE::getPolicy() const {
-  if (activePrimalSolutionPtr_ != nullptr) {
-    return *activePrimalSolutionPtr_;
-  } else {
-    throw std::runtime_error("[MRT_BASE::getPolicy] updatePolicy() should be called first!");
-  }
+  return getActiveBuffer("getPolicy").primalSolution;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PerformanceIndex& MRT_BASE::getPerformanceIndices() const {
-  if (activePerformanceIndicesPtr_ != nullptr) {
-    return *activePerformanceIndicesPtr_;
-  } else {
-    throw std::runtime_error("[MRT_BASE::getPerformanceIndices] updatePolicy() should be called first!");
-  }
+  return getActiveBuffer("getPerformanceIndices").performanceIndices;
 }
 
 /******************************************************************************************************/
@@ -102,20 +91,31 @@ void MRT_BASE::initRollout(const RolloutBase* rolloutPtr) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode) {
-  if (activePrimalSolutionPtr_ == nullptr) {
-    throw std::runtime_error("[MRT_BASE::evaluatePolicy] updatePolicy() should be called first!");
-  }
+  const auto& activePrimalSolution = getActiveBuffer("evaluatePolicy").primalSolution;
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolution.timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolution.timeTrajectory_.back()) << "\n";
   }
 
-  mpcInput = activePrimalSolutionPtr_->controllerPtr_->computeInput(currentTime, currentState);
-  mpcState =
-      LinearInterpolation::interpolate(currentTime, activePrimalSolutionPtr_->timeTrajectory_, activePrimalSolutionPtr_->stateTrajectory_);
+  mpcInput = activePrimalSolution.controllerPtr_->computeInput(currentTime, currentState);
+  mpcState = LinearInterpolation::interpolate(currentTime, activePrimalSolution.timeTrajectory_, activePrimalSolution.stateTrajectory_);
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(currentTime);
+  mode = activePrimalSolution.modeSchedule_.modeAtTime(currentTime);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::evaluatePolicyRealtime(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput,
+                                      size_t& mode) {
+  auto& activePrimalSolution = getActiveBuffer("evaluatePolicyRealtime").primalSolution;
+
+  activePrimalSolution.controllerPtr_->computeInputWithCursor(currentTime, currentState, mpcInput, controllerCursor_);
+  const auto indexAlpha = LinearInterpolation::timeSegment(currentTime, activePrimalSolution.timeTrajectory_, stateCursor_);
+  LinearInterpolation::interpolate(indexAlpha, activePrimalSolution.stateTrajectory_, mpcState);
+
+  mode = activePrimalSolution.modeSchedule_.modeAtTime(currentTime);
 }
 
 /******************************************************************************************************/
@@ -127,13 +127,11 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] rollout class is not set! Use initRollout() to initialize it!");
   }
 
-  if (activePrimalSolutionPtr_ == nullptr) {
-    throw std::runtime_error("[MRT_BASE::rolloutPolicy] updatePolicy() should be called first!");
-  }
+  auto& activePrimalSolution = getActiveBuffer("rolloutPolicy").primalSolution;
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolution.timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolution.timeTrajectory_.back()) << "\n";
   }
 
   // perform a rollout
@@ -141,42 +139,42 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
   size_array_t postEventIndicesStock;
   vector_array_t stateTrajectory, inputTrajectory;
   const scalar_t finalTime = currentTime + timeStep;
-  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr_->controllerPtr_.get(),
-                   activePrimalSolutionPtr_->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
+  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolution.controllerPtr_.get(), activePrimalSolution.modeSchedule_,
+                   timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
 
   mpcState = stateTrajectory.back();
   mpcInput = inputTrajectory.back();
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime);
+  mode = activePrimalSolution.modeSchedule_.modeAtTime(finalTime);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MRT_BASE::updatePolicy() {
-  std::unique_lock<std::mutex> lock(bufferMutex_, std::try_to_lock);
-  if (lock.owns_lock()) {
-    mrtTrylockWarningCount_ = 0;
-    if (newPolicyInBuffer_) {
-      // update the active solution from buffer
-      activeCommandPtr_.swap(bufferCommandPtr_);
-      activePrimalSolutionPtr_.swap(bufferPrimalSolutionPtr_);
-      activePerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
-      newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
-
-      modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
-      return true;
-    } else {
-      return false;  // No policy update: the buffer contains nothing new.
-    }
-  } else {
-    ++mrtTrylockWarningCount_;
-    if (mrtTrylockWarningCount_ > mrtTrylockWarningThreshold_) {
-      std::cerr << "[MRT_BASE::updatePolicy] failed to lock the policyBufferMutex for " << mrtTrylockWarningCount_
-                << " consecutive times.\n";
-    }
-    return false;  // No policy update: the lock could not be acquired.
+  if ((publishedIndex_.load(std::memory_order_acquire) & (newPolicyFlag_ | resetFlag_)) == 0) {
+    return false;  // No policy update: the buffer contains nothing new.
+  }
+
+  // hand the previously active slot back and take over the latest published one
+  const int published = publishedIndex_.exchange(static_cast<int>(activeIndex_), std::memory_order_acq_rel);
+  activeIndex_ = static_cast<size_t>(published & indexMask_);
+  activePolicyAvailable_ = (published & newPolicyFlag_) != 0;
+  stateCursor_ = 0;
+  controllerCursor_ = 0;
+
+  if ((published & resetFlag_) != 0) {
+    policyLatencyTimer_.reset();
+  }
+  if (!activePolicyAvailable_) {
+    return false;  // reset() was called and no policy has been published since.
   }
+
+  auto& activeBuffer = policyBuffers_[activeIndex_];
+  policyLatencyTimer_.addInterval(std::chrono::steady_clock::now() - activeBuffer.publishTime);
+
+  modifyActiveSolution(activeBuffer.command, activeBuffer.primalSolution);
+  return true;
 }
 
 /******************************************************************************************************/
@@ -196,19 +194,44 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
     throw std::runtime_error("[MRT_BASE::moveToBuffer] performanceIndicesPtr cannot be a null pointer!");
   }
 
-  std::lock_guard<std::mutex> lk(bufferMutex_);
-  // use swap such that the old objects are destroyed after releasing the lock.
-  bufferCommandPtr_.swap(commandDataPtr);
-  bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
-  bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
+  writeToBuffer([&](CommandData& command, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+    command = std::move(*commandDataPtr);
+    primalSolution.swap(*primalSolutionPtr);
+    performanceIndices = *performanceIndicesPtr;
+  });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::publishWriteBuffer() {
+  auto& writeBuffer = policyBuffers_[writeIndex_];
 
   // allow user to modify the buffer
-  modifyBufferedSolution(*bufferCommandPtr_, *bufferPrimalSolutionPtr_);
+  modifyBufferedSolution(writeBuffer.command, writeBuffer.primalSolution);
+
+  // publish the written slot and take over the previously published one, which the reader has not picked up or has already released
+  // a pending reset flag is kept, such that the reader still drops the state of its previous policy.
+  writeBuffer.publishTime = std::chrono::steady_clock::now();
+  int published = publishedIndex_.load(std::memory_order_relaxed);
+  while (!publishedIndex_.compare_exchange_weak(published, static_cast<int>(writeIndex_) | newPolicyFlag_ | (published & resetFlag_),
+                                                std::memory_order_acq_rel, std::memory_order_relaxed)) {
+  }
+  writeIndex_ = static_cast<size_t>(published & indexMask_);
 
-  newPolicyInBuffer_ = true;
   policyReceivedEver_ = true;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const MRT_BASE::PolicyBuffer& MRT_BASE::getActiveBuffer(const char* caller) const {
+  if (!activePolicyAvailable_) {
+    throw std::runtime_error("[MRT_BASE::" + std::string(caller) + "] updatePolicy() should be called first!");
+  }
+  return policyBuffers_[activeIndex_];
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -44,6 +44,11 @@ namespace ballbot {
 BallbotMpcnetInterface::BallbotMpcnetInterface(size_t nDataGenerationThreads, size_t nPolicyEvaluationThreads, bool raisim) {
   // create ONNX environment
   auto onnxEnvironmentPtr = ocs2::mpcnet::createOnnxEnvironment();
+  // create inference services shared by the controllers of the data generation and policy evaluation threads, respectively
+  auto dataGenerationInferencePtr =
+      std::make_shared<ocs2::mpcnet::MpcnetOnnxInferenceService>(onnxEnvironmentPtr, nDataGenerationThreads);
+  auto policyEvaluationInferencePtr =
+      std::make_shared<ocs2::mpcnet::MpcnetOnnxInferenceService>(onnxEnvironmentPtr, nPolicyEvaluationThreads);
   // path to config file
   const std::string taskFile = ros::package::getPath("ocs2_ballbot") + "/config/mpc/task.info";
   // path to save auto-generated libraries
@@ -64,7 +69,8 @@ BallbotMpcnetInterface::BallbotMpcnetInterface(size_t nDataGenerationThreads, si
     auto mpcnetDefinitionPtr = std::make_shared<BallbotMpcnetDefinition>();
     mpcPtrs.push_back(getMpc(ballbotInterface));
     mpcnetPtrs.push_back(std::make_unique<ocs2::mpcnet::MpcnetOnnxController>(
-        mpcnetDefinitionPtr, ballbotInterface.getReferenceManagerPtr(), onnxEnvironmentPtr));
+        mpcnetDefinitionPtr, ballbotInterface.getReferenceManagerPtr(),
+        i < nDataGenerationThreads ? dataGenerationInferencePtr : policyEvaluationInferencePtr));
     if (raisim) {
       throw std::runtime_error("[BallbotMpcnetInterface::BallbotMpcnetInterface] raisim rollout not yet implemented for ballbot.");
     } else {
@@ -76,6 +82,7 @@ BallbotMpcnetInterface::BallbotMpcnetInterface(size_t nDataGenerationThreads, si
   mpcnetRolloutManagerPtr_.reset(new ocs2::mpcnet::MpcnetRolloutManager(nDataGenerationThreads, nPolicyEvaluationThreads,
                                                                         std::move(mpcPtrs), std::move(mpcnetPtrs), std::move(rolloutPtrs),
                                                                         mpcnetDefinitionPtrs, referenceManagerPtrs));
+  mpcnetRolloutManagerPtr_->setInferenceServices(dataGenerationInferencePtr, policyEvaluationInferencePtr);
 }
 
 /******************************************************************************************************/
@@ -46,6 +46,11 @@ namespace legged_robot {
 LeggedRobotMpcnetInterface::LeggedRobotMpcnetInterface(size_t nDataGenerationThreads, size_t nPolicyEvaluationThreads, bool raisim) {
   // create ONNX environment
   auto onnxEnvironmentPtr = ocs2::mpcnet::createOnnxEnvironment();
+  // create inference services shared by the controllers of the data generation and policy evaluation threads, respectively
+  auto dataGenerationInferencePtr =
+      std::make_shared<ocs2::mpcnet::MpcnetOnnxInferenceService>(onnxEnvironmentPtr, nDataGenerationThreads);
+  auto policyEvaluationInferencePtr =
+      std::make_shared<ocs2::mpcnet::MpcnetOnnxInferenceService>(onnxEnvironmentPtr, nPolicyEvaluationThreads);
   // paths to files
   const std::string taskFile = ros::package::getPath("ocs2_legged_robot") + "/config/mpc/task.info";
   const std::string urdfFile = ros::package::getPath("ocs2_robotic_assets") + "/resources/anymal_c/urdf/anymal.urdf";
@@ -68,7 +73,8 @@ LeggedRobotMpcnetInterface::LeggedRobotMpcnetInterface(size_t nDataGenerationThr
     auto mpcnetDefinitionPtr = std::make_shared<LeggedRobotMpcnetDefinition>(*leggedRobotInterfacePtrs_[i]);
     mpcPtrs.push_back(getMpc(*leggedRobotInterfacePtrs_[i]));
     mpcnetPtrs.push_back(std::unique_ptr<ocs2::mpcnet::MpcnetControllerBase>(new ocs2::mpcnet::MpcnetOnnxController(
-        mpcnetDefinitionPtr, leggedRobotInterfacePtrs_[i]->getReferenceManagerPtr(), onnxEnvironmentPtr)));
+        mpcnetDefinitionPtr, leggedRobotInterfacePtrs_[i]->getReferenceManagerPtr(),
+        i < nDataGenerationThreads ? dataGenerationInferencePtr : policyEvaluationInferencePtr)));
     if (raisim) {
       RaisimRolloutSettings raisimRolloutSettings(raisimFile, "rollout");
       raisimRolloutSettings.portNumber_ += i;
@@ -107,6 +113,7 @@ LeggedRobotMpcnetInterface::LeggedRobotMpcnetInterface(size_t nDataGenerationThr
   mpcnetRolloutManagerPtr_.reset(new ocs2::mpcnet::MpcnetRolloutManager(nDataGenerationThreads, nPolicyEvaluationThreads,
                                                                         std::move(mpcPtrs), std::move(mpcnetPtrs), std::move(rolloutPtrs),
                                                                         mpcnetDefinitionPtrs, referenceManagerPtrs));
+  mpcnetRolloutManagerPtr_->setInferenceServices(dataGenerationInferencePtr, policyEvaluationInferencePtr);
 }
 
 /******************************************************************************************************/
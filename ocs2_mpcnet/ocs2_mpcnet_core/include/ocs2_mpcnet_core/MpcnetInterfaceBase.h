@@ -61,6 +61,16 @@ class MpcnetInterfaceBase {
    */
   data_array_t getGeneratedData();
 
+  /**
+   * @see MpcnetRolloutManager::setDataFile()
+   */
+  void setDataFile(const std::string& filePath, size_t chunkSize);
+
+  /**
+   * @see MpcnetRolloutManager::flushGeneratedData()
+   */
+  size_t flushGeneratedData();
+
   /**
    * @see MpcnetRolloutManager::startPolicyEvaluation()
    */
@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_python_interface/PybindMacros.h>
 
 #include "ocs2_mpcnet_core/rollout/MpcnetData.h"
+#include "ocs2_mpcnet_core/rollout/MpcnetDataWriter.h"
 #include "ocs2_mpcnet_core/rollout/MpcnetMetrics.h"
 
 using namespace pybind11::literals;
@@ -103,6 +104,14 @@ using namespace pybind11::literals;
         .def_readwrite("observation", &ocs2::mpcnet::data_point_t::observation)                             \
         .def_readwrite("actionTransformation", &ocs2::mpcnet::data_point_t::actionTransformation)           \
         .def_readwrite("hamiltonian", &ocs2::mpcnet::data_point_t::hamiltonian);                            \
+    /* bind data writer class */                                                                            \
+    pybind11::class_<ocs2::mpcnet::MpcnetDataWriter>(m, "DataWriter")                                       \
+        .def(pybind11::init<std::string, size_t>(), "filePath"_a, "chunkSize"_a = 1024)                     \
+        .def("write", &ocs2::mpcnet::MpcnetDataWriter::write, "dataPoint"_a)                                \
+        .def("invalidate", &ocs2::mpcnet::MpcnetDataWriter::invalidate, "index"_a)                          \
+        .def("clear", &ocs2::mpcnet::MpcnetDataWriter::clear)                                               \
+        .def("flush", &ocs2::mpcnet::MpcnetDataWriter::flush)                                               \
+        .def("getNumRecords", &ocs2::mpcnet::MpcnetDataWriter::getNumRecords);                              \
     /* bind metrics struct */                                                                               \
     pybind11::class_<ocs2::mpcnet::metrics_t>(m, "Metrics")                                                 \
         .def(pybind11::init<>())                                                                            \
@@ -126,6 +135,8 @@ using namespace pybind11::literals;
              "targetTrajectories"_a)                                                                                           \
         .def("isDataGenerationDone", &MPCNET_INTERFACE::isDataGenerationDone)                                                  \
         .def("getGeneratedData", &MPCNET_INTERFACE::getGeneratedData)                                                          \
+        .def("setDataFile", &MPCNET_INTERFACE::setDataFile, "filePath"_a, "chunkSize"_a = 1024)                                \
+        .def("flushGeneratedData", &MPCNET_INTERFACE::flushGeneratedData)                                                      \
         .def("startPolicyEvaluation", &MPCNET_INTERFACE::startPolicyEvaluation, "alpha"_a, "policyFilePath"_a, "timeStep"_a,   \
              "initialObservations"_a, "modeSchedules"_a, "targetTrajectories"_a)                                               \
         .def("isPolicyEvaluationDone", &MPCNET_INTERFACE::isPolicyEvaluationDone)                                              \
@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpcnet_core/MpcnetDefinitionBase.h"
 #include "ocs2_mpcnet_core/control/MpcnetControllerBase.h"
+#include "ocs2_mpcnet_core/control/MpcnetOnnxInferenceService.h"
 
 namespace ocs2 {
 namespace mpcnet {
@@ -55,6 +56,8 @@ inline std::shared_ptr<Ort::Env> createOnnxEnvironment() {
  * x: relative state (1 x dimensionOfState),
  * u: predicted input (1 x dimensionOfInput),
  * @note The additional first dimension with size 1 for the variables of the model comes from batch processing during training.
+ * @note The inference runs through a MpcnetOnnxInferenceService. Controllers of different rollout threads can share one service, which
+ * then coalesces their requests into batches.
  */
 class MpcnetOnnxController final : public MpcnetControllerBase {
  public:
@@ -69,7 +72,24 @@ class MpcnetOnnxController final : public MpcnetControllerBase {
                        std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr, std::shared_ptr<Ort::Env> onnxEnvironmentPtr)
       : mpcnetDefinitionPtr_(std::move(mpcnetDefinitionPtr)),
         referenceManagerPtr_(std::move(referenceManagerPtr)),
-        onnxEnvironmentPtr_(std::move(onnxEnvironmentPtr)) {}
+        onnxEnvironmentPtr_(std::move(onnxEnvironmentPtr)),
+        inferenceServicePtr_(std::make_shared<MpcnetOnnxInferenceService>(onnxEnvironmentPtr_)),
+        isInferenceServiceShared_(false) {}
+
+  /**
+   * Constructor.
+   * @note The class is not fully instantiated until calling loadPolicyModel(). Clones share the inference service.
+   * @param [in] mpcnetDefinitionPtr : Pointer to the MPC-Net definitions.
+   * @param [in] referenceManagerPtr : Pointer to the reference manager.
+   * @param [in] inferenceServicePtr : Pointer to the inference service shared with other controllers.
+   */
+  MpcnetOnnxController(std::shared_ptr<MpcnetDefinitionBase> mpcnetDefinitionPtr,
+                       std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr,
+                       std::shared_ptr<MpcnetOnnxInferenceService> inferenceServicePtr)
+      : mpcnetDefinitionPtr_(std::move(mpcnetDefinitionPtr)),
+        referenceManagerPtr_(std::move(referenceManagerPtr)),
+        inferenceServicePtr_(std::move(inferenceServicePtr)),
+        isInferenceServiceShared_(true) {}
 
   ~MpcnetOnnxController() override = default;
   MpcnetOnnxController* clone() const override { return new MpcnetOnnxController(*this); }
@@ -77,6 +97,15 @@ class MpcnetOnnxController final : public MpcnetControllerBase {
   void loadPolicyModel(const std::string& policyFilePath) override;
 
   vector_t computeInput(const scalar_t t, const vector_t& x) override;
+
+  /**
+   * Computes the inputs for a batch of times and states with a single inference run.
+   * @param [in] timeTrajectory : The times.
+   * @param [in] stateTrajectory : The states.
+   * @return The inputs.
+   */
+  vector_array_t computeInputs(const scalar_array_t& timeTrajectory, const vector_array_t& stateTrajectory);
+
   ControllerType getType() const override { return ControllerType::ONNX; }
 
   int size() const override { throw std::runtime_error("[MpcnetOnnxController::size] not implemented."); }
@@ -87,24 +116,28 @@ class MpcnetOnnxController final : public MpcnetControllerBase {
   }
 
  private:
-  using tensor_element_t = float;
-
   MpcnetOnnxController(const MpcnetOnnxController& other)
-      : MpcnetOnnxController(other.mpcnetDefinitionPtr_, other.referenceManagerPtr_, other.onnxEnvironmentPtr_) {
-    if (!other.policyFilePath_.empty()) {
-      loadPolicyModel(other.policyFilePath_);
+      : mpcnetDefinitionPtr_(other.mpcnetDefinitionPtr_),
+        referenceManagerPtr_(other.referenceManagerPtr_),
+        onnxEnvironmentPtr_(other.onnxEnvironmentPtr_),
+        isInferenceServiceShared_(other.isInferenceServiceShared_) {
+    if (isInferenceServiceShared_) {
+      inferenceServicePtr_ = other.inferenceServicePtr_;
+    } else {
+      inferenceServicePtr_ = std::make_shared<MpcnetOnnxInferenceService>(onnxEnvironmentPtr_);
+      if (!other.policyFilePath_.empty()) {
+        loadPolicyModel(other.policyFilePath_);
+      }
     }
+    policyFilePath_ = other.policyFilePath_;
   }
 
   std::shared_ptr<MpcnetDefinitionBase> mpcnetDefinitionPtr_;
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;
   std::shared_ptr<Ort::Env> onnxEnvironmentPtr_;
+  std::shared_ptr<MpcnetOnnxInferenceService> inferenceServicePtr_;
+  bool isInferenceServiceShared_;
   std::string policyFilePath_;
-  std::unique_ptr<Ort::Session> sessionPtr_;
-  std::vector<const char*> inputNames_;
-  std::vector<const char*> outputNames_;
-  std::vector<std::vector<int64_t>> inputShapes_;
-  std::vector<std::vector<int64_t>> outputShapes_;
 };
 
 }  // namespace mpcnet
@@ -0,0 +1,173 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <onnxruntime/onnxruntime_cxx_api.h>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/misc/Benchmark.h>
+
+namespace ocs2 {
+namespace mpcnet {
+
+/**
+ * Batched inference of an MPC-Net policy with ONNX Runtime.
+ *
+ * The observations of a batch are copied into preallocated buffers which are bound to the session through an IO binding, such that a
+ * batch is evaluated by a single Session::Run without allocating input or output tensors. The service is thread safe and can be shared
+ * by the controllers of several rollout threads: Concurrent calls of evaluate() with a single observation are coalesced into batches
+ * of at most maxBatchSize observations. The first request of a batch runs it right away if no other batch is being evaluated.
+ * Otherwise, it collects the requests which arrive until the session is free. With a positive maxWaitTime, the first request
+ * additionally waits at most maxWaitTime for the batch to fill up.
+ *
+ * @note Batches with more than one observation require a policy exported with a dynamic batch dimension. For policies with a fixed batch
+ * size of one, the observations of a batch are evaluated one after the other.
+ */
+class MpcnetOnnxInferenceService {
+ public:
+  /** Inference statistics. */
+  struct Statistics {
+    size_t numSamples = 0;        //!< number of evaluated observations
+    size_t numBatches = 0;        //!< number of evaluated batches
+    scalar_t inferenceTime = 0.0;  //!< accumulated wall time of the batch evaluations [s]
+  };
+
+  /**
+   * Constructor.
+   * @note The class is not fully instantiated until calling loadPolicyModel().
+   * @param [in] onnxEnvironmentPtr : Pointer to the environment for ONNX Runtime.
+   * @param [in] maxBatchSize : The maximum number of coalesced single-observation requests per batch.
+   * @param [in] maxWaitTime : The maximum time [s] the first request of a batch waits for further requests, 0 to only coalesce the
+   *                          requests which arrive while another batch is evaluated.
+   */
+  explicit MpcnetOnnxInferenceService(std::shared_ptr<Ort::Env> onnxEnvironmentPtr, size_t maxBatchSize = 1, scalar_t maxWaitTime = 0.0);
+
+  virtual ~MpcnetOnnxInferenceService() = default;
+  MpcnetOnnxInferenceService(const MpcnetOnnxInferenceService&) = delete;
+  MpcnetOnnxInferenceService& operator=(const MpcnetOnnxInferenceService&) = delete;
+
+  /**
+   * Load the model of the policy. Does nothing if the model of this file is already loaded.
+   * @param [in] policyFilePath : Path to the file with the model of the policy.
+   */
+  void loadPolicyModel(const std::string& policyFilePath);
+
+  /**
+   * Evaluates the policy on a batch of observations with one Session::Run.
+   * @param [in] observations : The observations, one column per sample.
+   * @return The actions, one column per sample.
+   */
+  matrix_t evaluate(const matrix_t& observations);
+
+  /**
+   * Evaluates the policy on a single observation. Concurrent calls are coalesced into batches.
+   * @param [in] observation : The observation.
+   * @return The action.
+   */
+  vector_t evaluate(const vector_t& observation);
+
+  /** Gets the inference statistics. */
+  Statistics getStatistics() const;
+
+  /** Resets the inference statistics. */
+  void resetStatistics();
+
+  /** Gets the number of single-observation requests which have not been answered yet. */
+  size_t getNumPendingRequests() const;
+
+ protected:
+  /**
+   * Evaluates the policy on a batch of observations. Called with the session lock held, i.e., one batch at a time.
+   * @param [in] observations : The observations, one column per sample.
+   * @return The actions, one column per sample.
+   */
+  virtual matrix_t evaluateBatch(const matrix_t& observations);
+
+ private:
+  using tensor_element_t = float;
+  using tensor_matrix_t = Eigen::Matrix<tensor_element_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+  /** A batch of coalesced single-observation requests. */
+  struct PendingBatch {
+    std::vector<vector_t> observations;
+    matrix_t actions;
+    std::exception_ptr exceptionPtr;
+    bool isDone = false;
+  };
+
+  /** Resizes the buffers and binds them to the session inputs and outputs. Requires sessionMutex_. */
+  void bindBuffers(size_t batchSize);
+
+  /** Runs the session on the bound buffers. Requires sessionMutex_. */
+  void run();
+
+  std::shared_ptr<Ort::Env> onnxEnvironmentPtr_;
+  const size_t maxBatchSize_;
+  const scalar_t maxWaitTime_;
+
+  // session and preallocated buffers, guarded by sessionMutex_
+  mutable std::mutex sessionMutex_;
+  std::string policyFilePath_;
+  std::unique_ptr<Ort::Session> sessionPtr_;
+  std::unique_ptr<Ort::IoBinding> ioBindingPtr_;
+  Ort::MemoryInfo memoryInfo_{nullptr};
+  Ort::RunOptions runOptions_{nullptr};
+  Ort::Value observationTensor_{nullptr};
+  Ort::Value actionTensor_{nullptr};
+  std::vector<const char*> inputNames_;
+  std::vector<const char*> outputNames_;
+  std::vector<std::vector<int64_t>> inputShapes_;
+  std::vector<std::vector<int64_t>> outputShapes_;
+  size_t actionOutputIndex_ = 0;
+  bool hasDynamicBatchSize_ = false;
+  size_t boundBatchSize_ = 0;
+  tensor_matrix_t observationBuffer_;
+  tensor_matrix_t actionBuffer_;
+  size_t numSamples_ = 0;
+  benchmark::RepeatedTimer inferenceTimer_;
+
+  // coalescing of single-observation requests, guarded by requestMutex_
+  mutable std::mutex requestMutex_;
+  std::condition_variable batchFullCondition_;
+  std::condition_variable batchDoneCondition_;
+  std::shared_ptr<PendingBatch> openBatchPtr_;
+  size_t numPendingRequests_ = 0;
+  size_t numEvaluatingBatches_ = 0;
+};
+
+}  // namespace mpcnet
+}  // namespace ocs2
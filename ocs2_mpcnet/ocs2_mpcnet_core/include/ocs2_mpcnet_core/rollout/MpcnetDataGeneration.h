@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include "ocs2_mpcnet_core/rollout/MpcnetData.h"
+#include "ocs2_mpcnet_core/rollout/MpcnetDataWriter.h"
 #include "ocs2_mpcnet_core/rollout/MpcnetRolloutBase.h"
 
 namespace ocs2 {
@@ -70,6 +71,12 @@ class MpcnetDataGeneration final : public MpcnetRolloutBase {
    */
   MpcnetDataGeneration& operator=(const MpcnetDataGeneration&) = delete;
 
+  /**
+   * Sets a data writer, through which the generated data is streamed into a file instead of being collected in the data array.
+   * @param [in] dataWriterPtr : Pointer to the data writer (shared ownership), nullptr for collecting the data in the data array.
+   */
+  void setDataWriter(std::shared_ptr<MpcnetDataWriter> dataWriterPtr) { dataWriterPtr_ = std::move(dataWriterPtr); }
+
   /**
    * Run the data generation.
    * @param [in] alpha : The mixture parameter for the behavioral controller.
@@ -81,14 +88,21 @@ class MpcnetDataGeneration final : public MpcnetRolloutBase {
    * @param [in] initialObservation : The initial system observation to start from (time and state required).
    * @param [in] modeSchedule : The mode schedule providing the event times and mode sequence.
    * @param [in] targetTrajectories : The target trajectories to be tracked.
-   * @return Pointer to the data array with the generated data.
+   * @return Pointer to the data array with the generated data (empty if a data writer is set).
    */
   const data_array_t* run(scalar_t alpha, const std::string& policyFilePath, scalar_t timeStep, size_t dataDecimation, size_t nSamples,
                           const matrix_t& samplingCovariance, const SystemObservation& initialObservation, const ModeSchedule& modeSchedule,
                           const TargetTrajectories& targetTrajectories);
 
  private:
+  /**
+   * Stores a data point, either in the data array or through the data writer.
+   */
+  void storeDataPoint(const data_point_t& dataPoint);
+
   data_array_t dataArray_;
+  std::shared_ptr<MpcnetDataWriter> dataWriterPtr_;
+  std::vector<size_t> writtenRecords_;
 };
 
 }  // namespace mpcnet
@@ -0,0 +1,144 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ocs2_mpcnet_core/rollout/MpcnetData.h"
+
+namespace ocs2 {
+namespace mpcnet {
+
+/**
+ * Streams data points into a binary file with a fixed record layout, such that the file can be memory-mapped as arrays (e.g. with
+ * numpy.memmap) without any conversion.
+ *
+ * The file starts with a header of headerSize bytes holding the uint64 words
+ * [magic, version, stateDim, inputDim, observationDim, actionDim, recordSize, numRecords],
+ * followed by numRecords records of recordSize bytes. Each record consists of 8-byte words
+ * [valid (uint64), mode (uint64), t, x (X), u (U), observation (O), actionTransformationMatrix (U x A), actionTransformationVector (U),
+ *  H, dHdx (X), dHdu (U), dHdxx (X x X), dHdux (U x X), dHduu (U x U)],
+ * where the matrices are stored in row-major order. The file grows in chunks of chunkSize records, which are memory-mapped on demand.
+ *
+ * @note write() and invalidate() can be called concurrently. clear() and flush() must not be called while other threads write.
+ */
+class MpcnetDataWriter {
+ public:
+  static constexpr uint64_t magic = 0x4e43504d3253434fULL;  // "OCS2MPCN"
+  static constexpr uint64_t version = 1;
+  static constexpr size_t headerSize = 4096;
+
+  /**
+   * Constructor.
+   * @param [in] filePath : The path of the data file, an existing file is overwritten.
+   * @param [in] chunkSize : The number of records by which the file grows.
+   */
+  explicit MpcnetDataWriter(const std::string& filePath, size_t chunkSize = 1024);
+
+  /**
+   * Destructor, flushes the header and unmaps the file.
+   */
+  ~MpcnetDataWriter();
+
+  /**
+   * Deleted copy constructor.
+   */
+  MpcnetDataWriter(const MpcnetDataWriter&) = delete;
+
+  /**
+   * Deleted copy assignment.
+   */
+  MpcnetDataWriter& operator=(const MpcnetDataWriter&) = delete;
+
+  /**
+   * Writes a data point as a new record.
+   * @note The dimensions are fixed by the first data point written to the file.
+   * @param [in] dataPoint : The data point.
+   * @return The index of the record.
+   */
+  size_t write(const data_point_t& dataPoint);
+
+  /**
+   * Marks a record as invalid, e.g. because the rollout it belongs to failed.
+   * @param [in] index : The index of the record.
+   */
+  void invalidate(size_t index);
+
+  /**
+   * Discards all records. The file keeps its size and the mapped chunks are reused.
+   */
+  void clear();
+
+  /**
+   * Writes the number of records to the header and flushes the mapped memory to the file.
+   * @return The number of records.
+   */
+  size_t flush();
+
+  /** Gets the path of the data file. */
+  const std::string& getFilePath() const { return filePath_; }
+
+  /** Gets the number of records. */
+  size_t getNumRecords() const;
+
+ private:
+  struct Chunk {
+    void* mapAddress;
+    size_t mapLength;
+    char* records;
+  };
+
+  void initializeLayout(const data_point_t& dataPoint);
+  void checkDimensions(const data_point_t& dataPoint) const;
+  char* getRecord(size_t index) const;
+  void mapChunk();
+  void writeHeader();
+
+  const std::string filePath_;
+  const size_t chunkSize_;
+  int fileDescriptor_ = -1;
+  uint64_t* header_ = nullptr;
+
+  mutable std::mutex mutex_;
+  size_t stateDim_ = 0;
+  size_t inputDim_ = 0;
+  size_t observationDim_ = 0;
+  size_t actionDim_ = 0;
+  size_t recordSize_ = 0;
+  size_t numRecords_ = 0;
+  std::vector<Chunk> chunks_;
+};
+
+}  // namespace mpcnet
+}  // namespace ocs2
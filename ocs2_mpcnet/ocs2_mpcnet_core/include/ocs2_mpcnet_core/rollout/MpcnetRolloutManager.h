@@ -29,8 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <chrono>
+
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include "ocs2_mpcnet_core/control/MpcnetOnnxInferenceService.h"
 #include "ocs2_mpcnet_core/rollout/MpcnetDataGeneration.h"
 #include "ocs2_mpcnet_core/rollout/MpcnetPolicyEvaluation.h"
 
@@ -92,6 +95,22 @@ class MpcnetRolloutManager {
    */
   const data_array_t& getGeneratedData();
 
+  /**
+   * Streams the data of the data generation rollouts into a memory-mappable file instead of collecting it in memory.
+   * @note With a data file, getGeneratedData() returns an empty array and the data is accessed via flushGeneratedData().
+   * @see MpcnetDataWriter for the file layout.
+   * @param [in] filePath : The path of the data file.
+   * @param [in] chunkSize : The number of records by which the file grows.
+   */
+  void setDataFile(const std::string& filePath, size_t chunkSize);
+
+  /**
+   * Flushes the data streamed into the data file by the data generation rollout.
+   * @note Call either this or getGeneratedData() once per data generation.
+   * @return The number of records in the data file.
+   */
+  size_t flushGeneratedData();
+
   /**
    * Starts the policy evaluation forward simulated by a behavioral controller.
    * @param [in] alpha : The mixture parameter for the behavioral controller.
@@ -117,7 +136,25 @@ class MpcnetRolloutManager {
    */
   metrics_array_t getComputedMetrics();
 
+  /**
+   * Sets the inference services shared by the policies of the data generation and policy evaluation rollouts, respectively.
+   * @note The inference statistics of a service are reset when its rollouts are started and printed when their results are collected.
+   * @param [in] dataGenerationInferencePtr : The inference service of the data generation, may be null.
+   * @param [in] policyEvaluationInferencePtr : The inference service of the policy evaluation, may be null.
+   */
+  void setInferenceServices(std::shared_ptr<MpcnetOnnxInferenceService> dataGenerationInferencePtr,
+                            std::shared_ptr<MpcnetOnnxInferenceService> policyEvaluationInferencePtr);
+
  private:
+  /**
+   * Prints the inference statistics of a service since the start of its rollouts.
+   * @param [in] name : The name of the rollouts.
+   * @param [in] inferenceService : The inference service.
+   * @param [in] startTime : The start time of the rollouts.
+   */
+  static void printInferenceStatistics(const std::string& name, const MpcnetOnnxInferenceService& inferenceService,
+                                       std::chrono::steady_clock::time_point startTime);
+
   // data generation variables
   size_t nDataGenerationThreads_;
   std::atomic_int nDataGenerationTasksDone_;
@@ -125,12 +162,17 @@ class MpcnetRolloutManager {
   std::vector<std::unique_ptr<MpcnetDataGeneration>> dataGenerationPtrs_;
   std::vector<std::future<const data_array_t*>> dataGenerationFtrs_;
   data_array_t dataArray_;
+  std::shared_ptr<MpcnetDataWriter> dataWriterPtr_;
+  std::shared_ptr<MpcnetOnnxInferenceService> dataGenerationInferencePtr_;
+  std::chrono::steady_clock::time_point dataGenerationStartTime_;
   // policy evaluation variables
   size_t nPolicyEvaluationThreads_;
   std::atomic_int nPolicyEvaluationTasksDone_;
   std::unique_ptr<ThreadPool> policyEvaluationThreadPoolPtr_;
   std::vector<std::unique_ptr<MpcnetPolicyEvaluation>> policyEvaluationPtrs_;
   std::vector<std::future<metrics_t>> policyEvaluationFtrs_;
+  std::shared_ptr<MpcnetOnnxInferenceService> policyEvaluationInferencePtr_;
+  std::chrono::steady_clock::time_point policyEvaluationStartTime_;
 };
 
 }  // namespace mpcnet
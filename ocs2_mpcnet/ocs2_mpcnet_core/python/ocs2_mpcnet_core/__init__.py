@@ -3,5 +3,5 @@ from ocs2_mpcnet_core.MpcnetPybindings import ScalarFunctionQuadraticApproximati
 from ocs2_mpcnet_core.MpcnetPybindings import SystemObservation, SystemObservationArray
 from ocs2_mpcnet_core.MpcnetPybindings import ModeSchedule, ModeScheduleArray
 from ocs2_mpcnet_core.MpcnetPybindings import TargetTrajectories, TargetTrajectoriesArray
-from ocs2_mpcnet_core.MpcnetPybindings import DataPoint, DataArray
+from ocs2_mpcnet_core.MpcnetPybindings import DataPoint, DataArray, DataWriter
 from ocs2_mpcnet_core.MpcnetPybindings import Metrics, MetricsArray
@@ -307,3 +307,87 @@ def get_one_hot(mode: int, expert_number: int, expert_for_mode: Dict[int, int])
     one_hot = np.zeros(expert_number)
     one_hot[expert_for_mode[mode]] = 1.0
     return one_hot
+
+
+def get_one_hot_batch(modes: np.ndarray, expert_number: int, expert_for_mode: Dict[int, int]) -> np.ndarray:
+    """Get one hot encodings of a batch of modes.
+
+    Batch-wise version of get_one_hot for a batch of B modes.
+
+    Args:
+        modes: The modes of the system given by a NumPy array of shape (B) containing integers.
+        expert_number: The number of experts given by an integer.
+        expert_for_mode: A dictionary that assigns modes to experts.
+
+    Returns:
+        p: Discrete probability distributions given by a NumPy array of shape (B,P) containing floats.
+    """
+    one_hot = np.zeros((len(modes), expert_number))
+    one_hot[np.arange(len(modes)), [expert_for_mode[int(mode)] for mode in modes]] = 1.0
+    return one_hot
+
+
+DATA_FILE_MAGIC = 0x4E43504D3253434F
+DATA_FILE_VERSION = 1
+DATA_FILE_HEADER_SIZE = 4096
+
+
+def get_data_file_dtype(state_dim: int, input_dim: int, observation_dim: int, action_dim: int) -> np.dtype:
+    """Get data file record type.
+
+    Get the NumPy structured data type of a record in a data file written by the C++ MpcnetDataWriter.
+
+    Args:
+        state_dim: The state dimension X given by an integer.
+        input_dim: The input dimension U given by an integer.
+        observation_dim: The observation dimension O given by an integer.
+        action_dim: The action dimension A given by an integer.
+
+    Returns:
+        The structured data type of a record.
+    """
+    X, U, O, A = state_dim, input_dim, observation_dim, action_dim
+    return np.dtype(
+        [
+            ("valid", "<u8"),
+            ("mode", "<u8"),
+            ("t", "<f8"),
+            ("x", "<f8", (X,)),
+            ("u", "<f8", (U,)),
+            ("observation", "<f8", (O,)),
+            ("action_transformation_matrix", "<f8", (U, A)),
+            ("action_transformation_vector", "<f8", (U,)),
+            ("H", "<f8"),
+            ("dHdx", "<f8", (X,)),
+            ("dHdu", "<f8", (U,)),
+            ("dHdxx", "<f8", (X, X)),
+            ("dHdux", "<f8", (U, X)),
+            ("dHduu", "<f8", (U, U)),
+        ]
+    )
+
+
+def map_data_file(file_path: str) -> np.ndarray:
+    """Map data file.
+
+    Maps the records of a data file written by the C++ MpcnetDataWriter into memory without copying them. Records of
+    failed data generation rollouts are marked as invalid and are removed, which requires a copy.
+
+    Args:
+        file_path: The path of the data file given by a string.
+
+    Returns:
+        A structured NumPy array of shape (N), e.g. data["x"] is a view of shape (N,X) with the observed states.
+    """
+    header = np.fromfile(file_path, dtype="<u8", count=8)
+    magic, version, state_dim, input_dim, observation_dim, action_dim, record_size, num_records = (int(h) for h in header)
+    if magic != DATA_FILE_MAGIC or version != DATA_FILE_VERSION:
+        raise ValueError("The file " + file_path + " is not a data file of a supported version.")
+    dtype = get_data_file_dtype(state_dim, input_dim, observation_dim, action_dim)
+    if num_records == 0:
+        return np.empty(0, dtype=dtype)
+    if dtype.itemsize != record_size:
+        raise ValueError("The record size of the file " + file_path + " does not match its dimensions.")
+    data = np.memmap(file_path, dtype=dtype, mode="r", offset=DATA_FILE_HEADER_SIZE, shape=(num_records,))
+    valid = data["valid"] != 0
+    return data if valid.all() else data[valid]
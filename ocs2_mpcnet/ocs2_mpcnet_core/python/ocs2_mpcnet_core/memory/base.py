@@ -83,6 +83,44 @@ class BaseMemory(metaclass=ABCMeta):
         """
         pass
 
+    @abstractmethod
+    def push_batch(
+        self,
+        t: np.ndarray,
+        x: np.ndarray,
+        u: np.ndarray,
+        p: np.ndarray,
+        observation: np.ndarray,
+        action_transformation_matrix: np.ndarray,
+        action_transformation_vector: np.ndarray,
+        dHdxx: np.ndarray,
+        dHdux: np.ndarray,
+        dHduu: np.ndarray,
+        dHdx: np.ndarray,
+        dHdu: np.ndarray,
+        H: np.ndarray,
+    ) -> None:
+        """Pushes a batch of data into the memory.
+
+        Pushes N data samples into the memory, e.g. the arrays of a memory-mapped data file.
+
+        Args:
+            t: A NumPy array of shape (N) with the times.
+            x: A NumPy array of shape (N,X) with the observed states.
+            u: A NumPy array of shape (N,U) with the optimal inputs.
+            p: A NumPy array of shape (N,P) with the observed discrete probability distributions of the modes.
+            observation: A NumPy array of shape (N,O) with the observations.
+            action_transformation_matrix: A NumPy array of shape (N,U,A) with the action transformation matrices.
+            action_transformation_vector: A NumPy array of shape (N,U) with the action transformation vectors.
+            dHdxx: A NumPy array of shape (N,X,X) with the state-state Hessians of the Hamiltonian approximations.
+            dHdux: A NumPy array of shape (N,U,X) with the input-state Hessians of the Hamiltonian approximations.
+            dHduu: A NumPy array of shape (N,U,U) with the input-input Hessians of the Hamiltonian approximations.
+            dHdx: A NumPy array of shape (N,X) with the state gradients of the Hamiltonian approximations.
+            dHdu: A NumPy array of shape (N,U) with the input gradients of the Hamiltonian approximations.
+            H: A NumPy array of shape (N) with the Hamiltonians at the development/expansion points.
+        """
+        pass
+
     @abstractmethod
     def sample(self, batch_size: int) -> Tuple[torch.Tensor, ...]:
         """Samples data from the memory.
@@ -153,6 +153,75 @@ class CircularMemory(BaseMemory):
         self.size = min(self.size + 1, self.capacity)
         self.position = (self.position + 1) % self.capacity
 
+    def push_batch(
+        self,
+        t: np.ndarray,
+        x: np.ndarray,
+        u: np.ndarray,
+        p: np.ndarray,
+        observation: np.ndarray,
+        action_transformation_matrix: np.ndarray,
+        action_transformation_vector: np.ndarray,
+        dHdxx: np.ndarray,
+        dHdux: np.ndarray,
+        dHduu: np.ndarray,
+        dHdx: np.ndarray,
+        dHdu: np.ndarray,
+        H: np.ndarray,
+    ) -> None:
+        """Pushes a batch of data into the memory.
+
+        Pushes N data samples into the memory, e.g. the arrays of a memory-mapped data file.
+
+        Args:
+            t: A NumPy array of shape (N) with the times.
+            x: A NumPy array of shape (N,X) with the observed states.
+            u: A NumPy array of shape (N,U) with the optimal inputs.
+            p: A NumPy array of shape (N,P) with the observed discrete probability distributions of the modes.
+            observation: A NumPy array of shape (N,O) with the observations.
+            action_transformation_matrix: A NumPy array of shape (N,U,A) with the action transformation matrices.
+            action_transformation_vector: A NumPy array of shape (N,U) with the action transformation vectors.
+            dHdxx: A NumPy array of shape (N,X,X) with the state-state Hessians of the Hamiltonian approximations.
+            dHdux: A NumPy array of shape (N,U,X) with the input-state Hessians of the Hamiltonian approximations.
+            dHduu: A NumPy array of shape (N,U,U) with the input-input Hessians of the Hamiltonian approximations.
+            dHdx: A NumPy array of shape (N,X) with the state gradients of the Hamiltonian approximations.
+            dHdu: A NumPy array of shape (N,U) with the input gradients of the Hamiltonian approximations.
+            H: A NumPy array of shape (N) with the Hamiltonians at the development/expansion points.
+        """
+        # push data into memory
+        # note: - the batch is split into at most two contiguous segments due to the wrap-around of the memory
+        #       - np.ascontiguousarray: gathers the strided fields of memory-mapped records into one contiguous segment
+        batch_size = len(t)
+        arrays = (
+            (self.t, t),
+            (self.x, x),
+            (self.u, u),
+            (self.p, p),
+            (self.observation, observation),
+            (self.action_transformation_matrix, action_transformation_matrix),
+            (self.action_transformation_vector, action_transformation_vector),
+            (self.dHdxx, dHdxx),
+            (self.dHdux, dHdux),
+            (self.dHduu, dHduu),
+            (self.dHdx, dHdx),
+            (self.dHdu, dHdu),
+            (self.H, H),
+        )
+        # only the last capacity samples of a batch larger than the memory are kept
+        start = max(batch_size - self.capacity, 0)
+        position = (self.position + start) % self.capacity
+        while start < batch_size:
+            length = min(batch_size - start, self.capacity - position)
+            for memory, data in arrays:
+                memory[position : position + length].copy_(
+                    torch.as_tensor(np.ascontiguousarray(data[start : start + length]), device=torch.device("cpu"))
+                )
+            start += length
+            position = (position + length) % self.capacity
+        # update size and position
+        self.size = min(self.size + batch_size, self.capacity)
+        self.position = (self.position + batch_size) % self.capacity
+
     def sample(self, batch_size: int) -> Tuple[torch.Tensor, ...]:
         """Samples data from the memory.
 
@@ -91,6 +91,9 @@ class Mpcnet(metaclass=ABCMeta):
         timestamp = datetime.datetime.now().strftime("%Y-%m-%d_%H-%M-%S")
         self.log_dir = os.path.join(root_dir, "runs", f"{timestamp}_{config.NAME}_{config.DESCRIPTION}")
         self.writer = SummaryWriter(self.log_dir)
+        # generated data is streamed into a memory-mapped file
+        self.data_file_path = "/tmp/data_generation_" + timestamp + ".bin"
+        self.interface.setDataFile(self.data_file_path)
         # loss
         self.experts_loss = experts_loss
         self.gating_loss = gating_loss
@@ -123,6 +126,27 @@ class Mpcnet(metaclass=ABCMeta):
         """
         pass
 
+    def export_policy(self, policy: BasePolicy, file_path: str) -> None:
+        """Export policy.
+
+        Export the policy in the ONNX format with a dynamic batch dimension, such that the C++ inference can evaluate
+        the observations of several rollouts in a single run.
+
+        Args:
+            policy: The policy to be exported.
+            file_path: The path of the ONNX file given by a string.
+        """
+        output_names = list(policy.output_names)
+        dynamic_axes = {name: {0: "batch"} for name in ["observation"] + output_names}
+        torch.onnx.export(
+            model=policy,
+            args=self.dummy_observation,
+            f=file_path,
+            input_names=["observation"],
+            output_names=output_names,
+            dynamic_axes=dynamic_axes,
+        )
+
     def start_data_generation(self, policy: BasePolicy, alpha: float = 1.0):
         """Start data generation.
 
@@ -133,7 +157,7 @@ class Mpcnet(metaclass=ABCMeta):
             alpha: The weight of the MPC policy in the rollouts.
         """
         policy_file_path = "/tmp/data_generation_" + datetime.datetime.now().strftime("%Y-%m-%d_%H-%M-%S") + ".onnx"
-        torch.onnx.export(model=policy, args=self.dummy_observation, f=policy_file_path)
+        self.export_policy(policy, policy_file_path)
         initial_observations, mode_schedules, target_trajectories = self.get_tasks(
             self.config.DATA_GENERATION_TASKS, self.config.DATA_GENERATION_DURATION
         )
@@ -159,7 +183,7 @@ class Mpcnet(metaclass=ABCMeta):
             alpha: The weight of the MPC policy in the rollouts.
         """
         policy_file_path = "/tmp/policy_evaluation_" + datetime.datetime.now().strftime("%Y-%m-%d_%H-%M-%S") + ".onnx"
-        torch.onnx.export(model=policy, args=self.dummy_observation, f=policy_file_path)
+        self.export_policy(policy, policy_file_path)
         initial_observations, mode_schedules, target_trajectories = self.get_tasks(
             self.config.POLICY_EVALUATION_TASKS, self.config.POLICY_EVALUATION_DURATION
         )
@@ -180,7 +204,7 @@ class Mpcnet(metaclass=ABCMeta):
         try:
             # save initial policy
             save_path = self.log_dir + "/initial_policy"
-            torch.onnx.export(model=self.policy, args=self.dummy_observation, f=save_path + ".onnx")
+            self.export_policy(self.policy, save_path + ".onnx")
             torch.save(obj=self.policy, f=save_path + ".pt")
 
             print("==============\nWaiting for first data.\n==============")
@@ -195,23 +219,31 @@ class Mpcnet(metaclass=ABCMeta):
 
                 # data generation
                 if self.interface.isDataGenerationDone():
-                    # get generated data
-                    data = self.interface.getGeneratedData()
-                    for i in range(len(data)):
-                        # push t, x, u, p, observation, action transformation, Hamiltonian into memory
-                        self.memory.push(
-                            data[i].t,
-                            data[i].x,
-                            data[i].u,
-                            helper.get_one_hot(data[i].mode, self.config.EXPERT_NUM, self.config.EXPERT_FOR_MODE),
-                            data[i].observation,
-                            data[i].actionTransformation,
-                            data[i].hamiltonian,
-                        )
+                    # get generated data, mapped from the data file without copying
+                    self.interface.flushGeneratedData()
+                    data = helper.map_data_file(self.data_file_path)
+                    num_new_data_points = len(data)
+                    # push t, x, u, p, observation, action transformation, Hamiltonian into memory
+                    self.memory.push_batch(
+                        data["t"],
+                        data["x"],
+                        data["u"],
+                        helper.get_one_hot_batch(data["mode"], self.config.EXPERT_NUM, self.config.EXPERT_FOR_MODE),
+                        data["observation"],
+                        data["action_transformation_matrix"],
+                        data["action_transformation_vector"],
+                        data["dHdxx"],
+                        data["dHdux"],
+                        data["dHduu"],
+                        data["dHdx"],
+                        data["dHdu"],
+                        data["H"],
+                    )
+                    del data
                     # logging
-                    self.writer.add_scalar("data/new_data_points", len(data), iteration)
+                    self.writer.add_scalar("data/new_data_points", num_new_data_points, iteration)
                     self.writer.add_scalar("data/total_data_points", len(self.memory), iteration)
-                    print("iteration", iteration, "received data points", len(data), "requesting with alpha", alpha)
+                    print("iteration", iteration, "received data points", num_new_data_points, "requesting with alpha", alpha)
                     # start new data generation
                     self.start_data_generation(self.policy, alpha)
 
@@ -239,7 +271,7 @@ class Mpcnet(metaclass=ABCMeta):
                 # save intermediate policy
                 if (iteration % int(0.1 * self.config.LEARNING_ITERATIONS) == 0) and (iteration > 0):
                     save_path = self.log_dir + "/intermediate_policy_" + str(iteration)
-                    torch.onnx.export(model=self.policy, args=self.dummy_observation, f=save_path + ".onnx")
+                    self.export_policy(self.policy, save_path + ".onnx")
                     torch.save(obj=self.policy, f=save_path + ".pt")
 
                 # extract batch from memory
@@ -316,7 +348,7 @@ class Mpcnet(metaclass=ABCMeta):
 
             # save final policy
             save_path = self.log_dir + "/final_policy"
-            torch.onnx.export(model=self.policy, args=self.dummy_observation, f=save_path + ".onnx")
+            self.export_policy(self.policy, save_path + ".onnx")
             torch.save(obj=self.policy, f=save_path + ".pt")
 
         except KeyboardInterrupt:
@@ -48,6 +48,7 @@ class BasePolicy(torch.nn.Module, metaclass=ABCMeta):
     Attributes:
         observation_scaling: A (1,O,O) tensor for the observation scaling.
         action_scaling: A (1,A,A) tensor for the action scaling.
+        output_names: A tuple with the names of the outputs returned by the forward method, the first being the action.
     """
 
     def __init__(self, config: Config) -> None:
@@ -65,6 +66,7 @@ class BasePolicy(torch.nn.Module, metaclass=ABCMeta):
         self.action_scaling = (
             torch.tensor(config.ACTION_SCALING, device=config.DEVICE, dtype=config.DTYPE).diag().unsqueeze(dim=0)
         )
+        self.output_names = ("action",)
 
     @abstractmethod
     def forward(self, observation: torch.Tensor) -> Tuple[torch.Tensor, ...]:
@@ -67,6 +67,7 @@ class MixtureOfLinearExpertsPolicy(BasePolicy):
         self.observation_dimension = config.OBSERVATION_DIM
         self.action_dimension = config.ACTION_DIM
         self.expert_number = config.EXPERT_NUM
+        self.output_names = ("action", "expert_weights")
         # gating
         self.gating_net = torch.nn.Sequential(
             torch.nn.Linear(self.observation_dimension, self.expert_number), torch.nn.Softmax(dim=1)
@@ -72,6 +72,7 @@ class MixtureOfNonlinearExpertsPolicy(BasePolicy):
         self.expert_hidden_dimension = int((config.OBSERVATION_DIM + config.ACTION_DIM) / 2)
         self.action_dimension = config.ACTION_DIM
         self.expert_number = config.EXPERT_NUM
+        self.output_names = ("action", "expert_weights")
         # gating
         self.gating_net = torch.nn.Sequential(
             torch.nn.Linear(self.observation_dimension, self.gating_hidden_dimension),
@@ -58,6 +58,20 @@ data_array_t MpcnetInterfaceBase::getGeneratedData() {
   return mpcnetRolloutManagerPtr_->getGeneratedData();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetInterfaceBase::setDataFile(const std::string& filePath, size_t chunkSize) {
+  mpcnetRolloutManagerPtr_->setDataFile(filePath, chunkSize);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MpcnetInterfaceBase::flushGeneratedData() {
+  return mpcnetRolloutManagerPtr_->flushGeneratedData();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
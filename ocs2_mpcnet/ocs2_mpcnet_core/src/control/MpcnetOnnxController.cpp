@@ -37,52 +37,63 @@ namespace mpcnet {
 /******************************************************************************************************/
 void MpcnetOnnxController::loadPolicyModel(const std::string& policyFilePath) {
   policyFilePath_ = policyFilePath;
-  // create session
-  Ort::SessionOptions sessionOptions;
-  sessionOptions.SetIntraOpNumThreads(1);
-  sessionOptions.SetInterOpNumThreads(1);
-  sessionPtr_.reset(new Ort::Session(*onnxEnvironmentPtr_, policyFilePath_.c_str(), sessionOptions));
-  // get input and output info
-  inputNames_.clear();
-  outputNames_.clear();
-  inputShapes_.clear();
-  outputShapes_.clear();
-  Ort::AllocatorWithDefaultOptions allocator;
-  for (int i = 0; i < sessionPtr_->GetInputCount(); i++) {
-    inputNames_.push_back(sessionPtr_->GetInputName(i, allocator));
-    inputShapes_.push_back(sessionPtr_->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
-  }
-  for (int i = 0; i < sessionPtr_->GetOutputCount(); i++) {
-    outputNames_.push_back(sessionPtr_->GetOutputName(i, allocator));
-    outputShapes_.push_back(sessionPtr_->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
-  }
+  inferenceServicePtr_->loadPolicyModel(policyFilePath_);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t MpcnetOnnxController::computeInput(const scalar_t t, const vector_t& x) {
-  if (sessionPtr_ == nullptr) {
+  if (policyFilePath_.empty()) {
     throw std::runtime_error("[MpcnetOnnxController::computeInput] cannot compute input, since policy model is not loaded.");
   }
-  // create input tensor object
-  Eigen::Matrix<tensor_element_t, Eigen::Dynamic, 1> observation =
-      mpcnetDefinitionPtr_->getObservation(t, x, referenceManagerPtr_->getModeSchedule(), referenceManagerPtr_->getTargetTrajectories())
-          .cast<tensor_element_t>();
-  Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-  std::vector<Ort::Value> inputValues;
-  inputValues.push_back(Ort::Value::CreateTensor<tensor_element_t>(memoryInfo, observation.data(), observation.size(),
-                                                                   inputShapes_[0].data(), inputShapes_[0].size()));
-  // run inference
-  Ort::RunOptions runOptions;
-  std::vector<Ort::Value> outputValues = sessionPtr_->Run(runOptions, inputNames_.data(), inputValues.data(), 1, outputNames_.data(), 1);
-  // evaluate output tensor object
-  Eigen::Map<Eigen::Matrix<tensor_element_t, Eigen::Dynamic, 1>> action(outputValues[0].GetTensorMutableData<tensor_element_t>(),
-                                                                        outputShapes_[0][1], outputShapes_[0][0]);
-  std::pair<matrix_t, vector_t> actionTransformation = mpcnetDefinitionPtr_->getActionTransformation(
-      t, x, referenceManagerPtr_->getModeSchedule(), referenceManagerPtr_->getTargetTrajectories());
+  const vector_t observation =
+      mpcnetDefinitionPtr_->getObservation(t, x, referenceManagerPtr_->getModeSchedule(), referenceManagerPtr_->getTargetTrajectories());
+  // run inference, concurrent requests of controllers sharing the service are coalesced into one batch
+  const vector_t action = inferenceServicePtr_->evaluate(observation);
   // transform action
-  return actionTransformation.first * action.cast<scalar_t>() + actionTransformation.second;
+  const std::pair<matrix_t, vector_t> actionTransformation = mpcnetDefinitionPtr_->getActionTransformation(
+      t, x, referenceManagerPtr_->getModeSchedule(), referenceManagerPtr_->getTargetTrajectories());
+  return actionTransformation.first * action + actionTransformation.second;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_array_t MpcnetOnnxController::computeInputs(const scalar_array_t& timeTrajectory, const vector_array_t& stateTrajectory) {
+  if (policyFilePath_.empty()) {
+    throw std::runtime_error("[MpcnetOnnxController::computeInputs] cannot compute inputs, since policy model is not loaded.");
+  }
+  if (timeTrajectory.size() != stateTrajectory.size()) {
+    throw std::runtime_error("[MpcnetOnnxController::computeInputs] timeTrajectory and stateTrajectory have different sizes.");
+  }
+  if (timeTrajectory.empty()) {
+    return {};
+  }
+
+  const auto& modeSchedule = referenceManagerPtr_->getModeSchedule();
+  const auto& targetTrajectories = referenceManagerPtr_->getTargetTrajectories();
+
+  // stack the observations
+  const vector_t firstObservation = mpcnetDefinitionPtr_->getObservation(timeTrajectory[0], stateTrajectory[0], modeSchedule,
+                                                                         targetTrajectories);
+  matrix_t observations(firstObservation.size(), timeTrajectory.size());
+  observations.col(0) = firstObservation;
+  for (size_t i = 1; i < timeTrajectory.size(); i++) {
+    observations.col(i) = mpcnetDefinitionPtr_->getObservation(timeTrajectory[i], stateTrajectory[i], modeSchedule, targetTrajectories);
+  }
+
+  // run inference once for the whole batch
+  const matrix_t actions = inferenceServicePtr_->evaluate(observations);
+
+  // transform actions
+  vector_array_t inputs(timeTrajectory.size());
+  for (size_t i = 0; i < timeTrajectory.size(); i++) {
+    const std::pair<matrix_t, vector_t> actionTransformation =
+        mpcnetDefinitionPtr_->getActionTransformation(timeTrajectory[i], stateTrajectory[i], modeSchedule, targetTrajectories);
+    inputs[i] = actionTransformation.first * actions.col(i) + actionTransformation.second;
+  }
+  return inputs;
 }
 
 }  // namespace mpcnet
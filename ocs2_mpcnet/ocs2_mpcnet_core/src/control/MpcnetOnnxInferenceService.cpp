@@ -0,0 +1,259 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpcnet_core/control/MpcnetOnnxInferenceService.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace ocs2 {
+namespace mpcnet {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcnetOnnxInferenceService::MpcnetOnnxInferenceService(std::shared_ptr<Ort::Env> onnxEnvironmentPtr, size_t maxBatchSize,
+                                                       scalar_t maxWaitTime)
+    : onnxEnvironmentPtr_(std::move(onnxEnvironmentPtr)),
+      maxBatchSize_(std::max<size_t>(maxBatchSize, 1)),
+      maxWaitTime_(maxWaitTime),
+      memoryInfo_(Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault)),
+      runOptions_() {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxInferenceService::loadPolicyModel(const std::string& policyFilePath) {
+  std::lock_guard<std::mutex> lock(sessionMutex_);
+  if (sessionPtr_ != nullptr && policyFilePath == policyFilePath_) {
+    return;
+  }
+
+  policyFilePath_ = policyFilePath;
+  // create session
+  Ort::SessionOptions sessionOptions;
+  sessionOptions.SetIntraOpNumThreads(1);
+  sessionOptions.SetInterOpNumThreads(1);
+  sessionPtr_.reset(new Ort::Session(*onnxEnvironmentPtr_, policyFilePath_.c_str(), sessionOptions));
+  ioBindingPtr_.reset(new Ort::IoBinding(*sessionPtr_));
+  boundBatchSize_ = 0;
+  // get input and output info
+  inputNames_.clear();
+  outputNames_.clear();
+  inputShapes_.clear();
+  outputShapes_.clear();
+  Ort::AllocatorWithDefaultOptions allocator;
+  for (int i = 0; i < sessionPtr_->GetInputCount(); i++) {
+    inputNames_.push_back(sessionPtr_->GetInputName(i, allocator));
+    inputShapes_.push_back(sessionPtr_->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
+  }
+  for (int i = 0; i < sessionPtr_->GetOutputCount(); i++) {
+    outputNames_.push_back(sessionPtr_->GetOutputName(i, allocator));
+    outputShapes_.push_back(sessionPtr_->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
+  }
+  // the action is the output named "action", or the first output for policies exported without output names
+  const auto actionNameItr = std::find_if(outputNames_.cbegin(), outputNames_.cend(),
+                                          [](const char* name) { return std::string(name) == "action"; });
+  actionOutputIndex_ = (actionNameItr != outputNames_.cend()) ? std::distance(outputNames_.cbegin(), actionNameItr) : 0;
+  // a dynamic dimension is reported as -1
+  hasDynamicBatchSize_ = inputShapes_[0][0] < 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxInferenceService::bindBuffers(size_t batchSize) {
+  if (batchSize == boundBatchSize_) {
+    return;
+  }
+
+  const int64_t observationDim = inputShapes_[0][1];
+  const int64_t actionDim = outputShapes_[actionOutputIndex_][1];
+  observationBuffer_.resize(observationDim, batchSize);
+  actionBuffer_.resize(actionDim, batchSize);
+
+  // the column-major buffers with one column per sample match the row-major (batch x dimension) tensors
+  const std::vector<int64_t> observationShape{static_cast<int64_t>(batchSize), observationDim};
+  const std::vector<int64_t> actionShape{static_cast<int64_t>(batchSize), actionDim};
+  observationTensor_ = Ort::Value::CreateTensor<tensor_element_t>(memoryInfo_, observationBuffer_.data(), observationBuffer_.size(),
+                                                                  observationShape.data(), observationShape.size());
+  actionTensor_ = Ort::Value::CreateTensor<tensor_element_t>(memoryInfo_, actionBuffer_.data(), actionBuffer_.size(), actionShape.data(),
+                                                             actionShape.size());
+
+  ioBindingPtr_->ClearBoundInputs();
+  ioBindingPtr_->ClearBoundOutputs();
+  ioBindingPtr_->BindInput(inputNames_[0], observationTensor_);
+  ioBindingPtr_->BindOutput(outputNames_[actionOutputIndex_], actionTensor_);
+  boundBatchSize_ = batchSize;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxInferenceService::run() {
+  sessionPtr_->Run(runOptions_, *ioBindingPtr_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t MpcnetOnnxInferenceService::evaluate(const matrix_t& observations) {
+  std::lock_guard<std::mutex> lock(sessionMutex_);
+  inferenceTimer_.startTimer();
+  matrix_t actions = evaluateBatch(observations);
+  inferenceTimer_.endTimer();
+  numSamples_ += observations.cols();
+  return actions;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t MpcnetOnnxInferenceService::evaluateBatch(const matrix_t& observations) {
+  if (sessionPtr_ == nullptr) {
+    throw std::runtime_error("[MpcnetOnnxInferenceService::evaluate] cannot evaluate policy, since policy model is not loaded.");
+  }
+  if (observations.rows() != inputShapes_[0][1]) {
+    throw std::runtime_error("[MpcnetOnnxInferenceService::evaluate] observation dimension does not match the policy model.");
+  }
+
+  const size_t numSamples = observations.cols();
+  if (hasDynamicBatchSize_) {
+    // one run for the whole batch
+    bindBuffers(numSamples);
+    observationBuffer_ = observations.cast<tensor_element_t>();
+    run();
+    return actionBuffer_.cast<scalar_t>();
+  } else {
+    // the model has a fixed batch size of one
+    bindBuffers(1);
+    matrix_t actions(actionBuffer_.rows(), numSamples);
+    for (size_t i = 0; i < numSamples; i++) {
+      observationBuffer_ = observations.col(i).cast<tensor_element_t>();
+      run();
+      actions.col(i) = actionBuffer_.col(0).cast<scalar_t>();
+    }
+    return actions;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t MpcnetOnnxInferenceService::evaluate(const vector_t& observation) {
+  if (maxBatchSize_ == 1) {
+    return evaluate(matrix_t(observation)).col(0);
+  }
+
+  std::unique_lock<std::mutex> lock(requestMutex_);
+  // join the open batch or open a new one
+  if (openBatchPtr_ == nullptr) {
+    openBatchPtr_ = std::make_shared<PendingBatch>();
+    openBatchPtr_->observations.reserve(maxBatchSize_);
+  }
+  const auto batchPtr = openBatchPtr_;
+  const size_t index = batchPtr->observations.size();
+  batchPtr->observations.push_back(observation);
+  numPendingRequests_++;
+  auto isBatchFull = [&] { return batchPtr->observations.size() >= maxBatchSize_; };
+
+  if (index == 0) {
+    // the first request runs the batch once it is full or the session is free, optionally after waiting for further requests
+    if (maxWaitTime_ > 0.0) {
+      batchFullCondition_.wait_for(lock, std::chrono::duration<scalar_t>(maxWaitTime_), isBatchFull);
+    }
+    batchFullCondition_.wait(lock, [&] { return isBatchFull() || numEvaluatingBatches_ == 0; });
+    if (openBatchPtr_ == batchPtr) {
+      openBatchPtr_.reset();  // close the batch, later requests open the next one
+    }
+    numEvaluatingBatches_++;
+    lock.unlock();
+
+    try {
+      matrix_t observations(observation.size(), batchPtr->observations.size());
+      for (size_t i = 0; i < batchPtr->observations.size(); i++) {
+        observations.col(i) = batchPtr->observations[i];
+      }
+      batchPtr->actions = evaluate(observations);
+    } catch (...) {
+      batchPtr->exceptionPtr = std::current_exception();
+    }
+
+    lock.lock();
+    numEvaluatingBatches_--;
+    batchPtr->isDone = true;
+    batchDoneCondition_.notify_all();
+    batchFullCondition_.notify_all();  // the session is free for the next batch
+  } else {
+    if (isBatchFull()) {
+      openBatchPtr_.reset();
+      batchFullCondition_.notify_all();
+    }
+    batchDoneCondition_.wait(lock, [&] { return batchPtr->isDone; });
+  }
+  numPendingRequests_--;
+
+  if (batchPtr->exceptionPtr) {
+    std::rethrow_exception(batchPtr->exceptionPtr);
+  }
+  return batchPtr->actions.col(index);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto MpcnetOnnxInferenceService::getStatistics() const -> Statistics {
+  std::lock_guard<std::mutex> lock(sessionMutex_);
+  Statistics statistics;
+  statistics.numSamples = numSamples_;
+  statistics.numBatches = inferenceTimer_.getNumTimedIntervals();
+  statistics.inferenceTime = 1e-3 * inferenceTimer_.getTotalInMilliseconds();
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxInferenceService::resetStatistics() {
+  std::lock_guard<std::mutex> lock(sessionMutex_);
+  numSamples_ = 0;
+  inferenceTimer_.reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MpcnetOnnxInferenceService::getNumPendingRequests() const {
+  std::lock_guard<std::mutex> lock(requestMutex_);
+  return numPendingRequests_;
+}
+
+}  // namespace mpcnet
+}  // namespace ocs2
@@ -45,6 +45,7 @@ const data_array_t* MpcnetDataGeneration::run(scalar_t alpha, const std::string&
                                               const TargetTrajectories& targetTrajectories) {
   // clear data array
   dataArray_.clear();
+  writtenRecords_.clear();
 
   // set system
   set(alpha, policyFilePath, initialObservation, modeSchedule, targetTrajectories);
@@ -67,12 +68,12 @@ const data_array_t* MpcnetDataGeneration::run(scalar_t alpha, const std::string&
       if (iteration % dataDecimation == 0) {
         // get nominal data point
         const vector_t deviation = vector_t::Zero(primalSolution_.stateTrajectory_.front().size());
-        dataArray_.push_back(getDataPoint(*mpcPtr_, *mpcnetDefinitionPtr_, deviation));
+        storeDataPoint(getDataPoint(*mpcPtr_, *mpcnetDefinitionPtr_, deviation));
 
         // get samples around nominal data point
         for (int i = 0; i < nSamples; i++) {
           const vector_t deviation = L * vector_t::NullaryExpr(primalSolution_.stateTrajectory_.front().size(), standardNormalNullaryOp);
-          dataArray_.push_back(getDataPoint(*mpcPtr_, *mpcnetDefinitionPtr_, deviation));
+          storeDataPoint(getDataPoint(*mpcPtr_, *mpcnetDefinitionPtr_, deviation));
         }
       }
 
@@ -84,11 +85,26 @@ const data_array_t* MpcnetDataGeneration::run(scalar_t alpha, const std::string&
     std::cerr << "[MpcnetDataGeneration::run] a standard exception was caught, with message: " << e.what() << "\n";
     // this data generation run failed, clear data
     dataArray_.clear();
+    for (const auto index : writtenRecords_) {
+      dataWriterPtr_->invalidate(index);
+    }
+    writtenRecords_.clear();
   }
 
   // return pointer to the data array
   return &dataArray_;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetDataGeneration::storeDataPoint(const data_point_t& dataPoint) {
+  if (dataWriterPtr_ != nullptr) {
+    writtenRecords_.push_back(dataWriterPtr_->write(dataPoint));
+  } else {
+    dataArray_.push_back(dataPoint);
+  }
+}
+
 }  // namespace mpcnet
 }  // namespace ocs2
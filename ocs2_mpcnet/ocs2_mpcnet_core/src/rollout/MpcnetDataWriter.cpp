@@ -0,0 +1,265 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include "ocs2_mpcnet_core/rollout/MpcnetDataWriter.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace ocs2 {
+namespace mpcnet {
+
+namespace {
+static_assert(sizeof(scalar_t) == sizeof(uint64_t), "The record layout assumes 8-byte scalars.");
+
+using row_major_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+std::string getErrorMessage(const std::string& where, const std::string& what) {
+  return "[MpcnetDataWriter::" + where + "] " + what + ": " + std::strerror(errno);
+}
+}  // namespace
+
+constexpr uint64_t MpcnetDataWriter::magic;
+constexpr uint64_t MpcnetDataWriter::version;
+constexpr size_t MpcnetDataWriter::headerSize;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcnetDataWriter::MpcnetDataWriter(const std::string& filePath, size_t chunkSize) : filePath_(filePath), chunkSize_(chunkSize) {
+  if (chunkSize_ == 0) {
+    throw std::runtime_error("[MpcnetDataWriter::MpcnetDataWriter] chunkSize must be positive.");
+  }
+  fileDescriptor_ = ::open(filePath_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fileDescriptor_ < 0) {
+    throw std::runtime_error(getErrorMessage("MpcnetDataWriter", "cannot open " + filePath_));
+  }
+  if (::ftruncate(fileDescriptor_, headerSize) != 0) {
+    ::close(fileDescriptor_);
+    throw std::runtime_error(getErrorMessage("MpcnetDataWriter", "cannot resize " + filePath_));
+  }
+  void* headerAddress = ::mmap(nullptr, headerSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor_, 0);
+  if (headerAddress == MAP_FAILED) {
+    ::close(fileDescriptor_);
+    throw std::runtime_error(getErrorMessage("MpcnetDataWriter", "cannot map " + filePath_));
+  }
+  header_ = static_cast<uint64_t*>(headerAddress);
+  writeHeader();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MpcnetDataWriter::~MpcnetDataWriter() {
+  flush();
+  for (const auto& chunk : chunks_) {
+    ::munmap(chunk.mapAddress, chunk.mapLength);
+  }
+  ::munmap(header_, headerSize);
+  ::close(fileDescriptor_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MpcnetDataWriter::write(const data_point_t& dataPoint) {
+  const size_t X = dataPoint.x.size();
+  const size_t U = dataPoint.u.size();
+  const size_t O = dataPoint.observation.size();
+  const size_t A = dataPoint.actionTransformation.first.cols();
+
+  // reserve a record, the mapped chunks stay valid while other threads fill their records
+  size_t index;
+  char* record;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (recordSize_ == 0) {
+      initializeLayout(dataPoint);
+    }
+    checkDimensions(dataPoint);
+    if (numRecords_ >= chunks_.size() * chunkSize_) {
+      mapChunk();
+    }
+    index = numRecords_++;
+    record = getRecord(index);
+  }
+
+  auto* words = reinterpret_cast<uint64_t*>(record);
+  words[0] = 0;
+  words[1] = dataPoint.mode;
+  scalar_t* values = reinterpret_cast<scalar_t*>(record) + 2;
+  *values++ = dataPoint.t;
+  vector_t::Map(values, X) = dataPoint.x;
+  values += X;
+  vector_t::Map(values, U) = dataPoint.u;
+  values += U;
+  vector_t::Map(values, O) = dataPoint.observation;
+  values += O;
+  row_major_matrix_t::Map(values, U, A) = dataPoint.actionTransformation.first;
+  values += U * A;
+  vector_t::Map(values, U) = dataPoint.actionTransformation.second;
+  values += U;
+  *values++ = dataPoint.hamiltonian.f;
+  vector_t::Map(values, X) = dataPoint.hamiltonian.dfdx;
+  values += X;
+  vector_t::Map(values, U) = dataPoint.hamiltonian.dfdu;
+  values += U;
+  row_major_matrix_t::Map(values, X, X) = dataPoint.hamiltonian.dfdxx;
+  values += X * X;
+  row_major_matrix_t::Map(values, U, X) = dataPoint.hamiltonian.dfdux;
+  values += U * X;
+  row_major_matrix_t::Map(values, U, U) = dataPoint.hamiltonian.dfduu;
+  words[0] = 1;
+
+  return index;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetDataWriter::invalidate(size_t index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index >= numRecords_) {
+    throw std::runtime_error("[MpcnetDataWriter::invalidate] record index out of range.");
+  }
+  reinterpret_cast<uint64_t*>(getRecord(index))[0] = 0;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetDataWriter::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  numRecords_ = 0;
+  writeHeader();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MpcnetDataWriter::flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  writeHeader();
+  for (const auto& chunk : chunks_) {
+    ::msync(chunk.mapAddress, chunk.mapLength, MS_ASYNC);
+  }
+  ::msync(header_, headerSize, MS_ASYNC);
+  return numRecords_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MpcnetDataWriter::getNumRecords() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return numRecords_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetDataWriter::initializeLayout(const data_point_t& dataPoint) {
+  stateDim_ = dataPoint.x.size();
+  inputDim_ = dataPoint.u.size();
+  observationDim_ = dataPoint.observation.size();
+  actionDim_ = dataPoint.actionTransformation.first.cols();
+  const size_t X = stateDim_;
+  const size_t U = inputDim_;
+  const size_t numWords = 2 + 1 + X + U + observationDim_ + U * actionDim_ + U + 1 + X + U + X * X + U * X + U * U;
+  recordSize_ = numWords * sizeof(scalar_t);
+  writeHeader();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetDataWriter::checkDimensions(const data_point_t& dataPoint) const {
+  const size_t X = stateDim_;
+  const size_t U = inputDim_;
+  const auto& actionTransformation = dataPoint.actionTransformation;
+  const auto& hamiltonian = dataPoint.hamiltonian;
+  const bool isValid = dataPoint.x.size() == X && dataPoint.u.size() == U && dataPoint.observation.size() == observationDim_ &&
+                       actionTransformation.first.rows() == U && actionTransformation.first.cols() == actionDim_ &&
+                       actionTransformation.second.size() == U && hamiltonian.dfdx.size() == X && hamiltonian.dfdu.size() == U &&
+                       hamiltonian.dfdxx.rows() == X && hamiltonian.dfdxx.cols() == X && hamiltonian.dfdux.rows() == U &&
+                       hamiltonian.dfdux.cols() == X && hamiltonian.dfduu.rows() == U && hamiltonian.dfduu.cols() == U;
+  if (!isValid) {
+    throw std::runtime_error("[MpcnetDataWriter::write] the dimensions of the data point do not match the record layout of the file.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+char* MpcnetDataWriter::getRecord(size_t index) const {
+  return chunks_[index / chunkSize_].records + (index % chunkSize_) * recordSize_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetDataWriter::mapChunk() {
+  const size_t chunkLength = chunkSize_ * recordSize_;
+  const size_t chunkOffset = headerSize + chunks_.size() * chunkLength;
+  if (::ftruncate(fileDescriptor_, chunkOffset + chunkLength) != 0) {
+    throw std::runtime_error(getErrorMessage("write", "cannot grow " + filePath_));
+  }
+  // mmap requires offsets that are multiples of the page size
+  const size_t pageSize = ::sysconf(_SC_PAGE_SIZE);
+  const size_t mapOffset = chunkOffset - chunkOffset % pageSize;
+  const size_t mapLength = chunkLength + (chunkOffset - mapOffset);
+  void* mapAddress = ::mmap(nullptr, mapLength, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor_, mapOffset);
+  if (mapAddress == MAP_FAILED) {
+    throw std::runtime_error(getErrorMessage("write", "cannot map " + filePath_));
+  }
+  chunks_.push_back({mapAddress, mapLength, static_cast<char*>(mapAddress) + (chunkOffset - mapOffset)});
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetDataWriter::writeHeader() {
+  header_[0] = magic;
+  header_[1] = version;
+  header_[2] = stateDim_;
+  header_[3] = inputDim_;
+  header_[4] = observationDim_;
+  header_[5] = actionDim_;
+  header_[6] = recordSize_;
+  header_[7] = numRecords_;
+}
+
+}  // namespace mpcnet
+}  // namespace ocs2
@@ -81,6 +81,13 @@ void MpcnetRolloutManager::startDataGeneration(scalar_t alpha, const std::string
   // reset variables
   dataGenerationFtrs_.clear();
   nDataGenerationTasksDone_ = 0;
+  if (dataWriterPtr_ != nullptr) {
+    dataWriterPtr_->clear();
+  }
+  if (dataGenerationInferencePtr_ != nullptr) {
+    dataGenerationInferencePtr_->resetStatistics();
+  }
+  dataGenerationStartTime_ = std::chrono::steady_clock::now();
 
   // push tasks into pool
   for (int i = 0; i < initialObservations.size(); i++) {
@@ -145,6 +152,10 @@ const data_array_t& MpcnetRolloutManager::getGeneratedData() {
     }
   }
 
+  if (dataGenerationInferencePtr_ != nullptr) {
+    printInferenceStatistics("Data generation", *dataGenerationInferencePtr_, dataGenerationStartTime_);
+  }
+
   // find number of data points
   int nDataPoints = 0;
   for (int i = 0; i < dataPtrs.size(); i++) {
@@ -161,6 +172,51 @@ const data_array_t& MpcnetRolloutManager::getGeneratedData() {
   return dataArray_;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetRolloutManager::setDataFile(const std::string& filePath, size_t chunkSize) {
+  if (nDataGenerationThreads_ <= 0) {
+    throw std::runtime_error("[MpcnetRolloutManager::setDataFile] cannot work without at least one data generation thread.");
+  }
+  if (!dataGenerationFtrs_.empty() && !isDataGenerationDone()) {
+    throw std::runtime_error("[MpcnetRolloutManager::setDataFile] cannot set data file while data generation is running.");
+  }
+
+  dataWriterPtr_ = std::make_shared<MpcnetDataWriter>(filePath, chunkSize);
+  for (auto& dataGenerationPtr : dataGenerationPtrs_) {
+    dataGenerationPtr->setDataWriter(dataWriterPtr_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MpcnetRolloutManager::flushGeneratedData() {
+  if (dataWriterPtr_ == nullptr) {
+    throw std::runtime_error("[MpcnetRolloutManager::flushGeneratedData] cannot flush data without a data file.");
+  }
+  if (!isDataGenerationDone()) {
+    throw std::runtime_error("[MpcnetRolloutManager::flushGeneratedData] cannot flush data when data generation is not done.");
+  }
+
+  // get results from futures of the tasks, the data itself has already been written to the file
+  for (auto& dataGenerationFtr : dataGenerationFtrs_) {
+    try {
+      dataGenerationFtr.get();
+    } catch (const std::exception& e) {
+      // print error for exceptions
+      std::cerr << "[MpcnetRolloutManager::flushGeneratedData] a standard exception was caught, with message: " << e.what() << "\n";
+    }
+  }
+
+  if (dataGenerationInferencePtr_ != nullptr) {
+    printInferenceStatistics("Data generation", *dataGenerationInferencePtr_, dataGenerationStartTime_);
+  }
+
+  return dataWriterPtr_->flush();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -175,6 +231,10 @@ void MpcnetRolloutManager::startPolicyEvaluation(scalar_t alpha, const std::stri
   // reset variables
   policyEvaluationFtrs_.clear();
   nPolicyEvaluationTasksDone_ = 0;
+  if (policyEvaluationInferencePtr_ != nullptr) {
+    policyEvaluationInferencePtr_->resetStatistics();
+  }
+  policyEvaluationStartTime_ = std::chrono::steady_clock::now();
 
   // push tasks into pool
   for (int i = 0; i < initialObservations.size(); i++) {
@@ -235,9 +295,36 @@ metrics_array_t MpcnetRolloutManager::getComputedMetrics() {
     }
   }
 
+  if (policyEvaluationInferencePtr_ != nullptr) {
+    printInferenceStatistics("Policy evaluation", *policyEvaluationInferencePtr_, policyEvaluationStartTime_);
+  }
+
   // return metrics array
   return metricsArray;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetRolloutManager::setInferenceServices(std::shared_ptr<MpcnetOnnxInferenceService> dataGenerationInferencePtr,
+                                                std::shared_ptr<MpcnetOnnxInferenceService> policyEvaluationInferencePtr) {
+  dataGenerationInferencePtr_ = std::move(dataGenerationInferencePtr);
+  policyEvaluationInferencePtr_ = std::move(policyEvaluationInferencePtr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetRolloutManager::printInferenceStatistics(const std::string& name, const MpcnetOnnxInferenceService& inferenceService,
+                                                    std::chrono::steady_clock::time_point startTime) {
+  const auto statistics = inferenceService.getStatistics();
+  const scalar_t wallTime = std::chrono::duration<scalar_t>(std::chrono::steady_clock::now() - startTime).count();
+  const auto perSecond = [](size_t count, scalar_t time) { return time > 0.0 ? static_cast<scalar_t>(count) / time : 0.0; };
+  const scalar_t averageBatchSize = statistics.numBatches > 0 ? static_cast<scalar_t>(statistics.numSamples) / statistics.numBatches : 0.0;
+  std::cerr << name << " inference: " << statistics.numSamples << " samples in " << statistics.numBatches << " batches (average size "
+            << averageBatchSize << "), " << perSecond(statistics.numSamples, statistics.inferenceTime) << " samples/s in inference, "
+            << perSecond(statistics.numSamples, wallTime) << " samples/s over " << wallTime << " s wall time\n";
+}
+
 }  // namespace mpcnet
 }  // namespace ocs2
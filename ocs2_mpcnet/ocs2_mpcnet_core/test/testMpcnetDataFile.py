@@ -0,0 +1,146 @@
+###############################################################################
+# Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#  * Redistributions of source code must retain the above copyright notice, this
+#   list of conditions and the following disclaimer.
+#
+#  * Redistributions in binary form must reproduce the above copyright notice,
+#   this list of conditions and the following disclaimer in the documentation
+#   and/or other materials provided with the distribution.
+#
+#  * Neither the name of the copyright holder nor the names of its
+#   contributors may be used to endorse or promote products derived from
+#   this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+###############################################################################
+
+import os
+import tempfile
+import unittest
+
+import numpy as np
+
+from ocs2_mpcnet_core import helper
+from ocs2_mpcnet_core import DataPoint, DataWriter, ScalarFunctionQuadraticApproximation
+
+
+class data_file_tests(unittest.TestCase):
+    def setUp(self):
+        self.state_dim = 3
+        self.input_dim = 2
+        self.observation_dim = 4
+        self.action_dim = 5
+        self.directory = tempfile.TemporaryDirectory()
+        self.file_path = os.path.join(self.directory.name, "data.bin")
+        self.rng = np.random.default_rng(0)
+
+    def tearDown(self):
+        self.directory.cleanup()
+
+    def random_data_point(self, mode):
+        X, U, O, A = self.state_dim, self.input_dim, self.observation_dim, self.action_dim
+        data_point = DataPoint()
+        data_point.mode = mode
+        data_point.t = self.rng.standard_normal()
+        data_point.x = self.rng.standard_normal(X)
+        data_point.u = self.rng.standard_normal(U)
+        data_point.observation = self.rng.standard_normal(O)
+        data_point.actionTransformation = (self.rng.standard_normal((U, A)), self.rng.standard_normal(U))
+        hamiltonian = ScalarFunctionQuadraticApproximation()
+        hamiltonian.f = self.rng.standard_normal()
+        hamiltonian.dfdx = self.rng.standard_normal(X)
+        hamiltonian.dfdu = self.rng.standard_normal(U)
+        hamiltonian.dfdxx = self.rng.standard_normal((X, X))
+        hamiltonian.dfdux = self.rng.standard_normal((U, X))
+        hamiltonian.dfduu = self.rng.standard_normal((U, U))
+        data_point.hamiltonian = hamiltonian
+        return data_point
+
+    def test_field_layout(self):
+        # offsets and types of the record layout documented in MpcnetDataWriter.h
+        X, U, O, A = self.state_dim, self.input_dim, self.observation_dim, self.action_dim
+        layout = [
+            ("valid", "<u8", ()),
+            ("mode", "<u8", ()),
+            ("t", "<f8", ()),
+            ("x", "<f8", (X,)),
+            ("u", "<f8", (U,)),
+            ("observation", "<f8", (O,)),
+            ("action_transformation_matrix", "<f8", (U, A)),
+            ("action_transformation_vector", "<f8", (U,)),
+            ("H", "<f8", ()),
+            ("dHdx", "<f8", (X,)),
+            ("dHdu", "<f8", (U,)),
+            ("dHdxx", "<f8", (X, X)),
+            ("dHdux", "<f8", (U, X)),
+            ("dHduu", "<f8", (U, U)),
+        ]
+        dtype = helper.get_data_file_dtype(X, U, O, A)
+        self.assertEqual(list(dtype.names), [name for name, _, _ in layout])
+        offset = 0
+        for name, base, shape in layout:
+            field_dtype, field_offset = dtype.fields[name]
+            self.assertEqual(field_offset, offset, name)
+            self.assertEqual(field_dtype.base, np.dtype(base), name)
+            self.assertEqual(field_dtype.shape, shape, name)
+            offset += 8 * int(np.prod(shape))
+        self.assertEqual(dtype.itemsize, offset)
+
+    def test_round_trip(self):
+        # a small chunk size such that the records span several chunks
+        writer = DataWriter(self.file_path, 2)
+        data_points = [self.random_data_point(mode) for mode in range(5)]
+        indices = [writer.write(data_point) for data_point in data_points]
+        writer.invalidate(indices[1])
+        self.assertEqual(writer.flush(), len(data_points))
+
+        header = np.fromfile(self.file_path, dtype="<u8", count=8)
+        self.assertEqual(int(header[0]), helper.DATA_FILE_MAGIC)
+        self.assertEqual(int(header[1]), helper.DATA_FILE_VERSION)
+        self.assertEqual(
+            [int(h) for h in header[2:6]], [self.state_dim, self.input_dim, self.observation_dim, self.action_dim]
+        )
+        self.assertEqual(int(header[7]), len(data_points))
+
+        data = helper.map_data_file(self.file_path)
+        expected = [data_point for index, data_point in zip(indices, data_points) if index != indices[1]]
+        self.assertEqual(len(data), len(expected))
+        for record, data_point in zip(data, expected):
+            self.assertEqual(record["valid"], 1)
+            self.assertEqual(record["mode"], data_point.mode)
+            self.assertEqual(record["t"], data_point.t)
+            np.testing.assert_array_equal(record["x"], data_point.x)
+            np.testing.assert_array_equal(record["u"], data_point.u)
+            np.testing.assert_array_equal(record["observation"], data_point.observation)
+            np.testing.assert_array_equal(record["action_transformation_matrix"], data_point.actionTransformation[0])
+            np.testing.assert_array_equal(record["action_transformation_vector"], data_point.actionTransformation[1])
+            np.testing.assert_array_equal(record["H"], data_point.hamiltonian.f)
+            np.testing.assert_array_equal(record["dHdx"], data_point.hamiltonian.dfdx)
+            np.testing.assert_array_equal(record["dHdu"], data_point.hamiltonian.dfdu)
+            np.testing.assert_array_equal(record["dHdxx"], data_point.hamiltonian.dfdxx)
+            np.testing.assert_array_equal(record["dHdux"], data_point.hamiltonian.dfdux)
+            np.testing.assert_array_equal(record["dHduu"], data_point.hamiltonian.dfduu)
+
+    def test_empty_file(self):
+        writer = DataWriter(self.file_path)
+        self.assertEqual(writer.flush(), 0)
+        data = helper.map_data_file(self.file_path)
+        self.assertEqual(len(data), 0)
+        self.assertEqual(data.dtype.names[0], "valid")
+
+
+if __name__ == "__main__":
+    unittest.main()
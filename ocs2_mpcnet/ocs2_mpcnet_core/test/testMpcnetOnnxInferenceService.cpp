@@ -0,0 +1,137 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "ocs2_mpcnet_core/control/MpcnetOnnxInferenceService.h"
+
+using namespace ocs2;
+using namespace ocs2::mpcnet;
+
+namespace {
+
+/** Inference service with a mocked session: the action is twice the observation. The first batch can be held back. */
+class MockInferenceService final : public MpcnetOnnxInferenceService {
+ public:
+  MockInferenceService(size_t maxBatchSize, scalar_t maxWaitTime) : MpcnetOnnxInferenceService(nullptr, maxBatchSize, maxWaitTime) {}
+
+  std::vector<size_t> batchSizes;
+  std::atomic_bool holdFirstBatch{false};
+  std::atomic_bool isFirstBatchRunning{false};
+
+ protected:
+  matrix_t evaluateBatch(const matrix_t& observations) override {
+    batchSizes.push_back(observations.cols());
+    if (batchSizes.size() == 1) {
+      isFirstBatchRunning = true;
+      while (holdFirstBatch) {
+        std::this_thread::yield();
+      }
+    }
+    return 2.0 * observations;
+  }
+};
+
+/** Evaluates one observation per thread and checks that each thread receives its own action. */
+void evaluateInThreads(MockInferenceService& service, size_t numThreads) {
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < numThreads; i++) {
+    threads.emplace_back([&service, i]() {
+      const vector_t observation = vector_t::Constant(3, static_cast<scalar_t>(i));
+      const vector_t action = service.evaluate(observation);
+      EXPECT_TRUE(action.isApprox(2.0 * observation)) << "thread " << i << " received " << action.transpose();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // unnamed namespace
+
+TEST(MpcnetOnnxInferenceService, coalesceUntilBatchIsFull) {
+  // the first request waits for the batch to fill up, which happens long before the maximum wait time
+  constexpr size_t numThreads = 4;
+  MockInferenceService service(numThreads, 10.0);
+  evaluateInThreads(service, numThreads);
+
+  ASSERT_EQ(service.batchSizes.size(), 1);
+  EXPECT_EQ(service.batchSizes.front(), numThreads);
+  const auto statistics = service.getStatistics();
+  EXPECT_EQ(statistics.numSamples, numThreads);
+  EXPECT_EQ(statistics.numBatches, 1);
+  EXPECT_EQ(service.getNumPendingRequests(), 0);
+}
+
+TEST(MpcnetOnnxInferenceService, waitAtMostMaxWaitTime) {
+  constexpr scalar_t maxWaitTime = 0.05;
+  MockInferenceService service(4, maxWaitTime);
+
+  const auto startTime = std::chrono::steady_clock::now();
+  const vector_t observation = vector_t::Ones(3);
+  EXPECT_TRUE(service.evaluate(observation).isApprox(2.0 * observation));
+  const std::chrono::duration<scalar_t> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+  EXPECT_GE(elapsedTime.count(), maxWaitTime);
+  ASSERT_EQ(service.batchSizes.size(), 1);
+  EXPECT_EQ(service.batchSizes.front(), 1);
+}
+
+TEST(MpcnetOnnxInferenceService, coalesceWhileSessionIsBusy) {
+  // without a wait time, a request on an idle session runs right away and the requests arriving meanwhile form the next batch
+  MockInferenceService service(4, 0.0);
+  service.holdFirstBatch = true;
+
+  std::thread firstThread([&service]() {
+    const vector_t observation = vector_t::Constant(3, -1.0);
+    EXPECT_TRUE(service.evaluate(observation).isApprox(2.0 * observation));
+  });
+  while (!service.isFirstBatchRunning) {
+    std::this_thread::yield();
+  }
+
+  constexpr size_t numThreads = 3;
+  std::thread otherThreads([&service]() { evaluateInThreads(service, numThreads); });
+  while (service.getNumPendingRequests() < numThreads + 1) {
+    std::this_thread::yield();
+  }
+  service.holdFirstBatch = false;
+  firstThread.join();
+  otherThreads.join();
+
+  const std::vector<size_t> expectedBatchSizes{1, numThreads};
+  EXPECT_EQ(service.batchSizes, expectedBatchSizes);
+  const auto statistics = service.getStatistics();
+  EXPECT_EQ(statistics.numSamples, numThreads + 1);
+  EXPECT_EQ(statistics.numBatches, 2);
+}
@@ -136,6 +136,12 @@ scalar_t computeCost(const OptimalControlProblem& problem, const scalar_t& time,
 ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
                                                      const vector_t& input);
 
+/**
+ * Same as above, but writes the approximation into a caller-provided output to reuse its memory.
+ */
+void approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state, const vector_t& input,
+                     ScalarFunctionQuadraticApproximation& cost);
+
 /**
  * Compute the total preJump cost (i.e. cost + softConstraints). It is assumed that the precomputation request is already made.
  */
@@ -148,6 +154,12 @@ scalar_t computeEventCost(const OptimalControlProblem& problem, const scalar_t&
 ScalarFunctionQuadraticApproximation approximateEventCost(const OptimalControlProblem& problem, const scalar_t& time,
                                                           const vector_t& state);
 
+/**
+ * Same as above, but writes the approximation into a caller-provided output to reuse its memory.
+ */
+void approximateEventCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                          ScalarFunctionQuadraticApproximation& cost);
+
 /**
  * Compute the total final cost (i.e. cost + softConstraints). It is assumed that the precomputation request is already made.
  */
@@ -160,6 +172,12 @@ scalar_t computeFinalCost(const OptimalControlProblem& problem, const scalar_t&
 ScalarFunctionQuadraticApproximation approximateFinalCost(const OptimalControlProblem& problem, const scalar_t& time,
                                                           const vector_t& state);
 
+/**
+ * Same as above, but writes the approximation into a caller-provided output to reuse its memory.
+ */
+void approximateFinalCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                          ScalarFunctionQuadraticApproximation& cost);
+
 /**
  * Compute the intermediate-time Metrics (i.e. cost, softConstraints, and constraints).
  *
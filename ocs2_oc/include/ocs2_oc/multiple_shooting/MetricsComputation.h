@@ -60,6 +60,31 @@ Metrics computeMetrics(const EventTranscription& transcription);
  */
 Metrics computeMetrics(const TerminalTranscription& transcription);
 
+/**
+ * Same as above, but writes into caller-provided Metrics. When the Metrics are kept between calls, e.g. one per node of the horizon,
+ * the memory of its members is reused.
+ *
+ * @param transcription: multiple shooting transcription for an intermediate node.
+ * @param [out] metrics: Metrics for a single intermediate node.
+ */
+void computeMetrics(const Transcription& transcription, Metrics& metrics);
+
+/**
+ * Same as above, but writes into caller-provided Metrics.
+ *
+ * @param transcription: multiple shooting transcription for event node.
+ * @param [out] metrics: Metrics for a event node.
+ */
+void computeMetrics(const EventTranscription& transcription, Metrics& metrics);
+
+/**
+ * Same as above, but writes into caller-provided Metrics.
+ *
+ * @param transcription: multiple shooting transcription for terminal node.
+ * @param [out] metrics: Metrics for a terminal node.
+ */
+void computeMetrics(const TerminalTranscription& transcription, Metrics& metrics);
+
 /**
  * Compute the Metrics for a single intermediate node.
  * @param optimalControlProblem : Definition of the optimal control problem
@@ -79,7 +79,18 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
 
 /**
- * Apply the state-input equality constraint projection for a single intermediate node transcription.
+ * Same as above, but writes into a caller-provided transcription. When the transcription is kept between calls, e.g. one per node of the
+ * horizon, the memory of its members is reused and the setup does not allocate as long as the problem's sizes do not change.
+ * The constraint projection and its multiplier coefficients are left untouched, they are only written by projectTranscription().
+ *
+ * @param [out] transcription : multiple shooting transcription for this node.
+ */
+void setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer, scalar_t t,
+                           scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u, Transcription& transcription);
+
+/**
+ * Apply the state-input equality constraint projection for a single intermediate node transcription. The projection terms are written
+ * into the memory of the transcription's previous projection. Without state-input equality constraints, the projection is cleared.
  *
  * @param transcription : Transcription for a single intermediate node
  * @param extractProjectionMultiplier : Whether to extract the projection multiplier.
@@ -106,6 +117,13 @@ struct TerminalTranscription {
  */
 TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x);
 
+/**
+ * Same as above, but writes into a caller-provided transcription to reuse its memory.
+ *
+ * @param [out] transcription : multiple shooting transcription for the terminal node.
+ */
+void setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, TerminalTranscription& transcription);
+
 /**
  * Results of the transcription at an event
  */
@@ -128,5 +146,13 @@ struct EventTranscription {
  */
 EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next);
 
+/**
+ * Same as above, but writes into a caller-provided transcription to reuse its memory.
+ *
+ * @param [out] transcription : multiple shooting transcription for the event node.
+ */
+void setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                    EventTranscription& transcription);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
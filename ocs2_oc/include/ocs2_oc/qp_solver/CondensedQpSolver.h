@@ -0,0 +1,116 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/oc_problem/OcpSize.h"
+#include "ocs2_oc/qp_solver/ParallelRiccatiSolver.h"
+
+namespace ocs2 {
+
+/**
+ * Solves the unconstrained linear quadratic optimal control problem of ParallelRiccatiSolver after condensing.
+ *
+ * The stages are grouped into blocks of blockSize stages. The states inside a block are eliminated with the dynamics, such that each
+ * block becomes a single stage with the stacked inputs of the block (partial condensing). The condensed problem is solved with a Riccati
+ * recursion and the eliminated states are recovered by a forward simulation inside each block. The initial state is known, so the first
+ * block also eliminates x_0. With blockSize >= N the problem is fully condensed: one stage without state, whose Riccati step is the dense
+ * Cholesky solve of the QP in the inputs.
+ *
+ * Condensing trades the per-stage work of the Riccati recursion against dense operations on the stacked inputs. It pays off for short
+ * horizons and small input dimensions, selectBlockSize() estimates the best block size from the problem sizes.
+ *
+ * The blocks are condensed and expanded in parallel. The Riccati feedback of the original problem is not available, only the optimal
+ * trajectories.
+ */
+class CondensedQpSolver {
+ public:
+  /**
+   * Solves the LQ problem.
+   *
+   * @param [in] x0 : Initial state (deviation).
+   * @param [in] dynamics : Linearized approximation of the discrete dynamics.
+   * @param [in] cost : Quadratic approximation of the cost.
+   * @param [in] blockSize : Number of stages condensed into one stage.
+   * @param [in] threadPool : Thread pool that runs the parallel passes.
+   * @param [in] numThreads : Number of threads that take part in the parallel passes, including the calling thread.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @return true if the solve succeeded, false if a condensed Hessian was not positive definite or the solution is not finite.
+   */
+  bool solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, int blockSize, ThreadPool& threadPool, int numThreads,
+             vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
+
+  /**
+   * Estimates the number of floating point operations (multiply-adds) to solve a problem of the given size. A per-stage overhead is
+   * added to account for the lower efficiency of the small matrix operations in the sparse recursion.
+   *
+   * @param [in] ocpSize : Size of the problem.
+   * @param [in] blockSize : Number of stages condensed into one stage, 1 is the sparse Riccati recursion without condensing.
+   * @return Estimated cost.
+   */
+  static scalar_t estimateFlops(const OcpSize& ocpSize, int blockSize);
+
+  /** Returns the block size with the lowest estimated cost, 1 if condensing does not pay off. */
+  static int selectBlockSize(const OcpSize& ocpSize);
+
+ private:
+  /** Scratch memory of one worker, reused across solves. */
+  struct Workspace {
+    matrix_t Gamma;  // d x_k / d x_s
+    matrix_t Phi;    // d x_k / d U
+    vector_t c;      // x_k for x_s = 0 and U = 0
+    matrix_t QGamma;
+    matrix_t QPhi;
+    matrix_t tmp;
+    vector_t w;
+  };
+
+  /** Condenses the stages of block b into stage b of the condensed problem. */
+  void condenseBlock(int b, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     const std::vector<ScalarFunctionQuadraticApproximation>& cost, Workspace& workspace);
+
+  /** Recovers the states and inputs of block b from the solution of the condensed problem. */
+  void expandBlock(int b, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                   vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) const;
+
+  std::vector<int> blockStart_;  // First stage of each block, with an extra entry N at the end
+  std::vector<VectorFunctionLinearApproximation> condensedDynamics_;
+  std::vector<ScalarFunctionQuadraticApproximation> condensedCost_;
+  vector_array_t condensedStateTrajectory_;
+  vector_array_t condensedInputTrajectory_;
+  std::vector<Workspace> workspaces_;
+  ParallelRiccatiSolver riccatiSolver_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,151 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/**
+ * Solves the unconstrained linear quadratic optimal control problem
+ *
+ *   min  sum_k 0.5 [x_k; u_k]' [Q_k, S_k'; S_k, R_k] [x_k; u_k] + q_k' x_k + r_k' u_k  +  0.5 x_N' Q_N x_N + q_N' x_N
+ *   s.t. x_{k+1} = A_k x_k + B_k u_k + b_k,  x_0 given,
+ *
+ * with a Riccati recursion that is parallel in time. The backward pass is written as an associative scan over the conditional value
+ * functions of the stages, see S. Särkkä and Á. F. García-Fernández, "Temporal Parallelization of Dynamic Programming and Linear
+ * Quadratic Control", IEEE TAC 2023. The horizon is partitioned into one chunk per thread:
+ *  1. Every chunk combines the elements of its stages backwards. The last chunk holds the terminal cost and runs the standard
+ *     Riccati recursion instead.
+ *  2. The cost-to-go at the first node of each chunk is propagated serially from the back, one combination per chunk.
+ *  3. Every chunk combines its partial elements with the cost-to-go at its end node and computes the feedback gains.
+ * The forward rollout is serial.
+ *
+ * A combination of two elements costs a few times more than a Riccati step. The solver therefore pays off on long horizons with
+ * several threads, with a single thread it falls back to the standard Riccati recursion. The stage cost must have a positive definite
+ * input Hessian R_k, because the inputs are eliminated from the stage elements.
+ *
+ * The problem data uses the same layout as HpipmInterface: dynamics holds the N stages (dfdx = A, dfdu = B, f = b), and cost holds
+ * the N+1 nodes (dfdxx = Q, dfdux = S, dfduu = R, dfdx = q, dfdu = r). State and input sizes may vary over the horizon.
+ */
+class ParallelRiccatiSolver {
+ public:
+  /**
+   * Solves the LQ problem.
+   *
+   * @param [in] x0 : Initial state (deviation).
+   * @param [in] dynamics : Linearized approximation of the discrete dynamics.
+   * @param [in] cost : Quadratic approximation of the cost.
+   * @param [in] threadPool : Thread pool that runs the parallel passes.
+   * @param [in] numThreads : Number of threads that take part in the parallel passes, including the calling thread.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @return true if the solve succeeded, false if a Hessian was not positive definite or the solution is not finite.
+   */
+  bool solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, ThreadPool& threadPool, int numThreads,
+             vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
+
+  /**
+   * Return the Riccati cost-to-go for the previously solved problem.
+   *
+   * Cost-to-go at a node is: V_k(x) = 0.5 * x' * dfdxx * x + x' * dfdx + f
+   * As in HpipmInterface, the value for f is set to 0.0.
+   */
+  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo() const;
+
+  /** Return the sequence of N feedback matrices K of the optimal solution u = K x + k for the previously solved problem. */
+  const matrix_array_t& getRiccatiFeedback() const { return feedback_; }
+
+  /** Return the sequence of N feedforward vectors k of the optimal solution u = K x + k for the previously solved problem. */
+  const vector_array_t& getRiccatiFeedforward() const { return feedforward_; }
+
+ private:
+  /**
+   * Conditional value function of a piece of the horizon from node i to node j:
+   *   V_ij(x_i, x_j) = max_lambda 0.5 x_i' J x_i - eta' x_i + lambda' (x_j - A x_i - b) - 0.5 lambda' C lambda
+   * A piece that ends at the terminal node has A = 0, b = 0, and C = 0.
+   */
+  struct Element {
+    matrix_t A;
+    vector_t b;
+    matrix_t C;
+    vector_t eta;
+    matrix_t J;
+  };
+
+  /** Scratch memory of one chunk, reused across solves. */
+  struct Workspace {
+    Eigen::LLT<matrix_t> llt;
+    Eigen::PartialPivLU<matrix_t> lu;
+    matrix_t M;
+    matrix_t rhs;
+    matrix_t sol;
+    matrix_t tmp;
+    vector_t w;
+    vector_t g;
+  };
+
+  /** Sets up the element of stage k, the input is eliminated. Returns false if R_k is not positive definite. */
+  bool setupStageElement(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                         Element& element, Workspace& workspace) const;
+
+  /** Combines the element of a piece i->j with the element of the following piece j->k. The result i->k is written to first. */
+  void combineElements(Element& first, const Element& second, Workspace& workspace) const;
+
+  /** Cost-to-go at node k from the element of the piece k->j and the cost-to-go at node j. */
+  void valueFromElement(const Element& element, const matrix_t& Pj, const vector_t& pj, matrix_t& Pk, vector_t& pk,
+                        Workspace& workspace) const;
+
+  /**
+   * Computes the gains of stage k from the cost-to-go at node k+1. If requested, also computes the cost-to-go at node k.
+   * Returns false if the Hessian w.r.t. the input is not positive definite.
+   */
+  bool riccatiStep(int k, const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                   bool computeCostToGo, Workspace& workspace);
+
+  /** Splits the N+1 nodes into chunks, the last chunk holds the terminal node. */
+  void partitionHorizon(int N, int numThreads);
+
+  std::vector<int> chunkStart_;  // First node of each chunk, with an extra entry N+1 at the end
+  std::vector<Element> elements_;
+  std::vector<Workspace> workspaces_;
+
+  matrix_array_t costToGoHessian_;   // P_k
+  vector_array_t costToGoGradient_;  // p_k
+  matrix_array_t feedback_;          // K_k
+  vector_array_t feedforward_;       // k_k
+};
+
+}  // namespace ocs2
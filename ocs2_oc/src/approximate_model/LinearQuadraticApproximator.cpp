@@ -50,11 +50,11 @@ void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t ti
 
   // Dynamics
   modelData.dynamicsCovariance = problem.dynamicsPtr->dynamicsCovariance(time, state, input);
-  modelData.dynamics = problem.dynamicsPtr->linearApproximation(time, state, input, preComputation);
+  problem.dynamicsPtr->linearApproximation(time, state, input, preComputation, modelData.dynamics);
   modelData.dynamicsBias.setZero(modelData.dynamics.dfdx.rows());
 
   // Cost
-  modelData.cost = ocs2::approximateCost(problem, time, state, input);
+  ocs2::approximateCost(problem, time, state, input, modelData.cost);
 
   // Equality constraints
   modelData.stateEqConstraint = problem.stateEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
@@ -101,7 +101,7 @@ void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time,
   modelData.dynamicsBias.setZero(modelData.dynamics.dfdx.rows());
 
   // Pre-jump cost
-  modelData.cost = approximateEventCost(problem, time, state);
+  approximateEventCost(problem, time, state, modelData.cost);
 
   // state equality constraint
   modelData.stateEqConstraint = problem.preJumpEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
@@ -142,7 +142,7 @@ void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, co
   modelData.stateEqConstraint = problem.finalEqualityConstraintPtr->getLinearApproximation(time, state, preComputation);
 
   // Final cost
-  modelData.cost = approximateFinalCost(problem, time, state);
+  approximateFinalCost(problem, time, state, modelData.cost);
 
   // Lagrangians
   if (!problem.finalEqualityLagrangianPtr->empty()) {
@@ -180,32 +180,43 @@ scalar_t computeCost(const OptimalControlProblem& problem, const scalar_t& time,
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
                                                      const vector_t& input) {
+  ScalarFunctionQuadraticApproximation cost;
+  approximateCost(problem, time, state, input, cost);
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void approximateCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state, const vector_t& input,
+                     ScalarFunctionQuadraticApproximation& cost) {
   const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
   const auto& preComputation = *problem.preComputationPtr;
 
   // get the state-input cost approximations
-  auto cost = problem.costPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
+  problem.costPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
 
+  // the other collections are accumulated through a buffer which is reused between calls on the same thread
+  thread_local ScalarFunctionQuadraticApproximation tmpCost;
   if (!problem.softConstraintPtr->empty()) {
-    cost += problem.softConstraintPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
+    problem.softConstraintPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation, tmpCost);
+    cost += tmpCost;
   }
 
   // get the state only cost approximations
   if (!problem.stateCostPtr->empty()) {
-    auto stateCost = problem.stateCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-    cost.f += stateCost.f;
-    cost.dfdx += stateCost.dfdx;
-    cost.dfdxx += stateCost.dfdxx;
+    problem.stateCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation, tmpCost);
+    cost.f += tmpCost.f;
+    cost.dfdx += tmpCost.dfdx;
+    cost.dfdxx += tmpCost.dfdxx;
   }
 
   if (!problem.stateSoftConstraintPtr->empty()) {
-    auto stateCost = problem.stateSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-    cost.f += stateCost.f;
-    cost.dfdx += stateCost.dfdx;
-    cost.dfdxx += stateCost.dfdxx;
+    problem.stateSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation, tmpCost);
+    cost.f += tmpCost.f;
+    cost.dfdx += tmpCost.dfdx;
+    cost.dfdxx += tmpCost.dfdxx;
   }
-
-  return cost;
 }
 
 /******************************************************************************************************/
@@ -226,15 +237,25 @@ scalar_t computeEventCost(const OptimalControlProblem& problem, const scalar_t&
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation approximateEventCost(const OptimalControlProblem& problem, const scalar_t& time,
                                                           const vector_t& state) {
+  ScalarFunctionQuadraticApproximation cost;
+  approximateEventCost(problem, time, state, cost);
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void approximateEventCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                          ScalarFunctionQuadraticApproximation& cost) {
   const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
   const auto& preComputation = *problem.preComputationPtr;
 
-  auto cost = problem.preJumpCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
+  problem.preJumpCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
   if (!problem.preJumpSoftConstraintPtr->empty()) {
-    cost += problem.preJumpSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
+    thread_local ScalarFunctionQuadraticApproximation tmpCost;  // reused between calls on the same thread
+    problem.preJumpSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation, tmpCost);
+    cost += tmpCost;
   }
-
-  return cost;
 }
 
 /******************************************************************************************************/
@@ -255,15 +276,25 @@ scalar_t computeFinalCost(const OptimalControlProblem& problem, const scalar_t&
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation approximateFinalCost(const OptimalControlProblem& problem, const scalar_t& time,
                                                           const vector_t& state) {
+  ScalarFunctionQuadraticApproximation cost;
+  approximateFinalCost(problem, time, state, cost);
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void approximateFinalCost(const OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                          ScalarFunctionQuadraticApproximation& cost) {
   const auto& targetTrajectories = *problem.targetTrajectoriesPtr;
   const auto& preComputation = *problem.preComputationPtr;
 
-  auto cost = problem.finalCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
+  problem.finalCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
   if (!problem.finalSoftConstraintPtr->empty()) {
-    cost += problem.finalSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
+    thread_local ScalarFunctionQuadraticApproximation tmpCost;  // reused between calls on the same thread
+    problem.finalSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation, tmpCost);
+    cost += tmpCost;
   }
-
-  return cost;
 }
 
 /******************************************************************************************************/
@@ -60,6 +60,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // precondition
 #include <ocs2_oc/precondition/Ruzi.h>
 
+// qp_solver
+#include <ocs2_oc/qp_solver/CondensedQpSolver.h>
+#include <ocs2_oc/qp_solver/ParallelRiccatiSolver.h>
+
 // synchronized_module
 #include <ocs2_oc/synchronized_module/LoopshapingReferenceManager.h>
 #include <ocs2_oc/synchronized_module/LoopshapingSynchronizedModule.h>
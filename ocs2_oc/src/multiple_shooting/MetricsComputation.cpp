@@ -34,10 +34,36 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
+namespace {
+/** Clears the Lagrangian terms, which are not part of the metrics of a transcription. */
+void clearLagrangianMetrics(Metrics& metrics) {
+  metrics.stateEqLagrangian.clear();
+  metrics.stateIneqLagrangian.clear();
+  metrics.stateInputEqLagrangian.clear();
+  metrics.stateInputIneqLagrangian.clear();
+}
+}  // unnamed namespace
+
 Metrics computeMetrics(const Transcription& transcription) {
-  const auto& constraintsSize = transcription.constraintsSize;
+  Metrics metrics;
+  computeMetrics(transcription, metrics);
+  return metrics;
+}
+
+Metrics computeMetrics(const EventTranscription& transcription) {
+  Metrics metrics;
+  computeMetrics(transcription, metrics);
+  return metrics;
+}
 
+Metrics computeMetrics(const TerminalTranscription& transcription) {
   Metrics metrics;
+  computeMetrics(transcription, metrics);
+  return metrics;
+}
+
+void computeMetrics(const Transcription& transcription, Metrics& metrics) {
+  const auto& constraintsSize = transcription.constraintsSize;
 
   // Cost
   metrics.cost = transcription.cost.f;
@@ -46,21 +72,19 @@ Metrics computeMetrics(const Transcription& transcription) {
   metrics.dynamicsViolation = transcription.dynamics.f;
 
   // Equality constraints
-  metrics.stateEqConstraint = toConstraintArray(constraintsSize.stateEq, transcription.stateEqConstraints.f);
-  metrics.stateInputEqConstraint = toConstraintArray(constraintsSize.stateInputEq, transcription.stateInputEqConstraints.f);
+  toConstraintArray(constraintsSize.stateEq, transcription.stateEqConstraints.f, metrics.stateEqConstraint);
+  toConstraintArray(constraintsSize.stateInputEq, transcription.stateInputEqConstraints.f, metrics.stateInputEqConstraint);
 
   // Inequality constraints.
-  metrics.stateIneqConstraint = toConstraintArray(constraintsSize.stateIneq, transcription.stateIneqConstraints.f);
-  metrics.stateInputIneqConstraint = toConstraintArray(constraintsSize.stateInputIneq, transcription.stateInputIneqConstraints.f);
+  toConstraintArray(constraintsSize.stateIneq, transcription.stateIneqConstraints.f, metrics.stateIneqConstraint);
+  toConstraintArray(constraintsSize.stateInputIneq, transcription.stateInputIneqConstraints.f, metrics.stateInputIneqConstraint);
 
-  return metrics;
+  clearLagrangianMetrics(metrics);
 }
 
-Metrics computeMetrics(const EventTranscription& transcription) {
+void computeMetrics(const EventTranscription& transcription, Metrics& metrics) {
   const auto& constraintsSize = transcription.constraintsSize;
 
-  Metrics metrics;
-
   // Cost
   metrics.cost = transcription.cost.f;
 
@@ -68,29 +92,34 @@ Metrics computeMetrics(const EventTranscription& transcription) {
   metrics.dynamicsViolation = transcription.dynamics.f;
 
   // Equality constraints
-  metrics.stateEqConstraint = toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f);
+  toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f, metrics.stateEqConstraint);
+  metrics.stateInputEqConstraint.clear();
 
   // Inequality constraints.
-  metrics.stateIneqConstraint = toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f);
+  toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f, metrics.stateIneqConstraint);
+  metrics.stateInputIneqConstraint.clear();
 
-  return metrics;
+  clearLagrangianMetrics(metrics);
 }
 
-Metrics computeMetrics(const TerminalTranscription& transcription) {
+void computeMetrics(const TerminalTranscription& transcription, Metrics& metrics) {
   const auto& constraintsSize = transcription.constraintsSize;
 
-  Metrics metrics;
-
   // Cost
   metrics.cost = transcription.cost.f;
 
+  // Dynamics
+  metrics.dynamicsViolation.resize(0);
+
   // Equality constraints
-  metrics.stateEqConstraint = toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f);
+  toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f, metrics.stateEqConstraint);
+  metrics.stateInputEqConstraint.clear();
 
   // Inequality constraints.
-  metrics.stateIneqConstraint = toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f);
+  toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f, metrics.stateIneqConstraint);
+  metrics.stateInputIneqConstraint.clear();
 
-  return metrics;
+  clearLagrangianMetrics(metrics);
 }
 
 Metrics computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer, scalar_t t, scalar_t dt,
@@ -36,13 +36,16 @@ void ProjectionMultiplierCoefficients::compute(const ScalarFunctionQuadraticAppr
                                                const VectorFunctionLinearApproximation& dynamics,
                                                const VectorFunctionLinearApproximation& constraintProjection,
                                                const matrix_t& pseudoInverse) {
-  vector_t semiprojectedCost_dfdu = cost.dfdu;
+  thread_local vector_t semiprojectedCost_dfdu;  // reused between calls on the same thread
+  semiprojectedCost_dfdu = cost.dfdu;
   semiprojectedCost_dfdu.noalias() += cost.dfduu * constraintProjection.f;
 
-  matrix_t semiprojectedCost_dfdux = cost.dfdux;
+  thread_local matrix_t semiprojectedCost_dfdux;
+  semiprojectedCost_dfdux = cost.dfdux;
   semiprojectedCost_dfdux.noalias() += cost.dfduu * constraintProjection.dfdx;
 
-  const matrix_t semiprojectedCost_dfduu = cost.dfduu * constraintProjection.dfdu;
+  thread_local matrix_t semiprojectedCost_dfduu;
+  semiprojectedCost_dfduu.noalias() = cost.dfduu * constraintProjection.dfdu;
 
   this->dfdx.noalias() = -pseudoInverse * semiprojectedCost_dfdux;
   this->dfdu.noalias() = -pseudoInverse * semiprojectedCost_dfduu;
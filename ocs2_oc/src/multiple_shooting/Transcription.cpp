@@ -39,8 +39,14 @@ namespace multiple_shooting {
 
 Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
-  // Results and short-hand notation
   Transcription transcription;
+  setupIntermediateNode(optimalControlProblem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+  return transcription;
+}
+
+void setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer, scalar_t t,
+                           scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u, Transcription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
   auto& dynamics = transcription.dynamics;
   auto& constraintsSize = transcription.constraintsSize;
@@ -51,7 +57,7 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
 
   // Dynamics
   // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
-  dynamics = sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
+  sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt, dynamics);
   dynamics.f -= x_next;  // make it dx_{k+1} = ...
 
   // Precomputation for other terms
@@ -59,38 +65,48 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
   optimalControlProblem.preComputationPtr->request(request, t, x, u);
 
   // Costs: Approximate the integral with forward euler
-  cost = approximateCost(optimalControlProblem, t, x, u);
+  approximateCost(optimalControlProblem, t, x, u, cost);
   cost *= dt;
 
   // State equality constraints
   if (!optimalControlProblem.stateEqualityConstraintPtr->empty()) {
-    constraintsSize.stateEq = optimalControlProblem.stateEqualityConstraintPtr->getTermsSize(t);
-    stateEqConstraints =
-        optimalControlProblem.stateEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+    optimalControlProblem.stateEqualityConstraintPtr->getTermsSize(t, constraintsSize.stateEq);
+    optimalControlProblem.stateEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr,
+                                                                             stateEqConstraints);
+  } else {
+    constraintsSize.stateEq.clear();
+    stateEqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State-input equality constraints
   if (!optimalControlProblem.equalityConstraintPtr->empty()) {
-    constraintsSize.stateInputEq = optimalControlProblem.equalityConstraintPtr->getTermsSize(t);
-    stateInputEqConstraints =
-        optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+    optimalControlProblem.equalityConstraintPtr->getTermsSize(t, constraintsSize.stateInputEq);
+    optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr,
+                                                                        stateInputEqConstraints);
+  } else {
+    constraintsSize.stateInputEq.clear();
+    stateInputEqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.stateInequalityConstraintPtr->empty()) {
-    constraintsSize.stateIneq = optimalControlProblem.stateInequalityConstraintPtr->getTermsSize(t);
-    stateIneqConstraints =
-        optimalControlProblem.stateInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+    optimalControlProblem.stateInequalityConstraintPtr->getTermsSize(t, constraintsSize.stateIneq);
+    optimalControlProblem.stateInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr,
+                                                                               stateIneqConstraints);
+  } else {
+    constraintsSize.stateIneq.clear();
+    stateIneqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State-input inequality constraints.
   if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
-    constraintsSize.stateInputIneq = optimalControlProblem.inequalityConstraintPtr->getTermsSize(t);
-    stateInputIneqConstraints =
-        optimalControlProblem.inequalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+    optimalControlProblem.inequalityConstraintPtr->getTermsSize(t, constraintsSize.stateInputIneq);
+    optimalControlProblem.inequalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr,
+                                                                          stateInputIneqConstraints);
+  } else {
+    constraintsSize.stateInputIneq.clear();
+    stateInputIneqConstraints = VectorFunctionLinearApproximation();
   }
-
-  return transcription;
 }
 
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier) {
@@ -103,12 +119,13 @@ void projectTranscription(Transcription& transcription, bool extractProjectionMu
 
   if (stateInputEqConstraints.f.size() > 0) {
     // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
+    // The projection terms are written into the memory of the previous call.
     if (extractProjectionMultiplier) {
-      matrix_t constraintPseudoInverse;
-      std::tie(projection, constraintPseudoInverse) = LinearAlgebra::qrConstraintProjection(stateInputEqConstraints);
+      thread_local matrix_t constraintPseudoInverse;  // reused between calls on the same thread
+      LinearAlgebra::qrConstraintProjection(stateInputEqConstraints, projection, constraintPseudoInverse);
       projectionMultiplierCoefficients.compute(cost, dynamics, projection, constraintPseudoInverse);
     } else {
-      projection = LinearAlgebra::luConstraintProjection(stateInputEqConstraints).first;
+      LinearAlgebra::luConstraintProjection(stateInputEqConstraints, projection);
       projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
     }
     stateInputEqConstraints = VectorFunctionLinearApproximation();
@@ -119,12 +136,20 @@ void projectTranscription(Transcription& transcription, bool extractProjectionMu
     if (stateInputIneqConstraints.f.size() > 0) {
       changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f);
     }
+  } else {
+    projection = VectorFunctionLinearApproximation();
+    projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
   }
 }
 
 TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
-  // Results and short-hand notation
   TerminalTranscription transcription;
+  setupTerminalNode(optimalControlProblem, t, x, transcription);
+  return transcription;
+}
+
+void setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, TerminalTranscription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
   auto& constraintsSize = transcription.constraintsSize;
   auto& eqConstraints = transcription.eqConstraints;
@@ -134,28 +159,37 @@ TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlPro
   optimalControlProblem.preComputationPtr->requestFinal(request, t, x);
 
   // Costs
-  cost = approximateFinalCost(optimalControlProblem, t, x);
+  approximateFinalCost(optimalControlProblem, t, x, cost);
 
   // State equality constraints.
   if (!optimalControlProblem.finalEqualityConstraintPtr->empty()) {
-    constraintsSize.stateEq = optimalControlProblem.finalEqualityConstraintPtr->getTermsSize(t);
-    eqConstraints =
-        optimalControlProblem.finalEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+    optimalControlProblem.finalEqualityConstraintPtr->getTermsSize(t, constraintsSize.stateEq);
+    optimalControlProblem.finalEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr, eqConstraints);
+  } else {
+    constraintsSize.stateEq.clear();
+    eqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.finalInequalityConstraintPtr->empty()) {
-    constraintsSize.stateIneq = optimalControlProblem.finalInequalityConstraintPtr->getTermsSize(t);
-    ineqConstraints =
-        optimalControlProblem.finalInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+    optimalControlProblem.finalInequalityConstraintPtr->getTermsSize(t, constraintsSize.stateIneq);
+    optimalControlProblem.finalInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr,
+                                                                               ineqConstraints);
+  } else {
+    constraintsSize.stateIneq.clear();
+    ineqConstraints = VectorFunctionLinearApproximation();
   }
-
-  return transcription;
 }
 
 EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next) {
-  // Results and short-hand notation
   EventTranscription transcription;
+  setupEventNode(optimalControlProblem, t, x, x_next, transcription);
+  return transcription;
+}
+
+void setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                    EventTranscription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
   auto& dynamics = transcription.dynamics;
   auto& constraintsSize = transcription.constraintsSize;
@@ -172,23 +206,27 @@ EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem,
   dynamics.dfdu.setZero(x.size(), 0);  // Overwrite derivative that shouldn't exist.
 
   // Costs
-  cost = approximateEventCost(optimalControlProblem, t, x);
+  approximateEventCost(optimalControlProblem, t, x, cost);
 
   // State equality constraints.
   if (!optimalControlProblem.preJumpEqualityConstraintPtr->empty()) {
-    constraintsSize.stateEq = optimalControlProblem.preJumpEqualityConstraintPtr->getTermsSize(t);
-    eqConstraints =
-        optimalControlProblem.preJumpEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+    optimalControlProblem.preJumpEqualityConstraintPtr->getTermsSize(t, constraintsSize.stateEq);
+    optimalControlProblem.preJumpEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr,
+                                                                               eqConstraints);
+  } else {
+    constraintsSize.stateEq.clear();
+    eqConstraints = VectorFunctionLinearApproximation();
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.preJumpInequalityConstraintPtr->empty()) {
-    constraintsSize.stateIneq = optimalControlProblem.preJumpInequalityConstraintPtr->getTermsSize(t);
-    ineqConstraints =
-        optimalControlProblem.preJumpInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+    optimalControlProblem.preJumpInequalityConstraintPtr->getTermsSize(t, constraintsSize.stateIneq);
+    optimalControlProblem.preJumpInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr,
+                                                                                 ineqConstraints);
+  } else {
+    constraintsSize.stateIneq.clear();
+    ineqConstraints = VectorFunctionLinearApproximation();
   }
-
-  return transcription;
 }
 
 }  // namespace multiple_shooting
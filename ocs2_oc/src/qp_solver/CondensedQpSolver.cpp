@@ -0,0 +1,277 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/qp_solver/CondensedQpSolver.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace ocs2 {
+
+namespace {
+/**
+ * Overhead per stage in multiply-adds, for the Riccati recursion as well as for condensing. It accounts for the bookkeeping and the low
+ * efficiency of the small matrix products, and was fitted to the timings of benchmarkQpSolvers.
+ */
+constexpr scalar_t stageOverheadFlops = 1000.0;
+
+/** Multiply-adds of one Riccati step with n1 states, n2 next states, and m inputs. */
+scalar_t riccatiStepFlops(scalar_t n1, scalar_t n2, scalar_t m) {
+  return n2 * n2 * (n1 + m) + n1 * n1 * (n2 + m) + m * m * (n1 + n2) + m * n1 * n2 + m * m * m / 3.0;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool CondensedQpSolver::solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                              const std::vector<ScalarFunctionQuadraticApproximation>& cost, int blockSize, ThreadPool& threadPool,
+                              int numThreads, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  const int N = static_cast<int>(dynamics.size());
+  if (cost.size() != dynamics.size() + 1) {
+    throw std::runtime_error("[CondensedQpSolver] The cost must be defined on N+1 nodes.");
+  }
+
+  blockSize = std::max(blockSize, 1);
+  const int numBlocks = (N + blockSize - 1) / blockSize;
+  blockStart_.resize(numBlocks + 1);
+  for (int b = 0; b < numBlocks; ++b) {
+    blockStart_[b] = b * blockSize;
+  }
+  blockStart_[numBlocks] = N;
+
+  condensedDynamics_.resize(numBlocks);
+  condensedCost_.resize(numBlocks + 1);
+  condensedCost_.back() = cost.back();
+  workspaces_.resize(threadPool.numThreads() + 1);
+
+  std::atomic_int nextBlock{0};
+  auto condenseTask = [&](int workerIndex) {
+    int b;
+    while ((b = nextBlock++) < numBlocks) {
+      condenseBlock(b, x0, dynamics, cost, workspaces_[workerIndex]);
+    }
+  };
+  threadPool.runParallel(condenseTask, numThreads);
+
+  // The first block eliminates x0, the condensed problem then starts from an empty state.
+  const vector_t condensedInitialState = (numBlocks > 0) ? vector_t() : x0;
+  if (!riccatiSolver_.solve(condensedInitialState, condensedDynamics_, condensedCost_, threadPool, numThreads, condensedStateTrajectory_,
+                            condensedInputTrajectory_)) {
+    return false;
+  }
+
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
+  if (numBlocks == 0) {
+    stateTrajectory.front() = x0;
+  }
+  nextBlock = 0;
+  auto expandTask = [&](int) {
+    int b;
+    while ((b = nextBlock++) < numBlocks) {
+      expandBlock(b, x0, dynamics, stateTrajectory, inputTrajectory);
+    }
+  };
+  threadPool.runParallel(expandTask, numThreads);
+
+  return std::all_of(stateTrajectory.cbegin(), stateTrajectory.cend(), [](const vector_t& x) { return x.allFinite(); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t CondensedQpSolver::estimateFlops(const OcpSize& ocpSize, int blockSize) {
+  const int N = ocpSize.numStages;
+  scalar_t flops = N * stageOverheadFlops;
+
+  if (blockSize <= 1) {
+    for (int k = 0; k < N; ++k) {
+      flops += riccatiStepFlops(ocpSize.numStates[k], ocpSize.numStates[k + 1], ocpSize.numInputs[k]);
+    }
+    return flops;
+  }
+
+  for (int start = 0; start < N; start += blockSize) {
+    const int end = std::min(start + blockSize, N);
+    const scalar_t nxs = (start == 0) ? 0.0 : ocpSize.numStates[start];
+    scalar_t offset = 0.0;
+    for (int k = start; k < end; ++k) {
+      const scalar_t nx = ocpSize.numStates[k];
+      const scalar_t nxNext = ocpSize.numStates[k + 1];
+      const scalar_t nu = ocpSize.numInputs[k];
+      // Cost terms in Gamma and Phi, then propagation of Gamma and Phi through the dynamics
+      flops += nx * nx * (nxs + offset) + nx * (nxs + offset) * (nxs + offset) + nu * nx * (nxs + offset);
+      flops += nxNext * nx * (nxs + offset);
+      offset += nu;
+    }
+    flops += riccatiStepFlops(nxs, ocpSize.numStates[end], offset) + stageOverheadFlops;
+  }
+  return flops;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int CondensedQpSolver::selectBlockSize(const OcpSize& ocpSize) {
+  const int N = ocpSize.numStages;
+  int bestBlockSize = 1;
+  scalar_t bestFlops = estimateFlops(ocpSize, 1);
+
+  // Powers of two and full condensing
+  for (int blockSize = 2; blockSize < 2 * N; blockSize *= 2) {
+    const int candidate = std::min(blockSize, N);
+    const scalar_t flops = estimateFlops(ocpSize, candidate);
+    if (flops < bestFlops) {
+      bestFlops = flops;
+      bestBlockSize = candidate;
+    }
+  }
+  return bestBlockSize;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CondensedQpSolver::condenseBlock(int b, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                      const std::vector<ScalarFunctionQuadraticApproximation>& cost, Workspace& workspace) {
+  /*
+   * Inside the block, x_k = Gamma_k * x_s + Phi_k * U + c_k with U the stacked inputs of the block. Only the first columns of Phi_k
+   * that belong to the inputs before stage k are nonzero. For the first block, x_s = x0 is known and moved into c.
+   */
+  const int start = blockStart_[b];
+  const int end = blockStart_[b + 1];
+  int numBlockInputs = 0;
+  for (int k = start; k < end; ++k) {
+    numBlockInputs += dynamics[k].dfdu.cols();
+  }
+  const auto numStartStates = dynamics[start].dfdx.cols();
+  const auto numCondensedStates = (b == 0) ? 0 : numStartStates;
+
+  auto& Gamma = workspace.Gamma;
+  auto& Phi = workspace.Phi;
+  auto& c = workspace.c;
+  if (b == 0) {
+    Gamma.resize(numStartStates, 0);
+    c = x0;
+  } else {
+    Gamma.setIdentity(numStartStates, numStartStates);
+    c.setZero(numStartStates);
+  }
+  Phi.resize(numStartStates, numBlockInputs);
+
+  auto& condensedCost = condensedCost_[b];
+  condensedCost.dfdxx.setZero(numCondensedStates, numCondensedStates);
+  condensedCost.dfdux.setZero(numBlockInputs, numCondensedStates);
+  condensedCost.dfduu.setZero(numBlockInputs, numBlockInputs);
+  condensedCost.dfdx.setZero(numCondensedStates);
+  condensedCost.dfdu.setZero(numBlockInputs);
+  condensedCost.f = 0.0;
+
+  int offset = 0;
+  for (int k = start; k < end; ++k) {
+    const auto& Q = cost[k].dfdxx;
+    const auto& S = cost[k].dfdux;
+    const auto& R = cost[k].dfduu;
+    const auto& A = dynamics[k].dfdx;
+    const auto& B = dynamics[k].dfdu;
+    const auto numInputs = B.cols();
+    const auto numNextStates = A.rows();
+    const auto PhiActive = Phi.leftCols(offset);
+
+    // Cost: 0.5 x' Q x + u' S x + 0.5 u' R u + q' x + r' u + f
+    workspace.w = cost[k].dfdx;  // w = Q * c + q
+    workspace.w.noalias() += Q * c;
+    condensedCost.f += cost[k].f + 0.5 * c.dot(workspace.w + cost[k].dfdx);
+
+    workspace.QGamma.noalias() = Q * Gamma;
+    workspace.QPhi.noalias() = Q * PhiActive;
+    condensedCost.dfdxx.noalias() += Gamma.transpose() * workspace.QGamma;
+    condensedCost.dfdx.noalias() += Gamma.transpose() * workspace.w;
+    condensedCost.dfdux.topRows(offset).noalias() += PhiActive.transpose() * workspace.QGamma;
+    condensedCost.dfduu.topLeftCorner(offset, offset).noalias() += PhiActive.transpose() * workspace.QPhi;
+    condensedCost.dfdu.head(offset).noalias() += PhiActive.transpose() * workspace.w;
+
+    if (numInputs > 0) {
+      condensedCost.dfdux.middleRows(offset, numInputs).noalias() += S * Gamma;
+      workspace.tmp.noalias() = S * PhiActive;
+      condensedCost.dfduu.block(offset, 0, numInputs, offset) += workspace.tmp;
+      condensedCost.dfduu.block(0, offset, offset, numInputs) += workspace.tmp.transpose();
+      condensedCost.dfduu.block(offset, offset, numInputs, numInputs) += R;
+      condensedCost.dfdu.segment(offset, numInputs) += cost[k].dfdu;
+      condensedCost.dfdu.segment(offset, numInputs).noalias() += S * c;
+    }
+
+    // Dynamics: x_{k+1} = A x + B u + b
+    workspace.tmp.noalias() = A * Gamma;
+    Gamma.swap(workspace.tmp);
+    workspace.w = dynamics[k].f;
+    workspace.w.noalias() += A * c;
+    c.swap(workspace.w);
+    workspace.tmp.resize(numNextStates, numBlockInputs);
+    workspace.tmp.leftCols(offset).noalias() = A * PhiActive;
+    workspace.tmp.middleCols(offset, numInputs) = B;
+    Phi.swap(workspace.tmp);
+
+    offset += numInputs;
+  }
+
+  auto& condensedDynamics = condensedDynamics_[b];
+  condensedDynamics.dfdx.swap(Gamma);
+  condensedDynamics.dfdu.swap(Phi);
+  condensedDynamics.f.swap(c);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CondensedQpSolver::expandBlock(int b, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                    vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) const {
+  const int start = blockStart_[b];
+  const int end = blockStart_[b + 1];
+  const bool isLastBlock = (b + 1 == static_cast<int>(condensedDynamics_.size()));
+  const vector_t& U = condensedInputTrajectory_[b];
+
+  stateTrajectory[start] = (b == 0) ? x0 : condensedStateTrajectory_[b];
+  int offset = 0;
+  for (int k = start; k < end; ++k) {
+    const auto numInputs = dynamics[k].dfdu.cols();
+    inputTrajectory[k] = U.segment(offset, numInputs);
+    offset += numInputs;
+
+    // The first state of the next block is written by that block.
+    if (k + 1 < end || isLastBlock) {
+      stateTrajectory[k + 1] = dynamics[k].f;
+      stateTrajectory[k + 1].noalias() += dynamics[k].dfdx * stateTrajectory[k];
+      stateTrajectory[k + 1].noalias() += dynamics[k].dfdu * inputTrajectory[k];
+    }
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,382 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/qp_solver/ParallelRiccatiSolver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace ocs2 {
+
+namespace {
+/** Minimum number of nodes in a chunk. Below that, the combination overhead is not worth it. */
+constexpr int minNodesPerChunk = 8;
+
+/**
+ * The last chunk runs the plain Riccati recursion during the first pass while the other chunks set up and combine elements, which costs
+ * about three times as much per node. The last chunk therefore gets this many times more nodes than the others.
+ */
+constexpr scalar_t lastChunkWeight = 3.0;
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                  const std::vector<ScalarFunctionQuadraticApproximation>& cost, ThreadPool& threadPool, int numThreads,
+                                  vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  const int N = static_cast<int>(dynamics.size());
+  if (cost.size() != dynamics.size() + 1) {
+    throw std::runtime_error("[ParallelRiccatiSolver] The cost must be defined on N+1 nodes.");
+  }
+
+  partitionHorizon(N, numThreads);
+  const int numChunks = static_cast<int>(chunkStart_.size()) - 1;
+  const int lastChunk = numChunks - 1;
+
+  elements_.resize(chunkStart_[lastChunk]);
+  workspaces_.resize(numChunks);
+  costToGoHessian_.resize(N + 1);
+  costToGoGradient_.resize(N + 1);
+  feedback_.resize(N);
+  feedforward_.resize(N);
+
+  costToGoHessian_[N] = cost[N].dfdxx;
+  costToGoGradient_[N] = cost[N].dfdx;
+
+  std::atomic_bool success{true};
+
+  // 1. Backward pass inside each chunk. The last chunk already ends at the terminal node.
+  std::atomic_int nextChunk{0};
+  auto chunkBackwardPass = [&](int) {
+    int c;
+    while ((c = nextChunk++) < numChunks) {
+      auto& workspace = workspaces_[c];
+      const int start = chunkStart_[c];
+      const int end = chunkStart_[c + 1];
+      if (c == lastChunk) {
+        // The recursion cannot continue past a stage of which the Hessian is not positive definite.
+        for (int k = N - 1; k >= std::max(start - 1, 0); --k) {
+          if (!riccatiStep(k, dynamics[k], cost[k], k >= start, workspace)) {
+            success = false;
+            break;
+          }
+        }
+      } else {
+        for (int k = end - 1; k >= start; --k) {
+          if (!setupStageElement(dynamics[k], cost[k], elements_[k], workspace)) {
+            success = false;
+            break;
+          } else if (k < end - 1) {
+            combineElements(elements_[k], elements_[k + 1], workspace);
+          }
+        }
+      }
+    }
+  };
+  threadPool.runParallel(chunkBackwardPass, numThreads);
+  if (!success) {
+    return false;
+  }
+
+  // 2. Cost-to-go at the first node of each chunk.
+  for (int c = lastChunk - 1; c >= 0; --c) {
+    const int start = chunkStart_[c];
+    const int end = chunkStart_[c + 1];
+    valueFromElement(elements_[start], costToGoHessian_[end], costToGoGradient_[end], costToGoHessian_[start], costToGoGradient_[start],
+                     workspaces_[c]);
+  }
+
+  // 3. Cost-to-go at the remaining nodes and the gains of the stages that lead into them.
+  nextChunk = 0;
+  auto chunkFinalPass = [&](int) {
+    int c;
+    while ((c = nextChunk++) < lastChunk) {
+      auto& workspace = workspaces_[c];
+      const int start = chunkStart_[c];
+      const int end = chunkStart_[c + 1];
+      for (int k = end - 1; k > start; --k) {
+        valueFromElement(elements_[k], costToGoHessian_[end], costToGoGradient_[end], costToGoHessian_[k], costToGoGradient_[k], workspace);
+      }
+      for (int k = end - 2; k >= std::max(start - 1, 0); --k) {
+        if (!riccatiStep(k, dynamics[k], cost[k], false, workspace)) {
+          success = false;
+          break;
+        }
+      }
+    }
+  };
+  if (numChunks > 1) {
+    threadPool.runParallel(chunkFinalPass, numThreads);
+  }
+  if (!success) {
+    return false;
+  }
+
+  // Forward rollout
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
+  stateTrajectory.front() = x0;
+  for (int k = 0; k < N; ++k) {
+    inputTrajectory[k] = feedforward_[k];
+    inputTrajectory[k].noalias() += feedback_[k] * stateTrajectory[k];
+    stateTrajectory[k + 1] = dynamics[k].f;
+    stateTrajectory[k + 1].noalias() += dynamics[k].dfdx * stateTrajectory[k];
+    stateTrajectory[k + 1].noalias() += dynamics[k].dfdu * inputTrajectory[k];
+  }
+
+  return std::all_of(stateTrajectory.cbegin(), stateTrajectory.cend(), [](const vector_t& x) { return x.allFinite(); }) &&
+         std::all_of(inputTrajectory.cbegin(), inputTrajectory.cend(), [](const vector_t& u) { return u.allFinite(); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<ScalarFunctionQuadraticApproximation> ParallelRiccatiSolver::getRiccatiCostToGo() const {
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo(costToGoHessian_.size());
+  for (size_t k = 0; k < costToGo.size(); ++k) {
+    costToGo[k].dfdxx = costToGoHessian_[k];
+    costToGo[k].dfdx = costToGoGradient_[k];
+    costToGo[k].f = 0.0;
+  }
+  return costToGo;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::setupStageElement(const VectorFunctionLinearApproximation& dynamics,
+                                              const ScalarFunctionQuadraticApproximation& cost, Element& element,
+                                              Workspace& workspace) const {
+  const auto numInputs = dynamics.dfdu.cols();
+  const auto numStates = dynamics.dfdx.cols();
+  const auto numNextStates = dynamics.dfdx.rows();
+
+  element.A = dynamics.dfdx;
+  element.b = dynamics.f;
+  element.J = cost.dfdxx;
+  element.eta = -cost.dfdx;
+
+  if (numInputs == 0) {
+    element.C.setZero(numNextStates, numNextStates);
+    return true;
+  }
+
+  workspace.llt.compute(cost.dfduu);
+  if (workspace.llt.info() != Eigen::Success) {
+    return false;
+  }
+
+  // rhs = inv(R) * [S, r]
+  workspace.rhs.resize(numInputs, numStates + 1);
+  workspace.rhs.leftCols(numStates) = cost.dfdux;
+  workspace.rhs.col(numStates) = cost.dfdu;
+  workspace.llt.solveInPlace(workspace.rhs);
+
+  // Eliminate u = -inv(R) * (S * x + r) + v, the remaining cost on v does not depend on x.
+  element.A.noalias() -= dynamics.dfdu * workspace.rhs.leftCols(numStates);
+  element.b.noalias() -= dynamics.dfdu * workspace.rhs.col(numStates);
+  element.J.noalias() -= cost.dfdux.transpose() * workspace.rhs.leftCols(numStates);
+  element.eta.noalias() += cost.dfdux.transpose() * workspace.rhs.col(numStates);
+
+  // C = B * inv(R) * B' = (inv(L) * B')' * (inv(L) * B')
+  workspace.tmp = dynamics.dfdu.transpose();
+  workspace.llt.matrixL().solveInPlace(workspace.tmp);
+  element.C.noalias() = workspace.tmp.transpose() * workspace.tmp;
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ParallelRiccatiSolver::combineElements(Element& first, const Element& second, Workspace& workspace) const {
+  /*
+   * With M = I + C_ij * J_jk, the combined element is
+   *   A = A_jk * inv(M) * A_ij
+   *   b = A_jk * inv(M) * (b_ij + C_ij * eta_jk) + b_jk
+   *   C = A_jk * inv(M) * C_ij * A_jk' + C_jk
+   *   eta = A_ij' * inv(M') * (eta_jk - J_jk * b_ij) + eta_ij
+   *   J = A_ij' * inv(M') * J_jk * A_ij + J_ij
+   * inv(M') is avoided with inv(M') * J_jk = J_jk * inv(M) and inv(M') = I - J_jk * inv(M) * C_ij. All terms then need a single
+   * factorization of M.
+   */
+  const auto ni = first.A.cols();
+  const auto nj = first.A.rows();
+  const auto nk = second.A.rows();
+
+  workspace.M.setIdentity(nj, nj);
+  workspace.M.noalias() += first.C * second.J;
+  workspace.lu.compute(workspace.M);
+
+  // w = eta_jk - J_jk * b_ij
+  workspace.w = second.eta;
+  workspace.w.noalias() -= second.J * first.b;
+
+  // sol = inv(M) * [A_ij, b_ij + C_ij * eta_jk, C_ij * A_jk', C_ij * w]
+  workspace.rhs.resize(nj, ni + nk + 2);
+  workspace.rhs.leftCols(ni) = first.A;
+  workspace.rhs.col(ni) = first.b;
+  workspace.rhs.col(ni).noalias() += first.C * second.eta;
+  workspace.rhs.middleCols(ni + 1, nk).noalias() = first.C * second.A.transpose();
+  workspace.rhs.col(ni + nk + 1).noalias() = first.C * workspace.w;
+  workspace.sol.noalias() = workspace.lu.solve(workspace.rhs);
+
+  // tmp = A_ij' * J_jk
+  workspace.tmp.noalias() = first.A.transpose() * second.J;
+  first.J.noalias() += workspace.tmp * workspace.sol.leftCols(ni);
+  first.eta.noalias() += first.A.transpose() * workspace.w;
+  first.eta.noalias() -= workspace.tmp * workspace.sol.col(ni + nk + 1);
+
+  first.A.noalias() = second.A * workspace.sol.leftCols(ni);
+  first.b = second.b;
+  first.b.noalias() += second.A * workspace.sol.col(ni);
+  first.C = second.C;
+  first.C.noalias() += second.A * workspace.sol.middleCols(ni + 1, nk);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ParallelRiccatiSolver::valueFromElement(const Element& element, const matrix_t& Pj, const vector_t& pj, matrix_t& Pk, vector_t& pk,
+                                             Workspace& workspace) const {
+  /*
+   * Combination with an element that ends at the terminal node (A = 0, b = 0, C = 0, eta = -p_j, J = P_j). With M = I + C * P_j:
+   *   P_k = A' * P_j * inv(M) * A + J
+   *   p_k = A' * inv(M') * (p_j + P_j * b) - eta
+   */
+  const auto nk = element.A.cols();
+  const auto nj = element.A.rows();
+
+  workspace.M.setIdentity(nj, nj);
+  workspace.M.noalias() += element.C * Pj;
+  workspace.lu.compute(workspace.M);
+
+  // w = p_j + P_j * b
+  workspace.w = pj;
+  workspace.w.noalias() += Pj * element.b;
+
+  // sol = inv(M) * [A, C * w]
+  workspace.rhs.resize(nj, nk + 1);
+  workspace.rhs.leftCols(nk) = element.A;
+  workspace.rhs.col(nk).noalias() = element.C * workspace.w;
+  workspace.sol.noalias() = workspace.lu.solve(workspace.rhs);
+
+  // tmp = A' * P_j
+  workspace.tmp.noalias() = element.A.transpose() * Pj;
+  Pk = element.J;
+  Pk.noalias() += workspace.tmp * workspace.sol.leftCols(nk);
+  pk = -element.eta;
+  pk.noalias() += element.A.transpose() * workspace.w;
+  pk.noalias() -= workspace.tmp * workspace.sol.col(nk);
+
+  // Remove the asymmetry from round-off, Pk is used as a Hessian in the gains.
+  workspace.M = 0.5 * (Pk + Pk.transpose());
+  Pk.swap(workspace.M);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::riccatiStep(int k, const VectorFunctionLinearApproximation& dynamics,
+                                        const ScalarFunctionQuadraticApproximation& cost, bool computeCostToGo, Workspace& workspace) {
+  const auto numInputs = dynamics.dfdu.cols();
+  const auto numStates = dynamics.dfdx.cols();
+  const matrix_t& P = costToGoHessian_[k + 1];
+  const vector_t& p = costToGoGradient_[k + 1];
+  auto& K = feedback_[k];
+  auto& kff = feedforward_[k];
+
+  // w = P * b + p
+  workspace.w = p;
+  workspace.w.noalias() += P * dynamics.f;
+
+  if (numInputs > 0) {
+    // H = R + B' * P * B
+    workspace.tmp.noalias() = P * dynamics.dfdu;
+    workspace.M = cost.dfduu;
+    workspace.M.noalias() += dynamics.dfdu.transpose() * workspace.tmp;
+    workspace.llt.compute(workspace.M);
+    if (workspace.llt.info() != Eigen::Success) {
+      return false;
+    }
+
+    // G = S + B' * P * A,  g = r + B' * (P * b + p)
+    workspace.rhs = cost.dfdux;
+    workspace.rhs.noalias() += workspace.tmp.transpose() * dynamics.dfdx;
+    workspace.g = cost.dfdu;
+    workspace.g.noalias() += dynamics.dfdu.transpose() * workspace.w;
+
+    // K = -inv(H) * G,  k = -inv(H) * g
+    K = -workspace.rhs;
+    workspace.llt.solveInPlace(K);
+    kff = -workspace.g;
+    workspace.llt.solveInPlace(kff);
+  } else {
+    K.resize(0, numStates);
+    kff.resize(0);
+  }
+
+  if (computeCostToGo) {
+    // P_k = Q + A' * P * A + G' * K,  p_k = q + A' * (P * b + p) + G' * k
+    auto& Pk = costToGoHessian_[k];
+    auto& pk = costToGoGradient_[k];
+    workspace.sol.noalias() = P * dynamics.dfdx;
+    Pk = cost.dfdxx;
+    Pk.noalias() += dynamics.dfdx.transpose() * workspace.sol;
+    pk = cost.dfdx;
+    pk.noalias() += dynamics.dfdx.transpose() * workspace.w;
+    if (numInputs > 0) {
+      Pk.noalias() += workspace.rhs.transpose() * K;
+      pk.noalias() += workspace.rhs.transpose() * kff;
+    }
+    workspace.M = 0.5 * (Pk + Pk.transpose());
+    Pk.swap(workspace.M);
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ParallelRiccatiSolver::partitionHorizon(int N, int numThreads) {
+  const int numNodes = N + 1;
+  const int numChunks = std::max(1, std::min(numThreads, numNodes / minNodesPerChunk));
+
+  chunkStart_.resize(numChunks + 1);
+  const scalar_t nodesPerChunk = static_cast<scalar_t>(numNodes) / (numChunks - 1 + lastChunkWeight);
+  for (int c = 0; c < numChunks; ++c) {
+    chunkStart_[c] = static_cast<int>(std::round(c * nodesPerChunk));
+  }
+  chunkStart_[numChunks] = numNodes;
+}
+
+}  // namespace ocs2
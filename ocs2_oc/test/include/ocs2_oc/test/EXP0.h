@@ -119,9 +119,10 @@ class EXP0_Cost final : public QuadraticStateInputCost {
  private:
   EXP0_Cost(const EXP0_Cost& other) = default;
 
-  std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                       const TargetTrajectories& targetTrajectories) const override {
-    return {state - targetTrajectories.stateTrajectory[0], input - targetTrajectories.inputTrajectory[0]};
+  void getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                              vector_t& stateDeviation, vector_t& inputDeviation) const override {
+    stateDeviation = state - targetTrajectories.stateTrajectory[0];
+    inputDeviation = input - targetTrajectories.inputTrajectory[0];
   }
 };
 
@@ -137,8 +138,9 @@ class EXP0_FinalCost final : public QuadraticStateCost {
  private:
   EXP0_FinalCost(const EXP0_FinalCost& other) = default;
 
-  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const override {
-    return state - targetTrajectories.stateTrajectory[0];
+  void getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                         vector_t& stateDeviation) const override {
+    stateDeviation = state - targetTrajectories.stateTrajectory[0];
   }
 };
 
@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/constraint/LinearStateConstraint.h>
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+
+#include <ocs2_oc/multiple_shooting/Transcription.h>
+
+#include <ocs2_core/test/testTools.h>
+
+#include "ocs2_oc/test/CountingAllocator.h"
+
+using namespace ocs2;
+
+class TranscriptionAllocationsTest : public testing::Test {
+ protected:
+  static constexpr size_t nx = 4;
+  static constexpr size_t nu = 3;
+  static constexpr size_t nc = 2;
+
+  TranscriptionAllocationsTest()
+      : targetTrajectories({0.0}, {vector_t::Zero(nx)}, {vector_t::Zero(nu)}),
+        sensitivityDiscretizer(selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4)),
+        x(vector_t::Random(nx)),
+        x_next(vector_t::Random(nx)),
+        u(vector_t::Random(nu)) {
+    problem.dynamicsPtr.reset(new LinearSystemDynamics(matrix_t::Random(nx, nx), matrix_t::Random(nx, nu)));
+    problem.costPtr->add("cost", std::unique_ptr<StateInputCost>(
+                                     new QuadraticStateInputCost(matrix_t::Identity(nx, nx), matrix_t::Identity(nu, nu))));
+    problem.finalCostPtr->add("finalCost", std::unique_ptr<StateCost>(new QuadraticStateCost(matrix_t::Identity(nx, nx))));
+    problem.inequalityConstraintPtr->add(
+        "inequality", std::unique_ptr<StateInputConstraint>(
+                          new LinearStateInputConstraint(vector_t::Random(nc), matrix_t::Random(nc, nx), matrix_t::Random(nc, nu))));
+    problem.stateInequalityConstraintPtr->add(
+        "stateInequality", std::unique_ptr<StateConstraint>(new LinearStateConstraint(vector_t::Random(nc), matrix_t::Random(nc, nx))));
+    problem.finalInequalityConstraintPtr->add(
+        "finalInequality", std::unique_ptr<StateConstraint>(new LinearStateConstraint(vector_t::Random(nc), matrix_t::Random(nc, nx))));
+    problem.targetTrajectoriesPtr = &targetTrajectories;
+  }
+
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  OptimalControlProblem problem;
+  TargetTrajectories targetTrajectories;
+  DynamicsSensitivityDiscretizer sensitivityDiscretizer;
+  vector_t x;
+  vector_t x_next;
+  vector_t u;
+};
+
+constexpr size_t TranscriptionAllocationsTest::nx;
+constexpr size_t TranscriptionAllocationsTest::nu;
+constexpr size_t TranscriptionAllocationsTest::nc;
+
+TEST_F(TranscriptionAllocationsTest, inPlaceMatchesByValue) {
+  multiple_shooting::Transcription transcription;
+  multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+  multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+  const auto expected = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u);
+
+  EXPECT_TRUE(isApprox(transcription.cost, expected.cost, 1e-12));
+  EXPECT_TRUE(isApprox(transcription.dynamics, expected.dynamics, 1e-12));
+  EXPECT_TRUE(isApprox(transcription.stateIneqConstraints, expected.stateIneqConstraints, 1e-12));
+  EXPECT_TRUE(isApprox(transcription.stateInputIneqConstraints, expected.stateInputIneqConstraints, 1e-12));
+  EXPECT_EQ(transcription.constraintsSize.stateInputIneq, expected.constraintsSize.stateInputIneq);
+  EXPECT_EQ(transcription.stateInputEqConstraints.f.size(), 0);
+
+  multiple_shooting::TerminalTranscription terminalTranscription;
+  multiple_shooting::setupTerminalNode(problem, t, x, terminalTranscription);
+  const auto expectedTerminal = multiple_shooting::setupTerminalNode(problem, t, x);
+  EXPECT_TRUE(isApprox(terminalTranscription.cost, expectedTerminal.cost, 1e-12));
+  EXPECT_TRUE(isApprox(terminalTranscription.ineqConstraints, expectedTerminal.ineqConstraints, 1e-12));
+}
+
+TEST_F(TranscriptionAllocationsTest, noAllocationsAfterWarmUp) {
+#ifdef OCS2_COUNT_ALLOCATIONS
+  multiple_shooting::Transcription transcription;
+  multiple_shooting::TerminalTranscription terminalTranscription;
+
+  // Warm-up: sizes the workspace and the thread-local buffers
+  multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+  multiple_shooting::setupTerminalNode(problem, t, x, terminalTranscription);
+
+  numAllocations = 0;
+  countAllocations = true;
+  for (int i = 0; i < 10; ++i) {
+    multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u, transcription);
+    multiple_shooting::setupTerminalNode(problem, t, x, terminalTranscription);
+  }
+  countAllocations = false;
+
+  EXPECT_EQ(numAllocations, 0);
+#endif
+}
@@ -0,0 +1,155 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+/** Benchmarks of the QP solvers in ocs2_oc on random LQ problems. */
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ocs2_oc/qp_solver/CondensedQpSolver.h"
+#include "ocs2_oc/qp_solver/ParallelRiccatiSolver.h"
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+
+struct LqProblem {
+  vector_t x0;
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+};
+
+/** Random LQ problem */
+LqProblem getRandomLqProblem(int N, int nx, int nu) {
+  LqProblem problem;
+  problem.x0 = vector_t::Random(nx);
+  for (int k = 0; k < N; ++k) {
+    problem.dynamics.push_back(getRandomDynamics(nx, nu));
+    problem.cost.push_back(getRandomCost(nx, nu));
+  }
+  problem.cost.push_back(getRandomCost(nx, 0));
+  return problem;
+}
+
+/**
+ * Scaling of the solve time with the number of threads and the horizon length. The timings are printed, the speedup depends on the
+ * number of cores of the machine.
+ */
+void parallelRiccatiScaling() {
+  const int nx = 12;
+  const int nu = 4;
+  const int numRepetitions = 10;
+
+  for (const int N : {50, 100, 200, 500, 1000}) {
+    const auto problem = getRandomLqProblem(N, nx, nu);
+    scalar_t serialTime = 0.0;
+    for (const int numThreads : {1, 2, 4, 8, 16}) {
+      ThreadPool threadPool(numThreads - 1);
+      ParallelRiccatiSolver solver;
+      vector_array_t xSol, uSol;
+      solver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, numThreads, xSol, uSol);  // warm start memory
+
+      const auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < numRepetitions; ++i) {
+        solver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, numThreads, xSol, uSol);
+      }
+      const auto finish = std::chrono::steady_clock::now();
+      const scalar_t time = std::chrono::duration<scalar_t, std::milli>(finish - start).count() / numRepetitions;
+      if (numThreads == 1) {
+        serialTime = time;
+      }
+      std::cout << "[ParallelRiccatiSolverBenchmark] N = " << N << ", threads = " << numThreads << ": " << time
+                << " [ms], speedup = " << serialTime / time << "\n";
+    }
+  }
+}
+
+/**
+ * Solve times of the sparse Riccati recursion and of the condensed solver with the block size of selectBlockSize(), for random problems
+ * with the sizes of the mobile manipulator (ridgeback_ur5: 9 states, 9 inputs) and the legged robot (24 states, 24 inputs). The example
+ * packages need pinocchio, so their problems are not linked here.
+ */
+void condensedExamples() {
+  struct Case {
+    std::string name;
+    int N;
+    int nx;
+    int nu;
+  };
+  const std::vector<Case> cases{{"mobile manipulator", 10, 9, 9}, {"mobile manipulator", 20, 9, 9}, {"mobile manipulator", 100, 9, 9},
+                                {"legged robot", 66, 24, 24},      {"cartpole", 50, 4, 1},           {"quadrotor", 20, 12, 4},
+                                {"many states, few inputs", 10, 30, 2}};
+  const int numRepetitions = 50;
+  ThreadPool threadPool(0);
+
+  auto timeSolve = [&](const std::function<void()>& solve) {
+    solve();  // warm start memory
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numRepetitions; ++i) {
+      solve();
+    }
+    const auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<scalar_t, std::micro>(finish - start).count() / numRepetitions;
+  };
+
+  for (const auto& c : cases) {
+    const auto problem = getRandomLqProblem(c.N, c.nx, c.nu);
+    vector_array_t xSol, uSol;
+
+    ParallelRiccatiSolver riccatiSolver;
+    const scalar_t riccatiTime =
+        timeSolve([&] { riccatiSolver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, 1, xSol, uSol); });
+
+    const int selectedBlockSize = CondensedQpSolver::selectBlockSize(OcpSize(c.N, c.nx, c.nu));
+    std::cout << "[CondensedQpSolverBenchmark] " << c.name << " N = " << c.N << ", nx = " << c.nx << ", nu = " << c.nu
+              << ": riccati " << riccatiTime << " [us], selected block size " << selectedBlockSize;
+    for (const int blockSize : {2, 4, 8, c.N}) {
+      if (blockSize == c.N && c.N * c.nu > 200) {
+        continue;  // large dense QP
+      }
+      CondensedQpSolver condensedSolver;
+      const scalar_t condensedTime = timeSolve(
+          [&] { condensedSolver.solve(problem.x0, problem.dynamics, problem.cost, blockSize, threadPool, 1, xSol, uSol); });
+      std::cout << ", condensed(" << blockSize << ") " << condensedTime << " [us]";
+    }
+    std::cout << "\n";
+  }
+}
+
+}  // unnamed namespace
+
+int main() {
+  parallelRiccatiScaling();
+  condensedExamples();
+  return 0;
+}
@@ -0,0 +1,121 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "ocs2_oc/qp_solver/CondensedQpSolver.h"
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+
+struct LqProblem {
+  vector_t x0;
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+};
+
+/** Random LQ problem, stages with an index in noInputStages have no inputs. */
+LqProblem getRandomLqProblem(int N, int nx, int nu, const std::vector<int>& noInputStages = {}) {
+  LqProblem problem;
+  problem.x0 = vector_t::Random(nx);
+  for (int k = 0; k < N; ++k) {
+    const bool hasInputs = std::find(noInputStages.begin(), noInputStages.end(), k) == noInputStages.end();
+    problem.dynamics.push_back(getRandomDynamics(nx, hasInputs ? nu : 0));
+    problem.cost.push_back(getRandomCost(nx, hasInputs ? nu : 0));
+  }
+  problem.cost.push_back(getRandomCost(nx, 0));
+  return problem;
+}
+
+}  // unnamed namespace
+
+class CondensedQpSolverTest : public testing::TestWithParam<std::tuple<int, int>> {
+ protected:
+  CondensedQpSolverTest() : numThreads(std::get<1>(GetParam())), threadPool(numThreads - 1) {}
+
+  const int numThreads;
+  ThreadPool threadPool;
+  CondensedQpSolver solver;
+};
+
+TEST_P(CondensedQpSolverTest, matchesRiccati) {
+  const int blockSize = std::get<0>(GetParam());
+  const auto problem = getRandomLqProblem(20, 4, 2, {0, 7, 19});
+
+  ThreadPool serialPool(0);
+  ParallelRiccatiSolver riccatiSolver;
+  vector_array_t xRiccati, uRiccati;
+  ASSERT_TRUE(riccatiSolver.solve(problem.x0, problem.dynamics, problem.cost, serialPool, 1, xRiccati, uRiccati));
+
+  vector_array_t xSol, uSol;
+  ASSERT_TRUE(solver.solve(problem.x0, problem.dynamics, problem.cost, blockSize, threadPool, numThreads, xSol, uSol));
+
+  ASSERT_EQ(xSol.size(), xRiccati.size());
+  ASSERT_EQ(uSol.size(), uRiccati.size());
+  for (int k = 0; k < xSol.size(); ++k) {
+    EXPECT_TRUE(xSol[k].isApprox(xRiccati[k], 1e-8)) << "k = " << k;
+  }
+  for (int k = 0; k < uSol.size(); ++k) {
+    EXPECT_EQ(uSol[k].size(), uRiccati[k].size());
+    EXPECT_TRUE(uSol[k].isApprox(uRiccati[k], 1e-8)) << "k = " << k;
+  }
+}
+
+TEST_P(CondensedQpSolverTest, resolveWithOtherSize) {
+  const int blockSize = std::get<0>(GetParam());
+  vector_array_t xSol, uSol;
+  for (const int N : {30, 1, 0, 12}) {
+    const auto problem = getRandomLqProblem(N, 3, 2);
+    ASSERT_TRUE(solver.solve(problem.x0, problem.dynamics, problem.cost, blockSize, threadPool, numThreads, xSol, uSol));
+    ASSERT_EQ(xSol.size(), N + 1);
+    ASSERT_EQ(uSol.size(), N);
+    ASSERT_TRUE(xSol.front().isApprox(problem.x0));
+    for (int k = 0; k < N; ++k) {
+      const vector_t xNext = problem.dynamics[k].dfdx * xSol[k] + problem.dynamics[k].dfdu * uSol[k] + problem.dynamics[k].f;
+      ASSERT_TRUE(xSol[k + 1].isApprox(xNext, 1e-8));
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(CondensedQpSolverTestCase, CondensedQpSolverTest,
+                        testing::Combine(testing::Values(1, 2, 3, 7, 20, 100), testing::Values(1, 3)));
+
+TEST(CondensedQpSolverHeuristics, selectBlockSize) {
+  // Many states, few inputs, and a short horizon: condense fully
+  EXPECT_EQ(CondensedQpSolver::selectBlockSize(OcpSize(10, 30, 2)), 10);
+  // Many inputs and a long horizon: keep the sparse recursion
+  EXPECT_EQ(CondensedQpSolver::selectBlockSize(OcpSize(100, 24, 24)), 1);
+  // Nothing to condense
+  EXPECT_EQ(CondensedQpSolver::selectBlockSize(OcpSize(0, 4, 2)), 1);
+  EXPECT_EQ(CondensedQpSolver::selectBlockSize(OcpSize(1, 4, 2)), 1);
+}
@@ -0,0 +1,203 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "ocs2_oc/qp_solver/ParallelRiccatiSolver.h"
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+
+struct LqProblem {
+  vector_t x0;
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+};
+
+/** Random LQ problem, stages with an index in noInputStages have no inputs. */
+LqProblem getRandomLqProblem(int N, int nx, int nu, const std::vector<int>& noInputStages = {}) {
+  LqProblem problem;
+  problem.x0 = vector_t::Random(nx);
+  for (int k = 0; k < N; ++k) {
+    const bool hasInputs = std::find(noInputStages.begin(), noInputStages.end(), k) == noInputStages.end();
+    problem.dynamics.push_back(getRandomDynamics(nx, hasInputs ? nu : 0));
+    problem.cost.push_back(getRandomCost(nx, hasInputs ? nu : 0));
+  }
+  problem.cost.push_back(getRandomCost(nx, 0));
+  return problem;
+}
+
+/** Solves the LQ problem through its dense KKT system. */
+void solveDenseKkt(const LqProblem& problem, vector_array_t& xSol, vector_array_t& uSol) {
+  const int N = problem.dynamics.size();
+  std::vector<int> xIndex(N + 1), uIndex(N);
+  int numDecisionVariables = 0;
+  int numConstraints = 0;  // one per state
+  for (int k = 0; k <= N; ++k) {
+    xIndex[k] = numDecisionVariables;
+    numDecisionVariables += problem.cost[k].dfdxx.rows();
+    numConstraints += problem.cost[k].dfdxx.rows();
+    if (k < N) {
+      uIndex[k] = numDecisionVariables;
+      numDecisionVariables += problem.dynamics[k].dfdu.cols();
+    }
+  }
+
+  matrix_t kkt = matrix_t::Zero(numDecisionVariables + numConstraints, numDecisionVariables + numConstraints);
+  vector_t rhs = vector_t::Zero(numDecisionVariables + numConstraints);
+  int constraintIndex = numDecisionVariables;
+  for (int k = 0; k <= N; ++k) {
+    const auto& c = problem.cost[k];
+    const int nx = c.dfdxx.rows();
+    kkt.block(xIndex[k], xIndex[k], nx, nx) = c.dfdxx;
+    rhs.segment(xIndex[k], nx) = -c.dfdx;
+    if (k < N && c.dfdu.size() > 0) {
+      const int nu = c.dfdu.size();
+      kkt.block(uIndex[k], uIndex[k], nu, nu) = c.dfduu;
+      kkt.block(uIndex[k], xIndex[k], nu, nx) = c.dfdux;
+      kkt.block(xIndex[k], uIndex[k], nx, nu) = c.dfdux.transpose();
+      rhs.segment(uIndex[k], nu) = -c.dfdu;
+    }
+  }
+  // x_0 = x0
+  const int nx0 = problem.x0.size();
+  kkt.block(constraintIndex, xIndex[0], nx0, nx0).setIdentity();
+  rhs.segment(constraintIndex, nx0) = problem.x0;
+  constraintIndex += nx0;
+  // x_{k+1} - A x_k - B u_k = b
+  for (int k = 0; k < N; ++k) {
+    const auto& d = problem.dynamics[k];
+    const int nx = d.dfdx.cols();
+    const int nxNext = d.dfdx.rows();
+    kkt.block(constraintIndex, xIndex[k + 1], nxNext, nxNext).setIdentity();
+    kkt.block(constraintIndex, xIndex[k], nxNext, nx) = -d.dfdx;
+    kkt.block(constraintIndex, uIndex[k], nxNext, d.dfdu.cols()) = -d.dfdu;
+    rhs.segment(constraintIndex, nxNext) = d.f;
+    constraintIndex += nxNext;
+  }
+  kkt.topRightCorner(numDecisionVariables, numConstraints) = kkt.bottomLeftCorner(numConstraints, numDecisionVariables).transpose();
+
+  const vector_t sol = kkt.lu().solve(rhs);
+  xSol.resize(N + 1);
+  uSol.resize(N);
+  for (int k = 0; k <= N; ++k) {
+    xSol[k] = sol.segment(xIndex[k], problem.cost[k].dfdxx.rows());
+    if (k < N) {
+      uSol[k] = sol.segment(uIndex[k], problem.dynamics[k].dfdu.cols());
+    }
+  }
+}
+
+}  // unnamed namespace
+
+class ParallelRiccatiSolverTest : public testing::TestWithParam<int> {
+ protected:
+  ParallelRiccatiSolverTest() : threadPool(GetParam() - 1) {}
+
+  ThreadPool threadPool;
+  ParallelRiccatiSolver solver;
+};
+
+TEST_P(ParallelRiccatiSolverTest, matchesKkt) {
+  const int numThreads = GetParam();
+  const auto problem = getRandomLqProblem(60, 4, 2, {5, 23, 59});
+
+  vector_array_t xSol, uSol;
+  ASSERT_TRUE(solver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, numThreads, xSol, uSol));
+
+  vector_array_t xKkt, uKkt;
+  solveDenseKkt(problem, xKkt, uKkt);
+  ASSERT_EQ(xSol.size(), xKkt.size());
+  ASSERT_EQ(uSol.size(), uKkt.size());
+  for (int k = 0; k < xSol.size(); ++k) {
+    EXPECT_TRUE(xSol[k].isApprox(xKkt[k], 1e-8)) << "k = " << k;
+  }
+  for (int k = 0; k < uSol.size(); ++k) {
+    EXPECT_TRUE(uSol[k].isApprox(uKkt[k], 1e-8)) << "k = " << k;
+  }
+}
+
+TEST_P(ParallelRiccatiSolverTest, matchesSerialRiccati) {
+  const int numThreads = GetParam();
+  const auto problem = getRandomLqProblem(500, 6, 3);
+
+  ThreadPool serialPool(0);
+  ParallelRiccatiSolver serialSolver;
+  vector_array_t xSerial, uSerial;
+  ASSERT_TRUE(serialSolver.solve(problem.x0, problem.dynamics, problem.cost, serialPool, 1, xSerial, uSerial));
+
+  vector_array_t xSol, uSol;
+  ASSERT_TRUE(solver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, numThreads, xSol, uSol));
+
+  const auto costToGo = solver.getRiccatiCostToGo();
+  const auto serialCostToGo = serialSolver.getRiccatiCostToGo();
+  for (int k = 0; k < costToGo.size(); ++k) {
+    EXPECT_TRUE(costToGo[k].dfdxx.isApprox(serialCostToGo[k].dfdxx, 1e-8)) << "k = " << k;
+    EXPECT_TRUE(costToGo[k].dfdx.isApprox(serialCostToGo[k].dfdx, 1e-8)) << "k = " << k;
+  }
+  for (int k = 0; k < uSol.size(); ++k) {
+    EXPECT_TRUE(solver.getRiccatiFeedback()[k].isApprox(serialSolver.getRiccatiFeedback()[k], 1e-8)) << "k = " << k;
+    EXPECT_TRUE(solver.getRiccatiFeedforward()[k].isApprox(serialSolver.getRiccatiFeedforward()[k], 1e-8)) << "k = " << k;
+    EXPECT_TRUE(uSol[k].isApprox(uSerial[k], 1e-8)) << "k = " << k;
+  }
+}
+
+TEST_P(ParallelRiccatiSolverTest, resolveWithOtherSize) {
+  const int numThreads = GetParam();
+  vector_array_t xSol, uSol;
+  for (const int N : {100, 3, 0, 40}) {
+    const auto problem = getRandomLqProblem(N, 3, 2);
+    ASSERT_TRUE(solver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, numThreads, xSol, uSol));
+
+    vector_array_t xKkt, uKkt;
+    solveDenseKkt(problem, xKkt, uKkt);
+    ASSERT_EQ(xSol.size(), N + 1);
+    ASSERT_EQ(uSol.size(), N);
+    ASSERT_EQ(solver.getRiccatiFeedback().size(), N);
+    ASSERT_EQ(solver.getRiccatiCostToGo().size(), N + 1);
+    EXPECT_TRUE(xSol.back().isApprox(xKkt.back(), 1e-8));
+  }
+}
+
+TEST_P(ParallelRiccatiSolverTest, indefiniteHessian) {
+  const int numThreads = GetParam();
+  for (const int k : {10, 50, 98}) {
+    auto problem = getRandomLqProblem(100, 3, 2);
+    problem.cost[k].dfduu = -100.0 * matrix_t::Identity(2, 2);
+    vector_array_t xSol, uSol;
+    EXPECT_FALSE(solver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, numThreads, xSol, uSol)) << "k = " << k;
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(ParallelRiccatiSolverTestCase, ParallelRiccatiSolverTest, testing::Values(1, 2, 3, 4, 7),
+                        testing::PrintToStringParamName());
@@ -29,8 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <array>
 #include <vector>
 
+#include <ocs2_core/thread_support/ThreadPool.h>
+
 namespace ocs2 {
 
 /**
@@ -79,6 +82,64 @@ template <typename GetValFunc, typename SetValFunc, typename SetImageIndexFunc,
 void computeDistanceTransform(size_t numSamples, GetValFunc&& getValue, SetValFunc&& setValue, SetImageIndexFunc&& setImageIndex,
                               size_t start, size_t end, std::vector<size_t>& vBuffer, std::vector<Scalar>& zBuffer);
 
+/**
+ * Working memory of the grid distance transform. It holds one vBuffer/zBuffer pair per participant of the thread pool and the
+ * intermediate results of the separable passes. Keep an instance alive between calls to avoid reallocations on every map update.
+ *
+ * @tparam Scalar: The Scalar type
+ */
+template <typename Scalar = float>
+struct DistanceTransformBuffers {
+  std::vector<std::vector<size_t>> vBuffers;
+  std::vector<std::vector<Scalar>> zBuffers;
+  std::array<std::vector<Scalar>, 2> intermediate;
+};
+
+/**
+ * Computes the squared Euclidean distance transform of a sampled function on a 2-D or 3-D grid by applying the one-dimensional
+ * transform along each axis. The lines of each pass are distributed over the thread pool.
+ *
+ * The grid is stored with x running fastest, i.e. the value of the cell (x, y, z) is at index x + sizeX * (y + sizeY * z). A 2-D grid is
+ * given as {sizeX, sizeY, 1}. The sampled function is typically zero on the occupied cells and a large value elsewhere, in which case the
+ * output is the squared distance to the nearest occupied cell in units of cells.
+ *
+ * @param gridSize: The number of cells along x, y, and z.
+ * @param input: The sampled function with size sizeX * sizeY * sizeZ.
+ * @param output: The squared distance transform. It is resized to the size of input.
+ * @param threadPool: The thread pool used for running the passes in parallel.
+ * @param buffers: The working memory.
+ *
+ * @tparam Scalar: The Scalar type
+ */
+template <typename Scalar = float>
+void computeDistanceTransform(const std::array<size_t, 3>& gridSize, const std::vector<Scalar>& input, std::vector<Scalar>& output,
+                              ThreadPool& threadPool, DistanceTransformBuffers<Scalar>& buffers);
+
+/**
+ * Incrementally updates the squared distance transform of a grid after the sampled function has changed inside a region. The output
+ * is assumed to hold the result of a previous call of computeDistanceTransform() or updateDistanceTransform() on the same grid.
+ *
+ * The update is exact for a distance transform truncated at maxDistance: Only the cells within maxDistance of the changed region can
+ * change, and their truncated distance depends only on the cells within 2 * maxDistance of it. Therefore only the lines of this band
+ * are processed and only the cells within maxDistance of the changed region are written. The written values are clamped to
+ * maxDistance^2.
+ *
+ * @param gridSize: The number of cells along x, y, and z.
+ * @param input: The updated sampled function with size sizeX * sizeY * sizeZ.
+ * @param output: The squared distance transform to be updated.
+ * @param changedLower: The lower corner (inclusive) of the changed region in cell indices.
+ * @param changedUpper: The upper corner (exclusive) of the changed region in cell indices.
+ * @param maxDistance: The truncation distance in units of cells.
+ * @param threadPool: The thread pool used for running the passes in parallel.
+ * @param buffers: The working memory.
+ *
+ * @tparam Scalar: The Scalar type
+ */
+template <typename Scalar = float>
+void updateDistanceTransform(const std::array<size_t, 3>& gridSize, const std::vector<Scalar>& input, std::vector<Scalar>& output,
+                             const std::array<size_t, 3>& changedLower, const std::array<size_t, 3>& changedUpper, Scalar maxDistance,
+                             ThreadPool& threadPool, DistanceTransformBuffers<Scalar>& buffers);
+
 }  // namespace ocs2
 
 #include "implementation/ComputeDistanceTransform.h"
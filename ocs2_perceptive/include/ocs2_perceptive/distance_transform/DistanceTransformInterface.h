@@ -39,6 +39,7 @@ namespace ocs2 {
 class DistanceTransformInterface {
  public:
   using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+  using matrix3x_t = Eigen::Matrix<scalar_t, 3, Eigen::Dynamic>;
 
   DistanceTransformInterface() = default;
   virtual ~DistanceTransformInterface() = default;
@@ -56,6 +57,39 @@ class DistanceTransformInterface {
 
   /** Gets the distance's value and its gradient at the given point. */
   virtual std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const = 0;
+
+  /**
+   * Gets the distances to a batch of points. The points are stored column-wise and the i-th value corresponds to the i-th column.
+   * The default implementation calls getValue() on each point. Implementations backed by a grid should override it with a vectorized
+   * voxel lookup and interpolation, e.g. trilinear_interpolation::getValues().
+   *
+   * @param [in] points: 3 x N matrix of the queried points.
+   * @param [out] values: The distances of the points.
+   */
+  virtual void getValues(const matrix3x_t& points, vector_t& values) const {
+    values.resize(points.cols());
+    for (Eigen::Index i = 0; i < points.cols(); i++) {
+      values(i) = getValue(points.col(i));
+    }
+  }
+
+  /**
+   * Gets the distances and their gradients for a batch of points in structure-of-arrays layout.
+   * The default implementation calls getLinearApproximation() on each point.
+   *
+   * @param [in] points: 3 x N matrix of the queried points.
+   * @param [out] values: The distances of the points.
+   * @param [out] gradients: 3 x N matrix of the distance gradients, column i corresponds to the i-th point.
+   */
+  virtual void getLinearApproximations(const matrix3x_t& points, vector_t& values, matrix3x_t& gradients) const {
+    values.resize(points.cols());
+    gradients.resize(3, points.cols());
+    for (Eigen::Index i = 0; i < points.cols(); i++) {
+      const auto valueGradient = getLinearApproximation(points.col(i));
+      values(i) = valueGradient.first;
+      gradients.col(i) = valueGradient.second;
+    }
+  }
 };
 
 /** Identity distance transform with constant zero value and zero gradients. */
@@ -67,6 +101,12 @@ class IdentityDistanceTransform : public DistanceTransformInterface {
   scalar_t getValue(const vector3_t&) const override { return 0.0; }
   vector3_t getProjectedPoint(const vector3_t& p) const override { return p; }
   std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t&) const override { return {0.0, vector3_t::Zero()}; }
+
+  void getValues(const matrix3x_t& points, vector_t& values) const override { values.setZero(points.cols()); }
+  void getLinearApproximations(const matrix3x_t& points, vector_t& values, matrix3x_t& gradients) const override {
+    values.setZero(points.cols());
+    gradients.setZero(3, points.cols());
+  }
 };
 
 }  // namespace ocs2
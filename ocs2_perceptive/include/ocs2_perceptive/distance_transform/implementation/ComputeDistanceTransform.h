@@ -27,7 +27,11 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <limits>
+#include <stdexcept>
 #include <utility>
 
 namespace ocs2 {
@@ -96,4 +100,140 @@ void computeDistanceTransform(size_t numSamples, GetValFunc&& getValue, SetValFu
   }  // end of for loop
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+namespace internal {
+
+/** Axis-aligned box of grid cells, [lower, upper). */
+struct GridBox {
+  std::array<size_t, 3> lower;
+  std::array<size_t, 3> upper;
+};
+
+/**
+ * Runs the one-dimensional transform along each non-singleton axis of the grid. All passes operate on the lines of computeBox, while
+ * the last pass only processes and writes the cells of writeBox, which has to be contained in computeBox.
+ */
+template <typename Scalar>
+void computeSeparableDistanceTransform(const std::array<size_t, 3>& gridSize, const std::vector<Scalar>& input,
+                                       std::vector<Scalar>& output, const GridBox& computeBox, const GridBox& writeBox,
+                                       Scalar maxSquaredDistance, ThreadPool& threadPool, DistanceTransformBuffers<Scalar>& buffers) {
+  const size_t numCells = gridSize[0] * gridSize[1] * gridSize[2];
+  if (input.size() != numCells) {
+    throw std::runtime_error("[computeDistanceTransform] The input size does not match the grid size!");
+  }
+  output.resize(numCells);
+
+  // the calling thread participates with the index numThreads
+  const size_t numParticipants = threadPool.numThreads() + 1;
+  buffers.vBuffers.resize(numParticipants);
+  buffers.zBuffers.resize(numParticipants);
+
+  std::vector<size_t> axes;
+  for (size_t d = 0; d < 3; d++) {
+    if (gridSize[d] > 1) {
+      axes.push_back(d);
+    }
+  }
+  if (axes.empty()) {
+    output = input;
+    return;
+  }
+
+  const std::array<size_t, 3> strides{1, gridSize[0], gridSize[0] * gridSize[1]};
+  const std::vector<Scalar>* sourcePtr = &input;
+  for (size_t pass = 0; pass < axes.size(); pass++) {
+    const bool isLastPass = (pass + 1 == axes.size());
+    std::vector<Scalar>& destination = isLastPass ? output : buffers.intermediate[pass % 2];
+    destination.resize(numCells);
+    const std::vector<Scalar>& source = *sourcePtr;
+
+    // the two axes orthogonal to the pass axis span the lines of this pass
+    const size_t axis = axes[pass];
+    const size_t axisA = (axis + 1) % 3;
+    const size_t axisB = (axis + 2) % 3;
+    const GridBox& lineBox = isLastPass ? writeBox : computeBox;
+    const size_t numLinesA = lineBox.upper[axisA] - lineBox.lower[axisA];
+    const size_t numLines = numLinesA * (lineBox.upper[axisB] - lineBox.lower[axisB]);
+    const size_t stride = strides[axis];
+    const size_t start = computeBox.lower[axis];
+    const size_t end = computeBox.upper[axis];
+    const size_t writeStart = writeBox.lower[axis];
+    const size_t writeEnd = writeBox.upper[axis];
+
+    std::atomic_size_t nextLine{0};
+    auto task = [&](int workerIndex) {
+      auto& vBuffer = buffers.vBuffers[workerIndex];
+      auto& zBuffer = buffers.zBuffers[workerIndex];
+
+      size_t l;
+      while ((l = nextLine++) < numLines) {
+        const size_t offset =
+            (lineBox.lower[axisA] + l % numLinesA) * strides[axisA] + (lineBox.lower[axisB] + l / numLinesA) * strides[axisB];
+        const auto getValue = [&](size_t q) { return source[offset + q * stride]; };
+        if (isLastPass) {
+          const auto setValue = [&](size_t q, Scalar val) {
+            if (q >= writeStart && q < writeEnd) {
+              destination[offset + q * stride] = std::min(val, maxSquaredDistance);
+            }
+          };
+          computeDistanceTransform(gridSize[axis], getValue, setValue, start, end, vBuffer, zBuffer);
+        } else {
+          const auto setValue = [&](size_t q, Scalar val) { destination[offset + q * stride] = val; };
+          computeDistanceTransform(gridSize[axis], getValue, setValue, start, end, vBuffer, zBuffer);
+        }
+      }
+    };
+    threadPool.runParallel(task, numParticipants);
+
+    sourcePtr = &destination;
+  }  // end of pass loop
+}
+
+}  // namespace internal
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Scalar>
+void computeDistanceTransform(const std::array<size_t, 3>& gridSize, const std::vector<Scalar>& input, std::vector<Scalar>& output,
+                              ThreadPool& threadPool, DistanceTransformBuffers<Scalar>& buffers) {
+  const internal::GridBox gridBox{{0, 0, 0}, gridSize};
+  internal::computeSeparableDistanceTransform(gridSize, input, output, gridBox, gridBox, std::numeric_limits<Scalar>::max(), threadPool,
+                                              buffers);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Scalar>
+void updateDistanceTransform(const std::array<size_t, 3>& gridSize, const std::vector<Scalar>& input, std::vector<Scalar>& output,
+                             const std::array<size_t, 3>& changedLower, const std::array<size_t, 3>& changedUpper, Scalar maxDistance,
+                             ThreadPool& threadPool, DistanceTransformBuffers<Scalar>& buffers) {
+  if (output.size() != input.size()) {
+    throw std::runtime_error("[updateDistanceTransform] The output does not hold a distance transform of this grid!");
+  }
+
+  // cells within maxDistance of the changed region are written, and they are computed from the cells within 2 * maxDistance of it
+  const auto band = static_cast<size_t>(std::ceil(maxDistance));
+  internal::GridBox writeBox;
+  internal::GridBox computeBox;
+  for (size_t d = 0; d < 3; d++) {
+    if (changedUpper[d] > gridSize[d]) {
+      throw std::runtime_error("[updateDistanceTransform] The changed region exceeds the grid!");
+    }
+    if (changedLower[d] >= changedUpper[d]) {
+      return;  // nothing has changed
+    }
+    writeBox.lower[d] = changedLower[d] - std::min(changedLower[d], band);
+    writeBox.upper[d] = std::min(changedUpper[d] + band, gridSize[d]);
+    computeBox.lower[d] = changedLower[d] - std::min(changedLower[d], 2 * band);
+    computeBox.upper[d] = std::min(changedUpper[d] + 2 * band, gridSize[d]);
+  }
+
+  internal::computeSeparableDistanceTransform(gridSize, input, output, computeBox, writeBox, maxDistance * maxDistance, threadPool,
+                                              buffers);
+}
+
 }  // namespace ocs2
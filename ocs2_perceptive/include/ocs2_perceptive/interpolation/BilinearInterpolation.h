@@ -65,6 +65,39 @@ std::pair<Scalar, Eigen::Matrix<Scalar, 2, 1>> getLinearApproximation(Scalar res
                                                                       const std::array<Scalar, 4>& cornerValues,
                                                                       const Eigen::Matrix<Scalar, 2, 1>& position);
 
+/**
+ * Batched version of getValue() in structure-of-arrays layout. Each column of the inputs corresponds to one queried position, and the
+ * interpolation is carried out row-wise on the whole batch.
+ *
+ * @param resolution The resolution of the grid.
+ * @param referenceCorners 2 x N matrix of the reference positions on the 2-D grid closest to each point.
+ * @param cornerValues 4 x N matrix of the values around each reference corner, in the order: (0, 0), (1, 0), (0, 1), (1, 1).
+ * @param positions 2 x N matrix of the queried positions.
+ * @tparam Scalar : The Scalar type.
+ * @return Eigen::Matrix<Scalar, -1, 1> : The interpolated function's values at the queried positions.
+ */
+template <typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, 1> getValues(Scalar resolution, const Eigen::Matrix<Scalar, 2, Eigen::Dynamic>& referenceCorners,
+                                                   const Eigen::Matrix<Scalar, 4, Eigen::Dynamic>& cornerValues,
+                                                   const Eigen::Matrix<Scalar, 2, Eigen::Dynamic>& positions);
+
+/**
+ * Batched version of getLinearApproximation() in structure-of-arrays layout.
+ *
+ * @param resolution The resolution of the grid.
+ * @param referenceCorners 2 x N matrix of the reference positions on the 2-D grid closest to each point.
+ * @param cornerValues 4 x N matrix of the values around each reference corner, in the order: (0, 0), (1, 0), (0, 1), (1, 1).
+ * @param positions 2 x N matrix of the queried positions.
+ * @param values The interpolated function's values at the queried positions.
+ * @param gradients 2 x N matrix of the gradients at the queried positions.
+ * @tparam Scalar : The Scalar type.
+ */
+template <typename Scalar>
+void getLinearApproximations(Scalar resolution, const Eigen::Matrix<Scalar, 2, Eigen::Dynamic>& referenceCorners,
+                             const Eigen::Matrix<Scalar, 4, Eigen::Dynamic>& cornerValues,
+                             const Eigen::Matrix<Scalar, 2, Eigen::Dynamic>& positions, Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& values,
+                             Eigen::Matrix<Scalar, 2, Eigen::Dynamic>& gradients);
+
 }  // namespace bilinear_interpolation
 }  // namespace ocs2
 
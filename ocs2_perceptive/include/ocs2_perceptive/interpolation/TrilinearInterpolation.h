@@ -67,6 +67,39 @@ std::pair<Scalar, Eigen::Matrix<Scalar, 3, 1>> getLinearApproximation(Scalar res
                                                                       const std::array<Scalar, 8>& cornerValues,
                                                                       const Eigen::Matrix<Scalar, 3, 1>& position);
 
+/**
+ * Batched version of getValue() in structure-of-arrays layout. Each column of the inputs corresponds to one queried position, and the
+ * interpolation is carried out row-wise on the whole batch.
+ *
+ * @param resolution The resolution of the grid.
+ * @param referenceCorners 3 x N matrix of the reference positions on the 3-D grid closest to each point.
+ * @param cornerValues 8 x N matrix of the values around each reference corner, with the rows in the same order as getValue().
+ * @param positions 3 x N matrix of the queried positions.
+ * @tparam Scalar : The Scalar type.
+ * @return Eigen::Matrix<Scalar, -1, 1> : The interpolated function's values at the queried positions.
+ */
+template <typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, 1> getValues(Scalar resolution, const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>& referenceCorners,
+                                                   const Eigen::Matrix<Scalar, 8, Eigen::Dynamic>& cornerValues,
+                                                   const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>& positions);
+
+/**
+ * Batched version of getLinearApproximation() in structure-of-arrays layout.
+ *
+ * @param resolution The resolution of the grid.
+ * @param referenceCorners 3 x N matrix of the reference positions on the 3-D grid closest to each point.
+ * @param cornerValues 8 x N matrix of the values around each reference corner, with the rows in the same order as getValue().
+ * @param positions 3 x N matrix of the queried positions.
+ * @param values The interpolated function's values at the queried positions.
+ * @param gradients 3 x N matrix of the gradients at the queried positions.
+ * @tparam Scalar : The Scalar type.
+ */
+template <typename Scalar>
+void getLinearApproximations(Scalar resolution, const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>& referenceCorners,
+                             const Eigen::Matrix<Scalar, 8, Eigen::Dynamic>& cornerValues,
+                             const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>& positions, Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& values,
+                             Eigen::Matrix<Scalar, 3, Eigen::Dynamic>& gradients);
+
 }  // namespace trilinear_interpolation
 }  // namespace ocs2
 
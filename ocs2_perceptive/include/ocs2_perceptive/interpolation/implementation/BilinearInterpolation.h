@@ -80,5 +80,51 @@ std::pair<Scalar, Eigen::Matrix<Scalar, 2, 1>> getLinearApproximation(Scalar res
   return {value, gradient};
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, 1> getValues(Scalar resolution, const Eigen::Matrix<Scalar, 2, Eigen::Dynamic>& referenceCorners,
+                                                   const Eigen::Matrix<Scalar, 4, Eigen::Dynamic>& cornerValues,
+                                                   const Eigen::Matrix<Scalar, 2, Eigen::Dynamic>& positions) {
+  // auxiliary variables
+  const Scalar r_inv = 1.0 / resolution;
+  const Eigen::Array<Scalar, 2, Eigen::Dynamic> v = (positions - referenceCorners).array() * r_inv;
+  const Eigen::Array<Scalar, 2, Eigen::Dynamic> w = Scalar(1.0) - v;
+  const auto c = cornerValues.array();
+  // (1 - x)(1 - y) f_00 + x (1 - y) f_10 + (1 - x) y f_01 + x y f_11
+  return (w.row(1) * (w.row(0) * c.row(0) + v.row(0) * c.row(1)) + v.row(1) * (w.row(0) * c.row(2) + v.row(0) * c.row(3)))
+      .transpose()
+      .matrix();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Scalar>
+void getLinearApproximations(Scalar resolution, const Eigen::Matrix<Scalar, 2, Eigen::Dynamic>& referenceCorners,
+                             const Eigen::Matrix<Scalar, 4, Eigen::Dynamic>& cornerValues,
+                             const Eigen::Matrix<Scalar, 2, Eigen::Dynamic>& positions, Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& values,
+                             Eigen::Matrix<Scalar, 2, Eigen::Dynamic>& gradients) {
+  using row_array_t = Eigen::Array<Scalar, 1, Eigen::Dynamic>;
+
+  // auxiliary variables
+  const Scalar r_inv = 1.0 / resolution;
+  const Eigen::Array<Scalar, 2, Eigen::Dynamic> v = (positions - referenceCorners).array() * r_inv;
+  const Eigen::Array<Scalar, 2, Eigen::Dynamic> w = Scalar(1.0) - v;
+  const auto c = cornerValues.array();
+  const row_array_t f_0 = w.row(0) * c.row(0) + v.row(0) * c.row(1);  // f_0 = (1 - x) f_00 + x f_10
+  const row_array_t f_1 = w.row(0) * c.row(2) + v.row(0) * c.row(3);  // f_1 = (1 - x) f_01 + x f_11
+
+  // f = (1 - y) f_0 + y f_1
+  values = (w.row(1) * f_0 + v.row(1) * f_1).transpose().matrix();
+
+  gradients.resize(2, positions.cols());
+  // (1 - y) (f_10 - f_00) + y (f_11 - f_01)
+  gradients.row(0) = ((w.row(1) * (c.row(1) - c.row(0)) + v.row(1) * (c.row(3) - c.row(2))) * r_inv).matrix();
+  // (1 - x) (f_01 - f_00) + x (f_11 - f_10)
+  gradients.row(1) = ((f_1 - f_0) * r_inv).matrix();
+}
+
 }  // namespace bilinear_interpolation
 }  // namespace ocs2
@@ -94,5 +94,64 @@ std::pair<Scalar, Eigen::Matrix<Scalar, 3, 1>> getLinearApproximation(Scalar res
   return {value, gradient};
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Scalar>
+Eigen::Matrix<Scalar, Eigen::Dynamic, 1> getValues(Scalar resolution, const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>& referenceCorners,
+                                                   const Eigen::Matrix<Scalar, 8, Eigen::Dynamic>& cornerValues,
+                                                   const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>& positions) {
+  using row_array_t = Eigen::Array<Scalar, 1, Eigen::Dynamic>;
+
+  // auxiliary variables
+  const Scalar r_inv = 1.0 / resolution;
+  const Eigen::Array<Scalar, 3, Eigen::Dynamic> v = (positions - referenceCorners).array() * r_inv;
+  const Eigen::Array<Scalar, 3, Eigen::Dynamic> w = Scalar(1.0) - v;
+  const auto c = cornerValues.array();
+  const row_array_t f_00 = w.row(0) * c.row(0) + v.row(0) * c.row(1);  // f_00 = (1 - x) f_000 + x f_100
+  const row_array_t f_10 = w.row(0) * c.row(2) + v.row(0) * c.row(3);  // f_10 = (1 - x) f_010 + x f_110
+  const row_array_t f_01 = w.row(0) * c.row(4) + v.row(0) * c.row(5);  // f_01 = (1 - x) f_001 + x f_101
+  const row_array_t f_11 = w.row(0) * c.row(6) + v.row(0) * c.row(7);  // f_11 = (1 - x) f_011 + x f_111
+  // (1 - z) ((1 - y) f_00 + y f_10) + z ((1 - y) f_01 + y f_11)
+  return (w.row(2) * (w.row(1) * f_00 + v.row(1) * f_10) + v.row(2) * (w.row(1) * f_01 + v.row(1) * f_11)).transpose().matrix();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Scalar>
+void getLinearApproximations(Scalar resolution, const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>& referenceCorners,
+                             const Eigen::Matrix<Scalar, 8, Eigen::Dynamic>& cornerValues,
+                             const Eigen::Matrix<Scalar, 3, Eigen::Dynamic>& positions, Eigen::Matrix<Scalar, Eigen::Dynamic, 1>& values,
+                             Eigen::Matrix<Scalar, 3, Eigen::Dynamic>& gradients) {
+  using row_array_t = Eigen::Array<Scalar, 1, Eigen::Dynamic>;
+
+  // auxiliary variables
+  const Scalar r_inv = 1.0 / resolution;
+  const Eigen::Array<Scalar, 3, Eigen::Dynamic> v = (positions - referenceCorners).array() * r_inv;
+  const Eigen::Array<Scalar, 3, Eigen::Dynamic> w = Scalar(1.0) - v;
+  const auto c = cornerValues.array();
+  const row_array_t f_00 = w.row(0) * c.row(0) + v.row(0) * c.row(1);  // f_00 = (1 - x) f_000 + x f_100
+  const row_array_t f_10 = w.row(0) * c.row(2) + v.row(0) * c.row(3);  // f_10 = (1 - x) f_010 + x f_110
+  const row_array_t f_01 = w.row(0) * c.row(4) + v.row(0) * c.row(5);  // f_01 = (1 - x) f_001 + x f_101
+  const row_array_t f_11 = w.row(0) * c.row(6) + v.row(0) * c.row(7);  // f_11 = (1 - x) f_011 + x f_111
+  const row_array_t f_0 = w.row(1) * f_00 + v.row(1) * f_10;          // f_0 = (1 - y) f_00 + y f_10
+  const row_array_t f_1 = w.row(1) * f_01 + v.row(1) * f_11;          // f_1 = (1 - y) f_01 + y f_11
+
+  // f = (1 - z) f_0 + z f_1
+  values = (w.row(2) * f_0 + v.row(2) * f_1).transpose().matrix();
+
+  gradients.resize(3, positions.cols());
+  // df_z = f_1 - f_0
+  gradients.row(2) = ((f_1 - f_0) * r_inv).matrix();
+  // df_y = (1 - z) (f_10 - f_00) + z (f_11 - f_01)
+  gradients.row(1) = ((w.row(2) * (f_10 - f_00) + v.row(2) * (f_11 - f_01)) * r_inv).matrix();
+  // df_x = (1 - z) (1 - y) (f_100 - f_000) + (1 - z) y (f_110 - f_010) + z (1 - y) (f_101 - f_001) + z y (f_111 - f_011)
+  gradients.row(0) = ((w.row(2) * w.row(1) * (c.row(1) - c.row(0)) + w.row(2) * v.row(1) * (c.row(3) - c.row(2)) +
+                       v.row(2) * w.row(1) * (c.row(5) - c.row(4)) + v.row(2) * v.row(1) * (c.row(7) - c.row(6))) *
+                      r_inv)
+                         .matrix();
+}
+
 }  // namespace trilinear_interpolation
 }  // namespace ocs2
@@ -103,12 +103,16 @@ vector_t EndEffectorDistanceConstraint::getValue(scalar_t time, const vector_t&
   const auto numEEs = kinematicsPtr_->getIds().size();
   const auto eePositions = kinematicsPtr_->getPosition(state);
 
-  vector_t g(numEEs);
+  DistanceTransformInterface::matrix3x_t eePositionsBatch(3, numEEs);
   for (size_t i = 0; i < numEEs; i++) {
-    g(i) = weight_ * (distanceTransformPtr_->getValue(eePositions[i]) - clearances_[i]);
+    eePositionsBatch.col(i) = eePositions[i];
   }  // end of i loop
 
-  return g;
+  // one batched query for all the end-effectors
+  vector_t distances;
+  distanceTransformPtr_->getValues(eePositionsBatch, distances);
+
+  return weight_ * (distances - Eigen::Map<const vector_t>(clearances_.data(), clearances_.size()));
 }
 
 /******************************************************************************************************/
@@ -123,11 +127,20 @@ VectorFunctionLinearApproximation EndEffectorDistanceConstraint::getLinearApprox
   const auto numEEs = kinematicsPtr_->getIds().size();
   const auto eePosLinApprox = kinematicsPtr_->getPositionLinearApproximation(state);
 
+  DistanceTransformInterface::matrix3x_t eePositionsBatch(3, numEEs);
+  for (size_t i = 0; i < numEEs; i++) {
+    eePositionsBatch.col(i) = eePosLinApprox[i].f;
+  }  // end of i loop
+
+  // one batched query for all the end-effectors
+  vector_t distances;
+  DistanceTransformInterface::matrix3x_t gradients;
+  distanceTransformPtr_->getLinearApproximations(eePositionsBatch, distances, gradients);
+
   VectorFunctionLinearApproximation approx = VectorFunctionLinearApproximation::Zero(numEEs, stateDim_, 0);
+  approx.f = weight_ * (distances - Eigen::Map<const vector_t>(clearances_.data(), clearances_.size()));
   for (size_t i = 0; i < numEEs; i++) {
-    const auto distanceValueGradient = distanceTransformPtr_->getLinearApproximation(eePosLinApprox[i].f);
-    approx.f(i) = weight_ * (distanceValueGradient.first - clearances_[i]);
-    approx.dfdx.row(i).noalias() = weight_ * (distanceValueGradient.second.transpose() * eePosLinApprox[i].dfdx);
+    approx.dfdx.row(i).noalias() = weight_ * (gradients.col(i).transpose() * eePosLinApprox[i].dfdx);
   }  // end of i loop
 
   return approx;
@@ -106,12 +106,11 @@ vector_t EndEffectorDistanceConstraintCppAd::getValue(scalar_t time, const vecto
   const auto eePositions = kinematicsModelPtr_->getFunctionValue(state);
   assert(eePositions.size() == 3 * numEEs);
 
-  vector_t g(numEEs);
-  for (size_t i = 0; i < numEEs; i++) {
-    g(i) = config_.weight * (distanceTransformPtr_->getValue(eePositions.segment<3>(3 * i)) - clearances_[i]);
-  }  // end of i loop
+  // the kinematics model stacks the positions, i.e. they are already stored column-wise
+  vector_t distances;
+  distanceTransformPtr_->getValues(Eigen::Map<const DistanceTransformInterface::matrix3x_t>(eePositions.data(), 3, numEEs), distances);
 
-  return g;
+  return config_.weight * (distances - clearances_);
 }
 
 /******************************************************************************************************/
@@ -127,11 +126,16 @@ VectorFunctionLinearApproximation EndEffectorDistanceConstraintCppAd::getLinearA
   assert(eeJacobians.rows() == 3 * numEEs);
   assert(eeJacobians.cols() == stateDim_);
 
+  // one batched query for all the end-effectors
+  vector_t distances;
+  DistanceTransformInterface::matrix3x_t gradients;
+  distanceTransformPtr_->getLinearApproximations(Eigen::Map<const DistanceTransformInterface::matrix3x_t>(eePositions.data(), 3, numEEs),
+                                                 distances, gradients);
+
   VectorFunctionLinearApproximation approx = VectorFunctionLinearApproximation::Zero(numEEs, stateDim_, inputDim_);
+  approx.f = config_.weight * (distances - clearances_);
   for (size_t i = 0; i < numEEs; i++) {
-    const auto distanceValueGradient = distanceTransformPtr_->getLinearApproximation(eePositions.segment<3>(3 * i));
-    approx.f(i) = config_.weight * (distanceValueGradient.first - clearances_[i]);
-    approx.dfdx.row(i).noalias() = config_.weight * (distanceValueGradient.second.transpose() * eeJacobians.middleRows<3>(3 * i));
+    approx.dfdx.row(i).noalias() = config_.weight * (gradients.col(i).transpose() * eeJacobians.middleRows<3>(3 * i));
   }  // end of i loop
 
   return approx;
@@ -0,0 +1,150 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_perceptive/distance_transform/ComputeDistanceTransform.h"
+
+namespace ocs2 {
+
+class TestComputeDistanceTransform : public ::testing::TestWithParam<std::array<size_t, 3>> {
+ protected:
+  using grid_size_t = std::array<size_t, 3>;
+
+  TestComputeDistanceTransform() : threadPool(numThreads) {}
+
+  /** Samples random occupied cells, zero on the occupied cells and plus infinity elsewhere. */
+  std::vector<float> getRandomOccupancy(const grid_size_t& gridSize) {
+    std::vector<float> occupancy(gridSize[0] * gridSize[1] * gridSize[2], std::numeric_limits<float>::max());
+    std::bernoulli_distribution isOccupied(0.02);
+    for (auto& cell : occupancy) {
+      if (isOccupied(generator)) {
+        cell = 0.0;
+      }
+    }
+    occupancy.front() = 0.0;  // at least one occupied cell
+    return occupancy;
+  }
+
+  /** Brute-force squared distance transform. */
+  std::vector<float> bruteForce(const grid_size_t& gridSize, const std::vector<float>& occupancy) {
+    const auto toCoordinates = [&](size_t i) -> std::array<long, 3> {
+      return {static_cast<long>(i % gridSize[0]), static_cast<long>((i / gridSize[0]) % gridSize[1]),
+              static_cast<long>(i / (gridSize[0] * gridSize[1]))};
+    };
+
+    std::vector<float> result(occupancy.size(), std::numeric_limits<float>::max());
+    for (size_t i = 0; i < occupancy.size(); i++) {
+      const auto p = toCoordinates(i);
+      for (size_t j = 0; j < occupancy.size(); j++) {
+        if (occupancy[j] == 0.0) {
+          const auto o = toCoordinates(j);
+          const long squaredDistance = (p[0] - o[0]) * (p[0] - o[0]) + (p[1] - o[1]) * (p[1] - o[1]) + (p[2] - o[2]) * (p[2] - o[2]);
+          result[i] = std::min(result[i], static_cast<float>(squaredDistance));
+        }
+      }
+    }
+    return result;
+  }
+
+  static constexpr size_t numThreads = 3;
+  static constexpr float precision = 1e-3;
+
+  std::mt19937 generator{0};
+  ThreadPool threadPool;
+  DistanceTransformBuffers<float> buffers;
+};
+
+constexpr size_t TestComputeDistanceTransform::numThreads;
+constexpr float TestComputeDistanceTransform::precision;
+
+TEST_P(TestComputeDistanceTransform, computeDistanceTransform) {
+  const grid_size_t gridSize = GetParam();
+  const auto occupancy = getRandomOccupancy(gridSize);
+  const auto trueDistances = bruteForce(gridSize, occupancy);
+
+  std::vector<float> distances;
+  computeDistanceTransform(gridSize, occupancy, distances, threadPool, buffers);
+
+  ASSERT_EQ(distances.size(), trueDistances.size());
+  for (size_t i = 0; i < distances.size(); i++) {
+    ASSERT_NEAR(distances[i], trueDistances[i], precision) << "at cell " << i;
+  }
+}
+
+TEST_P(TestComputeDistanceTransform, updateDistanceTransform) {
+  const grid_size_t gridSize = GetParam();
+  const float maxDistance = 3.5;
+  auto occupancy = getRandomOccupancy(gridSize);
+
+  std::vector<float> distances;
+  computeDistanceTransform(gridSize, occupancy, distances, threadPool, buffers);
+  for (auto& d : distances) {
+    d = std::min(d, maxDistance * maxDistance);
+  }
+
+  // change a region of the map
+  grid_size_t changedLower;
+  grid_size_t changedUpper;
+  for (size_t d = 0; d < 3; d++) {
+    changedLower[d] = gridSize[d] / 3;
+    changedUpper[d] = std::max(changedLower[d] + 1, gridSize[d] / 2);
+  }
+  std::bernoulli_distribution isOccupied(0.1);
+  for (size_t z = changedLower[2]; z < changedUpper[2]; z++) {
+    for (size_t y = changedLower[1]; y < changedUpper[1]; y++) {
+      for (size_t x = changedLower[0]; x < changedUpper[0]; x++) {
+        occupancy[x + gridSize[0] * (y + gridSize[1] * z)] = isOccupied(generator) ? 0.0 : std::numeric_limits<float>::max();
+      }
+    }
+  }
+
+  updateDistanceTransform(gridSize, occupancy, distances, changedLower, changedUpper, maxDistance, threadPool, buffers);
+
+  // compare against the truncated full recomputation
+  std::vector<float> trueDistances;
+  computeDistanceTransform(gridSize, occupancy, trueDistances, threadPool, buffers);
+  for (size_t i = 0; i < distances.size(); i++) {
+    ASSERT_NEAR(distances[i], std::min(trueDistances[i], maxDistance * maxDistance), precision) << "at cell " << i;
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(GridSizes, TestComputeDistanceTransform,
+                        ::testing::Values(std::array<size_t, 3>{40, 30, 1}, std::array<size_t, 3>{17, 23, 11},
+                                          std::array<size_t, 3>{1, 50, 1}));
+
+}  // namespace ocs2
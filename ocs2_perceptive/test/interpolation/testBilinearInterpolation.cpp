@@ -154,5 +154,38 @@ TEST_F(TestBilinearInterpolation, testBilinearInterpolation) {
   }  // end of i loop
 }
 
+TEST_F(TestBilinearInterpolation, testBatchBilinearInterpolation) {
+  Eigen::Matrix<scalar_t, 2, Eigen::Dynamic> positions(2, numSamples);
+  Eigen::Matrix<scalar_t, 2, Eigen::Dynamic> referenceCorners(2, numSamples);
+  Eigen::Matrix<scalar_t, 4, Eigen::Dynamic> cornerValues(4, numSamples);
+  for (size_t i = 0; i < numSamples; i++) {
+    const vector_t randValues = vector_t::Random(parameterDim - 1 + variableDim - 1);
+    positions.col(i) = randValues.head<2>();
+    referenceCorners.col(i) = randValues.segment<2>(2);
+    cornerValues.col(i) = randValues.tail<4>();
+  }  // end of i loop
+
+  // batch value and linear approximation
+  const vector_t values = bilinear_interpolation::getValues(resolution, referenceCorners, cornerValues, positions);
+  vector_t linApproxValues;
+  Eigen::Matrix<scalar_t, 2, Eigen::Dynamic> linApproxGradients;
+  bilinear_interpolation::getLinearApproximations(resolution, referenceCorners, cornerValues, positions, linApproxValues,
+                                                  linApproxGradients);
+
+  ASSERT_EQ(values.size(), numSamples);
+  ASSERT_EQ(linApproxValues.size(), numSamples);
+  ASSERT_EQ(linApproxGradients.cols(), numSamples);
+  for (size_t i = 0; i < numSamples; i++) {
+    const array4_t cornerValuesArray = {cornerValues(0, i), cornerValues(1, i), cornerValues(2, i), cornerValues(3, i)};
+    const vector2_t referenceCorner = referenceCorners.col(i);
+    const vector2_t position = positions.col(i);
+    const auto trueLinApprox = bilinear_interpolation::getLinearApproximation(resolution, referenceCorner, cornerValuesArray, position);
+
+    EXPECT_NEAR(trueLinApprox.first, values(i), precision);
+    EXPECT_NEAR(trueLinApprox.first, linApproxValues(i), precision);
+    EXPECT_TRUE(trueLinApprox.second.isApprox(linApproxGradients.col(i), precision));
+  }  // end of i loop
+}
+
 }  // namespace bilinear_interpolation
 }  // namespace ocs2
@@ -176,5 +176,41 @@ TEST_F(TestTrilinearInterpolation, testTrilinearInterpolation) {
   }  // end of i loop
 }
 
+TEST_F(TestTrilinearInterpolation, testBatchTrilinearInterpolation) {
+  Eigen::Matrix<scalar_t, 3, Eigen::Dynamic> positions(3, numSamples);
+  Eigen::Matrix<scalar_t, 3, Eigen::Dynamic> referenceCorners(3, numSamples);
+  Eigen::Matrix<scalar_t, 8, Eigen::Dynamic> cornerValues(8, numSamples);
+  for (size_t i = 0; i < numSamples; i++) {
+    const vector_t randValues = vector_t::Random(parameterDim - 1 + variableDim - 1);
+    positions.col(i) = randValues.head<3>();
+    referenceCorners.col(i) = randValues.segment<3>(3);
+    cornerValues.col(i) = randValues.tail<8>();
+  }  // end of i loop
+
+  // batch value and linear approximation
+  const vector_t values = trilinear_interpolation::getValues(resolution, referenceCorners, cornerValues, positions);
+  vector_t linApproxValues;
+  Eigen::Matrix<scalar_t, 3, Eigen::Dynamic> linApproxGradients;
+  trilinear_interpolation::getLinearApproximations(resolution, referenceCorners, cornerValues, positions, linApproxValues,
+                                                   linApproxGradients);
+
+  ASSERT_EQ(values.size(), numSamples);
+  ASSERT_EQ(linApproxValues.size(), numSamples);
+  ASSERT_EQ(linApproxGradients.cols(), numSamples);
+  for (size_t i = 0; i < numSamples; i++) {
+    const array8_t cornerValuesArray = {cornerValues(0, i), cornerValues(1, i), cornerValues(2, i), cornerValues(3, i),
+                                        cornerValues(4, i), cornerValues(5, i), cornerValues(6, i), cornerValues(7, i)};
+    const vector3_t referenceCorner = referenceCorners.col(i);
+    const vector3_t position = positions.col(i);
+    const auto trueLinApprox = trilinear_interpolation::getLinearApproximation(resolution, referenceCorner, cornerValuesArray, position);
+
+    EXPECT_NEAR(trueLinApprox.first, values(i), precision);
+    EXPECT_NEAR(trueLinApprox.first, linApproxValues(i), precision);
+    EXPECT_TRUE(trueLinApprox.second.isApprox(linApproxGradients.col(i), precision))
+        << "the true value is (" << trueLinApprox.second.transpose() << ") while the batch gradient is ("
+        << linApproxGradients.col(i).transpose() << ") ";
+  }  // end of i loop
+}
+
 }  // namespace trilinear_interpolation
 }  // namespace ocs2
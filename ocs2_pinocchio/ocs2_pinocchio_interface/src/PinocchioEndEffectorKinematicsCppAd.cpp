@@ -160,7 +160,8 @@ ad_vector_t PinocchioEndEffectorKinematicsCppAd::getPositionCppAd(PinocchioInter
 /******************************************************************************************************/
 /******************************************************************************************************/
 auto PinocchioEndEffectorKinematicsCppAd::getPosition(const vector_t& state) const -> std::vector<vector3_t> {
-  const vector_t positionValues = positionCppAdInterfacePtr_->getFunctionValue(state);
+  thread_local vector_t positionValues;
+  positionCppAdInterfacePtr_->getFunctionValue(state, vector_t(0), positionValues);
 
   std::vector<vector3_t> positions;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
@@ -174,8 +175,11 @@ auto PinocchioEndEffectorKinematicsCppAd::getPosition(const vector_t& state) con
 /******************************************************************************************************/
 std::vector<VectorFunctionLinearApproximation> PinocchioEndEffectorKinematicsCppAd::getPositionLinearApproximation(
     const vector_t& state) const {
-  const vector_t positionValues = positionCppAdInterfacePtr_->getFunctionValue(state);
-  const matrix_t positionJacobian = positionCppAdInterfacePtr_->getJacobian(state);
+  // Evaluation buffers are reused between calls on the same thread
+  thread_local vector_t positionValues;
+  thread_local matrix_t positionJacobian;
+  positionCppAdInterfacePtr_->getFunctionValue(state, vector_t(0), positionValues);
+  positionCppAdInterfacePtr_->getJacobian(state, vector_t(0), positionJacobian);
 
   std::vector<VectorFunctionLinearApproximation> positions;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
@@ -215,7 +219,8 @@ ad_vector_t PinocchioEndEffectorKinematicsCppAd::getVelocityCppAd(PinocchioInter
 auto PinocchioEndEffectorKinematicsCppAd::getVelocity(const vector_t& state, const vector_t& input) const -> std::vector<vector3_t> {
   vector_t stateInput(state.rows() + input.rows());
   stateInput << state, input;
-  const vector_t velocityValues = velocityCppAdInterfacePtr_->getFunctionValue(stateInput);
+  thread_local vector_t velocityValues;
+  velocityCppAdInterfacePtr_->getFunctionValue(stateInput, vector_t(0), velocityValues);
 
   std::vector<vector3_t> velocities;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
@@ -231,8 +236,11 @@ std::vector<VectorFunctionLinearApproximation> PinocchioEndEffectorKinematicsCpp
     const vector_t& state, const vector_t& input) const {
   vector_t stateInput(state.rows() + input.rows());
   stateInput << state, input;
-  const vector_t velocityValues = velocityCppAdInterfacePtr_->getFunctionValue(stateInput);
-  const matrix_t velocityJacobian = velocityCppAdInterfacePtr_->getJacobian(stateInput);
+  // Evaluation buffers are reused between calls on the same thread
+  thread_local vector_t velocityValues;
+  thread_local matrix_t velocityJacobian;
+  velocityCppAdInterfacePtr_->getFunctionValue(stateInput, vector_t(0), velocityValues);
+  velocityCppAdInterfacePtr_->getJacobian(stateInput, vector_t(0), velocityJacobian);
 
   std::vector<VectorFunctionLinearApproximation> velocities;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
@@ -256,7 +264,8 @@ auto PinocchioEndEffectorKinematicsCppAd::getOrientationError(const vector_t& st
     params.segment<4>(4 * i) = referenceOrientations[i].coeffs();
   }
 
-  const vector_t errorValues = orientationErrorCppAdInterfacePtr_->getFunctionValue(state, params);
+  thread_local vector_t errorValues;
+  orientationErrorCppAdInterfacePtr_->getFunctionValue(state, params, errorValues);
 
   std::vector<vector3_t> errors;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
@@ -275,8 +284,11 @@ std::vector<VectorFunctionLinearApproximation> PinocchioEndEffectorKinematicsCpp
     params.segment<4>(4 * i) = referenceOrientations[i].coeffs();
   }
 
-  const vector_t errorValues = orientationErrorCppAdInterfacePtr_->getFunctionValue(state, params);
-  const matrix_t errorJacobian = orientationErrorCppAdInterfacePtr_->getJacobian(state, params);
+  // Evaluation buffers are reused between calls on the same thread
+  thread_local vector_t errorValues;
+  thread_local matrix_t errorJacobian;
+  orientationErrorCppAdInterfacePtr_->getFunctionValue(state, params, errorValues);
+  orientationErrorCppAdInterfacePtr_->getJacobian(state, params, errorJacobian);
 
   std::vector<VectorFunctionLinearApproximation> errors;
   for (int i = 0; i < endEffectorIds_.size(); i++) {
@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
 #include <utility>
+#include <vector>
 
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
@@ -46,6 +48,8 @@ namespace ocs2 {
 
 class PinocchioGeometryInterface final {
  public:
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+
   /**
    * Constructor
    *
@@ -70,6 +74,10 @@ class PinocchioGeometryInterface final {
   /**
    * Compute collision pair distances
    *
+   * A broad phase first bounds the distance of each pair by the distance between the bounding spheres of its objects. If this bound
+   * is larger than the activation distance, the exact query is skipped and the result contains the bound and the closest points
+   * of the bounding spheres. Otherwise, the exact distance is computed.
+   *
    * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
    *
    * @param [in] pinocchioInterface: pinocchio interface of the robot model
@@ -77,6 +85,33 @@ class PinocchioGeometryInterface final {
    */
   std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface) const;
 
+  /**
+   * Compute collision pair distances, where the exact queries are warm-started from the previous query of the same pair.
+   *
+   * The GJK guesses are kept in the caller-owned distance requests, e.g. one array per thread which evaluates a sequence of close
+   * configurations. The results differ from the ones of computeDistances() by no more than the GJK tolerance.
+   *
+   * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in, out] distanceRequests: The distance requests of the collision pairs, which store the GJK guess of the previous query.
+   * They are initialized if their size does not match the number of collision pairs.
+   * @return An array of distances between pairs of collision bodies defined in the constructor.
+   */
+  std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface,
+                                                         std::vector<hpp::fcl::DistanceRequest>& distanceRequests) const;
+
+  /**
+   * Sets the activation distance of the broad phase. The exact distance is only computed for the collision pairs whose bounding
+   * spheres are closer than this value. The default value is infinity, i.e., the exact distance is computed for all pairs.
+   *
+   * @param [in] activationDistance: The non-negative activation distance.
+   */
+  void setActivationDistance(scalar_t activationDistance);
+
+  /** Get the activation distance of the broad phase */
+  scalar_t getActivationDistance() const { return activationDistance_; }
+
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const;
 
@@ -92,7 +127,20 @@ class PinocchioGeometryInterface final {
   void addCollisionLinkPairs(const PinocchioInterface& pinocchioInterface,
                              const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs);
 
+  void computeBoundingSpheres();
+
+  /** Computes the distances with the given request of each pair, or with a default request if distanceRequests is a nullptr. */
+  std::vector<hpp::fcl::DistanceResult> computeDistancesImpl(const PinocchioInterface& pinocchioInterface,
+                                                             std::vector<hpp::fcl::DistanceRequest>* distanceRequests) const;
+
+  struct BoundingSphere {
+    vector3_t center;  // in the frame of the geometry object
+    scalar_t radius;
+  };
+
   std::shared_ptr<pinocchio::GeometryModel> geometryModelPtr_;
+  std::vector<BoundingSphere> boundingSpheres_;
+  scalar_t activationDistance_ = std::numeric_limits<scalar_t>::infinity();
 };
 
 }  // namespace ocs2
@@ -38,6 +38,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pinocchio/multibody/model.hpp>
 #include <pinocchio/parsers/urdf.hpp>
 
+#include <hpp/fcl/distance.h>
+
 #include <urdf_parser/urdf_parser.h>
 
 namespace ocs2 {
@@ -49,6 +51,7 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
                                                        const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs)
     : geometryModelPtr_(new pinocchio::GeometryModel) {
   buildGeomFromPinocchioInterface(pinocchioInterface, *geometryModelPtr_);
+  computeBoundingSpheres();
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
 }
@@ -58,6 +61,7 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
                                                        const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs)
     : geometryModelPtr_(new pinocchio::GeometryModel) {
   buildGeomFromPinocchioInterface(pinocchioInterface, *geometryModelPtr_);
+  computeBoundingSpheres();
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
   addCollisionLinkPairs(pinocchioInterface, collisionLinkPairs);
@@ -67,12 +71,79 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistances(const PinocchioInterface& pinocchioInterface) const {
-  pinocchio::GeometryData geometryData(*geometryModelPtr_);
+  return computeDistancesImpl(pinocchioInterface, nullptr);
+}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistances(
+    const PinocchioInterface& pinocchioInterface, std::vector<hpp::fcl::DistanceRequest>& distanceRequests) const {
+  const auto numCollisionPairs = geometryModelPtr_->collisionPairs.size();
+  if (distanceRequests.size() != numCollisionPairs) {
+    hpp::fcl::DistanceRequest request(true);
+    request.enable_cached_gjk_guess = true;
+    distanceRequests.assign(numCollisionPairs, request);
+  }
+  return computeDistancesImpl(pinocchioInterface, &distanceRequests);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistancesImpl(
+    const PinocchioInterface& pinocchioInterface, std::vector<hpp::fcl::DistanceRequest>* distanceRequests) const {
+  pinocchio::GeometryData geometryData(*geometryModelPtr_);
   pinocchio::updateGeometryPlacements(pinocchioInterface.getModel(), pinocchioInterface.getData(), *geometryModelPtr_, geometryData);
-  pinocchio::computeDistances(*geometryModelPtr_, geometryData);
 
-  return std::move(geometryData.distanceResults);
+  const auto& collisionPairs = geometryModelPtr_->collisionPairs;
+  hpp::fcl::DistanceRequest coldRequest(true);
+
+  std::vector<hpp::fcl::DistanceResult> distanceResults(collisionPairs.size());
+  for (size_t i = 0; i < collisionPairs.size(); ++i) {
+    const auto& object1 = geometryModelPtr_->geometryObjects[collisionPairs[i].first];
+    const auto& object2 = geometryModelPtr_->geometryObjects[collisionPairs[i].second];
+    const auto& placement1 = geometryData.oMg[collisionPairs[i].first];
+    const auto& placement2 = geometryData.oMg[collisionPairs[i].second];
+    auto& result = distanceResults[i];
+
+    // broad phase: the distance between the bounding spheres is a lower bound of the distance between the objects
+    const auto& sphere1 = boundingSpheres_[collisionPairs[i].first];
+    const auto& sphere2 = boundingSpheres_[collisionPairs[i].second];
+    const vector3_t center1 = placement1.act(sphere1.center);
+    const vector3_t center2 = placement2.act(sphere2.center);
+    const scalar_t centerDistance = (center2 - center1).norm();
+    const scalar_t lowerBound = centerDistance - sphere1.radius - sphere2.radius;
+    if (lowerBound > activationDistance_) {
+      const vector3_t normal = (center2 - center1) / centerDistance;
+      result.min_distance = lowerBound;
+      result.nearest_points[0] = center1 + sphere1.radius * normal;
+      result.nearest_points[1] = center2 - sphere2.radius * normal;
+      result.o1 = object1.geometry.get();
+      result.o2 = object2.geometry.get();
+      continue;
+    }
+
+    // narrow phase: exact distance, warm-started from the previous query of this pair if a request is given
+    auto& request = (distanceRequests != nullptr) ? (*distanceRequests)[i] : coldRequest;
+    hpp::fcl::distance(object1.geometry.get(), pinocchio::toFclTransform3f(placement1), object2.geometry.get(),
+                       pinocchio::toFclTransform3f(placement2), request, result);
+    if (distanceRequests != nullptr) {
+      request.updateGuess(result);
+    }
+  }  // end of i loop
+
+  return distanceResults;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::setActivationDistance(scalar_t activationDistance) {
+  if (activationDistance < 0.0) {
+    throw std::runtime_error("[PinocchioGeometryInterface] The activation distance should be non-negative!");
+  }
+  activationDistance_ = activationDistance;
 }
 
 /******************************************************************************************************/
@@ -101,6 +172,18 @@ void PinocchioGeometryInterface::buildGeomFromPinocchioInterface(const Pinocchio
 
   pinocchio::urdf::buildGeom(pinocchioInterface.getModel(), urdfAsStringStream, pinocchio::COLLISION, geomModel);
 }
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::computeBoundingSpheres() {
+  boundingSpheres_.clear();
+  boundingSpheres_.reserve(geometryModelPtr_->geometryObjects.size());
+  for (const auto& object : geometryModelPtr_->geometryObjects) {
+    object.geometry->computeLocalAABB();
+    boundingSpheres_.push_back({object.geometry->aabb_center, object.geometry->aabb_radius});
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
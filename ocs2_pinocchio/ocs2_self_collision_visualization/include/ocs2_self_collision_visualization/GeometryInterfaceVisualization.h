@@ -47,6 +47,7 @@ class GeometryInterfaceVisualization {
  private:
   PinocchioInterface pinocchioInterface_;
   PinocchioGeometryInterface geometryInterface_;
+  std::vector<hpp::fcl::DistanceRequest> distanceRequests_;  // warm-starts the queries from the previously published configuration
 
   ros::Publisher markerPublisher_;
 
@@ -58,7 +58,7 @@ void GeometryInterfaceVisualization::publishDistances(const ocs2::vector_t& q) {
   const auto& model = pinocchioInterface_.getModel();
   auto& data = pinocchioInterface_.getData();
   pinocchio::forwardKinematics(model, data, q);
-  const auto results = geometryInterface_.computeDistances(pinocchioInterface_);
+  const auto results = geometryInterface_.computeDistances(pinocchioInterface_, distanceRequests_);
 
   visualization_msgs::MarkerArray markerArray;
 
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <pinocchio/multibody/model.hpp>
 
+#include <functional>
 #include <utility>
 
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
@@ -56,6 +57,14 @@ namespace ocs2 {
 class PinocchioSphereInterface final {
  public:
   using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+  using matrix3x_t = Eigen::Matrix<scalar_t, 3, Eigen::Dynamic>;
+
+  /**
+   * Batched distance query on a structure-of-arrays point set, e.g. a thin wrapper around a distance transform or a signed distance field.
+   * Column i of points is the query point i. The callee writes the distance of each point into distances and the distance gradient
+   * w.r.t. each point into the corresponding column of gradients. Both outputs are pre-sized by the caller.
+   */
+  using BatchDistanceQuery = std::function<void(const matrix3x_t& points, vector_t& distances, matrix3x_t& gradients)>;
 
   /** Constructor
    * @param [in] pinocchioInterface : pinocchio interface
@@ -80,6 +89,18 @@ class PinocchioSphereInterface final {
    */
   std::vector<vector3_t> computeSphereCentersInWorldFrame(const PinocchioInterface& pinocchioInterface) const;
 
+  /** Compute the sphere center positions in world frame as a structure of arrays
+   *
+   * All sphere centers of a primitive shape are transformed in one pass, (R * C).colwise() + t, where C holds the local sphere centers
+   * column-wise. Prefer this overload over the array-of-vectors one in hot loops.
+   *
+   * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [out] sphereCentersInWorldFrame: 3 x numSpheresInTotal matrix. Column i is the center of sphere i in world frame.
+   */
+  void computeSphereCentersInWorldFrame(const PinocchioInterface& pinocchioInterface, matrix3x_t& sphereCentersInWorldFrame) const;
+
   /** Get the array of the collision links approximated with spheres */
   const std::vector<std::string>& getCollisionLinks() const { return collisionLinks_; };
 
@@ -112,6 +133,12 @@ class PinocchioSphereInterface final {
     return sphereApproximations_[approxId].getSphereCentersToObjectCenter();
   };
 
+  /** Get the column-wise sphere centers of a primitive shape w.r.t. its object frame */
+  const matrix3x_t& getSphereCentersToObjectCenterBatch(size_t approxId) const { return sphereCentersToObjectCenterBatch_[approxId]; }
+
+  /** Get the index of the first sphere of each primitive shape in the flattened sphere arrays */
+  const size_array_t& getSphereOffsets() const { return sphereOffsets_; };
+
   /** Access the pinocchio geometry model */
   pinocchio::GeometryModel& getGeometryModel() { return *geometryModelPtr_; }
   const pinocchio::GeometryModel& getGeometryModel() const { return *geometryModelPtr_; }
@@ -129,8 +156,10 @@ class PinocchioSphereInterface final {
   size_t numPrimitiveShapes_ = 0;
   size_t numSpheresInTotal_ = 0;
   size_array_t numSpheres_;
+  size_array_t sphereOffsets_;
   size_array_t geomObjIds_;
   scalar_array_t sphereRadii_;
+  std::vector<matrix3x_t> sphereCentersToObjectCenterBatch_;
 };
 
 }  // namespace ocs2
@@ -59,6 +59,7 @@ class PinocchioSphereKinematics final : public EndEffectorKinematics<scalar_t> {
   using EndEffectorKinematics<scalar_t>::vector3_t;
   using EndEffectorKinematics<scalar_t>::matrix3x_t;
   using EndEffectorKinematics<scalar_t>::quaternion_t;
+  using BatchDistanceQuery = PinocchioSphereInterface::BatchDistanceQuery;
 
   /** Constructor
    * @param [in] pinocchioSphereInterface: pinocchio sphere interface.
@@ -92,6 +93,12 @@ class PinocchioSphereKinematics final : public EndEffectorKinematics<scalar_t> {
    */
   std::vector<vector3_t> getPosition(const vector_t& state) const override;
 
+  /** Get the sphere center positions as a structure of arrays, column i is the center of sphere i.
+   * @note requires pinocchioInterface to be updated with:
+   *       pinocchio::forwardKinematics(model, data, q)
+   */
+  matrix3x_t getPositionBatch(const vector_t& state) const;
+
   /** Get the sphere center velocity vectors.
    * @note requires pinocchioInterface to be updated with:
    *       pinocchio::forwardKinematics(model, data, q, v)
@@ -117,6 +124,22 @@ class PinocchioSphereKinematics final : public EndEffectorKinematics<scalar_t> {
    */
   std::vector<VectorFunctionLinearApproximation> getPositionLinearApproximation(const vector_t& state) const override;
 
+  /** Get the linear approximation of the clearance of all spheres, i.e. distance(center_i) - radius_i, in one batch.
+   *
+   * The distance query is evaluated once on all sphere centers. The state Jacobian is then assembled per primitive shape with two
+   * dense products, G^T Jv + (O x G)^T Jw, where G holds the distance gradients, O the sphere offsets from the parent joint, and Jv, Jw
+   * the linear and angular parts of the parent joint Jacobian.
+   *
+   * @note requires pinocchioInterface to be updated with:
+   *       pinocchio::forwardKinematics(model, data, q)
+   *       pinocchio::computeJointJacobians(model, data)
+   *
+   * @param [in] state: state vector
+   * @param [in] distanceQuery: batched distance query, e.g. a distance transform or signed distance field evaluated on many points.
+   * @return The clearances (f) and their state Jacobian (dfdx), one row per sphere.
+   */
+  VectorFunctionLinearApproximation getDistanceLinearApproximation(const vector_t& state, const BatchDistanceQuery& distanceQuery) const;
+
   /** Get the sphere center velocity linear approximation
    * @note requires pinocchioInterface to be updated with:
    *       pinocchio::computeForwardKinematicsDerivatives(model, data, q, v, a)
@@ -51,6 +51,7 @@ class PinocchioSphereKinematicsCppAd final : public EndEffectorKinematics<scalar
   using EndEffectorKinematics<scalar_t>::vector3_t;
   using EndEffectorKinematics<scalar_t>::matrix3x_t;
   using EndEffectorKinematics<scalar_t>::quaternion_t;
+  using BatchDistanceQuery = PinocchioSphereInterface::BatchDistanceQuery;
 
   struct SphereApproxParam {
     SphereApproxParam(vector3_t placementTranslation, quaternion_t placementOrientation, std::vector<vector3_t> sphereCentersToObjectCenter)
@@ -88,6 +89,8 @@ class PinocchioSphereKinematicsCppAd final : public EndEffectorKinematics<scalar
   const std::vector<std::string>& getIds() const override { return linkIds_; };
 
   std::vector<vector3_t> getPosition(const vector_t& state) const override;
+  /** Get the sphere center positions as a structure of arrays, column i is the center of sphere i. */
+  matrix3x_t getPositionBatch(const vector_t& state) const;
   std::vector<vector3_t> getVelocity(const vector_t& state, const vector_t& input) const override {
     throw std::runtime_error("[PinocchioSphereKinematicsCppAd] getVelocity() is not implemented");
   };
@@ -96,6 +99,9 @@ class PinocchioSphereKinematicsCppAd final : public EndEffectorKinematics<scalar
   };
 
   std::vector<VectorFunctionLinearApproximation> getPositionLinearApproximation(const vector_t& state) const override;
+  /** Get the linear approximation of the clearance of all spheres, distance(center_i) - radius_i, with a single batched distance query.
+   * See PinocchioSphereKinematics::getDistanceLinearApproximation. */
+  VectorFunctionLinearApproximation getDistanceLinearApproximation(const vector_t& state, const BatchDistanceQuery& distanceQuery) const;
   std::vector<VectorFunctionLinearApproximation> getVelocityLinearApproximation(const vector_t& state,
                                                                                 const vector_t& input) const override {
     throw std::runtime_error("[PinocchioSphereKinematicsCppAd] getVelocityLinearApproximation() is not implemented");
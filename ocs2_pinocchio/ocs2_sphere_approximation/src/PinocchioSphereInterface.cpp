@@ -61,16 +61,23 @@ PinocchioSphereInterface::PinocchioSphereInterface(const PinocchioInterface& pin
 
   numPrimitiveShapes_ = sphereApproximations_.size();
   numSpheres_.reserve(numPrimitiveShapes_);
+  sphereOffsets_.reserve(numPrimitiveShapes_);
   geomObjIds_.reserve(numPrimitiveShapes_);
+  sphereCentersToObjectCenterBatch_.reserve(numPrimitiveShapes_);
   for (const auto& sphereApprox : sphereApproximations_) {
     const size_t numSpheres = sphereApprox.getNumSpheres();
+    sphereOffsets_.emplace_back(numSpheresInTotal_);
     numSpheresInTotal_ += numSpheres;
     numSpheres_.emplace_back(numSpheres);
     geomObjIds_.emplace_back(sphereApprox.getGeomObjId());
 
+    const auto& sphereCentersToObjectCenter = sphereApprox.getSphereCentersToObjectCenter();
+    matrix3x_t sphereCentersBatch(3, numSpheres);
     for (size_t j = 0; j < numSpheres; j++) {
+      sphereCentersBatch.col(j) = sphereCentersToObjectCenter[j];
       sphereRadii_.push_back(sphereApprox.getSphereRadius());
     }
+    sphereCentersToObjectCenterBatch_.emplace_back(std::move(sphereCentersBatch));
   }
 }
 
@@ -90,8 +97,10 @@ PinocchioSphereInterface::PinocchioSphereInterface(const PinocchioSphereInterfac
       numPrimitiveShapes_(rhs.numPrimitiveShapes_),
       numSpheresInTotal_(rhs.numSpheresInTotal_),
       numSpheres_(rhs.numSpheres_),
+      sphereOffsets_(rhs.sphereOffsets_),
       geomObjIds_(rhs.geomObjIds_),
-      sphereRadii_(rhs.sphereRadii_) {}
+      sphereRadii_(rhs.sphereRadii_),
+      sphereCentersToObjectCenterBatch_(rhs.sphereCentersToObjectCenterBatch_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -124,23 +133,33 @@ void PinocchioSphereInterface::buildGeomFromPinocchioInterface(const PinocchioIn
 /******************************************************************************************************/
 auto PinocchioSphereInterface::computeSphereCentersInWorldFrame(const PinocchioInterface& pinocchioInterface) const
     -> std::vector<vector3_t> {
-  pinocchio::GeometryData geometryData(*geometryModelPtr_);
-
-  pinocchio::updateGeometryPlacements(pinocchioInterface.getModel(), pinocchioInterface.getData(), *geometryModelPtr_, geometryData);
+  matrix3x_t sphereCentersBatch;
+  computeSphereCentersInWorldFrame(pinocchioInterface, sphereCentersBatch);
 
   std::vector<vector3_t> sphereCentersInWorldFrame(numSpheresInTotal_);
+  for (size_t i = 0; i < numSpheresInTotal_; i++) {
+    sphereCentersInWorldFrame[i] = sphereCentersBatch.col(i);
+  }
+  return sphereCentersInWorldFrame;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioSphereInterface::computeSphereCentersInWorldFrame(const PinocchioInterface& pinocchioInterface,
+                                                                matrix3x_t& sphereCentersInWorldFrame) const {
+  const pinocchio::Data& data = pinocchioInterface.getData();
+  sphereCentersInWorldFrame.resize(3, numSpheresInTotal_);
 
-  size_t count = 0;
   for (size_t i = 0; i < numPrimitiveShapes_; i++) {
-    const auto& objTransform = geometryData.oMg[geomObjIds_[i]];
-    const auto& sphereCentersToObjectCenter = sphereApproximations_[i].getSphereCentersToObjectCenter();
-    for (size_t j = 0; j < numSpheres_[i]; j++) {
-      sphereCentersInWorldFrame[count] = objTransform.translation();
-      sphereCentersInWorldFrame[count].noalias() += objTransform.rotation() * sphereCentersToObjectCenter[j];
-      count++;
-    }
+    // only the placement of the geometry objects that are approximated with spheres is needed
+    const pinocchio::GeometryObject& object = geometryModelPtr_->geometryObjects[geomObjIds_[i]];
+    const pinocchio::SE3 objTransform = data.oMi[object.parentJoint] * object.placement;
+
+    auto sphereCenters = sphereCentersInWorldFrame.middleCols(sphereOffsets_[i], numSpheres_[i]);
+    sphereCenters.noalias() = objTransform.rotation() * sphereCentersToObjectCenterBatch_[i];
+    sphereCenters.colwise() += objTransform.translation();
   }
-  return sphereCentersInWorldFrame;
 }
 
 }  // namespace ocs2
@@ -86,6 +86,19 @@ auto PinocchioSphereKinematics::getPosition(const vector_t& state) const -> std:
   return pinocchioSphereInterface_.computeSphereCentersInWorldFrame(*pinocchioInterfacePtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto PinocchioSphereKinematics::getPositionBatch(const vector_t& state) const -> matrix3x_t {
+  if (pinocchioInterfacePtr_ == nullptr) {
+    throw std::runtime_error("[PinocchioSphereKinematics] pinocchioInterfacePtr_ is not set. Use setPinocchioInterface()");
+  }
+
+  matrix3x_t sphereCentersInWorldFrame;
+  pinocchioSphereInterface_.computeSphereCentersInWorldFrame(*pinocchioInterfacePtr_, sphereCentersInWorldFrame);
+  return sphereCentersInWorldFrame;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -94,7 +107,8 @@ std::vector<VectorFunctionLinearApproximation> PinocchioSphereKinematics::getPos
     throw std::runtime_error("[PinocchioSphereKinematics] pinocchioInterfacePtr_ is not set. Use setPinocchioInterface()");
   }
 
-  std::vector<vector3_t> sphereCentersInWorldFrame = pinocchioSphereInterface_.computeSphereCentersInWorldFrame(*pinocchioInterfacePtr_);
+  matrix3x_t sphereCentersInWorldFrame;
+  pinocchioSphereInterface_.computeSphereCentersInWorldFrame(*pinocchioInterfacePtr_, sphereCentersInWorldFrame);
 
   const pinocchio::ReferenceFrame rf = pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED;
   const pinocchio::Model& model = pinocchioInterfacePtr_->getModel();
@@ -103,32 +117,96 @@ std::vector<VectorFunctionLinearApproximation> PinocchioSphereKinematics::getPos
   pinocchio::Data data = pinocchio::Data(pinocchioInterfacePtr_->getData());
 
   std::vector<VectorFunctionLinearApproximation> positions;
+  positions.reserve(sphereCentersInWorldFrame.cols());
 
   const auto& geometryModel = pinocchioSphereInterface_.getGeometryModel();
   const size_t numPrimitiveShapes = pinocchioSphereInterface_.getNumPrimitiveShapes();
-  const auto geomObjIds = pinocchioSphereInterface_.getGeomObjIds();
-  const auto numSpheres = pinocchioSphereInterface_.getNumSpheres();
+  const auto& geomObjIds = pinocchioSphereInterface_.getGeomObjIds();
+  const auto& numSpheres = pinocchioSphereInterface_.getNumSpheres();
+  const auto& sphereOffsets = pinocchioSphereInterface_.getSphereOffsets();
 
-  size_t count = 0;
+  matrix_t jointJacobian = matrix_t::Zero(6, model.nv);
   for (size_t i = 0; i < numPrimitiveShapes; i++) {
     const auto& parentJointId = geometryModel.geometryObjects[geomObjIds[i]].parentJoint;
     const vector3_t& jointPosition = data.oMi[parentJointId].translation();
-    matrix_t jointJacobian = matrix_t::Zero(6, model.nv);
+    jointJacobian.setZero();
     pinocchio::getJointJacobian(model, data, parentJointId, rf, jointJacobian);
 
     for (size_t j = 0; j < numSpheres[i]; j++) {
       VectorFunctionLinearApproximation pos;
-      pos.f = sphereCentersInWorldFrame[count + j];
-      const vector3_t sphereCenterOffset = sphereCentersInWorldFrame[count + j] - jointPosition;
+      pos.f = sphereCentersInWorldFrame.col(sphereOffsets[i] + j);
+      const vector3_t sphereCenterOffset = pos.f - jointPosition;
       const matrix_t sphereCenterJacobian =
           jointJacobian.topRows<3>() - skewSymmetricMatrix(sphereCenterOffset) * jointJacobian.bottomRows<3>();
-      std::tie(pos.dfdx, std::ignore) = mappingPtr_->getOcs2Jacobian(state, sphereCenterJacobian.topRows<3>(), matrix_t::Zero(0, model.nq));
+      std::tie(pos.dfdx, std::ignore) = mappingPtr_->getOcs2Jacobian(state, sphereCenterJacobian, matrix_t::Zero(0, model.nq));
       positions.emplace_back(std::move(pos));
     }
-    count += numSpheres[i];
   }
 
   return positions;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation PinocchioSphereKinematics::getDistanceLinearApproximation(const vector_t& state,
+                                                                                          const BatchDistanceQuery& distanceQuery) const {
+  if (pinocchioInterfacePtr_ == nullptr) {
+    throw std::runtime_error("[PinocchioSphereKinematics] pinocchioInterfacePtr_ is not set. Use setPinocchioInterface()");
+  }
+
+  const size_t numSpheresInTotal = pinocchioSphereInterface_.getNumSpheresInTotal();
+  matrix3x_t sphereCentersInWorldFrame;
+  pinocchioSphereInterface_.computeSphereCentersInWorldFrame(*pinocchioInterfacePtr_, sphereCentersInWorldFrame);
+
+  // one distance query for all the spheres
+  vector_t distances(numSpheresInTotal);
+  matrix3x_t gradients(3, numSpheresInTotal);
+  distanceQuery(sphereCentersInWorldFrame, distances, gradients);
+
+  VectorFunctionLinearApproximation clearance;
+  const auto& radii = pinocchioSphereInterface_.getSphereRadii();
+  clearance.f = distances - Eigen::Map<const vector_t>(radii.data(), radii.size());
+
+  const pinocchio::ReferenceFrame rf = pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED;
+  const pinocchio::Model& model = pinocchioInterfacePtr_->getModel();
+  // TODO(mspieler): Need to copy here because getFrameJacobian() modifies data. Will be fixed in pinocchio version 3.
+  pinocchio::Data data = pinocchio::Data(pinocchioInterfacePtr_->getData());
+
+  const auto& geometryModel = pinocchioSphereInterface_.getGeometryModel();
+  const size_t numPrimitiveShapes = pinocchioSphereInterface_.getNumPrimitiveShapes();
+  const auto& geomObjIds = pinocchioSphereInterface_.getGeomObjIds();
+  const auto& numSpheres = pinocchioSphereInterface_.getNumSpheres();
+  const auto& sphereOffsets = pinocchioSphereInterface_.getSphereOffsets();
+
+  matrix_t distanceJacobian(numSpheresInTotal, model.nv);
+  matrix_t jointJacobian = matrix_t::Zero(6, model.nv);
+  matrix3x_t offsetCrossGradient;
+  for (size_t i = 0; i < numPrimitiveShapes; i++) {
+    const auto& parentJointId = geometryModel.geometryObjects[geomObjIds[i]].parentJoint;
+    jointJacobian.setZero();
+    pinocchio::getJointJacobian(model, data, parentJointId, rf, jointJacobian);
+
+    const auto sphereGradients = gradients.middleCols(sphereOffsets[i], numSpheres[i]);
+    const matrix3x_t sphereCenterOffsets =
+        sphereCentersInWorldFrame.middleCols(sphereOffsets[i], numSpheres[i]).colwise() - data.oMi[parentJointId].translation();
+
+    // g^T (Jv - [o]x Jw) = g^T Jv + (o x g)^T Jw, with the cross products evaluated row-wise on the whole batch
+    offsetCrossGradient.resize(3, numSpheres[i]);
+    offsetCrossGradient.row(0) =
+        sphereCenterOffsets.row(1).cwiseProduct(sphereGradients.row(2)) - sphereCenterOffsets.row(2).cwiseProduct(sphereGradients.row(1));
+    offsetCrossGradient.row(1) =
+        sphereCenterOffsets.row(2).cwiseProduct(sphereGradients.row(0)) - sphereCenterOffsets.row(0).cwiseProduct(sphereGradients.row(2));
+    offsetCrossGradient.row(2) =
+        sphereCenterOffsets.row(0).cwiseProduct(sphereGradients.row(1)) - sphereCenterOffsets.row(1).cwiseProduct(sphereGradients.row(0));
+
+    auto jacobianBlock = distanceJacobian.middleRows(sphereOffsets[i], numSpheres[i]);
+    jacobianBlock.noalias() = sphereGradients.transpose() * jointJacobian.topRows<3>();
+    jacobianBlock.noalias() += offsetCrossGradient.transpose() * jointJacobian.bottomRows<3>();
+  }
+
+  std::tie(clearance.dfdx, std::ignore) = mappingPtr_->getOcs2Jacobian(state, distanceJacobian, matrix_t::Zero(0, model.nq));
+  return clearance;
+}
+
 }  // namespace ocs2
@@ -163,6 +163,39 @@ std::vector<VectorFunctionLinearApproximation> PinocchioSphereKinematicsCppAd::g
   return positions;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto PinocchioSphereKinematicsCppAd::getPositionBatch(const vector_t& state) const -> matrix3x_t {
+  // the generated position function already stores the sphere centers column-wise
+  const vector_t positionValues = positionCppAdInterfacePtr_->getFunctionValue(state);
+  return Eigen::Map<const matrix3x_t>(positionValues.data(), 3, linkIds_.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation PinocchioSphereKinematicsCppAd::getDistanceLinearApproximation(
+    const vector_t& state, const BatchDistanceQuery& distanceQuery) const {
+  const size_t numSpheresInTotal = linkIds_.size();
+  const vector_t positionValues = positionCppAdInterfacePtr_->getFunctionValue(state);
+  const matrix_t positionJacobian = positionCppAdInterfacePtr_->getJacobian(state);
+  const matrix3x_t sphereCentersInWorldFrame = Eigen::Map<const matrix3x_t>(positionValues.data(), 3, numSpheresInTotal);
+
+  vector_t distances(numSpheresInTotal);
+  matrix3x_t gradients(3, numSpheresInTotal);
+  distanceQuery(sphereCentersInWorldFrame, distances, gradients);
+
+  VectorFunctionLinearApproximation clearance;
+  const auto& radii = pinocchioSphereInterface_.getSphereRadii();
+  clearance.f = distances - Eigen::Map<const vector_t>(radii.data(), radii.size());
+  clearance.dfdx.resize(numSpheresInTotal, state.rows());
+  for (size_t i = 0; i < numSpheresInTotal; i++) {
+    clearance.dfdx.row(i).noalias() = gradients.col(i).transpose() * positionJacobian.middleRows<3>(3 * i);
+  }
+  return clearance;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
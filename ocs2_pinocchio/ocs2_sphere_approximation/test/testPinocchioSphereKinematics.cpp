@@ -201,4 +201,58 @@ TEST_F(TestSphereKinematics, testClone) {
   const auto spherePos = clonePtr->getPosition(x)[0];
   const auto spherePosAd = cloneCppAdPtr->getPosition(x)[0];
   EXPECT_TRUE(spherePos.isApprox(spherePosAd));
-}
\ No newline at end of file
+}
+
+TEST_F(TestSphereKinematics, testPositionBatch) {
+  const auto& model = pinocchioInterfacePtr->getModel();
+  auto& data = pinocchioInterfacePtr->getData();
+
+  pinocchio::forwardKinematics(model, data, q);
+  pinocchio::updateFramePlacements(model, data);
+
+  sphereKinematicsPtr->setPinocchioInterface(*pinocchioInterfacePtr);
+
+  const auto spherePos = sphereKinematicsPtr->getPosition(x);
+  const auto spherePosBatch = sphereKinematicsPtr->getPositionBatch(x);
+  const auto spherePosBatchAd = sphereKinematicsCppAdPtr->getPositionBatch(x);
+  ASSERT_EQ(spherePosBatch.cols(), spherePos.size());
+  for (size_t i = 0; i < spherePos.size(); i++) {
+    EXPECT_TRUE(spherePos[i].isApprox(spherePosBatch.col(i)));
+  }
+  EXPECT_TRUE(spherePosBatch.isApprox(spherePosBatchAd));
+}
+
+TEST_F(TestSphereKinematics, testDistanceLinearApproximation) {
+  const auto& model = pinocchioInterfacePtr->getModel();
+  auto& data = pinocchioInterfacePtr->getData();
+
+  pinocchio::forwardKinematics(model, data, q);
+  pinocchio::updateFramePlacements(model, data);
+  pinocchio::computeJointJacobians(model, data);
+
+  sphereKinematicsPtr->setPinocchioInterface(*pinocchioInterfacePtr);
+
+  // distance to an obstacle point
+  const vector3_t obstacle(1.0, -0.5, 0.3);
+  auto distanceQuery = [&](const ocs2::PinocchioSphereInterface::matrix3x_t& points, ocs2::vector_t& distances,
+                           ocs2::PinocchioSphereInterface::matrix3x_t& gradients) {
+    gradients = points.colwise() - obstacle;
+    distances = gradients.colwise().norm().transpose();
+    gradients.array().rowwise() /= distances.transpose().array();
+  };
+
+  const auto clearance = sphereKinematicsPtr->getDistanceLinearApproximation(x, distanceQuery);
+  const auto clearanceAd = sphereKinematicsCppAdPtr->getDistanceLinearApproximation(x, distanceQuery);
+  compareApproximation(clearance, clearanceAd);
+
+  // compare against the per-sphere path
+  const auto spherePosLin = sphereKinematicsPtr->getPositionLinearApproximation(x);
+  const auto& radii = pinocchioSphereInterfacePtr->getSphereRadii();
+  ASSERT_EQ(clearance.f.size(), spherePosLin.size());
+  for (size_t i = 0; i < spherePosLin.size(); i++) {
+    const vector3_t diff = spherePosLin[i].f - obstacle;
+    const ocs2::scalar_t distance = diff.norm();
+    EXPECT_NEAR(clearance.f(i), distance - radii[i], 1e-9);
+    EXPECT_TRUE(clearance.dfdx.row(i).isApprox(diff.transpose() / distance * spherePosLin[i].dfdx));
+  }
+}
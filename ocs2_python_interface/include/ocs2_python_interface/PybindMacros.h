@@ -30,11 +30,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include <ocs2_core/Types.h>
 
+#include "ocs2_python_interface/PythonInterface.h"
+
 using namespace pybind11::literals;
 
 //! convenience macro to bind all kinds of std::vector-like types
@@ -60,6 +63,16 @@ using namespace pybind11::literals;
           "__iter__", [](VTYPE& v) { return pybind11::make_iterator(v.begin(), v.end()); }, \
           pybind11::keep_alive<0, 1>()); /* Keep vector alive while iterator is used */
 
+/**
+ * @brief Convenience function to view the row-major matrices of a batch as a (T x rows x cols) NumPy array without copy.
+ * @note The array keeps the owner of the batch alive.
+ */
+inline pybind11::array_t<ocs2::scalar_t> batchMatrixView(const pybind11::object& owner, const ocs2::row_matrix_t& stacked, size_t rows,
+                                                         size_t cols) {
+  const std::vector<Eigen::Index> shape{stacked.rows(), static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(cols)};
+  return pybind11::array_t<ocs2::scalar_t>(shape, stacked.data(), owner);
+}
+
 /**
  * @brief Convenience macro to bind robot interface with all required vectors.
  * @note LIB_NAME must match target name in CMakeLists
@@ -94,6 +107,25 @@ using namespace pybind11::literals;
         .def_readwrite("dfdxx", &ocs2::ScalarFunctionQuadraticApproximation::dfdxx)                                                        \
         .def_readwrite("dfdux", &ocs2::ScalarFunctionQuadraticApproximation::dfdux)                                                        \
         .def_readwrite("dfduu", &ocs2::ScalarFunctionQuadraticApproximation::dfduu);                                                       \
+    /* bind batch of quadratic approximations, the stacked matrices are viewed as (T x rows x cols) arrays */                              \
+    pybind11::class_<ocs2::ScalarFunctionQuadraticApproximationBatch>(m, "ScalarFunctionQuadraticApproximationBatch")                      \
+        .def_readonly("f", &ocs2::ScalarFunctionQuadraticApproximationBatch::f)                                                            \
+        .def_readonly("dfdx", &ocs2::ScalarFunctionQuadraticApproximationBatch::dfdx)                                                      \
+        .def_readonly("dfdu", &ocs2::ScalarFunctionQuadraticApproximationBatch::dfdu)                                                      \
+        .def_property_readonly("dfdxx",                                                                                                    \
+                               [](const pybind11::object& self) {                                                                          \
+                                 const auto& batch = self.cast<const ocs2::ScalarFunctionQuadraticApproximationBatch&>();                  \
+                                 return batchMatrixView(self, batch.dfdxx, batch.dfdx.cols(), batch.dfdx.cols());                          \
+                               })                                                                                                          \
+        .def_property_readonly("dfdux",                                                                                                    \
+                               [](const pybind11::object& self) {                                                                          \
+                                 const auto& batch = self.cast<const ocs2::ScalarFunctionQuadraticApproximationBatch&>();                  \
+                                 return batchMatrixView(self, batch.dfdux, batch.dfdu.cols(), batch.dfdx.cols());                          \
+                               })                                                                                                          \
+        .def_property_readonly("dfduu", [](const pybind11::object& self) {                                                                 \
+          const auto& batch = self.cast<const ocs2::ScalarFunctionQuadraticApproximationBatch&>();                                         \
+          return batchMatrixView(self, batch.dfduu, batch.dfdu.cols(), batch.dfdu.cols());                                                 \
+        });                                                                                                                                \
     /* bind TargetTrajectories class */                                                                                                    \
     pybind11::class_<ocs2::TargetTrajectories>(m, "TargetTrajectories")                                                                    \
         .def(pybind11::init<ocs2::scalar_array_t, ocs2::vector_array_t, ocs2::vector_array_t>());                                          \
@@ -107,11 +139,16 @@ using namespace pybind11::literals;
         .def("reset", &PY_INTERFACE::reset, "targetTrajectories"_a)                                                                        \
         .def("advanceMpc", &PY_INTERFACE::advanceMpc)                                                                                      \
         .def("getMpcSolution", &PY_INTERFACE::getMpcSolution, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert())                     \
+        .def("getMpcSolutionArrays", &PY_INTERFACE::getMpcSolutionArrays)                                                                  \
         .def("getLinearFeedbackGain", &PY_INTERFACE::getLinearFeedbackGain, "t"_a.noconvert())                                             \
         .def("flowMap", &PY_INTERFACE::flowMap, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                               \
         .def("flowMapLinearApproximation", &PY_INTERFACE::flowMapLinearApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())         \
         .def("cost", &PY_INTERFACE::cost, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                                     \
         .def("costQuadraticApproximation", &PY_INTERFACE::costQuadraticApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())         \
+        .def("flowMapBatch", &PY_INTERFACE::flowMapBatch, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert())                         \
+        .def("costBatch", &PY_INTERFACE::costBatch, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert())                               \
+        .def("costQuadraticApproximationBatch", &PY_INTERFACE::costQuadraticApproximationBatch, "t"_a.noconvert(), "x"_a.noconvert(),      \
+             "u"_a.noconvert())                                                                                                            \
         .def("valueFunction", &PY_INTERFACE::valueFunction, "t"_a, "x"_a.noconvert())                                                      \
         .def("valueFunctionStateDerivative", &PY_INTERFACE::valueFunctionStateDerivative, "t"_a, "x"_a.noconvert())                        \
         .def("stateInputEqualityConstraint", &PY_INTERFACE::stateInputEqualityConstraint, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())     \
@@ -29,14 +29,33 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <tuple>
+
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 #include <ocs2_core/penalties/penalties/PenaltyBase.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_robotic_tools/common/RobotInterface.h>
 
 namespace ocs2 {
 
+/** Row-major matrix, whose memory layout matches a C-contiguous (rows x cols) NumPy array. */
+using row_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+/**
+ * Quadratic approximations of a scalar function at T points, stacked row-wise.
+ * The matrices of point i are stored in row-major order in row i, e.g. dfdxx is (T x nx*nx).
+ */
+struct ScalarFunctionQuadraticApproximationBatch {
+  vector_t f;
+  row_matrix_t dfdx;
+  row_matrix_t dfdu;
+  row_matrix_t dfdxx;
+  row_matrix_t dfdux;
+  row_matrix_t dfduu;
+};
+
 /**
  * PythonInterface provides a unified interface for all systems
  * to the MPC_MRT_Interface to be used for Python bindings
@@ -51,8 +70,9 @@ class PythonInterface {
    * @note This should be called from derived class constructor.
    * @param [in] robot: Robot interface.
    * @param [in] mpcPtr: The Python interface takes ownership of the mpcPtr
+   * @param [in] nThreads: The number of threads used by the batched evaluations, usually the number of threads of the solver.
    */
-  void init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr);
+  void init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr, size_t nThreads = 1);
 
  public:
   /** Destructor */
@@ -106,6 +126,12 @@ class PythonInterface {
    */
   void getMpcSolution(scalar_array_t& t, vector_array_t& x, vector_array_t& u);
 
+  /**
+   * @brief Obtain the full MPC solution as contiguous arrays
+   * @return The tuple of time (T), state (T x nx) and input (T x nu) arrays
+   */
+  std::tuple<vector_t, row_matrix_t, row_matrix_t> getMpcSolutionArrays();
+
   /**
    * @brief Obtains feedback gain matrix, if the underlying MPC algorithm computes it
    * @param[in] t: Query time
@@ -125,6 +151,34 @@ class PythonInterface {
   /** Cost function quadratic approximation with added penalty term */
   ScalarFunctionQuadraticApproximation costQuadraticApproximation(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u);
 
+  /**
+   * System dynamics at T points, evaluated in parallel.
+   * @param[in] t: Times (T)
+   * @param[in] x: States (T x nx)
+   * @param[in] u: Inputs (T x nu)
+   * @return The flow maps (T x nx)
+   */
+  row_matrix_t flowMapBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u);
+
+  /**
+   * Cost function with added penalty term at T points, evaluated in parallel.
+   * @param[in] t: Times (T)
+   * @param[in] x: States (T x nx)
+   * @param[in] u: Inputs (T x nu)
+   * @return The costs (T)
+   */
+  vector_t costBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u);
+
+  /**
+   * Cost function quadratic approximation with added penalty term at T points, evaluated in parallel.
+   * @param[in] t: Times (T)
+   * @param[in] x: States (T x nx)
+   * @param[in] u: Inputs (T x nu)
+   * @return The stacked quadratic approximations
+   */
+  ScalarFunctionQuadraticApproximationBatch costQuadraticApproximationBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                                            Eigen::Ref<const row_matrix_t> u);
+
   /**
    * The solver's internal value function
    * @param t query time
@@ -186,11 +240,22 @@ class PythonInterface {
   int inputDim_ = -1;  // -1 indicates that it is not initialized
 
  private:
+  /** Runs task(workerIndex, i) for all i in [0, numPoints) on the thread pool, with one problem copy per worker. */
+  void runParallel(size_t numPoints, const std::function<void(int, size_t)>& task);
+
+  /** Checks the dimensions of a batch and returns its size T */
+  size_t checkBatchSize(const std::string& caller, Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                        Eigen::Ref<const row_matrix_t> u) const;
+
   std::unique_ptr<MPC_BASE> mpcPtr_;
   std::unique_ptr<MPC_MRT_Interface> mpcMrtInterface_;
 
   TargetTrajectories targetTrajectories_;
   OptimalControlProblem problem_;
+
+  size_t nThreads_ = 1;
+  std::unique_ptr<ThreadPool> threadPoolPtr_;
+  std::vector<OptimalControlProblem> problemStock_;  // one copy of the problem per worker of the batched evaluations
 };
 
 }  // namespace ocs2
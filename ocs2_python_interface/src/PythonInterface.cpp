@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_python_interface/PythonInterface.h"
 
+#include <atomic>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
 
@@ -36,10 +38,74 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/** Cost function with added penalty term and the Lagrangians of the given multipliers */
+scalar_t costWithLagrangians(OptimalControlProblem& problem, const MultiplierCollection& m, scalar_t t, const vector_t& x,
+                             const vector_t& u) {
+  auto& preComputation = *problem.preComputationPtr;
+  const auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
+  preComputation.request(request, t, x, u);
+
+  // cost
+  scalar_t cost = computeCost(problem, t, x, u);
+
+  // Lagrangians
+  if (!problem.stateEqualityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.stateEqualityLagrangianPtr->getValue(t, x, m.stateEq, preComputation));
+  }
+  if (!problem.stateInequalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.stateInequalityLagrangianPtr->getValue(t, x, m.stateIneq, preComputation));
+  }
+  if (!problem.equalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.equalityLagrangianPtr->getValue(t, x, u, m.stateInputEq, preComputation));
+  }
+  if (!problem.inequalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.inequalityLagrangianPtr->getValue(t, x, u, m.stateInputIneq, preComputation));
+  }
+
+  return cost;
+}
+
+/** Quadratic approximation of costWithLagrangians() */
+ScalarFunctionQuadraticApproximation costWithLagrangiansQuadraticApproximation(OptimalControlProblem& problem, const MultiplierCollection& m,
+                                                                               scalar_t t, const vector_t& x, const vector_t& u) {
+  auto& preComputation = *problem.preComputationPtr;
+  const auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
+  preComputation.request(request, t, x, u);
+
+  // cost
+  auto cost = approximateCost(problem, t, x, u);
+
+  // Lagrangians
+  if (!problem.stateEqualityLagrangianPtr->empty()) {
+    auto approx = problem.stateEqualityLagrangianPtr->getQuadraticApproximation(t, x, m.stateEq, preComputation);
+    cost.f += approx.f;
+    cost.dfdx += approx.dfdx;
+    cost.dfdxx += approx.dfdxx;
+  }
+  if (!problem.stateInequalityLagrangianPtr->empty()) {
+    auto approx = problem.stateInequalityLagrangianPtr->getQuadraticApproximation(t, x, m.stateIneq, preComputation);
+    cost.f += approx.f;
+    cost.dfdx += approx.dfdx;
+    cost.dfdxx += approx.dfdxx;
+  }
+  if (!problem.equalityLagrangianPtr->empty()) {
+    cost += problem.equalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputEq, preComputation);
+  }
+  if (!problem.inequalityLagrangianPtr->empty()) {
+    cost += problem.inequalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputIneq, preComputation);
+  }
+
+  return cost;
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr) {
+void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE> mpcPtr, size_t nThreads) {
   if (!mpcPtr) {
     throw std::runtime_error("[PythonInterface] Mpc pointer must be initialized before passing to the Python interface.");
   }
@@ -48,6 +114,15 @@ void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE
   mpcMrtInterface_.reset(new MPC_MRT_Interface(*mpcPtr_));
 
   problem_ = robot.getOptimalControlProblem();
+
+  // resources of the batched evaluations, the calling thread is one of the workers
+  nThreads_ = std::max(nThreads, size_t(1));
+  threadPoolPtr_.reset(new ThreadPool(nThreads_ - 1));
+  problemStock_.clear();
+  problemStock_.reserve(nThreads_);
+  for (size_t i = 0; i < nThreads_; i++) {
+    problemStock_.push_back(problem_);
+  }
 }
 
 /******************************************************************************************************/
@@ -57,6 +132,9 @@ void PythonInterface::reset(TargetTrajectories targetTrajectories) {
   targetTrajectories_ = std::move(targetTrajectories);
   mpcMrtInterface_->resetMpcNode(targetTrajectories_);
   problem_.targetTrajectoriesPtr = &targetTrajectories_;
+  for (auto& problem : problemStock_) {
+    problem.targetTrajectoriesPtr = &targetTrajectories_;
+  }
 }
 
 /******************************************************************************************************/
@@ -76,6 +154,9 @@ void PythonInterface::setObservation(scalar_t t, Eigen::Ref<const vector_t> x, E
 void PythonInterface::setTargetTrajectories(TargetTrajectories targetTrajectories) {
   targetTrajectories_ = std::move(targetTrajectories);
   problem_.targetTrajectoriesPtr = &targetTrajectories_;
+  for (auto& problem : problemStock_) {
+    problem.targetTrajectoriesPtr = &targetTrajectories_;
+  }
   mpcMrtInterface_->getReferenceManager().setTargetTrajectories(targetTrajectories_);
 }
 
@@ -96,6 +177,28 @@ void PythonInterface::getMpcSolution(scalar_array_t& t, vector_array_t& x, vecto
   u = mpcMrtInterface_->getPolicy().inputTrajectory_;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::tuple<vector_t, row_matrix_t, row_matrix_t> PythonInterface::getMpcSolutionArrays() {
+  mpcMrtInterface_->updatePolicy();
+  const auto& policy = mpcMrtInterface_->getPolicy();
+  const size_t T = policy.timeTrajectory_.size();
+
+  vector_t t = Eigen::Map<const vector_t>(policy.timeTrajectory_.data(), T);
+  row_matrix_t x(T, T > 0 ? policy.stateTrajectory_.front().size() : 0);
+  for (size_t i = 0; i < T; i++) {
+    x.row(i) = policy.stateTrajectory_[i].transpose();
+  }
+  const size_t nu = policy.inputTrajectory_.empty() ? 0 : policy.inputTrajectory_.front().size();
+  row_matrix_t u(policy.inputTrajectory_.size(), nu);
+  for (size_t i = 0; i < policy.inputTrajectory_.size(); i++) {
+    u.row(i) = policy.inputTrajectory_[i].transpose();
+  }
+
+  return std::make_tuple(std::move(t), std::move(x), std::move(u));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -122,29 +225,7 @@ VectorFunctionLinearApproximation PythonInterface::flowMapLinearApproximation(sc
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t PythonInterface::cost(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
-  auto& preComputation = *problem_.preComputationPtr;
-  const auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
-  preComputation.request(request, t, x, u);
-
-  // cost
-  scalar_t cost = computeCost(problem_, t, x, u);
-
-  // Lagrangians
-  const auto m = mpcMrtInterface_->getIntermediateDualSolution(t);
-  if (!problem_.stateEqualityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.stateEqualityLagrangianPtr->getValue(t, x, m.stateEq, preComputation));
-  }
-  if (!problem_.stateInequalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.stateInequalityLagrangianPtr->getValue(t, x, m.stateIneq, preComputation));
-  }
-  if (!problem_.equalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.equalityLagrangianPtr->getValue(t, x, u, m.stateInputEq, preComputation));
-  }
-  if (!problem_.inequalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.inequalityLagrangianPtr->getValue(t, x, u, m.stateInputIneq, preComputation));
-  }
-
-  return cost;
+  return costWithLagrangians(problem_, mpcMrtInterface_->getIntermediateDualSolution(t), t, x, u);
 }
 
 /******************************************************************************************************/
@@ -152,35 +233,63 @@ scalar_t PythonInterface::cost(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation PythonInterface::costQuadraticApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
                                                                                  Eigen::Ref<const vector_t> u) {
-  auto& preComputation = *problem_.preComputationPtr;
-  const auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
-  preComputation.request(request, t, x, u);
+  return costWithLagrangiansQuadraticApproximation(problem_, mpcMrtInterface_->getIntermediateDualSolution(t), t, x, u);
+}
 
-  // cost
-  auto cost = approximateCost(problem_, t, x, u);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+row_matrix_t PythonInterface::flowMapBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                           Eigen::Ref<const row_matrix_t> u) {
+  const size_t T = checkBatchSize("flowMapBatch", t, x, u);
+  row_matrix_t dxdt(T, x.cols());
+  runParallel(T, [&](int workerIndex, size_t i) {
+    dxdt.row(i) = problemStock_[workerIndex].dynamicsPtr->computeFlowMap(t(i), x.row(i).transpose(), u.row(i).transpose()).transpose();
+  });
+  return dxdt;
+}
 
-  // Lagrangians
-  const auto m = mpcMrtInterface_->getIntermediateDualSolution(t);
-  if (!problem_.stateEqualityLagrangianPtr->empty()) {
-    auto approx = problem_.stateEqualityLagrangianPtr->getQuadraticApproximation(t, x, m.stateEq, preComputation);
-    cost.f += approx.f;
-    cost.dfdx += approx.dfdx;
-    cost.dfdxx += approx.dfdxx;
-  }
-  if (!problem_.stateInequalityLagrangianPtr->empty()) {
-    auto approx = problem_.stateInequalityLagrangianPtr->getQuadraticApproximation(t, x, m.stateIneq, preComputation);
-    cost.f += approx.f;
-    cost.dfdx += approx.dfdx;
-    cost.dfdxx += approx.dfdxx;
-  }
-  if (!problem_.equalityLagrangianPtr->empty()) {
-    cost += problem_.equalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputEq, preComputation);
-  }
-  if (!problem_.inequalityLagrangianPtr->empty()) {
-    cost += problem_.inequalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputIneq, preComputation);
-  }
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t PythonInterface::costBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u) {
+  const size_t T = checkBatchSize("costBatch", t, x, u);
+  vector_t costs(T);
+  runParallel(T, [&](int workerIndex, size_t i) {
+    const auto m = mpcMrtInterface_->getIntermediateDualSolution(t(i));
+    costs(i) = costWithLagrangians(problemStock_[workerIndex], m, t(i), x.row(i).transpose(), u.row(i).transpose());
+  });
+  return costs;
+}
 
-  return cost;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximationBatch PythonInterface::costQuadraticApproximationBatch(Eigen::Ref<const vector_t> t,
+                                                                                           Eigen::Ref<const row_matrix_t> x,
+                                                                                           Eigen::Ref<const row_matrix_t> u) {
+  const size_t T = checkBatchSize("costQuadraticApproximationBatch", t, x, u);
+  const size_t nx = x.cols();
+  const size_t nu = u.cols();
+  ScalarFunctionQuadraticApproximationBatch batch;
+  batch.f.resize(T);
+  batch.dfdx.resize(T, nx);
+  batch.dfdu.resize(T, nu);
+  batch.dfdxx.resize(T, nx * nx);
+  batch.dfdux.resize(T, nu * nx);
+  batch.dfduu.resize(T, nu * nu);
+  runParallel(T, [&](int workerIndex, size_t i) {
+    const auto m = mpcMrtInterface_->getIntermediateDualSolution(t(i));
+    const auto approx =
+        costWithLagrangiansQuadraticApproximation(problemStock_[workerIndex], m, t(i), x.row(i).transpose(), u.row(i).transpose());
+    batch.f(i) = approx.f;
+    batch.dfdx.row(i) = approx.dfdx.transpose();
+    batch.dfdu.row(i) = approx.dfdu.transpose();
+    row_matrix_t::Map(batch.dfdxx.row(i).data(), nx, nx) = approx.dfdxx;
+    row_matrix_t::Map(batch.dfdux.row(i).data(), nu, nx) = approx.dfdux;
+    row_matrix_t::Map(batch.dfduu.row(i).data(), nu, nu) = approx.dfduu;
+  });
+  return batch;
 }
 
 /******************************************************************************************************/
@@ -240,4 +349,34 @@ vector_t PythonInterface::stateInputEqualityConstraintLagrangian(scalar_t t, Eig
   return DmDager.transpose() * (R * DmDager * c - r - B.transpose() * costate);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PythonInterface::runParallel(size_t numPoints, const std::function<void(int, size_t)>& task) {
+  std::atomic_size_t nextIndex{0};
+  auto parallelTask = [&](int workerIndex) {
+    size_t i = nextIndex++;
+    while (i < numPoints) {
+      task(workerIndex, i);
+      i = nextIndex++;
+    }
+  };
+  threadPoolPtr_->runParallel(std::move(parallelTask), static_cast<int>(nThreads_));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t PythonInterface::checkBatchSize(const std::string& caller, Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                       Eigen::Ref<const row_matrix_t> u) const {
+  if (x.rows() != t.size() || u.rows() != t.size()) {
+    throw std::runtime_error("[PythonInterface::" + caller + "] t, x and u must have the same number of rows.");
+  }
+  // the dimensions are only known if the derived class has set them
+  if ((stateDim_ >= 0 && x.cols() != stateDim_) || (inputDim_ >= 0 && u.cols() != inputDim_)) {
+    throw std::runtime_error("[PythonInterface::" + caller + "] x and u must have stateDim and inputDim columns.");
+  }
+  return t.size();
+}
+
 }  // namespace ocs2
@@ -86,9 +86,11 @@ class DummyPyBindings final : public PythonInterface {
  public:
   using Base = PythonInterface;
 
-  DummyPyBindings() {
+  explicit DummyPyBindings(size_t nThreads = 1) {
+    stateDim_ = 2;
+    inputDim_ = 1;
     DummyInterface robot;
-    PythonInterface::init(robot, robot.getMpc());
+    PythonInterface::init(robot, robot.getMpc(), nThreads);
   }
 };
 
@@ -98,3 +100,43 @@ class DummyPyBindings final : public PythonInterface {
 TEST(OCS2PyBindingsTest, createDummyPyBindings) {
   ocs2::pybindings_test::DummyPyBindings dummy;
 }
+
+TEST(OCS2PyBindingsTest, batchedEvaluation) {
+  constexpr size_t T = 17;
+  ocs2::pybindings_test::DummyPyBindings dummy(3);
+  dummy.reset(ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Zero(2)}, {ocs2::vector_t::Zero(1)}));
+  dummy.setObservation(0.0, ocs2::vector_t::Ones(2), ocs2::vector_t::Zero(1));
+  dummy.advanceMpc();
+
+  const ocs2::vector_t t = ocs2::vector_t::LinSpaced(T, 0.0, 1.0);
+  const ocs2::row_matrix_t x = ocs2::row_matrix_t::Random(T, 2);
+  const ocs2::row_matrix_t u = ocs2::row_matrix_t::Random(T, 1);
+
+  const auto dxdt = dummy.flowMapBatch(t, x, u);
+  const auto costs = dummy.costBatch(t, x, u);
+  const auto approx = dummy.costQuadraticApproximationBatch(t, x, u);
+  for (size_t i = 0; i < T; i++) {
+    const ocs2::vector_t xi = x.row(i).transpose();
+    const ocs2::vector_t ui = u.row(i).transpose();
+    EXPECT_TRUE(dxdt.row(i).transpose().isApprox(dummy.flowMap(t(i), xi, ui)));
+    EXPECT_DOUBLE_EQ(costs(i), dummy.cost(t(i), xi, ui));
+    const auto expected = dummy.costQuadraticApproximation(t(i), xi, ui);
+    EXPECT_DOUBLE_EQ(approx.f(i), expected.f);
+    EXPECT_TRUE(approx.dfdx.row(i).transpose().isApprox(expected.dfdx));
+    EXPECT_TRUE(approx.dfdu.row(i).transpose().isApprox(expected.dfdu));
+    EXPECT_TRUE(ocs2::row_matrix_t::Map(approx.dfdxx.row(i).data(), 2, 2).isApprox(expected.dfdxx));
+    EXPECT_TRUE(ocs2::row_matrix_t::Map(approx.dfduu.row(i).data(), 1, 1).isApprox(expected.dfduu));
+  }
+
+  // solution as arrays
+  ocs2::scalar_array_t timeTrajectory;
+  ocs2::vector_array_t stateTrajectory, inputTrajectory;
+  dummy.getMpcSolution(timeTrajectory, stateTrajectory, inputTrajectory);
+  const auto solution = dummy.getMpcSolutionArrays();
+  ASSERT_EQ(std::get<0>(solution).size(), timeTrajectory.size());
+  for (size_t i = 0; i < timeTrajectory.size(); i++) {
+    EXPECT_DOUBLE_EQ(std::get<0>(solution)(i), timeTrajectory[i]);
+    EXPECT_TRUE(std::get<1>(solution).row(i).transpose().isApprox(stateTrajectory[i]));
+    EXPECT_TRUE(std::get<2>(solution).row(i).transpose().isApprox(inputTrajectory[i]));
+  }
+}
@@ -65,7 +65,7 @@ class BallbotPyBindings final : public PythonInterface {
     mpcPtr->getSolverPtr()->setReferenceManager(ballbotInterface.getReferenceManagerPtr());
 
     // Python interface
-    PythonInterface::init(ballbotInterface, std::move(mpcPtr));
+    PythonInterface::init(ballbotInterface, std::move(mpcPtr), ballbotInterface.ddpSettings().nThreads_);
   }
 };
 
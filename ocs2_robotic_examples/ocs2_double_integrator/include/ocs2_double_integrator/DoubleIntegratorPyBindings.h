@@ -36,7 +36,7 @@ class DoubleIntegratorPyBindings final : public PythonInterface {
     mpcPtr->getSolverPtr()->setReferenceManager(doubleIntegratorInterface.getReferenceManagerPtr());
 
     // Python interface
-    PythonInterface::init(doubleIntegratorInterface, std::move(mpcPtr));
+    PythonInterface::init(doubleIntegratorInterface, std::move(mpcPtr), doubleIntegratorInterface.ddpSettings().nThreads_);
   }
 };
 
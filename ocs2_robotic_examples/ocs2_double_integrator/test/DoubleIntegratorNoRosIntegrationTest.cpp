@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_double_integrator/DoubleIntegratorInterface.h>
 #include <ocs2_double_integrator/package_path.h>
 
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ExecuteAndSleep.h>
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
@@ -208,4 +209,78 @@ TEST_F(DoubleIntegratorIntegrationTest, asynchronousTracking) {
 
   ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
 }
+
+TEST_F(DoubleIntegratorIntegrationTest, realtimePolicyEvaluationJitter) {
+  auto mpcPtr = getMpc(true);
+  MPC_MRT_Interface mpcInterface(*mpcPtr);
+
+  const scalar_t f_mpc_rt = 100.0;
+  const scalar_t f_mrt = 1000.0;
+
+  SystemObservation observation;
+  observation.time = initTime;
+  observation.state = initState;
+  observation.input.setZero(INPUT_DIM);
+
+  // Wait for the first policy
+  mpcInterface.setCurrentObservation(observation);
+  while (!mpcInterface.initialPolicyReceived()) {
+    mpcInterface.advanceMpc();
+  }
+
+  // Run MPC in a thread
+  std::atomic_bool mpcRunning{true};
+  auto mpcThread = std::thread([&]() {
+    while (mpcRunning) {
+      try {
+        ocs2::executeAndSleep([&]() { mpcInterface.advanceMpc(); }, f_mpc_rt);
+      } catch (const std::exception& e) {
+        mpcRunning = false;
+        std::cerr << "EXCEPTION " << e.what() << std::endl;
+        EXPECT_TRUE(false);
+      }
+    }
+  });
+
+  // preallocated outputs of the control loop
+  vector_t mpcState = vector_t::Zero(STATE_DIM);
+  vector_t mpcInput = vector_t::Zero(INPUT_DIM);
+  size_t mode = 0;
+
+  // run MRT
+  benchmark::RepeatedTimer evaluationTimer;
+  while (observation.time < finalTime) {
+    ocs2::executeAndSleep(
+        [&]() {
+          observation.time += 1.0 / f_mrt;
+
+          // Evaluate the policy
+          evaluationTimer.startTimer();
+          mpcInterface.updatePolicy();
+          mpcInterface.evaluatePolicyRealtime(observation.time, observation.state, mpcState, mpcInput, mode);
+          evaluationTimer.endTimer();
+
+          // use optimal state for the next observation:
+          observation.state = mpcState;
+          observation.input = mpcInput;
+          observation.mode = mode;
+          mpcInterface.setCurrentObservation(observation);
+        },
+        f_mrt);
+  }
+
+  mpcRunning = false;
+  if (mpcThread.joinable()) {
+    mpcThread.join();
+  }
+
+  const auto& latencyTimer = mpcInterface.getPolicyLatencyTimer();
+  std::cerr << "\n### Realtime policy evaluation at " << f_mrt << " [Hz] with MPC at " << f_mpc_rt << " [Hz]";
+  std::cerr << "\n###   Evaluation maximum : " << evaluationTimer.getMaxIntervalInMilliseconds() << " [ms].";
+  std::cerr << "\n###   Evaluation average : " << evaluationTimer.getAverageInMilliseconds() << " [ms].";
+  std::cerr << "\n###   Policy handoff maximum : " << latencyTimer.getMaxIntervalInMilliseconds() << " [ms].";
+  std::cerr << "\n###   Policy handoff average : " << latencyTimer.getAverageInMilliseconds() << " [ms].\n";
+
+  ASSERT_NEAR(observation.state(0), goalState(0), tolerance);
+}
 #endif
@@ -54,12 +54,12 @@ class LeggedRobotStateInputQuadraticCost final : public QuadraticStateInputCost
  private:
   LeggedRobotStateInputQuadraticCost(const LeggedRobotStateInputQuadraticCost& rhs) = default;
 
-  std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                       const TargetTrajectories& targetTrajectories) const override {
+  void getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                              vector_t& stateDeviation, vector_t& inputDeviation) const override {
     const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
-    const vector_t xNominal = targetTrajectories.getDesiredState(time);
-    const vector_t uNominal = weightCompensatingInput(info_, contactFlags);
-    return {state - xNominal, input - uNominal};
+    targetTrajectories.getDesiredState(time, stateDeviation);
+    stateDeviation = state - stateDeviation;
+    inputDeviation = input - weightCompensatingInput(info_, contactFlags);
   }
 
   const CentroidalModelInfo info_;
@@ -80,10 +80,10 @@ class LeggedRobotStateQuadraticCost final : public QuadraticStateCost {
  private:
   LeggedRobotStateQuadraticCost(const LeggedRobotStateQuadraticCost& rhs) = default;
 
-  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const override {
-    const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
-    const vector_t xNominal = targetTrajectories.getDesiredState(time);
-    return state - xNominal;
+  void getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                         vector_t& stateDeviation) const override {
+    targetTrajectories.getDesiredState(time, stateDeviation);
+    stateDeviation = state - stateDeviation;
   }
 
   const CentroidalModelInfo info_;
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_centroidal_model/AccessHelperFunctions.h>
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
 #include <ocs2_centroidal_model/ModelHelperFunctions.h>
+#include <ocs2_core/automatic_differentiation/CppAdCompilePool.h>
 #include <ocs2_core/misc/Display.h>
 #include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
 #include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
@@ -133,6 +134,9 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   // Optimal control problem
   problemPtr_.reset(new OptimalControlProblem);
 
+  // The CppAD libraries of all the models below are compiled in parallel
+  CppAdCompilePool cppAdCompilePool;
+
   // Dynamics
   bool useAnalyticalGradientsDynamics = false;
   loadData::loadCppDataType(taskFile, "legged_robot_interface.useAnalyticalGradientsDynamics", useAnalyticalGradientsDynamics);
@@ -194,6 +198,9 @@ void LeggedRobotInterface::setupOptimalConrolProblem(const std::string& taskFile
   problemPtr_->preComputationPtr.reset(new LeggedRobotPreComputation(*pinocchioInterfacePtr_, centroidalModelInfo_,
                                                                      *referenceManagerPtr_->getSwingTrajectoryPlanner(), modelSettings_));
 
+  // Wait for the CppAD libraries before the models are used
+  cppAdCompilePool.wait();
+
   // Rollout
   rolloutPtr_.reset(new TimeTriggeredRollout(*problemPtr_->dynamicsPtr, rolloutSettings_));
 
@@ -156,3 +156,48 @@ TEST_F(TestSelfCollision, testRandomJointPositions) {
     ASSERT_TRUE(Jd1.isApprox(Jd2));
   }
 }
+
+TEST_F(TestSelfCollision, broadPhaseCulling) {
+  constexpr scalar_t activationDistance = 0.2;
+  PinocchioGeometryInterface culledGeometryInterface = geometryInterface;
+  culledGeometryInterface.setActivationDistance(activationDistance);
+  SelfCollision selfCollision(geometryInterface, minDistance);
+  SelfCollision culledSelfCollision(culledGeometryInterface, minDistance);
+
+  for (int i = 0; i < 10; i++) {
+    vector_t q = vector_t::Random(9);
+    computeLinearApproximation(pinocchioInterface, q);
+
+    const auto d = selfCollision.getValue(pinocchioInterface);
+    const auto culledD = culledSelfCollision.getValue(pinocchioInterface);
+    for (int j = 0; j < d.size(); j++) {
+      if (culledD[j] + minDistance <= activationDistance) {
+        // active pairs are evaluated exactly
+        ASSERT_NEAR(culledD[j], d[j], 1e-9);
+      } else {
+        // the bounding spheres underestimate the distance
+        ASSERT_LE(culledD[j], d[j] + 1e-9);
+      }
+    }
+  }
+}
+
+TEST_F(TestSelfCollision, warmStartedDistances) {
+  constexpr scalar_t gjkTolerance = 1e-6;
+  std::vector<hpp::fcl::DistanceRequest> distanceRequests;
+
+  // a trajectory of close configurations, as in a control loop, with a jump to a random configuration every 10 steps
+  vector_t q = jointPositon;
+  for (int i = 0; i < 50; i++) {
+    q = (i % 10 == 9) ? vector_t::Random(9) : vector_t(q + 0.01 * vector_t::Random(9));
+    computeValue(pinocchioInterface, q);
+
+    const auto warmResults = geometryInterface.computeDistances(pinocchioInterface, distanceRequests);
+    const auto coldResults = geometryInterface.computeDistances(pinocchioInterface);
+    ASSERT_EQ(distanceRequests.size(), collisionPairs.size());
+    ASSERT_EQ(warmResults.size(), coldResults.size());
+    for (size_t j = 0; j < coldResults.size(); j++) {
+      ASSERT_NEAR(warmResults[j].min_distance, coldResults[j].min_distance, gjkTolerance);
+    }
+  }
+}
@@ -0,0 +1,61 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+
+#include <ocs2_core/automatic_differentiation/CppAdModelBundle.h>
+#include <ocs2_mobile_manipulator/MobileManipulatorInterface.h>
+
+using namespace ocs2;
+using namespace mobile_manipulator;
+
+/**
+ * Generates the CppAD models of one or several mobile manipulators at build time, see ocs2_add_cppad_bundle(). The models of all the
+ * robots are exported into the same bundle.
+ *
+ * Usage: mobile_manipulator_cppad_bundle <output folder> <bundle name> <task file> <urdf file> [<task file> <urdf file> ...]
+ */
+int main(int argc, char** argv) {
+  if (argc < 5 || (argc - 3) % 2 != 0) {
+    std::cerr << "Usage: " << argv[0] << " <output folder> <bundle name> <task file> <urdf file> [<task file> <urdf file> ...]"
+              << std::endl;
+    return 1;
+  }
+
+  const std::string outputFolder = argv[1];
+  CppAdModelExporter exporter(argv[2]);
+  for (int i = 3; i < argc; i += 2) {
+    // Nothing is compiled into the library folder, the models are only exported
+    MobileManipulatorInterface interface(argv[i], outputFolder + "/auto_generated", argv[i + 1]);
+  }
+  exporter.write(outputFolder);
+
+  std::cerr << "[MobileManipulatorCppAdBundle] Exported " << exporter.getNumModels() << " models to " << outputFolder << std::endl;
+  return 0;
+}
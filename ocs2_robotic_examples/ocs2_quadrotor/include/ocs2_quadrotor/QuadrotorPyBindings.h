@@ -65,7 +65,7 @@ class QuadrotorPyBindings final : public PythonInterface {
     mpcPtr->getSolverPtr()->setReferenceManager(quadrotorInterface.getReferenceManagerPtr());
 
     // Python interface
-    PythonInterface::init(quadrotorInterface, std::move(mpcPtr));
+    PythonInterface::init(quadrotorInterface, std::move(mpcPtr), quadrotorInterface.ddpSettings().nThreads_);
   }
 };
 
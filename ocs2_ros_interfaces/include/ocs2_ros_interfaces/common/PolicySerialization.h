@@ -0,0 +1,93 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ocs2_mpc/CommandData.h>
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+namespace ocs2 {
+
+/** The channel over which the MPC policy is sent from MPC_ROS_Interface to MRT_ROS_Interface. */
+enum class PolicyTransport {
+  FLATTENED_MSG,  //!< ocs2_msgs::mpc_flattened_controller with per-node float arrays
+  BINARY_MSG,     //!< ocs2_msgs::mpc_serialized_policy holding a single contiguous binary buffer
+  SHARED_MEMORY,  //!< binary buffer written into a shared-memory ring (MPC and MRT must run on the same host)
+};
+
+namespace policy_serialization {
+
+/**
+ * Returns the number of bytes required to serialize the policy.
+ *
+ * @param [in] primalSolution: The policy data of the MPC.
+ * @param [in] commandData: The command data of the MPC.
+ * @param [in] performanceIndices: The performance indices data of the solver.
+ */
+size_t getSerializedSize(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices);
+
+/**
+ * Serializes the policy into a contiguous binary buffer. The controller is written with its own time stamps in double precision, so
+ * no interpolation or truncation takes place.
+ *
+ * @param [in] primalSolution: The policy data of the MPC.
+ * @param [in] commandData: The command data of the MPC.
+ * @param [in] performanceIndices: The performance indices data of the solver.
+ * @param [out] buffer: Pointer to the output buffer.
+ * @param [in] capacity: The size of the output buffer. Throws if it is smaller than getSerializedSize().
+ * @return The number of written bytes.
+ */
+size_t serialize(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+                 uint8_t* buffer, size_t capacity);
+
+/**
+ * Serializes the policy into the buffer, which is resized to the serialized size. The buffer capacity is reused between calls.
+ */
+void serialize(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+               std::vector<uint8_t>& buffer);
+
+/**
+ * Reads a policy from a buffer created by serialize(). The existing trajectories and controller of the outputs are overwritten in
+ * place such that no memory is allocated when the dimensions do not change between policies.
+ *
+ * @param [in] buffer: Pointer to the serialized policy.
+ * @param [in] size: The size of the serialized policy. Throws if the buffer is truncated or malformed.
+ * @param [out] commandData: The MPC command data
+ * @param [out] primalSolution: The MPC policy data
+ * @param [out] performanceIndices: The MPC performance indices data
+ */
+void deserialize(const uint8_t* buffer, size_t size, CommandData& commandData, PrimalSolution& primalSolution,
+                 PerformanceIndex& performanceIndices);
+
+}  // namespace policy_serialization
+}  // namespace ocs2
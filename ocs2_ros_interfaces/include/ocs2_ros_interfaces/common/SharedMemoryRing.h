@@ -0,0 +1,159 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ocs2 {
+
+/**
+ * Memory layout of a shared-memory ring which transports variable-sized messages from a single writer to any number of readers on
+ * the same host. Each slot is guarded by a sequence number (seqlock): the writer never waits and the readers never block the writer.
+ * A reader only retries if the slot it copies from is overwritten during the copy, which requires the writer to publish numSlots - 1
+ * further messages in the meantime.
+ */
+struct SharedMemoryRingHeader {
+  uint64_t magic;
+  uint64_t numSlots;
+  uint64_t slotCapacity;
+  std::atomic<uint64_t> latestSequence;  // sequence number of the latest published message, 0 if none
+  std::atomic<uint64_t> closed;          // set by the writer when it shuts down
+};
+
+struct SharedMemoryRingSlot {
+  std::atomic<uint64_t> sequence;  // sequence number of the message in the slot, kWriting while being written
+  uint64_t size;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The shared-memory ring requires lock-free 64-bit atomics.");
+
+/** Converts a ROS topic name into a valid shared-memory object name, e.g. "/robot/mpc_policy" to "/robot_mpc_policy". */
+std::string getSharedMemoryName(const std::string& topicName);
+
+/**
+ * Creates a shared-memory ring and publishes messages into it. An existing ring with the same name is replaced.
+ */
+class SharedMemoryRingWriter {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] name: Name of the shared-memory object, e.g. "/anonymousRobot_mpc_policy".
+   * @param [in] slotCapacity: Maximum size of a message in bytes.
+   * @param [in] numSlots: The number of slots in the ring (at least 2).
+   */
+  SharedMemoryRingWriter(std::string name, size_t slotCapacity, size_t numSlots = 4);
+
+  /** Destructor: marks the ring as closed and removes its name. Readers which still map it are not affected. */
+  ~SharedMemoryRingWriter();
+
+  SharedMemoryRingWriter(const SharedMemoryRingWriter&) = delete;
+  SharedMemoryRingWriter& operator=(const SharedMemoryRingWriter&) = delete;
+
+  /**
+   * Publishes a message which is written in place into the next slot.
+   *
+   * @param [in] size: The size of the message in bytes. Throws if it exceeds the slot capacity.
+   * @param [in] writeMessage: Callable with signature void(uint8_t* data) which writes the message into the slot.
+   */
+  template <typename Writer>
+  void write(size_t size, Writer&& writeMessage) {
+    uint8_t* data = beginWrite(size);
+    writeMessage(data);
+    endWrite();
+  }
+
+  /** Returns the maximum size of a message in bytes. */
+  size_t getSlotCapacity() const { return header_->slotCapacity; }
+
+ private:
+  uint8_t* beginWrite(size_t size);
+  void endWrite();
+
+  std::string name_;
+  size_t mappedSize_;
+  SharedMemoryRingHeader* header_ = nullptr;
+  SharedMemoryRingSlot* activeSlot_ = nullptr;
+  uint64_t sequence_ = 0;
+};
+
+/**
+ * Reads the latest message from a shared-memory ring created by SharedMemoryRingWriter. The reader attaches lazily, so it may be
+ * created before the writer, and re-attaches when the writer is restarted, also if the previous writer did not close its ring.
+ */
+class SharedMemoryRingReader {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] name: Name of the shared-memory object.
+   */
+  explicit SharedMemoryRingReader(std::string name);
+
+  /** Destructor */
+  ~SharedMemoryRingReader();
+
+  SharedMemoryRingReader(const SharedMemoryRingReader&) = delete;
+  SharedMemoryRingReader& operator=(const SharedMemoryRingReader&) = delete;
+
+  /**
+   * Copies the latest message into the buffer if a new message was published since the last successful read. Messages which were
+   * overwritten before they were read are skipped.
+   *
+   * @param [out] buffer: The message. It is resized to the message size, its capacity is reused between calls.
+   * @return true if a new message was copied.
+   */
+  bool readLatest(std::vector<uint8_t>& buffer);
+
+  /** Whether the reader is attached to a ring. */
+  bool isAttached() const { return header_ != nullptr; }
+
+ private:
+  bool attach();
+  void detach();
+  bool readFromRing(std::vector<uint8_t>& buffer);
+
+  /** Whether the name refers to another shared-memory object than the attached one, i.e., a new writer has created a new ring. */
+  bool isReplaced() const;
+
+  std::string name_;
+  size_t mappedSize_ = 0;
+  const SharedMemoryRingHeader* header_ = nullptr;
+  uint64_t lastSequence_ = 0;
+
+  // identifies the attached shared-memory object
+  uint64_t device_ = 0;
+  uint64_t inode_ = 0;
+};
+
+}  // namespace ocs2
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_msgs/mode_schedule.h>
 #include <ocs2_msgs/mpc_flattened_controller.h>
 #include <ocs2_msgs/mpc_observation.h>
+#include <ocs2_msgs/mpc_serialized_policy.h>
 #include <ocs2_msgs/mpc_target_trajectories.h>
 #include <ocs2_msgs/reset.h>
 
@@ -56,6 +57,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_mpc/SystemObservation.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
+#include "ocs2_ros_interfaces/common/PolicySerialization.h"
+#include "ocs2_ros_interfaces/common/SharedMemoryRing.h"
+
 #define PUBLISH_THREAD
 
 namespace ocs2 {
@@ -70,8 +74,11 @@ class MPC_ROS_Interface {
    *
    * @param [in] mpc: The underlying MPC class to be used.
    * @param [in] topicPrefix: The robot's name.
+   * @param [in] policyTransport: The channel over which the policy is sent. The MRT node should use the same transport.
+   * @param [in] sharedMemoryCapacity: The maximum size of a serialized policy in bytes, only used by PolicyTransport::SHARED_MEMORY.
    */
-  explicit MPC_ROS_Interface(MPC_BASE& mpc, std::string topicPrefix = "anonymousRobot");
+  explicit MPC_ROS_Interface(MPC_BASE& mpc, std::string topicPrefix = "anonymousRobot",
+                             PolicyTransport policyTransport = PolicyTransport::FLATTENED_MSG, size_t sharedMemoryCapacity = 8 << 20);
 
   /**
    * Destructor.
@@ -122,6 +129,15 @@ class MPC_ROS_Interface {
   static ocs2_msgs::mpc_flattened_controller createMpcPolicyMsg(const PrimalSolution& primalSolution, const CommandData& commandData,
                                                                 const PerformanceIndex& performanceIndices);
 
+  /**
+   * Publishes the policy over the selected policy transport.
+   *
+   * @param [in] primalSolution: The policy data of the MPC.
+   * @param [in] commandData: The command data of the MPC.
+   * @param [in] performanceIndices: The performance indices data of the solver.
+   */
+  void publishPolicy(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices);
+
   /**
    * Handles ROS publishing thread.
    */
@@ -158,6 +174,12 @@ class MPC_ROS_Interface {
   ::ros::Publisher mpcPolicyPublisher_;
   ::ros::ServiceServer mpcResetServiceServer_;
 
+  // Policy transport
+  const PolicyTransport policyTransport_;
+  const size_t sharedMemoryCapacity_;
+  ocs2_msgs::mpc_serialized_policy serializedPolicyMsg_;
+  std::unique_ptr<SharedMemoryRingWriter> sharedMemoryWriterPtr_;
+
   std::unique_ptr<CommandData> bufferCommandPtr_;
   std::unique_ptr<CommandData> publisherCommandPtr_;
   std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
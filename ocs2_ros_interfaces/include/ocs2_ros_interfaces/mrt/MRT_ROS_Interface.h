@@ -43,11 +43,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // MPC messages
 #include <ocs2_msgs/mpc_flattened_controller.h>
+#include <ocs2_msgs/mpc_serialized_policy.h>
 #include <ocs2_msgs/reset.h>
 
 #include <ocs2_mpc/MRT_BASE.h>
 
+#include "ocs2_ros_interfaces/common/PolicySerialization.h"
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
+#include "ocs2_ros_interfaces/common/SharedMemoryRing.h"
 
 #define PUBLISH_THREAD
 
@@ -64,9 +67,11 @@ class MRT_ROS_Interface : public MRT_BASE {
    * @param [in] topicPrefix: The prefix defines the names for: observation's publishing topic "topicPrefix_mpc_observation",
    * policy's receiving topic "topicPrefix_mpc_policy", and MPC reset service "topicPrefix_mpc_reset".
    * @param [in] mrtTransportHints: ROS transmission protocol.
+   * @param [in] policyTransport: The channel over which the policy is received. It should match the transport of the MPC node.
    */
   explicit MRT_ROS_Interface(std::string topicPrefix = "anonymousRobot",
-                             ::ros::TransportHints mrtTransportHints = ::ros::TransportHints().tcpNoDelay());
+                             ::ros::TransportHints mrtTransportHints = ::ros::TransportHints().tcpNoDelay(),
+                             PolicyTransport policyTransport = PolicyTransport::FLATTENED_MSG);
 
   /**
    * Destructor
@@ -86,7 +91,7 @@ class MRT_ROS_Interface : public MRT_BASE {
   void shutdownPublisher();
 
   /**
-   * spin the MRT callback queue
+   * spin the MRT callback queue. With PolicyTransport::SHARED_MEMORY, it polls the shared memory for a new policy instead.
    */
   void spinMRT();
 
@@ -107,6 +112,13 @@ class MRT_ROS_Interface : public MRT_BASE {
    */
   void mpcPolicyCallback(const ocs2_msgs::mpc_flattened_controller::ConstPtr& msg);
 
+  /**
+   * Callback method to receive the serialized MPC policy.
+   *
+   * @param [in] msg: A constant pointer to the message
+   */
+  void mpcSerializedPolicyCallback(const ocs2_msgs::mpc_serialized_policy::ConstPtr& msg);
+
   /**
    * Helper function to read a MPC policy message.
    *
@@ -138,6 +150,11 @@ class MRT_ROS_Interface : public MRT_BASE {
   ::ros::CallbackQueue mrtCallbackQueue_;
   ::ros::TransportHints mrtTransportHints_;
 
+  // Policy transport
+  PolicyTransport policyTransport_;
+  std::unique_ptr<SharedMemoryRingReader> sharedMemoryReaderPtr_;
+  std::vector<uint8_t> sharedMemoryBuffer_;
+
   // Multi-threading for publishers
   bool terminateThread_;
   bool readyToPublish_;
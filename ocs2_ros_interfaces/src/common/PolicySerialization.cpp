@@ -0,0 +1,365 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/common/PolicySerialization.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+namespace ocs2 {
+namespace policy_serialization {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x3253434f;  // "OCS2" in little endian
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kFeedforwardController = 1;
+constexpr uint32_t kLinearController = 2;
+
+static_assert(std::is_trivially_copyable<PerformanceIndex>::value, "PerformanceIndex is serialized as a plain memory block.");
+
+/** Archive that only counts the bytes. */
+class SizeCounter {
+ public:
+  template <typename T>
+  void write(const T& /* value */) {
+    size_ += sizeof(T);
+  }
+  void writeBytes(const void* /* data */, size_t numBytes) { size_ += numBytes; }
+  size_t size() const { return size_; }
+
+ private:
+  size_t size_ = 0;
+};
+
+/** Archive that writes into a buffer which is large enough. */
+class BufferWriter {
+ public:
+  explicit BufferWriter(uint8_t* buffer) : buffer_(buffer) {}
+  template <typename T>
+  void write(const T& value) {
+    writeBytes(&value, sizeof(T));
+  }
+  void writeBytes(const void* data, size_t numBytes) {
+    std::memcpy(buffer_ + size_, data, numBytes);
+    size_ += numBytes;
+  }
+  size_t size() const { return size_; }
+
+ private:
+  uint8_t* buffer_;
+  size_t size_ = 0;
+};
+
+/** Bounds-checked reader of a serialized buffer. */
+class BufferReader {
+ public:
+  BufferReader(const uint8_t* buffer, size_t size) : buffer_(buffer), size_(size) {}
+  template <typename T>
+  T read() {
+    T value;
+    readBytes(&value, sizeof(T));
+    return value;
+  }
+  void readBytes(void* data, size_t numBytes) {
+    require(numBytes);
+    std::memcpy(data, buffer_ + position_, numBytes);
+    position_ += numBytes;
+  }
+  /** Reads a number of elements and checks that the remaining buffer can hold them. */
+  size_t readCount(size_t minElementSize) {
+    const auto count = read<uint64_t>();
+    if (count > (size_ - position_) / minElementSize) {
+      throw std::runtime_error("[policy_serialization::deserialize] Array size exceeds the buffer!");
+    }
+    return static_cast<size_t>(count);
+  }
+  size_t remaining() const { return size_ - position_; }
+
+ private:
+  void require(size_t numBytes) const {
+    if (numBytes > size_ - position_) {
+      throw std::runtime_error("[policy_serialization::deserialize] The buffer is truncated!");
+    }
+  }
+
+  const uint8_t* buffer_;
+  size_t size_;
+  size_t position_ = 0;
+};
+
+template <typename Archive>
+void writeScalarArray(Archive& archive, const scalar_array_t& array) {
+  archive.write(static_cast<uint64_t>(array.size()));
+  archive.writeBytes(array.data(), array.size() * sizeof(scalar_t));
+}
+
+template <typename Archive>
+void writeSizeArray(Archive& archive, const size_array_t& array) {
+  archive.write(static_cast<uint64_t>(array.size()));
+  for (const auto i : array) {
+    archive.write(static_cast<uint64_t>(i));
+  }
+}
+
+template <typename Archive>
+void writeVector(Archive& archive, const vector_t& vector) {
+  archive.write(static_cast<uint64_t>(vector.size()));
+  archive.writeBytes(vector.data(), vector.size() * sizeof(scalar_t));
+}
+
+template <typename Archive>
+void writeMatrix(Archive& archive, const matrix_t& matrix) {
+  archive.write(static_cast<uint64_t>(matrix.rows()));
+  archive.write(static_cast<uint64_t>(matrix.cols()));
+  archive.writeBytes(matrix.data(), matrix.size() * sizeof(scalar_t));
+}
+
+template <typename Archive, typename Array, typename WriteElement>
+void writeArray(Archive& archive, const Array& array, WriteElement writeElement) {
+  archive.write(static_cast<uint64_t>(array.size()));
+  for (const auto& element : array) {
+    writeElement(archive, element);
+  }
+}
+
+void readScalarArray(BufferReader& reader, scalar_array_t& array) {
+  array.resize(reader.readCount(sizeof(scalar_t)));
+  reader.readBytes(array.data(), array.size() * sizeof(scalar_t));
+}
+
+void readSizeArray(BufferReader& reader, size_array_t& array) {
+  array.resize(reader.readCount(sizeof(uint64_t)));
+  for (auto& i : array) {
+    i = static_cast<size_t>(reader.read<uint64_t>());
+  }
+}
+
+void readVector(BufferReader& reader, vector_t& vector) {
+  vector.resize(reader.readCount(sizeof(scalar_t)));
+  reader.readBytes(vector.data(), vector.size() * sizeof(scalar_t));
+}
+
+void readMatrix(BufferReader& reader, matrix_t& matrix) {
+  const auto rows = reader.read<uint64_t>();
+  const auto cols = reader.read<uint64_t>();
+  if (rows != 0 && cols > reader.remaining() / sizeof(scalar_t) / rows) {
+    throw std::runtime_error("[policy_serialization::deserialize] Matrix size exceeds the buffer!");
+  }
+  matrix.resize(rows, cols);
+  reader.readBytes(matrix.data(), matrix.size() * sizeof(scalar_t));
+}
+
+template <typename Array, typename ReadElement>
+void readArray(BufferReader& reader, Array& array, ReadElement readElement) {
+  // every element holds at least its size
+  array.resize(reader.readCount(sizeof(uint64_t)));
+  for (auto& element : array) {
+    readElement(reader, element);
+  }
+}
+
+template <typename Archive>
+void writePolicy(Archive& archive, const PrimalSolution& primalSolution, const CommandData& commandData,
+                 const PerformanceIndex& performanceIndices) {
+  archive.write(kMagic);
+  archive.write(kVersion);
+
+  archive.write(performanceIndices);
+
+  // command
+  const auto& observation = commandData.mpcInitObservation_;
+  archive.write(static_cast<uint64_t>(observation.mode));
+  archive.write(observation.time);
+  writeVector(archive, observation.state);
+  writeVector(archive, observation.input);
+  const auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  writeScalarArray(archive, targetTrajectories.timeTrajectory);
+  writeArray(archive, targetTrajectories.stateTrajectory, writeVector<Archive>);
+  writeArray(archive, targetTrajectories.inputTrajectory, writeVector<Archive>);
+
+  // primal solution
+  writeScalarArray(archive, primalSolution.timeTrajectory_);
+  writeArray(archive, primalSolution.stateTrajectory_, writeVector<Archive>);
+  writeArray(archive, primalSolution.inputTrajectory_, writeVector<Archive>);
+  writeSizeArray(archive, primalSolution.postEventIndices_);
+  writeScalarArray(archive, primalSolution.modeSchedule_.eventTimes);
+  writeSizeArray(archive, primalSolution.modeSchedule_.modeSequence);
+
+  // controller
+  switch (primalSolution.controllerPtr_->getType()) {
+    case ControllerType::FEEDFORWARD: {
+      const auto& controller = static_cast<const FeedforwardController&>(*primalSolution.controllerPtr_);
+      archive.write(kFeedforwardController);
+      writeScalarArray(archive, controller.timeStamp_);
+      writeArray(archive, controller.uffArray_, writeVector<Archive>);
+      break;
+    }
+    case ControllerType::LINEAR: {
+      const auto& controller = static_cast<const LinearController&>(*primalSolution.controllerPtr_);
+      archive.write(kLinearController);
+      writeScalarArray(archive, controller.timeStamp_);
+      writeArray(archive, controller.biasArray_, writeVector<Archive>);
+      writeArray(archive, controller.gainArray_, writeMatrix<Archive>);
+      break;
+    }
+    default:
+      throw std::runtime_error("[policy_serialization::serialize] Unknown ControllerType!");
+  }
+}
+
+/** Returns the controller of the given type, reusing the existing instance if it has the same type. */
+template <typename Controller>
+Controller& getController(PrimalSolution& primalSolution) {
+  auto* controllerPtr = dynamic_cast<Controller*>(primalSolution.controllerPtr_.get());
+  if (controllerPtr == nullptr) {
+    controllerPtr = new Controller();
+    primalSolution.controllerPtr_.reset(controllerPtr);
+  }
+  return *controllerPtr;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t getSerializedSize(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices) {
+  SizeCounter counter;
+  writePolicy(counter, primalSolution, commandData, performanceIndices);
+  return counter.size();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t serialize(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+                 uint8_t* buffer, size_t capacity) {
+  const size_t size = getSerializedSize(primalSolution, commandData, performanceIndices);
+  if (size > capacity) {
+    throw std::runtime_error("[policy_serialization::serialize] The policy requires " + std::to_string(size) +
+                             " bytes but the buffer capacity is " + std::to_string(capacity) + " bytes!");
+  }
+  BufferWriter writer(buffer);
+  writePolicy(writer, primalSolution, commandData, performanceIndices);
+  return writer.size();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void serialize(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+               std::vector<uint8_t>& buffer) {
+  buffer.resize(getSerializedSize(primalSolution, commandData, performanceIndices));
+  BufferWriter writer(buffer.data());
+  writePolicy(writer, primalSolution, commandData, performanceIndices);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void deserialize(const uint8_t* buffer, size_t size, CommandData& commandData, PrimalSolution& primalSolution,
+                 PerformanceIndex& performanceIndices) {
+  BufferReader reader(buffer, size);
+  if (reader.read<uint32_t>() != kMagic) {
+    throw std::runtime_error("[policy_serialization::deserialize] The buffer does not contain a serialized policy!");
+  }
+  if (reader.read<uint32_t>() != kVersion) {
+    throw std::runtime_error("[policy_serialization::deserialize] Unsupported serialization version!");
+  }
+
+  performanceIndices = reader.read<PerformanceIndex>();
+
+  // command
+  auto& observation = commandData.mpcInitObservation_;
+  observation.mode = static_cast<size_t>(reader.read<uint64_t>());
+  observation.time = reader.read<scalar_t>();
+  readVector(reader, observation.state);
+  readVector(reader, observation.input);
+  auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  readScalarArray(reader, targetTrajectories.timeTrajectory);
+  readArray(reader, targetTrajectories.stateTrajectory, readVector);
+  readArray(reader, targetTrajectories.inputTrajectory, readVector);
+
+  // primal solution
+  readScalarArray(reader, primalSolution.timeTrajectory_);
+  readArray(reader, primalSolution.stateTrajectory_, readVector);
+  readArray(reader, primalSolution.inputTrajectory_, readVector);
+  readSizeArray(reader, primalSolution.postEventIndices_);
+  readScalarArray(reader, primalSolution.modeSchedule_.eventTimes);
+  readSizeArray(reader, primalSolution.modeSchedule_.modeSequence);
+
+  const size_t N = primalSolution.timeTrajectory_.size();
+  if (N == 0) {
+    throw std::runtime_error("[policy_serialization::deserialize] The policy is empty!");
+  }
+  if (primalSolution.stateTrajectory_.size() != N || primalSolution.inputTrajectory_.size() != N) {
+    throw std::runtime_error("[policy_serialization::deserialize] State and input trajectories must have the same length as time!");
+  }
+  if (primalSolution.modeSchedule_.modeSequence.size() != primalSolution.modeSchedule_.eventTimes.size() + 1) {
+    throw std::runtime_error("[policy_serialization::deserialize] The mode schedule is malformed!");
+  }
+
+  // controller
+  switch (reader.read<uint32_t>()) {
+    case kFeedforwardController: {
+      auto& controller = getController<FeedforwardController>(primalSolution);
+      readScalarArray(reader, controller.timeStamp_);
+      readArray(reader, controller.uffArray_, readVector);
+      if (controller.uffArray_.size() != controller.timeStamp_.size()) {
+        throw std::runtime_error("[policy_serialization::deserialize] The feedforward controller is malformed!");
+      }
+      break;
+    }
+    case kLinearController: {
+      auto& controller = getController<LinearController>(primalSolution);
+      readScalarArray(reader, controller.timeStamp_);
+      readArray(reader, controller.biasArray_, readVector);
+      readArray(reader, controller.gainArray_, readMatrix);
+      controller.deltaBiasArray_.clear();
+      if (controller.biasArray_.size() != controller.timeStamp_.size() || controller.gainArray_.size() != controller.timeStamp_.size()) {
+        throw std::runtime_error("[policy_serialization::deserialize] The linear controller is malformed!");
+      }
+      break;
+    }
+    default:
+      throw std::runtime_error("[policy_serialization::deserialize] Unknown controller type!");
+  }
+
+  if (reader.remaining() != 0) {
+    throw std::runtime_error("[policy_serialization::deserialize] Unexpected data at the end of the buffer!");
+  }
+}
+
+}  // namespace policy_serialization
+}  // namespace ocs2
@@ -0,0 +1,305 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_ros_interfaces/common/SharedMemoryRing.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+namespace ocs2 {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x474e4952324d4853;  // "SHM2RING" in little endian
+constexpr uint64_t kWriting = std::numeric_limits<uint64_t>::max();
+constexpr size_t kAlignment = 64;  // cache line
+
+constexpr size_t align(size_t size) {
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+constexpr size_t kHeaderSize = align(sizeof(SharedMemoryRingHeader));
+constexpr size_t kSlotHeaderSize = align(sizeof(SharedMemoryRingSlot));
+
+size_t getSlotStride(size_t slotCapacity) {
+  return kSlotHeaderSize + align(slotCapacity);
+}
+
+size_t getMappedSize(size_t numSlots, size_t slotCapacity) {
+  return kHeaderSize + numSlots * getSlotStride(slotCapacity);
+}
+
+SharedMemoryRingSlot* getSlot(SharedMemoryRingHeader* header, uint64_t sequence) {
+  auto* memory = reinterpret_cast<uint8_t*>(header) + kHeaderSize + (sequence % header->numSlots) * getSlotStride(header->slotCapacity);
+  return reinterpret_cast<SharedMemoryRingSlot*>(memory);
+}
+
+const SharedMemoryRingSlot* getSlot(const SharedMemoryRingHeader* header, uint64_t sequence) {
+  return getSlot(const_cast<SharedMemoryRingHeader*>(header), sequence);
+}
+
+uint8_t* getSlotData(SharedMemoryRingSlot* slot) {
+  return reinterpret_cast<uint8_t*>(slot) + kSlotHeaderSize;
+}
+
+const uint8_t* getSlotData(const SharedMemoryRingSlot* slot) {
+  return reinterpret_cast<const uint8_t*>(slot) + kSlotHeaderSize;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string getSharedMemoryName(const std::string& topicName) {
+  std::string name = "/";
+  for (const char c : topicName) {
+    if (c != '/' || name.size() > 1) {
+      name.push_back(c == '/' ? '_' : c);
+    }
+  }
+  return name;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryRingWriter::SharedMemoryRingWriter(std::string name, size_t slotCapacity, size_t numSlots)
+    : name_(std::move(name)), mappedSize_(getMappedSize(numSlots, slotCapacity)) {
+  if (numSlots < 2) {
+    throw std::runtime_error("[SharedMemoryRingWriter] The ring requires at least 2 slots!");
+  }
+
+  // replace a ring left over by a previous writer
+  shm_unlink(name_.c_str());
+  const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("[SharedMemoryRingWriter] Failed to create shared memory " + name_ + ": " + std::strerror(errno));
+  }
+  if (ftruncate(fd, static_cast<off_t>(mappedSize_)) != 0) {
+    const int error = errno;
+    close(fd);
+    shm_unlink(name_.c_str());
+    throw std::runtime_error("[SharedMemoryRingWriter] Failed to resize shared memory " + name_ + ": " + std::strerror(error));
+  }
+  void* memory = mmap(nullptr, mappedSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    shm_unlink(name_.c_str());
+    throw std::runtime_error("[SharedMemoryRingWriter] Failed to map shared memory " + name_ + ": " + std::strerror(errno));
+  }
+
+  header_ = new (memory) SharedMemoryRingHeader;
+  header_->numSlots = numSlots;
+  header_->slotCapacity = slotCapacity;
+  header_->latestSequence.store(0, std::memory_order_relaxed);
+  header_->closed.store(0, std::memory_order_relaxed);
+  for (size_t i = 0; i < numSlots; i++) {
+    auto* slot = new (getSlot(header_, i)) SharedMemoryRingSlot;
+    slot->sequence.store(0, std::memory_order_relaxed);
+    slot->size = 0;
+  }
+  // readers only attach once the magic number is visible
+  std::atomic_thread_fence(std::memory_order_release);
+  header_->magic = kMagic;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryRingWriter::~SharedMemoryRingWriter() {
+  header_->closed.store(1, std::memory_order_release);
+  munmap(header_, mappedSize_);
+  shm_unlink(name_.c_str());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint8_t* SharedMemoryRingWriter::beginWrite(size_t size) {
+  if (size > header_->slotCapacity) {
+    throw std::runtime_error("[SharedMemoryRingWriter::write] The message requires " + std::to_string(size) +
+                             " bytes but the slot capacity is " + std::to_string(header_->slotCapacity) + " bytes!");
+  }
+  sequence_++;
+  activeSlot_ = getSlot(header_, sequence_);
+  activeSlot_->sequence.store(kWriting, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  activeSlot_->size = size;
+  return getSlotData(activeSlot_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemoryRingWriter::endWrite() {
+  activeSlot_->sequence.store(sequence_, std::memory_order_release);
+  header_->latestSequence.store(sequence_, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryRingReader::SharedMemoryRingReader(std::string name) : name_(std::move(name)) {
+  attach();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryRingReader::~SharedMemoryRingReader() {
+  detach();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryRingReader::attach() {
+  const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < kHeaderSize) {
+    close(fd);
+    return false;
+  }
+  const auto mappedSize = static_cast<size_t>(status.st_size);
+  void* memory = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    return false;
+  }
+
+  const auto* header = static_cast<const SharedMemoryRingHeader*>(memory);
+  const bool isInitialized = header->magic == kMagic;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (!isInitialized || header->numSlots < 2 || getMappedSize(header->numSlots, header->slotCapacity) != mappedSize) {
+    munmap(memory, mappedSize);
+    return false;
+  }
+
+  header_ = header;
+  mappedSize_ = mappedSize;
+  lastSequence_ = 0;
+  device_ = static_cast<uint64_t>(status.st_dev);
+  inode_ = static_cast<uint64_t>(status.st_ino);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemoryRingReader::detach() {
+  if (header_ != nullptr) {
+    munmap(const_cast<SharedMemoryRingHeader*>(header_), mappedSize_);
+    header_ = nullptr;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryRingReader::isReplaced() const {
+  const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;  // no new ring yet
+  }
+  struct stat status;
+  const bool isStatValid = fstat(fd, &status) == 0;
+  close(fd);
+  return isStatValid && (static_cast<uint64_t>(status.st_dev) != device_ || static_cast<uint64_t>(status.st_ino) != inode_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryRingReader::readLatest(std::vector<uint8_t>& buffer) {
+  if (header_ != nullptr && header_->closed.load(std::memory_order_acquire) != 0) {
+    detach();  // the writer has shut down, a restarted writer creates a new ring
+  }
+  if (header_ == nullptr && !attach()) {
+    return false;
+  }
+
+  if (readFromRing(buffer)) {
+    return true;
+  }
+
+  // Without a new message, check whether a restarted writer has replaced a ring which was not closed, e.g. after a crash.
+  if (isReplaced()) {
+    detach();
+    return attach() && readFromRing(buffer);
+  }
+  return false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryRingReader::readFromRing(std::vector<uint8_t>& buffer) {
+  // retry only if the slot is overwritten while copying
+  for (size_t attempt = 0; attempt < header_->numSlots; attempt++) {
+    const uint64_t sequence = header_->latestSequence.load(std::memory_order_acquire);
+    if (sequence == lastSequence_) {
+      return false;
+    }
+
+    const auto* slot = getSlot(header_, sequence);
+    if (slot->sequence.load(std::memory_order_acquire) != sequence) {
+      continue;
+    }
+    const size_t size = slot->size;
+    if (size > header_->slotCapacity) {
+      continue;
+    }
+    buffer.resize(size);
+    std::memcpy(buffer.data(), getSlotData(slot), size);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+
+    lastSequence_ = sequence;
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace ocs2
@@ -4,8 +4,10 @@
 #include <ocs2_ros_interfaces/command/TargetTrajectoriesRosPublisher.h>
 
 // common
+#include <ocs2_ros_interfaces/common/PolicySerialization.h>
 #include <ocs2_ros_interfaces/common/RosMsgConversions.h>
 #include <ocs2_ros_interfaces/common/RosMsgHelpers.h>
+#include <ocs2_ros_interfaces/common/SharedMemoryRing.h>
 
 // mpc
 #include <ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h>
@@ -36,9 +36,12 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-MPC_ROS_Interface::MPC_ROS_Interface(MPC_BASE& mpc, std::string topicPrefix)
+MPC_ROS_Interface::MPC_ROS_Interface(MPC_BASE& mpc, std::string topicPrefix, PolicyTransport policyTransport,
+                                     size_t sharedMemoryCapacity)
     : mpc_(mpc),
       topicPrefix_(std::move(topicPrefix)),
+      policyTransport_(policyTransport),
+      sharedMemoryCapacity_(sharedMemoryCapacity),
       bufferPrimalSolutionPtr_(new PrimalSolution()),
       publisherPrimalSolutionPtr_(new PrimalSolution()),
       bufferCommandPtr_(new CommandData()),
@@ -177,6 +180,32 @@ ocs2_msgs::mpc_flattened_controller MPC_ROS_Interface::createMpcPolicyMsg(const
   return mpcPolicyMsg;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::publishPolicy(const PrimalSolution& primalSolution, const CommandData& commandData,
+                                      const PerformanceIndex& performanceIndices) {
+  switch (policyTransport_) {
+    case PolicyTransport::FLATTENED_MSG: {
+      mpcPolicyPublisher_.publish(createMpcPolicyMsg(primalSolution, commandData, performanceIndices));
+      break;
+    }
+    case PolicyTransport::BINARY_MSG: {
+      // the message buffer keeps its capacity between policies
+      policy_serialization::serialize(primalSolution, commandData, performanceIndices, serializedPolicyMsg_.data);
+      mpcPolicyPublisher_.publish(serializedPolicyMsg_);
+      break;
+    }
+    case PolicyTransport::SHARED_MEMORY: {
+      // serialized in place, directly into the shared memory
+      const size_t size = policy_serialization::getSerializedSize(primalSolution, commandData, performanceIndices);
+      sharedMemoryWriterPtr_->write(
+          size, [&](uint8_t* data) { policy_serialization::serialize(primalSolution, commandData, performanceIndices, data, size); });
+      break;
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -197,11 +226,8 @@ void MPC_ROS_Interface::publisherWorker() {
       publisherPerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
     }
 
-    ocs2_msgs::mpc_flattened_controller mpcPolicyMsg =
-        createMpcPolicyMsg(*publisherPrimalSolutionPtr_, *publisherCommandPtr_, *publisherPerformanceIndicesPtr_);
-
-    // publish the message
-    mpcPolicyPublisher_.publish(mpcPolicyMsg);
+    // publish the policy
+    publishPolicy(*publisherPrimalSolutionPtr_, *publisherCommandPtr_, *publisherPerformanceIndicesPtr_);
 
     readyToPublish_ = false;
     lk.unlock();
@@ -283,9 +309,7 @@ void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation:
   msgReady_.notify_one();
 
 #else
-  ocs2_msgs::mpc_flattened_controller mpcPolicyMsg =
-      createMpcPolicyMsg(*bufferPrimalSolutionPtr_, *bufferCommandPtr_, *bufferPerformanceIndicesPtr_);
-  mpcPolicyPublisher_.publish(mpcPolicyMsg);
+  publishPolicy(*bufferPrimalSolutionPtr_, *bufferCommandPtr_, *bufferPerformanceIndicesPtr_);
 #endif
 }
 
@@ -335,7 +359,18 @@ void MPC_ROS_Interface::launchNodes(ros::NodeHandle& nodeHandle) {
                                                    ::ros::TransportHints().tcpNoDelay());
 
   // MPC publisher
-  mpcPolicyPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_flattened_controller>(topicPrefix_ + "_mpc_policy", 1, true);
+  switch (policyTransport_) {
+    case PolicyTransport::FLATTENED_MSG:
+      mpcPolicyPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_flattened_controller>(topicPrefix_ + "_mpc_policy", 1, true);
+      break;
+    case PolicyTransport::BINARY_MSG:
+      mpcPolicyPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_serialized_policy>(topicPrefix_ + "_mpc_serialized_policy", 1, true);
+      break;
+    case PolicyTransport::SHARED_MEMORY:
+      sharedMemoryWriterPtr_.reset(new SharedMemoryRingWriter(getSharedMemoryName(topicPrefix_ + "_mpc_policy"), sharedMemoryCapacity_));
+      ROS_INFO_STREAM("Publishing the MPC policy through shared memory.");
+      break;
+  }
 
   // MPC reset service server
   mpcResetServiceServer_ = nodeHandle.advertiseService(topicPrefix_ + "_mpc_reset", &MPC_ROS_Interface::resetMpcCallback, this);
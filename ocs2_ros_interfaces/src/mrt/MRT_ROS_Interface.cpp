@@ -37,8 +37,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-MRT_ROS_Interface::MRT_ROS_Interface(std::string topicPrefix, ros::TransportHints mrtTransportHints)
-    : topicPrefix_(std::move(topicPrefix)), mrtTransportHints_(mrtTransportHints) {
+MRT_ROS_Interface::MRT_ROS_Interface(std::string topicPrefix, ros::TransportHints mrtTransportHints, PolicyTransport policyTransport)
+    : topicPrefix_(std::move(topicPrefix)), mrtTransportHints_(mrtTransportHints), policyTransport_(policyTransport) {
 // Start thread for publishing
 #ifdef PUBLISH_THREAD
   // Close old thread if it is already running
@@ -189,13 +189,19 @@ void MRT_ROS_Interface::readPolicyMsg(const ocs2_msgs::mpc_flattened_controller&
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::mpcPolicyCallback(const ocs2_msgs::mpc_flattened_controller::ConstPtr& msg) {
-  // read new policy and command from msg
-  auto commandPtr = std::make_unique<CommandData>();
-  auto primalSolutionPtr = std::make_unique<PrimalSolution>();
-  auto performanceIndicesPtr = std::make_unique<PerformanceIndex>();
-  readPolicyMsg(*msg, *commandPtr, *primalSolutionPtr, *performanceIndicesPtr);
+  // read new policy and command from msg directly into the free slot of the policy buffer
+  this->writeToBuffer([&](CommandData& command, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+    readPolicyMsg(*msg, command, primalSolution, performanceIndices);
+  });
+}
 
-  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_ROS_Interface::mpcSerializedPolicyCallback(const ocs2_msgs::mpc_serialized_policy::ConstPtr& msg) {
+  this->writeToBuffer([&](CommandData& command, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+    policy_serialization::deserialize(msg->data.data(), msg->data.size(), command, primalSolution, performanceIndices);
+  });
 }
 
 /******************************************************************************************************/
@@ -237,7 +243,16 @@ void MRT_ROS_Interface::shutdownPublisher() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::spinMRT() {
-  mrtCallbackQueue_.callOne();
+  if (policyTransport_ == PolicyTransport::SHARED_MEMORY) {
+    if (sharedMemoryReaderPtr_ != nullptr && sharedMemoryReaderPtr_->readLatest(sharedMemoryBuffer_)) {
+      this->writeToBuffer([&](CommandData& command, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+        policy_serialization::deserialize(sharedMemoryBuffer_.data(), sharedMemoryBuffer_.size(), command, primalSolution,
+                                          performanceIndices);
+      });
+    }
+  } else {
+    mrtCallbackQueue_.callOne();
+  }
 };
 
 /******************************************************************************************************/
@@ -253,15 +268,38 @@ void MRT_ROS_Interface::launchNodes(ros::NodeHandle& nodeHandle) {
   mpcObservationPublisher_ = nodeHandle.advertise<ocs2_msgs::mpc_observation>(topicPrefix_ + "_mpc_observation", 1);
 
   // policy subscriber
-  auto ops = ros::SubscribeOptions::create<ocs2_msgs::mpc_flattened_controller>(
-      topicPrefix_ + "_mpc_policy",                                                       // topic name
-      1,                                                                                  // queue length
-      boost::bind(&MRT_ROS_Interface::mpcPolicyCallback, this, boost::placeholders::_1),  // callback
-      ros::VoidConstPtr(),                                                                // tracked object
-      &mrtCallbackQueue_                                                                  // pointer to callback queue object
-  );
-  ops.transport_hints = mrtTransportHints_;
-  mpcPolicySubscriber_ = nodeHandle.subscribe(ops);
+  switch (policyTransport_) {
+    case PolicyTransport::FLATTENED_MSG: {
+      auto ops = ros::SubscribeOptions::create<ocs2_msgs::mpc_flattened_controller>(
+          topicPrefix_ + "_mpc_policy",                                                       // topic name
+          1,                                                                                  // queue length
+          boost::bind(&MRT_ROS_Interface::mpcPolicyCallback, this, boost::placeholders::_1),  // callback
+          ros::VoidConstPtr(),                                                                // tracked object
+          &mrtCallbackQueue_                                                                  // pointer to callback queue object
+      );
+      ops.transport_hints = mrtTransportHints_;
+      mpcPolicySubscriber_ = nodeHandle.subscribe(ops);
+      break;
+    }
+    case PolicyTransport::BINARY_MSG: {
+      auto ops = ros::SubscribeOptions::create<ocs2_msgs::mpc_serialized_policy>(
+          topicPrefix_ + "_mpc_serialized_policy",                                                      // topic name
+          1,                                                                                            // queue length
+          boost::bind(&MRT_ROS_Interface::mpcSerializedPolicyCallback, this, boost::placeholders::_1),  // callback
+          ros::VoidConstPtr(),                                                                          // tracked object
+          &mrtCallbackQueue_                                                                            // pointer to callback queue object
+      );
+      ops.transport_hints = mrtTransportHints_;
+      mpcPolicySubscriber_ = nodeHandle.subscribe(ops);
+      break;
+    }
+    case PolicyTransport::SHARED_MEMORY: {
+      // attaches lazily, the MPC node may create the shared memory later
+      sharedMemoryReaderPtr_.reset(new SharedMemoryRingReader(getSharedMemoryName(topicPrefix_ + "_mpc_policy")));
+      ROS_INFO_STREAM("Receiving the MPC policy through shared memory.");
+      break;
+    }
+  }
 
   // MPC reset service client
   mpcResetServiceClient_ = nodeHandle.serviceClient<ocs2_msgs::reset>(topicPrefix_ + "_mpc_reset");
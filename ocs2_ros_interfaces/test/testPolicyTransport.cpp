@@ -0,0 +1,275 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+#include "ocs2_ros_interfaces/common/PolicySerialization.h"
+#include "ocs2_ros_interfaces/common/SharedMemoryRing.h"
+
+using namespace ocs2;
+
+namespace {
+
+constexpr size_t stateDim = 12;
+constexpr size_t inputDim = 6;
+
+std::string getRingName() {
+  return "/ocs2_test_policy_transport_" + std::to_string(getpid());
+}
+
+void getRandomPolicy(size_t N, bool linear, PrimalSolution& primalSolution, CommandData& commandData,
+                     PerformanceIndex& performanceIndices) {
+  performanceIndices.merit = 1.0;
+  performanceIndices.cost = 2.0;
+  performanceIndices.dynamicsViolationSSE = 3.0;
+
+  commandData.mpcInitObservation_.mode = 1;
+  commandData.mpcInitObservation_.time = 0.5;
+  commandData.mpcInitObservation_.state = vector_t::Random(stateDim);
+  commandData.mpcInitObservation_.input = vector_t::Random(inputDim);
+  commandData.mpcTargetTrajectories_ = TargetTrajectories({0.0, 1.0}, {vector_t::Random(stateDim), vector_t::Random(stateDim)},
+                                                          {vector_t::Random(inputDim), vector_t::Random(inputDim)});
+
+  primalSolution.clear();
+  for (size_t k = 0; k < N; k++) {
+    primalSolution.timeTrajectory_.push_back(0.5 + 0.01 * k);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+    primalSolution.inputTrajectory_.push_back(vector_t::Random(inputDim));
+  }
+  primalSolution.postEventIndices_ = {N / 2};
+  primalSolution.modeSchedule_ = ModeSchedule({0.5 + 0.005 * N}, {1, 2});
+
+  if (linear) {
+    matrix_array_t gains(N, matrix_t::Random(inputDim, stateDim));
+    primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_, gains));
+  } else {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+  }
+}
+
+void expectEqual(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+                 const PrimalSolution& otherPrimalSolution, const CommandData& otherCommandData,
+                 const PerformanceIndex& otherPerformanceIndices) {
+  EXPECT_TRUE(performanceIndices.isApprox(otherPerformanceIndices, 0.0));
+
+  EXPECT_EQ(commandData.mpcInitObservation_.mode, otherCommandData.mpcInitObservation_.mode);
+  EXPECT_EQ(commandData.mpcInitObservation_.time, otherCommandData.mpcInitObservation_.time);
+  EXPECT_EQ(commandData.mpcInitObservation_.state, otherCommandData.mpcInitObservation_.state);
+  EXPECT_EQ(commandData.mpcInitObservation_.input, otherCommandData.mpcInitObservation_.input);
+  EXPECT_EQ(commandData.mpcTargetTrajectories_.timeTrajectory, otherCommandData.mpcTargetTrajectories_.timeTrajectory);
+  EXPECT_EQ(commandData.mpcTargetTrajectories_.stateTrajectory, otherCommandData.mpcTargetTrajectories_.stateTrajectory);
+  EXPECT_EQ(commandData.mpcTargetTrajectories_.inputTrajectory, otherCommandData.mpcTargetTrajectories_.inputTrajectory);
+
+  EXPECT_EQ(primalSolution.timeTrajectory_, otherPrimalSolution.timeTrajectory_);
+  EXPECT_EQ(primalSolution.stateTrajectory_, otherPrimalSolution.stateTrajectory_);
+  EXPECT_EQ(primalSolution.inputTrajectory_, otherPrimalSolution.inputTrajectory_);
+  EXPECT_EQ(primalSolution.postEventIndices_, otherPrimalSolution.postEventIndices_);
+  EXPECT_EQ(primalSolution.modeSchedule_.eventTimes, otherPrimalSolution.modeSchedule_.eventTimes);
+  EXPECT_EQ(primalSolution.modeSchedule_.modeSequence, otherPrimalSolution.modeSchedule_.modeSequence);
+
+  ASSERT_EQ(primalSolution.controllerPtr_->getType(), otherPrimalSolution.controllerPtr_->getType());
+  for (const auto t : {0.5, 0.52, 0.555}) {
+    const vector_t x = vector_t::Random(stateDim);
+    EXPECT_EQ(primalSolution.controllerPtr_->computeInput(t, x), otherPrimalSolution.controllerPtr_->computeInput(t, x));
+  }
+}
+
+}  // unnamed namespace
+
+class PolicyTransportTest : public testing::TestWithParam<bool> {};
+
+TEST_P(PolicyTransportTest, serializationRoundTrip) {
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndices;
+  getRandomPolicy(50, GetParam(), primalSolution, commandData, performanceIndices);
+
+  std::vector<uint8_t> buffer;
+  policy_serialization::serialize(primalSolution, commandData, performanceIndices, buffer);
+  EXPECT_EQ(buffer.size(), policy_serialization::getSerializedSize(primalSolution, commandData, performanceIndices));
+
+  PrimalSolution receivedPrimalSolution;
+  CommandData receivedCommandData;
+  PerformanceIndex receivedPerformanceIndices;
+  policy_serialization::deserialize(buffer.data(), buffer.size(), receivedCommandData, receivedPrimalSolution, receivedPerformanceIndices);
+  expectEqual(primalSolution, commandData, performanceIndices, receivedPrimalSolution, receivedCommandData, receivedPerformanceIndices);
+
+  // reading a policy of the same size reuses the memory of the previous one
+  const auto* controllerPtr = receivedPrimalSolution.controllerPtr_.get();
+  const auto* stateDataPtr = receivedPrimalSolution.stateTrajectory_.front().data();
+  getRandomPolicy(50, GetParam(), primalSolution, commandData, performanceIndices);
+  policy_serialization::serialize(primalSolution, commandData, performanceIndices, buffer);
+  policy_serialization::deserialize(buffer.data(), buffer.size(), receivedCommandData, receivedPrimalSolution, receivedPerformanceIndices);
+  expectEqual(primalSolution, commandData, performanceIndices, receivedPrimalSolution, receivedCommandData, receivedPerformanceIndices);
+  EXPECT_EQ(controllerPtr, receivedPrimalSolution.controllerPtr_.get());
+  EXPECT_EQ(stateDataPtr, receivedPrimalSolution.stateTrajectory_.front().data());
+}
+
+TEST_P(PolicyTransportTest, malformedBuffer) {
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndices;
+  getRandomPolicy(10, GetParam(), primalSolution, commandData, performanceIndices);
+
+  std::vector<uint8_t> buffer;
+  policy_serialization::serialize(primalSolution, commandData, performanceIndices, buffer);
+  EXPECT_THROW(policy_serialization::deserialize(buffer.data(), buffer.size() - 1, commandData, primalSolution, performanceIndices),
+               std::runtime_error);
+  buffer.front() = 0;
+  EXPECT_THROW(policy_serialization::deserialize(buffer.data(), buffer.size(), commandData, primalSolution, performanceIndices),
+               std::runtime_error);
+  EXPECT_THROW(policy_serialization::serialize(primalSolution, commandData, performanceIndices, buffer.data(), buffer.size() - 1),
+               std::runtime_error);
+}
+
+TEST_P(PolicyTransportTest, sharedMemoryLoopback) {
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndices;
+  PrimalSolution receivedPrimalSolution;
+  CommandData receivedCommandData;
+  PerformanceIndex receivedPerformanceIndices;
+  std::vector<uint8_t> buffer;
+
+  // the reader may be created before the writer
+  SharedMemoryRingReader reader(getRingName());
+  EXPECT_FALSE(reader.readLatest(buffer));
+
+  SharedMemoryRingWriter writer(getRingName(), 1 << 20);
+  EXPECT_FALSE(reader.readLatest(buffer));
+  EXPECT_TRUE(reader.isAttached());
+
+  for (size_t N : {20, 100, 60}) {
+    getRandomPolicy(N, GetParam(), primalSolution, commandData, performanceIndices);
+    const auto size = policy_serialization::getSerializedSize(primalSolution, commandData, performanceIndices);
+    writer.write(size,
+                 [&](uint8_t* data) { policy_serialization::serialize(primalSolution, commandData, performanceIndices, data, size); });
+
+    ASSERT_TRUE(reader.readLatest(buffer));
+    EXPECT_FALSE(reader.readLatest(buffer));
+    policy_serialization::deserialize(buffer.data(), buffer.size(), receivedCommandData, receivedPrimalSolution,
+                                      receivedPerformanceIndices);
+    expectEqual(primalSolution, commandData, performanceIndices, receivedPrimalSolution, receivedCommandData,
+                receivedPerformanceIndices);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(PolicyTransportTestCase, PolicyTransportTest, testing::Values(false, true),
+                        [](const testing::TestParamInfo<bool>& info) { return info.param ? "LINEAR" : "FEEDFORWARD"; });
+
+TEST(SharedMemoryRingTest, concurrentReadWrite) {
+  constexpr size_t numMessages = 20000;
+  constexpr size_t slotCapacity = 4096;
+  SharedMemoryRingWriter writer(getRingName(), slotCapacity, 3);
+  SharedMemoryRingReader reader(getRingName());
+
+  std::atomic_bool done{false};
+  std::thread writerThread([&]() {
+    for (size_t i = 1; i <= numMessages; i++) {
+      // each message is filled with its own index and has an index dependent size
+      const size_t size = sizeof(uint64_t) * (1 + i % (slotCapacity / sizeof(uint64_t)));
+      writer.write(size, [&](uint8_t* data) {
+        for (size_t j = 0; j < size; j += sizeof(uint64_t)) {
+          std::memcpy(data + j, &i, sizeof(uint64_t));
+        }
+      });
+    }
+    done = true;
+  });
+
+  std::vector<uint8_t> buffer;
+  uint64_t lastIndex = 0;
+  size_t numReceived = 0;
+  bool isConsistent = true;
+  auto checkMessage = [&]() {
+    uint64_t index;
+    std::memcpy(&index, buffer.data(), sizeof(uint64_t));
+    isConsistent &= index > lastIndex;
+    isConsistent &= buffer.size() == sizeof(uint64_t) * (1 + index % (slotCapacity / sizeof(uint64_t)));
+    for (size_t j = 0; j < buffer.size(); j += sizeof(uint64_t)) {
+      uint64_t value;
+      std::memcpy(&value, buffer.data() + j, sizeof(uint64_t));
+      isConsistent &= value == index;
+    }
+    lastIndex = index;
+    numReceived++;
+  };
+
+  while (!done) {
+    if (reader.readLatest(buffer)) {
+      checkMessage();
+    }
+  }
+  if (reader.readLatest(buffer)) {
+    checkMessage();
+  }
+  writerThread.join();
+
+  EXPECT_TRUE(isConsistent);
+  EXPECT_EQ(lastIndex, numMessages);
+  EXPECT_GT(numReceived, 0);
+}
+
+TEST(SharedMemoryRingTest, restartedWriter) {
+  const auto writeIndex = [](SharedMemoryRingWriter& writer, uint64_t index) {
+    writer.write(sizeof(uint64_t), [&](uint8_t* data) { std::memcpy(data, &index, sizeof(uint64_t)); });
+  };
+  const auto readIndex = [](const std::vector<uint8_t>& buffer) {
+    uint64_t index;
+    std::memcpy(&index, buffer.data(), sizeof(uint64_t));
+    return index;
+  };
+
+  std::vector<uint8_t> buffer;
+  SharedMemoryRingWriter writer(getRingName(), 64);
+  SharedMemoryRingReader reader(getRingName());
+  writeIndex(writer, 1);
+  ASSERT_TRUE(reader.readLatest(buffer));
+  EXPECT_EQ(readIndex(buffer), 1);
+
+  // a new writer replaces the ring while the previous one did not close it, as after a crash. Its first message has the same
+  // sequence number as the last message of the previous ring.
+  SharedMemoryRingWriter restartedWriter(getRingName(), 64);
+  writeIndex(restartedWriter, 2);
+  ASSERT_TRUE(reader.readLatest(buffer));
+  EXPECT_EQ(readIndex(buffer), 2);
+  EXPECT_FALSE(reader.readLatest(buffer));
+
+  writeIndex(restartedWriter, 3);
+  ASSERT_TRUE(reader.readLatest(buffer));
+  EXPECT_EQ(readIndex(buffer), 3);
+}
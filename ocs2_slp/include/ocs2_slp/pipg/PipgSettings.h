@@ -40,7 +40,8 @@ struct Settings {
   /** Termination criteria. **/
   scalar_t absoluteTolerance = 1e-3;
   scalar_t relativeTolerance = 1e-2;
-  /** Number of iterations between consecutive calculation of termination conditions. **/
+  /** Number of iterations between consecutive calculation of termination conditions. The residuals and solution norms are
+   * only computed on these iterations. **/
   size_t checkTerminationInterval = 1;
   /** The static lower bound of the cost hessian H. **/
   scalar_t lowerBoundH = 5e-6;
@@ -102,9 +102,37 @@ class PipgSolver {
   int numDecisionVariables_;
   int numDynamicsConstraints_;
 
-  // Data buffer for parallelized PIPG
-  vector_array_t X_, W_, V_, U_;
-  vector_array_t XNew_, UNew_, WNew_;
+  /**
+   * Offsets of a node inside the packed buffers. Node t owns the decision variable z_t = [x_t; u_t], the stage cost hessian
+   * H_t = [Q_t, P_t'; P_t, R_t] and gradient h_t = [q_t; r_t], and (for t < N) the dynamics constraint
+   * C_t * x_{t+1} = G_t * z_t + b_t with G_t = [A_t, B_t].
+   */
+  struct NodeLayout {
+    int nx = 0;      // state dimension of node t
+    int nu = 0;      // input dimension of node t
+    int nxNext = 0;  // state dimension of node t + 1 (zero for the final node)
+    size_t z = 0;    // offset of z_t in Z_
+    size_t w = 0;    // offset of the dual variable of constraint t in W_
+    size_t H = 0;    // offsets of H_t, h_t, G_t, b_t, and C_t in stageData_
+    size_t h = 0;
+    size_t G = 0;
+    size_t b = 0;
+    size_t C = 0;
+  };
+
+  /** Copies the per-stage OCP data into the packed, stage-contiguous buffer stageData_. */
+  void packStageData(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     const std::vector<ScalarFunctionQuadraticApproximation>& cost, const vector_array_t& scalingVectors);
+
+  // Packed problem data and its layout
+  std::vector<NodeLayout> layout_;
+  vector_t stageData_;
+
+  // Data buffer for parallelized PIPG. The primal (Z) and dual (W, V) variables of all nodes are stored contiguously.
+  vector_t Z_, ZNew_;
+  vector_t W_, WNew_, V_;
+  // Per-worker scratch for the dual variable of the succeeding node
+  vector_array_t VNextWorkspace_;
 };
 
 }  // namespace ocs2
@@ -63,42 +63,42 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
   // Disable Eigen's internal multithreading
   Eigen::setNbThreads(1);
 
-  vector_array_t primalResidualArray(N);
+  packStageData(dynamics, cost, scalingVectors);
+  const size_t numWorkers = threadPool.numThreads() + 1U;
+  VNextWorkspace_.resize(numWorkers);
+
   scalar_array_t constraintsViolationInfNormArray(N);
-  scalar_t constraintsViolationInfNorm;
-
-  scalar_t solutionSSE, solutionSquaredNorm;
-  scalar_array_t solutionSEArray(N);
-  scalar_array_t solutionSquaredNormArray(N);
-
-  // initial state
-  X_[0] = x0;
-  XNew_[0] = x0;
-  // cold start
-  for (int t = 0; t < N; t++) {
-    X_[t + 1].setZero(dynamics[t].dfdx.rows());
-    U_[t].setZero(dynamics[t].dfdu.cols());
-    W_[t].setZero(dynamics[t].dfdx.rows());
-    // WNew_ will NOT be filled, but will be swapped to W_ in iteration 0. Thus, initialize WNew_ here.
-    WNew_[t].setZero(dynamics[t].dfdx.rows());
-  }
+  scalar_t constraintsViolationInfNorm = 0.0;
+
+  scalar_t solutionSSE = 0.0, solutionSquaredNorm = 0.0;
+  scalar_array_t solutionSEArray(N + 1, 0.0);
+  scalar_array_t solutionSquaredNormArray(N + 1, 0.0);
+
+  // cold start with the initial state fixed in both primal buffers
+  Z_.setZero();
+  W_.setZero();
+  // WNew_ will NOT be filled, but will be swapped to W_ in iteration 0. Thus, initialize WNew_ here.
+  WNew_.setZero();
+  Z_.head(x0.size()) = x0;
+  ZNew_.head(x0.size()) = x0;
 
   scalar_t alpha = pipgBounds.primalStepSize(0);
   scalar_t beta = pipgBounds.primalStepSize(0);
   scalar_t betaLast = 0;
 
   size_t k = 0;
-  std::atomic_int timeIndex{1}, finishedTaskCounter{0};
+  std::atomic_int timeIndex{0}, finishedTaskCounter{0};
   std::atomic_bool keepRunning{true}, shouldWait{true};
   bool isConverged = false;
 
   std::mutex mux;
   std::condition_variable iterationFinished;
-  std::vector<int> threadsWorkloadCounter(threadPool.numThreads() + 1U, 0);
+  std::vector<int> threadsWorkloadCounter(numWorkers, 0);
 
   auto updateVariablesTask = [&](int workerId) {
     int t;
     int workerOrder;
+    vector_t& VNext = VNextWorkspace_[workerId];
 
     while (keepRunning) {
       // Reset workerOrder in case all tasks have been assigned and some workers cannot enter the following while loop, keeping the
@@ -112,84 +112,85 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
         // Multi-thread performance analysis
         ++threadsWorkloadCounter[workerId];
 
-        // PIPG algorithm
-        const auto& A = dynamics[t - 1].dfdx;
-        const auto& B = dynamics[t - 1].dfdu;
-        const auto& C = scalingVectors[t - 1];
-        const auto& b = dynamics[t - 1].f;
-
-        const auto& R = cost[t - 1].dfduu;
-        const auto& Q = cost[t].dfdxx;
-        const auto& P = cost[t - 1].dfdux;
-        const auto& q = cost[t].dfdx;
-        const auto& r = cost[t - 1].dfdu;
-
-        if (k != 0) {
-          // Update W of the iteration k - 1. Move the update of W to the front of the calculation of V to prevent data race.
-          // vector_t primalResidual = C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b;
-          primalResidualArray[t - 1] = -b;
-          primalResidualArray[t - 1].array() += C.array() * X_[t].array();
-          primalResidualArray[t - 1].noalias() -= A * X_[t - 1];
-          primalResidualArray[t - 1].noalias() -= B * U_[t - 1];
-          if (EInv != nullptr) {
-            constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(primalResidualArray[t - 1]).lpNorm<Eigen::Infinity>();
-          } else {
-            constraintsViolationInfNormArray[t - 1] = primalResidualArray[t - 1].lpNorm<Eigen::Infinity>();
+        // The termination quantities are only needed on the iterations in which the termination criteria are checked.
+        const bool computeTerminationData = k != 0 && k % settings().checkTerminationInterval == 0;
+        const scalar_t dualStep = beta + betaLast;
+
+        // PIPG algorithm on node t: z_t = [x_t; u_t]
+        const auto& node = layout_[t];
+        const int nz = node.nx + node.nu;
+        const scalar_t* data = stageData_.data();
+        const Eigen::Map<const matrix_t> H(data + node.H, nz, nz);
+        const Eigen::Map<const vector_t> h(data + node.h, nz);
+        const auto z = Z_.segment(node.z, nz);
+        auto zNew = ZNew_.segment(node.z, nz);
+
+        if (t != 0) {
+          // The constraint of the preceding node connects z_{t-1} and x_t. Node t owns its residual, dual update and V.
+          const auto& prev = layout_[t - 1];
+          const Eigen::Map<const matrix_t> G(data + prev.G, node.nx, prev.nx + prev.nu);
+          const Eigen::Map<const vector_t> b(data + prev.b, node.nx);
+          const Eigen::Map<const vector_t> C(data + prev.C, node.nx);
+          const auto W = W_.segment(prev.w, node.nx);
+          auto V = V_.segment(prev.w, node.nx);
+          auto WNew = WNew_.segment(prev.w, node.nx);
+
+          // Reuse WNew as the storage of the primal residual: C * x_t - G * z_{t-1} - b
+          WNew = C.cwiseProduct(z.head(node.nx)) - b;
+          WNew.noalias() -= G * Z_.segment(prev.z, prev.nx + prev.nu);
+
+          if (computeTerminationData) {
+            if (EInv != nullptr) {
+              constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(WNew).lpNorm<Eigen::Infinity>();
+            } else {
+              constraintsViolationInfNormArray[t - 1] = WNew.lpNorm<Eigen::Infinity>();
+            }
           }
 
-          WNew_[t - 1] = W_[t - 1] + betaLast * primalResidualArray[t - 1];
-
-          // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration k
-          // - 1. By convention, iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse UNew and XNew
-          // memory to store the difference between the last solution and the one before last solution.
-          UNew_[t - 1] -= U_[t - 1];
-          XNew_[t] -= X_[t];
-
-          solutionSEArray[t - 1] = UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
-          solutionSquaredNormArray[t - 1] = U_[t - 1].squaredNorm() + X_[t].squaredNorm();
+          // V = W + (beta + betaLast) * residual. Update W of the iteration k - 1: WNew = W + betaLast * residual. In iteration 0,
+          // betaLast is zero and W keeps its cold start value.
+          V = W + dualStep * WNew;
+          WNew = W + betaLast * WNew;
         }
 
-        // V_[t - 1] = W_[t - 1] + (beta + betaLast) * (C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b);
-        V_[t - 1] = W_[t - 1] - (beta + betaLast) * b;
-        V_[t - 1].array() += (beta + betaLast) * C.array() * X_[t].array();
-        V_[t - 1].noalias() -= (beta + betaLast) * (A * X_[t - 1]);
-        V_[t - 1].noalias() -= (beta + betaLast) * (B * U_[t - 1]);
+        if (t != N) {
+          // V_t is owned by node t + 1, recompute it here to avoid an additional synchronization.
+          const Eigen::Map<const matrix_t> G(data + node.G, node.nxNext, nz);
+          const Eigen::Map<const vector_t> b(data + node.b, node.nxNext);
+          const Eigen::Map<const vector_t> C(data + node.C, node.nxNext);
+          const auto& next = layout_[t + 1];
+          VNext = C.cwiseProduct(Z_.segment(next.z, node.nxNext)) - b;
+          VNext.noalias() -= G * z;
+          VNext = W_.segment(node.w, node.nxNext) + dualStep * VNext;
+        }
 
-        // UNew_[t - 1] = U_[t - 1] - alpha * (R * U_[t - 1] + P * X_[t - 1] + r - B.transpose() * V_[t - 1]);
-        UNew_[t - 1] = U_[t - 1] - alpha * r;
-        UNew_[t - 1].noalias() -= alpha * (R * U_[t - 1]);
-        UNew_[t - 1].noalias() -= alpha * (P * X_[t - 1]);
-        UNew_[t - 1].noalias() += alpha * (B.transpose() * V_[t - 1]);
+        // The node 0 state is fixed to x0. Only the input is updated.
+        const int offset = (t == 0) ? node.nx : 0;
+        const int numUpdated = nz - offset;
 
-        // XNew_[t] = X_[t] - alpha * (Q * X_[t] + q + C * V_[t - 1]);
-        XNew_[t] = X_[t] - alpha * q;
-        XNew_[t].array() -= alpha * C.array() * V_[t - 1].array();
-        XNew_[t].noalias() -= alpha * (Q * X_[t]);
+        if (computeTerminationData) {
+          // What stored in ZNew is the solution of iteration k - 2 and what stored in Z is the solution of iteration k - 1.
+          solutionSEArray[t] = (ZNew_.segment(node.z + offset, numUpdated) - z.tail(numUpdated)).squaredNorm();
+          solutionSquaredNormArray[t] = z.tail(numUpdated).squaredNorm();
+        }
 
+        // zNew = z - alpha * (H * z + h + [C_{t-1} * V_{t-1}; 0] - G_t' * V_t)
+        auto zNewUpdated = zNew.tail(numUpdated);
+        zNewUpdated = z.tail(numUpdated) - alpha * h.tail(numUpdated);
+        zNewUpdated.noalias() -= alpha * (H.bottomRows(numUpdated) * z);
+        if (t != 0) {
+          const Eigen::Map<const vector_t> C(data + layout_[t - 1].C, node.nx);
+          zNew.head(node.nx) -= alpha * C.cwiseProduct(V_.segment(layout_[t - 1].w, node.nx));
+        }
         if (t != N) {
-          const auto& ANext = dynamics[t].dfdx;
-          const auto& BNext = dynamics[t].dfdu;
-          const auto& CNext = scalingVectors[t];
-          const auto& bNext = dynamics[t].f;
-
-          // dfdux
-          const auto& PNext = cost[t].dfdux;
-
-          // vector_t VNext = W_[t] + (beta + betaLast) * (CNext * X_[t + 1] - ANext * X_[t] - BNext * U_[t] - bNext);
-          vector_t VNext = W_[t] - (beta + betaLast) * bNext;
-          VNext.array() += (beta + betaLast) * CNext.array() * X_[t + 1].array();
-          VNext.noalias() -= (beta + betaLast) * (ANext * X_[t]);
-          VNext.noalias() -= (beta + betaLast) * (BNext * U_[t]);
-
-          XNew_[t].noalias() += alpha * (ANext.transpose() * VNext);
-          // Add dfdxu * du if it is not the final state.
-          XNew_[t].noalias() -= alpha * (PNext.transpose() * U_[t]);
+          const Eigen::Map<const matrix_t> G(data + node.G, node.nxNext, nz);
+          zNewUpdated.noalias() += alpha * (G.rightCols(numUpdated).transpose() * VNext);
         }
 
         workerOrder = ++finishedTaskCounter;
       }
 
-      if (workerOrder != N) {
+      if (workerOrder != N + 1) {
         std::unique_lock<std::mutex> lk(mux);
         iterationFinished.wait(lk, [&shouldWait] { return !shouldWait; });
         lk.unlock();
@@ -213,13 +214,12 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
           keepRunning = k < settings().maxNumIterations && !isConverged;
         }
 
-        XNew_.swap(X_);
-        UNew_.swap(U_);
+        ZNew_.swap(Z_);
         WNew_.swap(W_);
 
         ++k;
         finishedTaskCounter = 0;
-        timeIndex = 1;
+        timeIndex = 0;
         {
           std::lock_guard<std::mutex> lk(mux);
           shouldWait = false;
@@ -228,10 +228,17 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
       }
     }
   };
-  threadPool.runParallel(std::move(updateVariablesTask), threadPool.numThreads() + 1U);
-
-  xTrajectory = X_;
-  uTrajectory = U_;
+  threadPool.runParallel(std::move(updateVariablesTask), numWorkers);
+
+  // unpack the solution
+  xTrajectory.resize(N + 1);
+  uTrajectory.resize(N);
+  for (int t = 0; t <= N; t++) {
+    xTrajectory[t] = Z_.segment(layout_[t].z, layout_[t].nx);
+    if (t < N) {
+      uTrajectory[t] = Z_.segment(layout_[t].z + layout_[t].nx, layout_[t].nu);
+    }
+  }
   const auto status = isConverged ? pipg::SolverStatus::SUCCESS : pipg::SolverStatus::MAX_ITER;
 
   if (settings().displayShortSummary) {
@@ -271,13 +278,71 @@ void PipgSolver::resize(const OcpSize& ocpSize) {
   numDecisionVariables_ += std::accumulate(ocpSize_.numInputs.begin(), ocpSize_.numInputs.end(), 0);
   numDynamicsConstraints_ = std::accumulate(std::next(ocpSize_.numStates.begin()), ocpSize_.numStates.end(), 0);
 
-  X_.resize(N + 1);
-  W_.resize(N);
-  V_.resize(N);
-  U_.resize(N);
-  XNew_.resize(N + 1);
-  UNew_.resize(N);
-  WNew_.resize(N);
+  // Layout of the packed buffers
+  layout_.resize(N + 1);
+  size_t dataSize = 0, primalSize = 0, dualSize = 0;
+  for (int t = 0; t <= N; t++) {
+    auto& node = layout_[t];
+    node.nx = ocpSize_.numStates[t];
+    node.nu = (t < N) ? ocpSize_.numInputs[t] : 0;
+    node.nxNext = (t < N) ? ocpSize_.numStates[t + 1] : 0;
+    const int nz = node.nx + node.nu;
+
+    node.z = primalSize;
+    primalSize += nz;
+    node.w = dualSize;
+    dualSize += node.nxNext;
+
+    node.H = dataSize;
+    dataSize += nz * nz;
+    node.h = dataSize;
+    dataSize += nz;
+    node.G = dataSize;
+    dataSize += node.nxNext * nz;
+    node.b = dataSize;
+    dataSize += node.nxNext;
+    node.C = dataSize;
+    dataSize += node.nxNext;
+  }
+
+  stageData_.resize(dataSize);
+  Z_.resize(primalSize);
+  ZNew_.resize(primalSize);
+  W_.resize(dualSize);
+  WNew_.resize(dualSize);
+  V_.resize(dualSize);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PipgSolver::packStageData(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                               const std::vector<ScalarFunctionQuadraticApproximation>& cost, const vector_array_t& scalingVectors) {
+  const int N = ocpSize_.numStages;
+  scalar_t* data = stageData_.data();
+  for (int t = 0; t <= N; t++) {
+    const auto& node = layout_[t];
+    const int nz = node.nx + node.nu;
+
+    Eigen::Map<matrix_t> H(data + node.H, nz, nz);
+    Eigen::Map<vector_t> h(data + node.h, nz);
+    H.topLeftCorner(node.nx, node.nx) = cost[t].dfdxx;
+    h.head(node.nx) = cost[t].dfdx;
+    if (node.nu > 0) {
+      H.bottomLeftCorner(node.nu, node.nx) = cost[t].dfdux;
+      H.topRightCorner(node.nx, node.nu) = cost[t].dfdux.transpose();
+      H.bottomRightCorner(node.nu, node.nu) = cost[t].dfduu;
+      h.tail(node.nu) = cost[t].dfdu;
+    }
+
+    if (t < N) {
+      Eigen::Map<matrix_t> G(data + node.G, node.nxNext, nz);
+      G.leftCols(node.nx) = dynamics[t].dfdx;
+      G.rightCols(node.nu) = dynamics[t].dfdu;
+      Eigen::Map<vector_t>(data + node.b, node.nxNext) = dynamics[t].f;
+      Eigen::Map<vector_t>(data + node.C, node.nxNext) = scalingVectors[t];
+    }
+  }
 }
 
 /******************************************************************************************************/
@@ -183,4 +183,33 @@ TEST_F(PIPGSolverTest, correctness) {
   ASSERT_TRUE(std::abs(PIPGConstraintViolation) < solver.settings().absoluteTolerance);
   EXPECT_TRUE(std::abs(QPConstraintViolation - PIPGConstraintViolation) < solver.settings().absoluteTolerance * 10.0);
   EXPECT_TRUE(std::abs(PIPGParallelCConstraintViolation - PIPGConstraintViolation) < solver.settings().absoluteTolerance * 10.0);
-}
\ No newline at end of file
+}
+
+TEST_F(PIPGSolverTest, checkTerminationInterval) {
+  Eigen::JacobiSVD<ocs2::matrix_t> svd(costApproximation.dfdxx);
+  ocs2::vector_t s = svd.singularValues();
+  const ocs2::scalar_t lambda = s(0);
+  const ocs2::scalar_t mu = s(svd.rank() - 1);
+  Eigen::JacobiSVD<ocs2::matrix_t> svdGTG(constraintsApproximation.dfdx.transpose() * constraintsApproximation.dfdx);
+  const ocs2::scalar_t sigma = svdGTG.singularValues()(0);
+  const ocs2::pipg::PipgBounds pipgBounds{mu, lambda, sigma};
+
+  ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+  ocs2::vector_array_t X, U;
+  std::ignore = solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+  ocs2::vector_t primalSolution;
+  ocs2::toKktSolution(X, U, primalSolution);
+
+  // Checking the termination criteria every few iterations only delays the exit by at most the interval length.
+  auto settings = solver.settings();
+  settings.checkTerminationInterval = 10;
+  ocs2::PipgSolver intervalSolver(settings);
+  intervalSolver.resize(solver.size());
+  const auto status = intervalSolver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+  ocs2::vector_t primalSolutionInterval;
+  ocs2::toKktSolution(X, U, primalSolutionInterval);
+
+  EXPECT_EQ(status, ocs2::pipg::SolverStatus::SUCCESS);
+  EXPECT_TRUE(primalSolutionInterval.isApprox(primalSolution, settings.absoluteTolerance * 10.0))
+      << "Inf-norm of (PIPG - PIPGInterval): " << (primalSolutionInterval - primalSolution).cwiseAbs().maxCoeff();
+}
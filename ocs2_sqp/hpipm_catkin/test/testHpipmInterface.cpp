@@ -338,3 +338,42 @@ TEST(test_hpiphm_interface, retrieveRiccati) {
     ASSERT_TRUE(uSol[k].isApprox(KSol[k] * xSol[k] + kSol[k]));
   }
 }
+
+TEST(test_hpiphm_interface, solve_repeated) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+  ocs2::OcpSize ocpSize(N, nx, nu);
+
+  auto getRandomProblem = [&](std::vector<ocs2::VectorFunctionLinearApproximation>& system,
+                              std::vector<ocs2::ScalarFunctionQuadraticApproximation>& cost) {
+    system.clear();
+    cost.clear();
+    for (int k = 0; k < N; k++) {
+      system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+      cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    }
+    cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  };
+
+  // The interface keeps the data passed to HPIPM between solves, a second problem must not see any of the first.
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  getRandomProblem(system, cost);
+  ASSERT_EQ(hpipmInterface.solve(ocs2::vector_t::Random(nx), system, cost, nullptr, xSol, uSol), hpipm_status::SUCCESS);
+
+  getRandomProblem(system, cost);
+  const ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol), hpipm_status::SUCCESS);
+
+  // Compare with a fresh interface
+  ocs2::HpipmInterface freshInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSolFresh;
+  std::vector<ocs2::vector_t> uSolFresh;
+  ASSERT_EQ(freshInterface.solve(x0, system, cost, nullptr, xSolFresh, uSolFresh), hpipm_status::SUCCESS);
+  ASSERT_TRUE(ocs2::isEqual(xSol, xSolFresh, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(uSol, uSolFresh, 1e-9));
+}
@@ -37,6 +37,28 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace sqp {
 
+/**
+ * Solver for the QP subproblem.
+ * HPIPM: Sequential Riccati recursion in HPIPM, handles all constraints.
+ * PARALLEL_RICCATI: Riccati recursion that is parallel in time over the thread pool of the solver. Needs positive definite input
+ *                   Hessians R_k. Iterations in which the factorization fails are solved with HPIPM.
+ * CONDENSED: Condenses blocks of condensingBlockSize stages and solves the condensed QP. Does not provide the Riccati feedback, hence
+ *            requires useFeedbackPolicy and createValueFunction to be false.
+ * AUTO: CONDENSED if the problem sizes favor condensing and no Riccati feedback is needed, HPIPM otherwise.
+ *
+ * All but HPIPM only solve unconstrained QPs, i.e. without state-input equality constraints or with
+ * projectStateInputEqualityConstraints. Other QPs go to HPIPM.
+ */
+enum class QpSolverType { HPIPM, PARALLEL_RICCATI, CONDENSED, AUTO };
+
+namespace qp_solver {
+/** Get string name of the QP solver type */
+std::string toString(QpSolverType qpSolverType);
+
+/** Get QP solver type from string name, useful for reading config file */
+QpSolverType fromString(const std::string& name);
+}  // namespace qp_solver
+
 struct Settings {
   // Sqp settings
   size_t sqpIteration = 10;  // Maximum number of SQP iterations
@@ -44,8 +66,9 @@ struct Settings {
   scalar_t costTol = 1e-4;   // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
   // Linesearch - step size rules
-  scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
-  scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  scalar_t alpha_decay = 0.5;               // multiply the step size by this factor every time a linesearch step is rejected.
+  scalar_t alpha_min = 1e-4;                // terminate linesearch if the attempted step size is below this threshold
+  size_t linesearchCandidatesPerSweep = 1;  // number of step sizes evaluated speculatively in one parallel sweep, 1 for one at a time
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -58,6 +81,8 @@ struct Settings {
   bool createValueFunction = false;  // true to store the value function, false to ignore it
 
   // QP subproblem solver settings
+  QpSolverType qpSolverType = QpSolverType::HPIPM;
+  int condensingBlockSize = 0;  // Number of stages condensed into one by the CONDENSED solver, 0 to select it from the problem sizes
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
 
   // Discretization method
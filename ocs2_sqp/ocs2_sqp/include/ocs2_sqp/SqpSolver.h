@@ -35,9 +35,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
+#include <ocs2_oc/qp_solver/CondensedQpSolver.h>
+#include <ocs2_oc/qp_solver/ParallelRiccatiSolver.h>
 #include <ocs2_oc/search_strategy/FilterLinesearch.h>
 
 #include <hpipm_catkin/HpipmInterface.h>
@@ -122,9 +125,13 @@ class SqpSolver : public SolverBase {
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                             const vector_array_t& u, std::vector<Metrics>& metrics);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, std::vector<Metrics>& metrics);
+  /**
+   * Computes only the performance metrics of a batch of candidate trajectories {t, x_c(t), u_c(t)}. The nodes of all candidates are
+   * evaluated in a single parallel sweep.
+   */
+  std::vector<PerformanceIndex> computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                                   const std::vector<vector_array_t>& x, const std::vector<vector_array_t>& u,
+                                                   std::vector<std::vector<Metrics>>& metrics);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -134,6 +141,9 @@ class SqpSolver : public SolverBase {
   };
   OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
 
+  /** Block size for the condensed solver of an unconstrained QP of the given size, 0 if the QP goes to HPIPM. */
+  int getCondensingBlockSize(const OcpSize& ocpSize) const;
+
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
 
@@ -158,6 +168,9 @@ class SqpSolver : public SolverBase {
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  ParallelRiccatiSolver parallelRiccatiSolver_;
+  CondensedQpSolver condensedQpSolver_;
+  bool qpSolvedWithParallelRiccati_ = false;  // Selects the backend that provides the Riccati feedback and cost-to-go
 
   // Threading
   ThreadPool threadPool_;
@@ -179,6 +192,12 @@ class SqpSolver : public SolverBase {
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
+  // Per-node transcription workspace. It is filled in place and swapped with the LQ approximation above, such that the memory of both
+  // is reused between iterations.
+  std::vector<multiple_shooting::Transcription> transcriptions_;
+  std::vector<multiple_shooting::EventTranscription> eventTranscriptions_;
+  multiple_shooting::TerminalTranscription terminalTranscription_;
+
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
@@ -188,6 +207,8 @@ class SqpSolver : public SolverBase {
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
+  size_t numLinesearchSweeps_{0};
+  size_t numLinesearchCandidates_{0};
   sqp::Logger<sqp::LogEntry> logger_;
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/SqpSettings.h"
 
+#include <unordered_map>
+
 #include <boost/property_tree/info_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
 
@@ -37,6 +39,26 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace sqp {
 
+namespace qp_solver {
+
+std::string toString(QpSolverType qpSolverType) {
+  static const std::unordered_map<QpSolverType, std::string> qpSolverMap = {{QpSolverType::HPIPM, "HPIPM"},
+                                                                            {QpSolverType::PARALLEL_RICCATI, "PARALLEL_RICCATI"},
+                                                                            {QpSolverType::CONDENSED, "CONDENSED"},
+                                                                            {QpSolverType::AUTO, "AUTO"}};
+  return qpSolverMap.at(qpSolverType);
+}
+
+QpSolverType fromString(const std::string& name) {
+  static const std::unordered_map<std::string, QpSolverType> qpSolverMap = {{"HPIPM", QpSolverType::HPIPM},
+                                                                            {"PARALLEL_RICCATI", QpSolverType::PARALLEL_RICCATI},
+                                                                            {"CONDENSED", QpSolverType::CONDENSED},
+                                                                            {"AUTO", QpSolverType::AUTO}};
+  return qpSolverMap.at(name);
+}
+
+}  // namespace qp_solver
+
 Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
   boost::property_tree::ptree pt;
   boost::property_tree::read_info(filename, pt);
@@ -52,6 +74,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.linesearchCandidatesPerSweep, fieldName + ".linesearchCandidatesPerSweep", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
@@ -63,6 +86,10 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
+  auto qpSolverName = qp_solver::toString(settings.qpSolverType);
+  loadData::loadPtreeValue(pt, qpSolverName, fieldName + ".qpSolverType", verbose);
+  settings.qpSolverType = qp_solver::fromString(qpSolverName);
+  loadData::loadPtreeValue(pt, settings.condensingBlockSize, fieldName + ".condensingBlockSize", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintMu, fieldName + ".inequalityConstraintMu", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
   loadData::loadPtreeValue(pt, settings.projectStateInputEqualityConstraints, fieldName + ".projectStateInputEqualityConstraints", verbose);
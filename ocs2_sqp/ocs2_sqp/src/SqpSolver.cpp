@@ -51,6 +51,9 @@ sqp::Settings rectifySettings(const OptimalControlProblem& ocp, sqp::Settings&&
   if (ocp.equalityConstraintPtr->empty()) {
     settings.projectStateInputEqualityConstraints = false;
   }
+  if (settings.qpSolverType == sqp::QpSolverType::CONDENSED && (settings.useFeedbackPolicy || settings.createValueFunction)) {
+    throw std::runtime_error("[SqpSolver] The CONDENSED QP solver does not provide the Riccati feedback or value function.");
+  }
   return settings;
 }
 }  // anonymous namespace
@@ -123,6 +126,8 @@ void SqpSolver::reset() {
   solveQpTimer_.reset();
   linesearchTimer_.reset();
   computeControllerTimer_.reset();
+  numLinesearchSweeps_ = 0;
+  numLinesearchCandidates_ = 0;
 }
 
 std::string SqpSolver::getBenchmarkingInformation() const {
@@ -145,6 +150,9 @@ std::string SqpSolver::getBenchmarkingInformation() const {
                << solveQpTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tLinesearch         :\t" << linesearchTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
+    infoStream << "\t  Sweeps           :\t" << static_cast<scalar_t>(numLinesearchSweeps_) / std::max<size_t>(totalNumIterations_, 1)
+               << " per iteration, " << static_cast<scalar_t>(numLinesearchCandidates_) / std::max<size_t>(numLinesearchSweeps_, 1)
+               << " step sizes per sweep\n";
     infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
   }
@@ -282,18 +290,47 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
+  bool qpSolved;
   const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
+  qpSolvedWithParallelRiccati_ = false;
   if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
     hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_));
-    status =
+    const auto status =
         hpipmInterface_.solve(delta_x0, dynamics_, cost_, &stateInputEqConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    qpSolved = status == hpipm_status::SUCCESS;
+  } else if (settings_.qpSolverType == sqp::QpSolverType::PARALLEL_RICCATI) {  // unconstrained QP as below, parallel in time
+    qpSolved = parallelRiccatiSolver_.solve(delta_x0, dynamics_, cost_, threadPool_, static_cast<int>(settings_.nThreads), deltaXSol,
+                                            deltaUSol);
+    qpSolvedWithParallelRiccati_ = qpSolved;
+    if (!qpSolved) {
+      // The parallel scan eliminates the inputs stage-wise and needs R_k > 0, HPIPM only needs R_k + B_k' P_{k+1} B_k > 0.
+      if (settings_.printSolverStatus) {
+        std::cerr << "[SqpSolver] Parallel Riccati factorization failed, solving the QP with HPIPM in this iteration.\n";
+      }
+      hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
+      const auto status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+      qpSolved = status == hpipm_status::SUCCESS;
+    }
   } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    auto ocpSize = extractSizesFromProblem(dynamics_, cost_, nullptr);
+    const int condensingBlockSize = getCondensingBlockSize(ocpSize);
+    qpSolved = false;
+    if (condensingBlockSize > 0) {
+      qpSolved = condensedQpSolver_.solve(delta_x0, dynamics_, cost_, condensingBlockSize, threadPool_,
+                                          static_cast<int>(settings_.nThreads), deltaXSol, deltaUSol);
+      // The Riccati recursion on the condensed QP needs a positive definite Hessian of each block's stacked inputs.
+      if (!qpSolved && settings_.printSolverStatus) {
+        std::cerr << "[SqpSolver] Condensed QP factorization failed, solving the QP with HPIPM in this iteration.\n";
+      }
+    }
+    if (!qpSolved) {
+      hpipmInterface_.resize(std::move(ocpSize));
+      const auto status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+      qpSolved = status == hpipm_status::SUCCESS;
+    }
   }
 
-  if (status != hpipm_status::SUCCESS) {
+  if (!qpSolved) {
     throw std::runtime_error("[SqpSolver] Failed to solve QP");
   }
 
@@ -308,9 +345,26 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
   return solution;
 }
 
+int SqpSolver::getCondensingBlockSize(const OcpSize& ocpSize) const {
+  switch (settings_.qpSolverType) {
+    case sqp::QpSolverType::CONDENSED:
+      return (settings_.condensingBlockSize > 0) ? settings_.condensingBlockSize : CondensedQpSolver::selectBlockSize(ocpSize);
+    case sqp::QpSolverType::AUTO: {
+      if (settings_.useFeedbackPolicy || settings_.createValueFunction) {
+        return 0;
+      }
+      const int blockSize = CondensedQpSolver::selectBlockSize(ocpSize);
+      return (blockSize > 1) ? blockSize : 0;
+    }
+    default:
+      return 0;
+  }
+}
+
 void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    valueFunction_ = qpSolvedWithParallelRiccati_ ? parallelRiccatiSolver_.getRiccatiCostToGo()
+                                                  : hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
     // Correct for linearization state
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
@@ -321,7 +375,8 @@ void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
 PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    matrix_array_t KMatrices = qpSolvedWithParallelRiccati_ ? parallelRiccatiSolver_.getRiccatiFeedback()
+                                                            : hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
     if (settings_.projectStateInputEqualityConstraints) {
       multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
     }
@@ -346,6 +401,8 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   stateInputIneqConstraints_.resize(N);
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
+  transcriptions_.resize(N);
+  eventTranscriptions_.resize(N);
   metrics.resize(N + 1);
 
   std::atomic_int timeIndex{0};
@@ -358,13 +415,14 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
     while (i < N) {
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
+        auto& result = eventTranscriptions_[i];
+        multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1], result);
+        multiple_shooting::computeMetrics(result, metrics[i]);
         workerPerformance += multiple_shooting::computePerformanceIndex(result);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
+        std::swap(cost_[i], result.cost);
+        std::swap(dynamics_[i], result.dynamics);
         stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+        std::swap(stateIneqConstraints_[i], result.ineqConstraints);
         stateInputIneqConstraints_[i].resize(0, x[i].size());
         constraintsProjection_[i].resize(0, x[i].size());
         projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
@@ -372,19 +430,20 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
+        auto& result = transcriptions_[i];
+        multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
+        multiple_shooting::computeMetrics(result, metrics[i]);
         workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
         if (settings_.projectStateInputEqualityConstraints) {
           multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
         }
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
+        std::swap(cost_[i], result.cost);
+        std::swap(dynamics_[i], result.dynamics);
+        std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+        std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+        std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+        std::swap(constraintsProjection_[i], result.constraintsProjection);
+        std::swap(projectionMultiplierCoefficients_[i], result.projectionMultiplierCoefficients);
       }
 
       i = timeIndex++;
@@ -392,12 +451,13 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
+      auto& result = terminalTranscription_;
+      multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N], result);
+      multiple_shooting::computeMetrics(result, metrics[i]);
       workerPerformance += multiple_shooting::computePerformanceIndex(result);
-      cost_[i] = std::move(result.cost);
+      std::swap(cost_[i], result.cost);
       stateInputEqConstraints_[i].resize(0, x[i].size());
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      std::swap(stateIneqConstraints_[i], result.ineqConstraints);
     }
 
     // Accumulate! Same worker might run multiple tasks
@@ -417,51 +477,60 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   return totalPerformance;
 }
 
-PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, std::vector<Metrics>& metrics) {
+std::vector<PerformanceIndex> SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                                            const std::vector<vector_array_t>& x, const std::vector<vector_array_t>& u,
+                                                            std::vector<std::vector<Metrics>>& metrics) {
   // Problem size
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numCandidates = static_cast<int>(x.size());
+  metrics.resize(numCandidates);
+  for (auto& candidateMetrics : metrics) {
+    candidateMetrics.resize(N + 1);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  // The nodes of all candidates are distributed over the workers: task j evaluates node (j % (N + 1)) of candidate (j / (N + 1))
+  std::vector<std::vector<PerformanceIndex>> performance(numCandidates, std::vector<PerformanceIndex>(settings_.nThreads));
+  std::atomic_int taskIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    int j;
+    while ((j = taskIndex++) < numCandidates * (N + 1)) {
+      const int c = j / (N + 1);
+      const int i = j % (N + 1);
+      if (i == N) {
+        const scalar_t tN = getIntervalStart(time[N]);
+        metrics[c][N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[c][N]);
+        performance[c][workerId] += toPerformanceIndex(metrics[c][N]);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
+        metrics[c][i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[c][i], x[c][i + 1]);
+        performance[c][workerId] += toPerformanceIndex(metrics[c][i]);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
+        metrics[c][i] =
+            multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[c][i], x[c][i + 1], u[c][i]);
+        performance[c][workerId] += toPerformanceIndex(metrics[c][i], dt);
       }
-
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += toPerformanceIndex(metrics[N]);
     }
   };
   runParallel(std::move(parallelTask));
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
-
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
+  std::vector<PerformanceIndex> totalPerformance(numCandidates);
+  for (int c = 0; c < numCandidates; c++) {
+    // Account for initial state in performance
+    const vector_t initDynamicsViolation = initState - x[c].front();
+    metrics[c].front().dynamicsViolation += initDynamicsViolation;
+    performance[c].front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+
+    // Sum performance of the threads
+    auto& total = totalPerformance[c];
+    total = std::accumulate(std::next(performance[c].begin()), performance[c].end(), performance[c].front());
+    total.merit = total.cost + total.equalityLagrangian + total.inequalityLagrangian;
+  }
   return totalPerformance;
 }
 
@@ -490,59 +559,89 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
 
+  // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
+  auto isStepTooSmall = [&](scalar_t alpha) { return alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol; };
+
+  const size_t numCandidatesPerSweep = std::max<size_t>(settings_.linesearchCandidatesPerSweep, 1);
   scalar_t alpha = 1.0;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  std::vector<Metrics> metricsNew(metrics.size());
-  do {
-    // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
+  bool keepSearching = true;
+  std::vector<scalar_t> alphas;
+  std::vector<vector_array_t> xNew;
+  std::vector<vector_array_t> uNew;
+  std::vector<std::vector<Metrics>> metricsNew;
+  while (keepSearching) {
+    // Speculatively evaluate the next step sizes of the back-tracking sequence in one sweep
+    alphas.assign(1, alpha);
+    while (alphas.size() < numCandidatesPerSweep) {
+      const scalar_t nextAlpha = alphas.back() * settings_.alpha_decay;
+      if (nextAlpha < settings_.alpha_min || isStepTooSmall(nextAlpha)) {
+        break;
+      }
+      alphas.push_back(nextAlpha);
+    }
 
-    // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew);
-
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
+    // Compute steps
+    xNew.resize(alphas.size(), vector_array_t(x.size()));
+    uNew.resize(alphas.size(), vector_array_t(u.size()));
+    for (size_t c = 0; c < alphas.size(); c++) {
+      multiple_shooting::incrementTrajectory(u, du, alphas[c], uNew[c]);
+      multiple_shooting::incrementTrajectory(x, dx, alphas[c], xNew[c]);
     }
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      sqp::StepInfo stepInfo;
-      stepInfo.stepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
-      alpha *= settings_.alpha_decay;
+    // Compute cost and constraints
+    const auto performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew);
+    ++numLinesearchSweeps_;
+    numLinesearchCandidates_ += alphas.size();
+
+    // Apply the acceptance logic in the order of the back-tracking sequence
+    for (size_t c = 0; c < alphas.size(); c++) {
+      alpha = alphas[c];
+
+      // Step acceptance and record step type
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, performanceNew[c], alpha * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
+        std::cerr << performanceNew[c] << "\n";
+      }
 
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
+      if (stepAccepted) {  // Return if step accepted
+        x = std::move(xNew[c]);
+        u = std::move(uNew[c]);
+        metrics = std::move(metricsNew[c]);
+
+        // Prepare step info
+        sqp::StepInfo stepInfo;
+        stepInfo.stepSize = alpha;
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = alpha * deltaXnorm;
+        stepInfo.du_norm = alpha * deltaUnorm;
+        stepInfo.performanceAfterStep = performanceNew[c];
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew[c]);
+        return stepInfo;
+      }
+
+      // Try smaller step
+      alpha *= settings_.alpha_decay;
+      if (isStepTooSmall(alpha)) {
         if (settings_.printLinesearch) {
           std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
                     << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
         }
+        keepSearching = false;
+        break;
+      }
+      if (alpha < settings_.alpha_min) {
+        keepSearching = false;
         break;
       }
     }
-  } while (alpha >= settings_.alpha_min);
+  }
 
   // Alpha_min reached -> Don't take a step
   sqp::StepInfo stepInfo;
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_sqp/SqpSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/initialization/OperatingPoints.h>
 
 #include <ocs2_oc/test/circular_kinematics.h>
 
@@ -141,3 +142,50 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, solve_speculativeLinesearch) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = true;
+  settings.printLinesearch = true;
+  settings.nThreads = 3;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Input guess pointing away from the circle, such that the linesearch has to back-track
+  const ocs2::vector_t initInput = (ocs2::vector_t(2) << 2.0, 0.0).finished();
+  ocs2::OperatingPoints operatingPoints(initState, initInput);
+
+  // Solve with one step size per sweep and with several step sizes per sweep
+  auto solve = [&](size_t linesearchCandidatesPerSweep) {
+    settings.linesearchCandidatesPerSweep = linesearchCandidatesPerSweep;
+    ocs2::SqpSolver solver(settings, problem, operatingPoints);
+    solver.run(startTime, initState, finalTime);
+    return std::make_pair(solver.primalSolution(finalTime), solver.getIterationsLog());
+  };
+  const auto sequential = solve(1);
+
+  // The speculative sweeps apply the acceptance logic in the same order, hence take the same steps.
+  for (const size_t linesearchCandidatesPerSweep : {2, 4}) {
+    const auto speculative = solve(linesearchCandidatesPerSweep);
+    ASSERT_EQ(sequential.second.size(), speculative.second.size());
+    for (int i = 0; i < sequential.second.size(); i++) {
+      EXPECT_DOUBLE_EQ(sequential.second[i].merit, speculative.second[i].merit);
+    }
+    ASSERT_EQ(sequential.first.stateTrajectory_.size(), speculative.first.stateTrajectory_.size());
+    for (int i = 0; i < sequential.first.stateTrajectory_.size(); i++) {
+      EXPECT_TRUE(sequential.first.stateTrajectory_[i].isApprox(speculative.first.stateTrajectory_[i]));
+      EXPECT_TRUE(sequential.first.inputTrajectory_[i].isApprox(speculative.first.inputTrajectory_[i]));
+    }
+  }
+}
@@ -0,0 +1,140 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/SqpSolver.h"
+
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/initialization/DefaultInitializer.h>
+
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+#include <ocs2_oc/test/CountingAllocator.h>
+
+namespace ocs2 {
+namespace {
+
+constexpr size_t numWarmUpIterations = 2;
+constexpr size_t numCountedIterations = 2;
+std::atomic_size_t numApproximations{0};
+
+/**
+ * Delimits the LQ approximation of an SQP iteration: counting starts with the first approximation request of an intermediate node and
+ * stops with the approximation request of the terminal node. The first iterations size the thread-local buffers and both sides of the
+ * swapped transcription storage and are not counted. The solver is run single-threaded such that no other work interleaves.
+ */
+class ApproximationProbe final : public PreComputation {
+ public:
+  ApproximationProbe* clone() const override { return new ApproximationProbe(*this); }
+
+  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override {
+    if (request.contains(Request::Approximation) && numApproximations >= numWarmUpIterations) {
+      countAllocations = true;
+    }
+  }
+
+  void requestFinal(RequestSet request, scalar_t t, const vector_t& x) override {
+    if (request.contains(Request::Approximation)) {
+      countAllocations = false;
+      ++numApproximations;
+    }
+  }
+};
+
+/** Linear dynamics plus an elementwise sine of the state, such that every SQP iteration takes a step. */
+class SineSystemDynamics final : public LinearSystemDynamics {
+ public:
+  using LinearSystemDynamics::LinearSystemDynamics;
+  using LinearSystemDynamics::linearApproximation;
+
+  SineSystemDynamics* clone() const override { return new SineSystemDynamics(*this); }
+
+  vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp) override {
+    vector_t dxdt = LinearSystemDynamics::computeFlowMap(t, x, u, preComp);
+    dxdt.array() += x.array().sin();
+    return dxdt;
+  }
+
+  void linearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp,
+                           VectorFunctionLinearApproximation& approximation) override {
+    LinearSystemDynamics::linearApproximation(t, x, u, preComp, approximation);
+    approximation.f.array() += x.array().sin();
+    approximation.dfdx.diagonal().array() += x.array().cos();
+  }
+};
+
+}  // unnamed namespace
+}  // namespace ocs2
+
+TEST(test_sqp_allocations, noAllocationsInApproximationAfterWarmUp) {
+#ifdef OCS2_COUNT_ALLOCATIONS
+  using namespace ocs2;
+  constexpr size_t nx = 4;
+  constexpr size_t nu = 2;
+
+  OptimalControlProblem problem;
+  problem.dynamicsPtr.reset(new SineSystemDynamics(matrix_t::Random(nx, nx), matrix_t::Random(nx, nu)));
+  problem.costPtr->add("cost", std::unique_ptr<StateInputCost>(
+                                   new QuadraticStateInputCost(matrix_t::Identity(nx, nx), matrix_t::Identity(nu, nu))));
+  problem.finalCostPtr->add("finalCost", std::unique_ptr<StateCost>(new QuadraticStateCost(matrix_t::Identity(nx, nx))));
+  problem.preComputationPtr.reset(new ApproximationProbe);
+
+  const TargetTrajectories targetTrajectories({0.0, 1.0}, {vector_t::Ones(nx), vector_t::Zero(nx)},
+                                              {vector_t::Zero(nu), vector_t::Zero(nu)});
+  auto referenceManagerPtr = std::make_shared<ReferenceManager>(targetTrajectories);
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  DefaultInitializer zeroInitializer(nu);
+
+  // Runs exactly the requested number of iterations
+  sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = numWarmUpIterations + numCountedIterations;
+  settings.costTol = -1.0;
+  settings.deltaTol = -1.0;
+  settings.nThreads = 1;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  SqpSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  numAllocations = 0;
+  numApproximations = 0;
+  solver.run(0.0, 2.0 * vector_t::Ones(nx), 1.0);
+  countAllocations = false;
+
+  EXPECT_EQ(numApproximations, numWarmUpIterations + numCountedIterations);
+  EXPECT_EQ(numAllocations, 0);
+#endif
+}
@@ -41,7 +41,7 @@ namespace {
 
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSetting(
     bool feedback, bool emptyConstraint, const VectorFunctionLinearApproximation& dynamicsMatrices,
-    const ScalarFunctionQuadraticApproximation& costMatrices) {
+    const ScalarFunctionQuadraticApproximation& costMatrices, sqp::QpSolverType qpSolverType = sqp::QpSolverType::HPIPM) {
   int n = dynamicsMatrices.dfdu.rows();
   int m = dynamicsMatrices.dfdu.cols();
 
@@ -76,6 +76,7 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSettin
   settings.printSolverStatus = true;
   settings.printLinesearch = true;
   settings.nThreads = 100;
+  settings.qpSolverType = qpSolverType;
 
   // Additional problem definitions
   const ocs2::scalar_t startTime = 0.0;
@@ -160,3 +161,119 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+TEST(test_unconstrained, parallelRiccati) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto solWithHpipm = ocs2::solveWithFeedbackSetting(true, true, dynamics, costs, ocs2::sqp::QpSolverType::HPIPM);
+  const auto solWithParallelRiccati =
+      ocs2::solveWithFeedbackSetting(true, true, dynamics, costs, ocs2::sqp::QpSolverType::PARALLEL_RICCATI);
+
+  ASSERT_LE(solWithParallelRiccati.second.size(), 2);
+  ASSERT_LT(solWithParallelRiccati.second.back().dynamicsViolationSSE, tol);
+
+  // Compare
+  const auto& withHpipm = solWithHpipm.first;
+  const auto& withParallelRiccati = solWithParallelRiccati.first;
+  for (int i = 0; i < withHpipm.timeTrajectory_.size(); i++) {
+    ASSERT_DOUBLE_EQ(withHpipm.timeTrajectory_[i], withParallelRiccati.timeTrajectory_[i]);
+    ASSERT_TRUE(withHpipm.stateTrajectory_[i].isApprox(withParallelRiccati.stateTrajectory_[i], tol));
+    ASSERT_TRUE(withHpipm.inputTrajectory_[i].isApprox(withParallelRiccati.inputTrajectory_[i], tol));
+
+    const auto t = withHpipm.timeTrajectory_[i];
+    const auto& x = withHpipm.stateTrajectory_[i];
+    ASSERT_TRUE(withHpipm.controllerPtr_->computeInput(t, x).isApprox(withParallelRiccati.controllerPtr_->computeInput(t, x), tol));
+  }
+}
+
+TEST(test_unconstrained, parallelRiccatiIndefiniteInputHessian) {
+  int n = 2;
+  int m = 2;
+  const double tol = 1e-9;
+
+  // R is indefinite, but the input acts strongly on the state such that R + B' P B is positive definite.
+  ocs2::VectorFunctionLinearApproximation dynamics;
+  dynamics.dfdx = ocs2::matrix_t::Identity(n, n);
+  dynamics.dfdu = 10.0 * ocs2::matrix_t::Identity(n, m);
+  dynamics.f = ocs2::vector_t::Zero(n);
+  ocs2::ScalarFunctionQuadraticApproximation costs;
+  costs.dfdxx = 10.0 * ocs2::matrix_t::Identity(n, n);
+  costs.dfdux = ocs2::matrix_t::Zero(m, n);
+  costs.dfduu = ocs2::vector_t::LinSpaced(m, 1.0, -0.1).asDiagonal();
+
+  // The parallel Riccati solver can not eliminate the inputs, the SQP falls back to HPIPM.
+  const auto solWithHpipm = ocs2::solveWithFeedbackSetting(true, true, dynamics, costs, ocs2::sqp::QpSolverType::HPIPM);
+  const auto solWithParallelRiccati =
+      ocs2::solveWithFeedbackSetting(true, true, dynamics, costs, ocs2::sqp::QpSolverType::PARALLEL_RICCATI);
+
+  ASSERT_LT(solWithParallelRiccati.second.back().dynamicsViolationSSE, tol);
+
+  // Compare
+  const auto& withHpipm = solWithHpipm.first;
+  const auto& withParallelRiccati = solWithParallelRiccati.first;
+  for (int i = 0; i < withHpipm.timeTrajectory_.size(); i++) {
+    ASSERT_DOUBLE_EQ(withHpipm.timeTrajectory_[i], withParallelRiccati.timeTrajectory_[i]);
+    ASSERT_TRUE(withHpipm.stateTrajectory_[i].isApprox(withParallelRiccati.stateTrajectory_[i], tol));
+    ASSERT_TRUE(withHpipm.inputTrajectory_[i].isApprox(withParallelRiccati.inputTrajectory_[i], tol));
+
+    const auto t = withHpipm.timeTrajectory_[i];
+    const auto& x = withHpipm.stateTrajectory_[i];
+    ASSERT_TRUE(withHpipm.controllerPtr_->computeInput(t, x).isApprox(withParallelRiccati.controllerPtr_->computeInput(t, x), tol));
+  }
+}
+
+TEST(test_unconstrained, condensed) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto solWithHpipm = ocs2::solveWithFeedbackSetting(false, true, dynamics, costs, ocs2::sqp::QpSolverType::HPIPM);
+  const auto solWithCondensing = ocs2::solveWithFeedbackSetting(false, true, dynamics, costs, ocs2::sqp::QpSolverType::CONDENSED);
+
+  ASSERT_LE(solWithCondensing.second.size(), 2);
+  ASSERT_LT(solWithCondensing.second.back().dynamicsViolationSSE, tol);
+
+  // Compare
+  const auto& withHpipm = solWithHpipm.first;
+  const auto& withCondensing = solWithCondensing.first;
+  for (int i = 0; i < withHpipm.timeTrajectory_.size(); i++) {
+    ASSERT_DOUBLE_EQ(withHpipm.timeTrajectory_[i], withCondensing.timeTrajectory_[i]);
+    ASSERT_TRUE(withHpipm.stateTrajectory_[i].isApprox(withCondensing.stateTrajectory_[i], tol));
+    ASSERT_TRUE(withHpipm.inputTrajectory_[i].isApprox(withCondensing.inputTrajectory_[i], tol));
+  }
+}
+
+TEST(test_unconstrained, condensedIndefiniteInputHessian) {
+  int n = 2;
+  int m = 2;
+  const double tol = 1e-9;
+
+  // R is indefinite. The last input of each block only acts on the next block, such that the condensed input Hessian is indefinite too.
+  ocs2::VectorFunctionLinearApproximation dynamics;
+  dynamics.dfdx = ocs2::matrix_t::Identity(n, n);
+  dynamics.dfdu = 10.0 * ocs2::matrix_t::Identity(n, m);
+  dynamics.f = ocs2::vector_t::Zero(n);
+  ocs2::ScalarFunctionQuadraticApproximation costs;
+  costs.dfdxx = 10.0 * ocs2::matrix_t::Identity(n, n);
+  costs.dfdux = ocs2::matrix_t::Zero(m, n);
+  costs.dfduu = ocs2::vector_t::LinSpaced(m, 1.0, -0.1).asDiagonal();
+
+  // The condensed QP can not be factorized, the SQP falls back to HPIPM.
+  const auto solWithHpipm = ocs2::solveWithFeedbackSetting(false, true, dynamics, costs, ocs2::sqp::QpSolverType::HPIPM);
+  const auto solWithCondensing = ocs2::solveWithFeedbackSetting(false, true, dynamics, costs, ocs2::sqp::QpSolverType::CONDENSED);
+
+  ASSERT_LT(solWithCondensing.second.back().dynamicsViolationSSE, tol);
+
+  // Compare
+  const auto& withHpipm = solWithHpipm.first;
+  const auto& withCondensing = solWithCondensing.first;
+  for (int i = 0; i < withHpipm.timeTrajectory_.size(); i++) {
+    ASSERT_DOUBLE_EQ(withHpipm.timeTrajectory_[i], withCondensing.timeTrajectory_[i]);
+    ASSERT_TRUE(withHpipm.stateTrajectory_[i].isApprox(withCondensing.stateTrajectory_[i], tol));
+    ASSERT_TRUE(withHpipm.inputTrajectory_[i].isApprox(withCondensing.inputTrajectory_[i], tol));
+  }
+}